@@ -0,0 +1,551 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* The address files only depend on the device description and the output     */
+/* format, not on the data. The address output of all blocks is rendered once */
+/* into a cache file and the address files are assembled by copying the       */
+/* slices of the used blocks from this file.                                  */
+/*----------------------------------------------------------------------------*/
+
+#include "address-cache.h"
+
+
+/* Continue a FNV-1a hash                                                     */
+/*----------------------------------------------------------------------------*/
+/* IN hash: Hash of the preceding bytes (FNV_OFFSET_BASIS at the start).      */
+/* IN data: Bytes to be hashed.                                               */
+/* IN length: Number of bytes.                                                */
+/* RETURNS: Hash of the preceding bytes and data.                             */
+/*----------------------------------------------------------------------------*/
+uint64_t	hashBytes(uint64_t hash, void *data, size_t length)
+{
+	size_t i;
+
+
+	for(i=0; i < length; i++)
+	{
+		hash ^= ((uint8_t *) data)[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+
+/* Copy the runs of a bit order into a header                                 */
+/*----------------------------------------------------------------------------*/
+/* The runs are copied field by field, so the unused bytes stay 0.            */
+/* OUT copy: Runs of the header (cleared).                                    */
+/* IN runs: Runs of the bit order.                                            */
+/*----------------------------------------------------------------------------*/
+static void	copyBitOrderRuns(bitOrderRuns *copy, bitOrderRuns *runs)
+{
+	int run;
+
+
+	copy->length = runs->length;
+	copy->runNum = runs->runNum;
+	for(run=0; run < runs->runNum; run++)
+	{
+		copy->run[run].type = runs->run[run].type;
+		copy->run[run].first = runs->run[run].first;
+		copy->run[run].length = runs->run[run].length;
+		copy->run[run].count = runs->run[run].count;
+	}
+}
+
+
+/* Collect everything an address stream depends on                            */
+/*----------------------------------------------------------------------------*/
+/* OUT header: Header of the cache file of the address stream.                */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN mode: PROGRAM or VERIFY.                                                */
+/* IN format: Output format.                                                  */
+/*----------------------------------------------------------------------------*/
+void	initializeAddressCacheHeader(addressCacheHeader *header, 
+			deviceData *device, int mode, outputFormat *format)
+{
+	memset(header, 0, sizeof(addressCacheHeader));
+
+	/* cache format and output format */
+	memcpy(header->magic, ADDRESS_CACHE_MAGIC, sizeof(header->magic));
+	header->version = ADDRESS_CACHE_VERSION;
+	header->wordSize = sizeof(uint32_64_t);
+	header->format.type = format->type;
+	memcpy(header->format.symbol, format->symbol, sizeof(format->symbol));
+	memcpy(header->format.separator, format->separator, 
+						format->separatorLength);
+	header->format.separatorLength = format->separatorLength;
+	memcpy(header->format.terminator, format->terminator, 
+						format->terminatorLength);
+	header->format.terminatorLength = format->terminatorLength;
+	header->format.wordsPerLine = format->wordsPerLine;
+
+	/* memory layout and addresses */
+	header->memorySize = device->memorySize;
+	header->blockSize = device->blockSize;
+	header->startAddress = device->startAddress;
+	header->addressStepPerWord = device->addressStepPerWord;
+	header->wordLength = device->wordLength;
+	header->addressLength = device->addressLength;
+
+	/* address bit orders */
+	copyBitOrderRuns(&header->wordAddressBitOrder, 
+					&device->wordAddressBitOrder[mode]);
+	copyBitOrderRuns(&header->preDataBlockAddrBitOrder, 
+				&device->preDataBlockAddrBitOrder[mode]);
+	copyBitOrderRuns(&header->postDataBlockAddrBitOrder, 
+				&device->postDataBlockAddrBitOrder[mode]);
+
+	/* cached output */
+	header->blockNum = device->memorySize / device->blockSize;
+	header->blockLength = calculateBlockLength(device, ADDRESS_STREAM, 
+							mode, format);
+}
+
+
+/* Hash everything an address stream depends on                               */
+/*----------------------------------------------------------------------------*/
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN mode: PROGRAM or VERIFY.                                                */
+/* IN format: Output format.                                                  */
+/* RETURNS: Hash of the address stream.                                       */
+/*----------------------------------------------------------------------------*/
+uint64_t	hashAddressStream(deviceData *device, int mode, 
+							outputFormat *format)
+{
+	addressCacheHeader header;
+
+
+	initializeAddressCacheHeader(&header, device, mode, format);
+
+	return hashBytes(FNV_OFFSET_BASIS, &header, sizeof(header));
+}
+
+
+/* Set the name of the cache file of an address stream                        */
+/*----------------------------------------------------------------------------*/
+/* OUT cacheFileName: Name of the cache file.                                 */
+/* IN cacheDirectory: Directory of the cache files.                           */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN mode: PROGRAM or VERIFY.                                                */
+/* IN format: Output format.                                                  */
+/*----------------------------------------------------------------------------*/
+void	setAddressCacheFileName(char *cacheFileName, char *cacheDirectory, 
+			deviceData *device, int mode, outputFormat *format)
+{
+	uint64_t hash;
+
+
+	hash = hashAddressStream(device, mode, format);
+	sprintf(cacheFileName, "%.*s/01ascii_%08lx%08lx.address", 
+		FILENAME_MAX - 64, cacheDirectory, 
+		(unsigned long) (hash >> 32), 
+		(unsigned long) (hash & 0xFFFFFFFF));
+}
+
+
+/* Copy a range of bytes between files                                        */
+/*----------------------------------------------------------------------------*/
+/* The data is copied within the kernel with copy_file_range if possible,     */
+/* otherwise it is read and written in pieces.                                */
+/* IN inputFile: File to copy from.                                           */
+/* IN inputOffset: Position of the range in the input file.                   */
+/* IN outputFile: File to copy to.                                            */
+/* IN outputOffset: Position of the range in the output file.                 */
+/* IN length: Number of bytes to copy.                                        */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	copyFileRange(int inputFile, off_t inputOffset, int outputFile,
+					off_t outputOffset, size_t length)
+{
+	ssize_t result;
+	ssize_t written;
+	ssize_t writtenBytes;
+	char *buffer;
+
+
+#ifdef HAVE_COPY_FILE_RANGE
+	while(length > 0)
+	{
+		result = copy_file_range(inputFile, &inputOffset, outputFile,
+						&outputOffset, length, 0);
+		if(result < 0 && errno == EINTR)
+			continue;
+
+		/* copy the rest by hand if the kernel can't copy it */
+		if(result <= 0)
+			break;
+
+		length -= result;
+	}
+
+	if(length == 0)
+		return EXIT_SUCCESS;
+#endif
+
+	buffer = malloc(OUTPUT_BUFFER_SIZE);
+	if(buffer == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	while(length > 0)
+	{
+		result = pread(inputFile, buffer, (length < OUTPUT_BUFFER_SIZE) ?
+				length : OUTPUT_BUFFER_SIZE, inputOffset);
+		if(result < 0 && errno == EINTR)
+			continue;
+		if(result <= 0)
+			break;
+
+		/* write the read piece */
+		writtenBytes = 0;
+		while(writtenBytes < result)
+		{
+			written = pwrite(outputFile, buffer + writtenBytes,
+					result - writtenBytes, 
+					outputOffset + writtenBytes);
+			if(written < 0 && errno == EINTR)
+				continue;
+			if(written <= 0)
+				break;
+
+			writtenBytes += written;
+		}
+		if(writtenBytes < result)
+			break;
+
+		inputOffset += result;
+		outputOffset += result;
+		length -= result;
+	}
+
+	free(buffer);
+
+	return (length == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* Check if a cache file holds the output of an address stream                */
+/*----------------------------------------------------------------------------*/
+/* The header of the file must match the header of the address stream and the */
+/* file must hold the output of all blocks.                                   */
+/* IN cacheFile: Opened cache file.                                           */
+/* IN header: Header of the address stream (see initializeAddressCacheHeader).*/
+/* RETURNS: true if the cache file can be used, false otherwise.              */
+/*----------------------------------------------------------------------------*/
+static int	addressCacheIsValid(int cacheFile, addressCacheHeader *header)
+{
+	ssize_t result;
+	struct stat cacheStatus;
+	addressCacheHeader fileHeader;
+
+
+	if((fstat(cacheFile, &cacheStatus) != 0) || (cacheStatus.st_size != 
+		(off_t) (sizeof(addressCacheHeader) + 
+				header->blockNum * header->blockLength)))
+		return false;
+
+	do
+		result = pread(cacheFile, &fileHeader, sizeof(fileHeader), 0);
+	while(result < 0 && errno == EINTR);
+
+	if((result != (ssize_t) sizeof(fileHeader)) || 
+			(memcmp(&fileHeader, header, sizeof(fileHeader)) != 0))
+		return false;
+
+	return true;
+}
+
+
+/* Render the address output of all blocks into a cache file                  */
+/*----------------------------------------------------------------------------*/
+/* The file is written under a temporary name and renamed when it is          */
+/* complete, so concurrent runs never see a partial cache file. The output of */
+/* the blocks follows the header of the address stream.                       */
+/* IN cacheFileName: Name of the cache file.                                  */
+/* IN header: Header of the address stream (see initializeAddressCacheHeader).*/
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN image: Memory image that contains the data.                             */
+/* IN mode: PROGRAM or VERIFY.                                                */
+/* IN options: Options of the output generation.                              */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	buildAddressCache(char *cacheFileName, addressCacheHeader *header, 
+			deviceData *device, memoryImage *image, int mode, 
+			outputOptions *options)
+{
+	int result;
+	ssize_t written;
+	char temporaryFileName[FILENAME_MAX];
+	outputStream stream;
+
+
+	sprintf(temporaryFileName, "%.*s.%lu", FILENAME_MAX - 32, 
+				cacheFileName, (unsigned long) getpid());
+
+	if(openOutputStream(&stream, temporaryFileName, device, ADDRESS_STREAM,
+		mode, &options->format, options->precompiled) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* the output of the blocks follows the header */
+	do
+		written = pwrite(stream.output.file, header, 
+					sizeof(addressCacheHeader), 0);
+	while(written < 0 && errno == EINTR);
+
+	result = EXIT_FAILURE;
+	if(written == (ssize_t) sizeof(addressCacheHeader))
+	{
+		stream.output.offset = sizeof(addressCacheHeader);
+		result = writeOutputStreamsParallel(&stream, 1, device, image,
+						true, options->threadNum);
+	}
+
+	if(result == EXIT_SUCCESS)
+		result = closeOutputStream(&stream);
+	else
+		disposeOutputStream(&stream);
+
+	if(result == EXIT_SUCCESS && 
+			rename(temporaryFileName, cacheFileName) != 0)
+		result = EXIT_FAILURE;
+
+	if(result != EXIT_SUCCESS)
+		remove(temporaryFileName);
+
+	return result;
+}
+
+
+/* Copy the output of blocks from the cache file to an output buffer          */
+/*----------------------------------------------------------------------------*/
+/* If the buffer is written with plain pwrite, the data is copied within the  */
+/* kernel (see copyFileRange). Otherwise it is read into the buffer, so it is */
+/* written like the output of the other streams (mapped, queued or kept out   */
+/* of the page cache).                                                        */
+/* INOUT output: Output buffer of the address file.                           */
+/* IN cacheFile: Opened cache file.                                           */
+/* IN offset: Position of the output of the blocks in the cache file.         */
+/* IN length: Number of bytes to copy.                                        */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	copyCachedBlocks(outputBuffer *output, int cacheFile, 
+						off_t offset, size_t length)
+{
+	size_t piece;
+	ssize_t result;
+	char *data;
+
+
+	if((output->map == NULL) && (output->bufferNum == 0) &&
+					(output->caching == PAGE_CACHE))
+	{
+		if((flushOutputBuffer(output) != EXIT_SUCCESS) || 
+			(copyFileRange(cacheFile, offset, output->file, 
+				output->offset, length) != EXIT_SUCCESS))
+			return EXIT_FAILURE;
+
+		output->offset += length;
+		output->writeNum++;
+		return EXIT_SUCCESS;
+	}
+
+	while(length > 0)
+	{
+		piece = (length < ADDRESS_CACHE_CHUNK_SIZE) ? length : 
+						ADDRESS_CACHE_CHUNK_SIZE;
+		data = reserveOutputBuffer(output, piece);
+		if(data == NULL)
+			return EXIT_FAILURE;
+
+		result = pread(cacheFile, data, piece, offset);
+		if(result < 0 && errno == EINTR)
+			continue;
+		if(result <= 0)
+			return EXIT_FAILURE;
+
+		output->length += result;
+		offset += result;
+		length -= result;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Write an address file with the help of the address cache                   */
+/*----------------------------------------------------------------------------*/
+/* The cache file is built if it doesn't exist yet or doesn't match the       */
+/* address stream. Devices whose address output is larger than                */
+/* ADDRESS_CACHE_MAX_SIZE are not cached. The output of the used blocks is    */
+/* copied from the cache file to the address file, consecutive used blocks at */
+/* once. The address file is written like the files of the output streams     */
+/* (see openOutputFiles).                                                     */
+/* IN cacheDirectory: Directory of the cache files.                           */
+/* IN fileName: Name of the address file.                                     */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN image: Memory image that contains the data.                             */
+/* IN mode: PROGRAM, VERIFY or PROGRAM_VERIFY.                                */
+/* IN options: Options of the output generation.                              */
+/* RETURNS: EXIT_FAILURE if the address file could not be written with the    */
+/*          cache, EXIT_SUCCESS otherwise.                                    */
+/*----------------------------------------------------------------------------*/
+int	writeCachedAddressFile(char *cacheDirectory, char *fileName,
+			deviceData *device, memoryImage *image, int mode,
+			outputOptions *options)
+{
+	int result;
+	int cacheFile;
+	char cacheFileName[FILENAME_MAX];
+	struct stat cacheStatus;
+	addressCacheHeader header;
+	outputBuffer output;
+
+	uint32_64_t block;
+	uint32_64_t firstBlock;
+	uint32_64_t usedBlockNum;
+
+
+	if(mode == PROGRAM_VERIFY)
+		mode = PROGRAM;
+
+	/* the cache directory must exist */
+	if((stat(cacheDirectory, &cacheStatus) != 0) || 
+					(!S_ISDIR(cacheStatus.st_mode)))
+		return EXIT_FAILURE;
+
+	/* the output of a block has a fixed length */
+	initializeAddressCacheHeader(&header, device, mode, &options->format);
+	if(header.blockNum * header.blockLength > ADDRESS_CACHE_MAX_SIZE)
+		return EXIT_FAILURE;
+
+	setAddressCacheFileName(cacheFileName, cacheDirectory, device, mode,
+							&options->format);
+
+	/* build the cache file if it is missing or doesn't match */
+	cacheFile = open(cacheFileName, O_RDONLY);
+	if((cacheFile >= 0) && (addressCacheIsValid(cacheFile, &header) != 
+								true))
+	{
+		close(cacheFile);
+		cacheFile = -1;
+	}
+
+	if(cacheFile < 0)
+	{
+		if(buildAddressCache(cacheFileName, &header, device, image, 
+					mode, options) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+
+		cacheFile = open(cacheFileName, O_RDONLY);
+		if(cacheFile < 0)
+			return EXIT_FAILURE;
+	}
+
+	if(openOutputBuffer(&output, fileName, ADDRESS_CACHE_CHUNK_SIZE) != 
+								EXIT_SUCCESS)
+	{
+		close(cacheFile);
+		return EXIT_FAILURE;
+	}
+
+	/* the address file is written like the files of the streams */
+	if(options->mapOutput == true)
+	{
+		usedBlockNum = countOutputBlocks(device, image, 
+						options->generateAllBlocks);
+		mapOutputBuffer(&output, usedBlockNum * header.blockLength);
+	}
+
+	if(output.map == NULL)
+	{
+		if(options->uncacheOutput == true)
+			uncacheOutputBuffer(&output);
+		if(options->queueOutput == true)
+			queueOutputBuffer(&output);
+	}
+
+	/* copy the used blocks */
+	result = EXIT_SUCCESS;
+	block = 0;
+	while((block < header.blockNum) && (result == EXIT_SUCCESS))
+	{
+		/* find the next range of used blocks */
+		while((block < header.blockNum) && 
+			(options->generateAllBlocks != true) &&
+			(memoryBlockIsAllocated(image, block) == false))
+			block++;
+
+		firstBlock = block;
+		while((block < header.blockNum) && 
+			((options->generateAllBlocks == true) ||
+			(memoryBlockIsAllocated(image, block) == true)))
+			block++;
+
+		if(block > firstBlock)
+			result = copyCachedBlocks(&output, cacheFile, 
+				sizeof(addressCacheHeader) + 
+				firstBlock * header.blockLength, 
+				(block - firstBlock) * header.blockLength);
+	}
+
+	close(cacheFile);
+	if(result == EXIT_SUCCESS)
+		result = closeOutputBuffer(&output);
+	else
+		disposeOutputBuffer(&output);
+
+	if((result == EXIT_SUCCESS) && (options->printStatistics == true))
+		printOutputBufferStatistics(&output);
+
+	return result;
+}
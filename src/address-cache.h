@@ -0,0 +1,111 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _ADDRESS_CACHE_H
+#define _ADDRESS_CACHE_H
+
+#include "converter.h"
+#include <sys/stat.h>
+
+
+/* version of the cache file content (part of the hash) */
+#define ADDRESS_CACHE_VERSION	3
+
+/* first bytes of a cache file */
+#define ADDRESS_CACHE_MAGIC	"01ASCIIA"
+
+/* devices with a larger address output are not cached */
+#define ADDRESS_CACHE_MAX_SIZE	(UINT64_C(256)*1024*1024)
+
+/* number of bytes copied from the cache file at once */
+#define ADDRESS_CACHE_CHUNK_SIZE	(64*1024)
+
+/* FNV-1a hash parameters */
+#define FNV_OFFSET_BASIS	UINT64_C(0xCBF29CE484222325)
+#define FNV_PRIME		UINT64_C(0x00000100000001B3)
+
+
+/* datatype for the header of a cache file, it holds everything the address */
+/* output depends on (unused bytes are 0, so it can be hashed and compared) */
+typedef struct
+{
+	char magic[8];
+	int version;
+	int wordSize;
+
+	/* output format */
+	outputFormat format;
+
+	/* memory layout and addresses */
+	uint64_t memorySize;
+	uint64_t blockSize;
+	uint64_t startAddress;
+	int addressStepPerWord;
+	int wordLength;
+	int addressLength;
+
+	/* address bit orders */
+	bitOrderRuns wordAddressBitOrder;
+	bitOrderRuns preDataBlockAddrBitOrder;
+	bitOrderRuns postDataBlockAddrBitOrder;
+
+	/* cached output following the header */
+	uint64_t blockNum;
+	uint64_t blockLength;
+}
+addressCacheHeader;
+
+
+extern	uint64_t	hashBytes(uint64_t, void *, size_t);
+extern	void	initializeAddressCacheHeader(addressCacheHeader *, 
+					deviceData *, int, outputFormat *);
+extern	uint64_t	hashAddressStream(deviceData *, int, outputFormat *);
+extern	void	setAddressCacheFileName(char *, char *, deviceData *, int, 
+							outputFormat *);
+extern	int	copyFileRange(int, off_t, int, off_t, size_t);
+extern	int	buildAddressCache(char *, addressCacheHeader *, deviceData *, 
+				memoryImage *, int, outputOptions *);
+extern	int	writeCachedAddressFile(char *, char *, deviceData *, 
+				memoryImage *, int, outputOptions *);
+
+#endif /* _ADDRESS_CACHE_H */
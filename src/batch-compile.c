@@ -0,0 +1,565 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* A batch compile translates many device description sources into compiled   */
+/* device files (see device-file.c) in one output directory. The sources are  */
+/* taken from a queue by a pool of threads, every thread works with its own   */
+/* parser state. The output file of a source is named like the source without */
+/* its extension. The hash of the source is stored in the output file, so     */
+/* sources which haven't changed since the last compile are skipped. The      */
+/* failures of every source are collected and printed in the order of the     */
+/* sources after all threads have finished.                                   */
+/*----------------------------------------------------------------------------*/
+
+#include "batch-compile.h"
+
+
+/* states of the sources */
+enum {WAITING_SOURCE, COMPILED_SOURCE, SKIPPED_SOURCE, FAILED_SOURCE};
+
+
+/* datatype for a source of a batch */
+typedef struct
+{
+	char *sourceName;
+	char outputName[FILENAME_MAX];
+	int state;
+
+	/* failures reported while compiling the source */
+	char *report;
+	size_t reportSize;
+}
+compileJob;
+
+
+/* datatype for the queue of the sources shared by the threads */
+typedef struct
+{
+	compileJob *jobs;
+	int jobNum;
+	int nextJob;
+	pthread_mutex_t lock;
+}
+compileQueue;
+
+
+/* Compare two source names for sorting                                       */
+/*----------------------------------------------------------------------------*/
+/* IN first: First source name.                                               */
+/* IN second: Second source name.                                             */
+/* RETURNS: Result of strcmp.                                                 */
+/*----------------------------------------------------------------------------*/
+static int	compareSourceNames(const void *first, const void *second)
+{
+	return strcmp(*(char **) first, *(char **) second);
+}
+
+
+/* Append a source name to a list of sources                                  */
+/*----------------------------------------------------------------------------*/
+/* IN/OUT sourceNames: List of the sources (grows if necessary).              */
+/* IN/OUT sourceNum: Number of the sources in the list.                       */
+/* IN/OUT sourceMax: Number of entries the list has been allocated for.       */
+/* IN directory: Directory of the source or NULL.                             */
+/* IN name: Name of the source.                                               */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	appendSourceName(char ***sourceNames, int *sourceNum,
+				int *sourceMax, char *directory, char *name)
+{
+	char **names;
+	char *sourceName;
+
+
+	if(*sourceNum == *sourceMax)
+	{
+		names = realloc(*sourceNames,
+				2 * (*sourceMax + 1) * sizeof(char *));
+		if(names == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+							"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+		*sourceNames = names;
+		*sourceMax = 2 * (*sourceMax + 1);
+	}
+
+	if(directory != NULL)
+		sourceName = malloc(strlen(directory) + strlen(name) + 2);
+	else
+		sourceName = malloc(strlen(name) + 1);
+	if(sourceName == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	if(directory != NULL)
+		sprintf(sourceName, "%s/%s", directory, name);
+	else
+		strcpy(sourceName, name);
+
+	(*sourceNames)[(*sourceNum)++] = sourceName;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Collect the sources of a batch compile                                     */
+/*----------------------------------------------------------------------------*/
+/* A directory provides all files ending with DEVICE_SOURCE_EXTENSION (sorted */
+/* by name), any other file is a list with the name of one source on every    */
+/* line. Empty lines and lines starting with '!' are skipped.                 */
+/* IN source: Directory or list file.                                         */
+/* OUT sourceNames: Allocated list of the source names (dispose it with       */
+/*                  disposeDeviceSources).                                    */
+/* OUT sourceNum: Number of the sources.                                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	collectDeviceSources(char *source, char ***sourceNames, int *sourceNum)
+{
+	struct stat fileStatus;
+	struct dirent *entry;
+	DIR *directory;
+	FILE *list;
+	char line[FILENAME_MAX];
+	size_t length;
+	int sourceMax;
+	int result;
+
+
+	*sourceNames = NULL;
+	*sourceNum = 0;
+	sourceMax = 0;
+	result = EXIT_SUCCESS;
+
+	if(stat(source, &fileStatus) != 0)
+	{
+		fprintf(stderr, "ERROR: Could not open %s for reading!\r\n",
+								source);
+		return EXIT_FAILURE;
+	}
+
+	/* all sources of a directory */
+	if(S_ISDIR(fileStatus.st_mode))
+	{
+		directory = opendir(source);
+		if(directory == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not open directory "
+						"\"%s\"!\r\n", source);
+			return EXIT_FAILURE;
+		}
+
+		while((result == EXIT_SUCCESS) &&
+				((entry = readdir(directory)) != NULL))
+		{
+			length = strlen(entry->d_name);
+			if((length > strlen(DEVICE_SOURCE_EXTENSION)) &&
+				(strcmp(entry->d_name + length -
+					strlen(DEVICE_SOURCE_EXTENSION),
+					DEVICE_SOURCE_EXTENSION) == 0))
+				result = appendSourceName(sourceNames,
+					sourceNum, &sourceMax, source,
+							entry->d_name);
+		}
+		closedir(directory);
+
+		if(*sourceNum > 1)
+			qsort(*sourceNames, *sourceNum, sizeof(char *),
+							compareSourceNames);
+	}
+	/* sources of a list file */
+	else
+	{
+		list = fopen(source, "r");
+		if(list == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not open %s for reading!"
+							"\r\n", source);
+			return EXIT_FAILURE;
+		}
+
+		while((result == EXIT_SUCCESS) &&
+				(fgets(line, sizeof(line), list) != NULL))
+		{
+			/* remove the line break and trailing blanks */
+			length = strlen(line);
+			while((length > 0) && (isspace(line[length-1])))
+				length--;
+			line[length] = '\0';
+
+			if((length > 0) && (line[0] != '!'))
+				result = appendSourceName(sourceNames,
+					sourceNum, &sourceMax, NULL, line);
+		}
+		fclose(list);
+	}
+
+	if(result != EXIT_SUCCESS)
+	{
+		disposeDeviceSources(*sourceNames, *sourceNum);
+		*sourceNames = NULL;
+		*sourceNum = 0;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Dispose a list of sources                                                  */
+/*----------------------------------------------------------------------------*/
+/* IN sourceNames: List of the sources (see collectDeviceSources).            */
+/* IN sourceNum: Number of the sources.                                       */
+/*----------------------------------------------------------------------------*/
+void	disposeDeviceSources(char **sourceNames, int sourceNum)
+{
+	int source;
+
+
+	if(sourceNames == NULL)
+		return;
+
+	for(source=0; source < sourceNum; source++)
+		free(sourceNames[source]);
+	free(sourceNames);
+}
+
+
+/* Compile a source of a batch                                                */
+/*----------------------------------------------------------------------------*/
+/* The source is skipped if its output file has been compiled from it.        */
+/* IN/OUT job: Source to compile, the state and the report are set.           */
+/*----------------------------------------------------------------------------*/
+static void	compileJobSource(compileJob *job)
+{
+	struct stat sourceStatus;
+	struct stat outputStatus;
+	FILE *report;
+	uint8_t *data;
+	size_t size;
+	int descriptor;
+	int mapped;
+	uint64_t sourceHash;
+	deviceData device;
+
+
+	/* the failures are collected, stdout is used if that's not possible */
+	job->report = NULL;
+	job->reportSize = 0;
+	report = open_memstream(&job->report, &job->reportSize);
+	if(report == NULL)
+		report = stdout;
+	job->state = FAILED_SOURCE;
+
+	/* read the whole source */
+	data = NULL;
+	size = 0;
+	mapped = false;
+	descriptor = open(job->sourceName, O_RDONLY);
+	if((descriptor < 0) || (fstat(descriptor, &sourceStatus) != 0))
+	{
+		fprintf(report, "ERROR: Could not open %s for reading!\r\n",
+							job->sourceName);
+		if(descriptor >= 0)
+			close(descriptor);
+	}
+	else
+	{
+		size = sourceStatus.st_size;
+		if((size == 0) || (mapFileContent(descriptor, size, &data,
+				&mapped, job->sourceName) == EXIT_SUCCESS))
+			job->state = WAITING_SOURCE;
+		close(descriptor);
+	}
+
+	if(job->state == WAITING_SOURCE)
+	{
+		sourceHash = hashDeviceSource(data, size);
+
+		/* never replace the source by its output */
+		if((stat(job->outputName, &outputStatus) == 0) &&
+			(outputStatus.st_dev == sourceStatus.st_dev) &&
+			(outputStatus.st_ino == sourceStatus.st_ino))
+		{
+			fprintf(report, "ERROR: The output file of %s is the "
+					"source itself!\r\n", job->sourceName);
+			job->state = FAILED_SOURCE;
+		}
+		/* skip sources which haven't changed */
+		else if(deviceFileMatchesSource(job->outputName, sourceHash)
+									== true)
+			job->state = SKIPPED_SOURCE;
+		else if((parseSourceBuffer((char *) data, size, &device,
+					report) == EXIT_SUCCESS) &&
+			(saveDeviceFile(&device, sourceHash, job->outputName)
+							== EXIT_SUCCESS))
+			job->state = COMPILED_SOURCE;
+		else
+			job->state = FAILED_SOURCE;
+	}
+
+	if(data != NULL)
+		unmapFileContent(data, size, mapped);
+
+	if(report != stdout)
+		fclose(report);
+}
+
+
+/* Compile the sources of a queue until it is empty                           */
+/*----------------------------------------------------------------------------*/
+/* IN/OUT argument: Queue of the sources (compileQueue).                      */
+/* RETURNS: NULL.                                                             */
+/*----------------------------------------------------------------------------*/
+static void	*runCompileWorker(void *argument)
+{
+	compileQueue *queue;
+	int job;
+
+
+	queue = (compileQueue *) argument;
+
+	while(true)
+	{
+		pthread_mutex_lock(&queue->lock);
+		job = queue->nextJob;
+		if(job < queue->jobNum)
+			queue->nextJob++;
+		pthread_mutex_unlock(&queue->lock);
+
+		if(job >= queue->jobNum)
+			break;
+
+		compileJobSource(&queue->jobs[job]);
+	}
+
+	return NULL;
+}
+
+
+/* Print the report of a source                                               */
+/*----------------------------------------------------------------------------*/
+/* Every line of the report is prefixed with the name of the source.          */
+/* IN job: Compiled source.                                                   */
+/*----------------------------------------------------------------------------*/
+static void	printJobReport(compileJob *job)
+{
+	char *line;
+	char *lineEnd;
+
+
+	if(job->report == NULL)
+		return;
+
+	for(line = job->report; *line != '\0'; line = lineEnd)
+	{
+		lineEnd = strchr(line, '\n');
+		if(lineEnd == NULL)
+			lineEnd = line + strlen(line);
+		else
+			lineEnd++;
+
+		fprintf(stdout, "%s: %.*s", job->sourceName,
+						(int) (lineEnd - line), line);
+	}
+
+	/* terminate a report without a final line break */
+	if((job->reportSize > 0) && (job->report[job->reportSize-1] != '\n'))
+		fprintf(stdout, "\r\n");
+}
+
+
+/* Compile many sources into an output directory                              */
+/*----------------------------------------------------------------------------*/
+/* The failures of the sources are printed to stdout, every line prefixed     */
+/* with the name of the source.                                               */
+/* IN sourceNames: Names of the sources.                                      */
+/* IN sourceNum: Number of the sources.                                       */
+/* IN outputDirectory: Directory for the compiled device files.               */
+/* IN threadNum: Number of threads compiling the sources.                     */
+/* OUT statistics: Number of compiled, skipped and failed sources.            */
+/* RETURNS: EXIT_FAILURE if a source failed or another failure occurred,      */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+int	compileDeviceSources(char **sourceNames, int sourceNum,
+		char *outputDirectory, int threadNum,
+					compileStatistics *statistics)
+{
+	compileQueue queue;
+	pthread_t *threads;
+	int *threadStarted;
+	char *name;
+	char *extension;
+	int thread;
+	int job;
+	int other;
+
+
+	statistics->compiledNum = 0;
+	statistics->skippedNum = 0;
+	statistics->failedNum = 0;
+
+	if(sourceNum < 1)
+		return EXIT_SUCCESS;
+
+	queue.jobs = malloc(sourceNum * sizeof(compileJob));
+	if(queue.jobs == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+	queue.jobNum = sourceNum;
+	queue.nextJob = 0;
+
+	/* the output file is named like the source without its extension */
+	for(job=0; job < sourceNum; job++)
+	{
+		name = strrchr(sourceNames[job], '/');
+		name = (name == NULL) ? sourceNames[job] : name + 1;
+		extension = strrchr(name, '.');
+		if((extension == NULL) || (extension == name))
+			extension = name + strlen(name);
+
+		if(strlen(outputDirectory) + (extension - name) + 2 >
+								FILENAME_MAX)
+		{
+			fprintf(stderr, "ERROR: The name of the output file of "
+				"%s is too long!\r\n", sourceNames[job]);
+			free(queue.jobs);
+			return EXIT_FAILURE;
+		}
+
+		queue.jobs[job].sourceName = sourceNames[job];
+		queue.jobs[job].state = WAITING_SOURCE;
+		queue.jobs[job].report = NULL;
+		queue.jobs[job].reportSize = 0;
+		sprintf(queue.jobs[job].outputName, "%s/%.*s", outputDirectory,
+					(int) (extension - name), name);
+	}
+
+	/* two sources must not be compiled into the same file */
+	for(job=0; job < sourceNum; job++)
+	{
+		for(other=job+1; other < sourceNum; other++)
+		{
+			if(strcmp(queue.jobs[job].outputName,
+					queue.jobs[other].outputName) == 0)
+			{
+				fprintf(stderr, "ERROR: %s and %s would be "
+					"compiled into the same file!\r\n",
+					sourceNames[job], sourceNames[other]);
+				free(queue.jobs);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if(threadNum > sourceNum)
+		threadNum = sourceNum;
+	if(threadNum < 1)
+		threadNum = 1;
+
+	threads = malloc(threadNum * sizeof(pthread_t));
+	threadStarted = malloc(threadNum * sizeof(int));
+	if((threads == NULL) || (threadStarted == NULL))
+	{
+		if(threads != NULL)
+			free(threads);
+		if(threadStarted != NULL)
+			free(threadStarted);
+		free(queue.jobs);
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+	pthread_mutex_init(&queue.lock, NULL);
+
+	/* this thread works on the queue as well, the sources of threads */
+	/* which can't be created are taken by the others */
+	threadStarted[0] = false;
+	for(thread=1; thread < threadNum; thread++)
+		threadStarted[thread] = (pthread_create(&threads[thread], NULL,
+					runCompileWorker, &queue) == 0);
+	runCompileWorker(&queue);
+
+	/* wait for all threads */
+	for(thread=1; thread < threadNum; thread++)
+		if(threadStarted[thread] == true)
+			pthread_join(threads[thread], NULL);
+	pthread_mutex_destroy(&queue.lock);
+
+	/* print the reports in the order of the sources */
+	for(job=0; job < sourceNum; job++)
+	{
+		printJobReport(&queue.jobs[job]);
+		if(queue.jobs[job].report != NULL)
+			free(queue.jobs[job].report);
+
+		switch(queue.jobs[job].state)
+		{
+			case COMPILED_SOURCE:
+				statistics->compiledNum++;
+				break;
+
+			case SKIPPED_SOURCE:
+				statistics->skippedNum++;
+				break;
+
+			default:
+				statistics->failedNum++;
+				break;
+		}
+	}
+
+	free(threads);
+	free(threadStarted);
+	free(queue.jobs);
+
+	if(statistics->failedNum > 0)
+		return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
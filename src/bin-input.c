@@ -44,24 +44,129 @@
 #include "input.h"
 
 
-/* Reads a complete bin file and store it into an array                       */
+/* Map a bin file into a memory image                                         */
 /*----------------------------------------------------------------------------*/
-/* The content of the file is copied to programData as a whole.               */
-/* programData must be a byte array with at least device->memorySize bytes    */
-/* size.                                                                      */
+/* The file is mapped read-only and the used blocks of the image point        */
+/* directly into the mapping, so the data is never copied. Only a block       */
+/* partially covered by the end of the file is copied and filled up with      */
+/* 0xFF, the blocks after it are not allocated at all.                        */
+/* IN fileName: Name of the file to be mapped.                                */
+/* IN device: Description of the device whose data should be read.            */
+/* INOUT image: Empty memory image where the file is mapped to.               */
+/* RETURNS: EXIT_FAILURE if the file could not be mapped (the image is left   */
+/*          empty), EXIT_SUCCESS otherwise.                                   */
+/*----------------------------------------------------------------------------*/
+int	mapBinFile(char *fileName, deviceData *device, memoryImage *image)
+{
+#ifdef HAVE_MMAP
+	int file;
+	uint8_t *mapping;
+	uint8_t *data;
+	uint32_64_t length;
+	uint32_64_t block;
+	struct stat fileStatus;
+
+
+	if(image->blockSize < 1)
+		return EXIT_FAILURE;
+
+	file = open(fileName, O_RDONLY);
+	if(file < 0)
+		return EXIT_FAILURE;
+
+#ifdef HAVE_POSIX_FADVISE
+	/* the file is read once from the first to the last byte */
+	posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	/* only regular files with at least one byte can be mapped */
+	if((fstat(file, &fileStatus) != 0) || 
+		(!S_ISREG(fileStatus.st_mode)) || (fileStatus.st_size < 1))
+	{
+		close(file);
+		return EXIT_FAILURE;
+	}
+
+	/* the data after the end of the memory is ignored */
+	length = device->memorySize;
+	if((uint32_64_t) fileStatus.st_size < length)
+		length = fileStatus.st_size;
+
+	if((size_t) length != length)
+	{
+		close(file);
+		return EXIT_FAILURE;
+	}
+
+	mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if(mapping == MAP_FAILED)
+		return EXIT_FAILURE;
+
+#ifdef HAVE_MADVISE
+	/* the blocks are checked and converted from the first to the last */
+	madvise(mapping, length, MADV_SEQUENTIAL);
+	madvise(mapping, length, MADV_WILLNEED);
+#endif
+
+	attachMemoryMapping(image, mapping, length);
+
+	/* blocks completely within the file */
+	for(block=0; block < length / image->blockSize; block++)
+	{
+		data = mapping + block * image->blockSize;
+		if(isBlankMemory(data, image->blockSize) != true)
+			referenceMemoryBlock(image, block, data);
+	}
+
+	/* block at the end of the file */
+	if(length % image->blockSize != 0)
+	{
+		data = allocateMemoryBlock(image, block);
+		if(data == NULL)
+		{
+			detachMemoryMapping(image);
+			return EXIT_FAILURE;
+		}
+
+		memcpy(data, mapping + block * image->blockSize, 
+						length % image->blockSize);
+		releaseBlankBlocks(image, block, block + 1);
+	}
+
+	return EXIT_SUCCESS;
+#else
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Reads a complete bin file and store it into a memory image                 */
+/*----------------------------------------------------------------------------*/
+/* The content of the file is copied to the memory image as a whole. The rest */
+/* of the memory reads as 0xFF.                                               */
+/* The file is mapped if possible (see mapBinFile). Otherwise it is read in   */
+/* chunks of whole blocks. Only the blocks of a chunk containing data are     */
+/* stored, blank blocks are not allocated at all.                             */
 /* IN fileName: Name of the file to be read.                                  */
 /* IN device: Description of the device whose data should be read.            */
-/* OUT programData: Byte array that contains the read data.                   */
+/* INOUT image: Empty memory image where the read data is stored.             */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	readBinFile(char *fileName, deviceData *device, uint8_t *programData)
+int	readBinFile(char *fileName, deviceData *device, memoryImage *image)
 {
+	uint8_t *chunk;
 	uint32_64_t readBytes;
+	uint32_64_t totalBytes;
+	uint32_64_t offset;
+	uint32_64_t chunkSize;
+	uint32_64_t block;
 	FILE *file;
 
 
-	/* initialize memory with 0xFF */
-	memset(programData, 0xFF, device->memorySize);
+	/* use the data of the file without copying it */
+	if(mapBinFile(fileName, device, image) == EXIT_SUCCESS)
+		return EXIT_SUCCESS;
 
 	/* open input file */
 	file = fopen(fileName, "rb");
@@ -72,16 +177,65 @@ int	readBinFile(char *fileName, deviceData *device, uint8_t *programData)
 		return EXIT_FAILURE;
 	}
 
+#ifdef HAVE_POSIX_FADVISE
+	/* the file is read once from the first to the last byte */
+	posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	/* chunks of whole blocks */
+	chunkSize = image->blockSize;
+	if((chunkSize > 0) && (chunkSize < INPUT_CHUNK_SIZE))
+		chunkSize = (INPUT_CHUNK_SIZE / chunkSize) * chunkSize;
+
+	chunk = malloc(chunkSize + 1);
+	if(chunk == NULL)
+	{
+		fclose(file);
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
 	/* read in the complete device memory */
-	readBytes = fread(programData, sizeof(*programData), 
-						device->memorySize, file);
+	totalBytes = 0;
+	for(offset=0; offset < device->memorySize; offset += chunkSize)
+	{
+		if(chunkSize > device->memorySize - offset)
+			chunkSize = device->memorySize - offset;
+
+		readBytes = fread(chunk, sizeof(*chunk), chunkSize, file);
+		totalBytes += readBytes;
+
+		/* the memory after the end of the file is unused */
+		if(readBytes < chunkSize)
+			memset(chunk + readBytes, 0xFF, chunkSize - readBytes);
+
+		/* store the blocks of the chunk containing data */
+		for(block=0; block < chunkSize / image->blockSize; block++)
+		{
+			if((isBlankMemory(chunk + block * image->blockSize,
+					image->blockSize) != true) &&
+				(storeMemoryBlock(image, 
+					offset / image->blockSize + block,
+					chunk + block * image->blockSize) 
+							!= EXIT_SUCCESS))
+			{
+				free(chunk);
+				fclose(file);
+				return EXIT_FAILURE;
+			}
+		}
+
+		if(readBytes < chunkSize)
+			break;
+	}
 
+	free(chunk);
 	fclose(file);
 
-	/* readBytes will be less than device->memorySize when the binary */
+	/* totalBytes will be less than device->memorySize when the binary */
 	/* file doesn't fill the complete memory of the device (almost always)*/
 	/* check if at least 1 byte could be read */
-	if(readBytes < 1)
+	if(totalBytes < 1)
 	{
 		fprintf(stderr, "ERROR: Could not read from file \"%s\"!\r\n", 
 			fileName);
@@ -90,4 +244,3 @@ int	readBinFile(char *fileName, deviceData *device, uint8_t *programData)
 
 	return EXIT_SUCCESS;
 }
-
@@ -0,0 +1,224 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "bin-stream.h"
+
+
+/* Fill the ring of block buffers from a binary file                          */
+/*----------------------------------------------------------------------------*/
+/* Reads until the ring is full or the end of the file is reached.            */
+/* IN file: File descriptor of the binary file.                               */
+/* OUT ring: Buffer receiving the data.                                       */
+/* IN length: Number of bytes to be read.                                     */
+/* OUT readBytes: Number of bytes read (less than length at the end of the    */
+/*                file).                                                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	fillStreamRing(int file, uint8_t *ring, uint32_64_t length, 
+						uint32_64_t *readBytes)
+{
+	ssize_t result;
+
+
+	*readBytes = 0;
+	while(*readBytes < length)
+	{
+		result = read(file, ring + *readBytes, length - *readBytes);
+
+		/* retry if the read was interrupted */
+		if((result < 0) && (errno == EINTR))
+			continue;
+
+		if(result < 0)
+			return EXIT_FAILURE;
+
+		/* end of file */
+		if(result == 0)
+			break;
+
+		*readBytes += result;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Generate the output files from a binary file block by block               */
+/*----------------------------------------------------------------------------*/
+/* The binary file is read sequentially into a small ring of block buffers.   */
+/* Each block is checked and rendered into the output streams as soon as it   */
+/* has been read, so the memory needed doesn't depend on the memory size of   */
+/* the device. The memory after the end of the file is unused (0xFF).         */
+/* The address cache is not used, because the used blocks are not known       */
+/* before the output is generated.                                            */
+/* IN inputFileName: Name of the binary file to be read.                      */
+/* IN fileNameBase: First part of the output file names.                      */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN options: Options of the output generation (see outputOptions).          */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	streamBinFile(char *inputFileName, char *fileNameBase, 
+				deviceData *device, outputOptions *options)
+{
+	int file;
+	int result;
+	int streamNum;
+	uint8_t *ring;
+	uint8_t *blockData;
+	uint32_64_t block;
+	uint32_64_t blockNum;
+	uint32_64_t ringBlock;
+	uint32_64_t ringBlockNum;
+	uint32_64_t readBytes;
+	uint32_64_t totalBytes;
+	outputStream streams[MAX_OUTPUT_STREAM_NUM];
+
+
+	if(checkOutputLayout(device) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* open input file */
+	file = open(inputFileName, O_RDONLY);
+	if(file < 0)
+	{
+		fprintf(stderr, "ERROR: Could not open file \"%s\"!\r\n", 
+			inputFileName);
+		return EXIT_FAILURE;
+	}
+
+#ifdef HAVE_POSIX_FADVISE
+	/* the file is read once from the first to the last byte */
+	posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	ring = malloc(STREAM_RING_BLOCK_NUM * device->blockSize);
+	if(ring == NULL)
+	{
+		close(file);
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	result = EXIT_SUCCESS;
+	streamNum = -1;
+	totalBytes = 0;
+	blockNum = device->memorySize / device->blockSize;
+	for(block=0; block < blockNum; block += ringBlockNum)
+	{
+		ringBlockNum = STREAM_RING_BLOCK_NUM;
+		if(ringBlockNum > blockNum - block)
+			ringBlockNum = blockNum - block;
+
+		/* read the next blocks (after the end of the file nothing */
+		/* is read anymore) */
+		readBytes = 0;
+		if((totalBytes == block * device->blockSize) &&
+			(fillStreamRing(file, ring, ringBlockNum * 
+				device->blockSize, &readBytes) != EXIT_SUCCESS))
+		{
+			fprintf(stderr, "ERROR: Could not read from file \"%s\""
+				"!\r\n", inputFileName);
+			result = EXIT_FAILURE;
+			break;
+		}
+		totalBytes += readBytes;
+
+		/* check if at least 1 byte could be read before the */
+		/* output files are opened */
+		if(totalBytes < 1)
+		{
+			fprintf(stderr, "ERROR: Could not read from file \"%s\""
+				"!\r\n", inputFileName);
+			result = EXIT_FAILURE;
+			break;
+		}
+
+		if((streamNum < 0) && (openOutputFiles(fileNameBase, device,
+				NULL, options, streams, &streamNum) 
+							!= EXIT_SUCCESS))
+		{
+			result = EXIT_FAILURE;
+			break;
+		}
+
+		/* the remaining blocks are unused */
+		if((readBytes == 0) && (options->generateAllBlocks != true))
+			break;
+
+		/* the memory after the end of the file is unused */
+		if(readBytes < ringBlockNum * device->blockSize)
+			memset(ring + readBytes, 0xFF, ringBlockNum * 
+					device->blockSize - readBytes);
+
+		/* render the used blocks */
+		for(ringBlock=0; (ringBlock < ringBlockNum) && 
+				(result == EXIT_SUCCESS); ringBlock++)
+		{
+			blockData = ring + ringBlock * device->blockSize;
+			if((options->generateAllBlocks == true) ||
+				(isBlankMemory(blockData, device->blockSize) 
+								!= true))
+				result = writeOutputBlock(streams, streamNum, 
+					device, block + ringBlock, blockData);
+		}
+
+		if(result != EXIT_SUCCESS)
+			break;
+	}
+
+	free(ring);
+	close(file);
+
+	/* nothing has been read if the device has no memory */
+	if(streamNum < 0)
+	{
+		if(result == EXIT_SUCCESS)
+			fprintf(stderr, "ERROR: Could not read from file \"%s\""
+				"!\r\n", inputFileName);
+		return EXIT_FAILURE;
+	}
+
+	return closeOutputFiles(streams, streamNum, options, result);
+}
+
@@ -41,42 +41,28 @@
 
 
 
-#include "bit-array.h"
-
+/*----------------------------------------------------------------------------*/
+/* The bit array collects the bit order of a bit order description while it   */
+/* is parsed. The bits are kept as runs: ranges are appended to the run they  */
+/* continue and a repeat is a single run, so the bit orders of the device are */
+/* never expanded into one entry per bit.                                     */
+/*----------------------------------------------------------------------------*/
 
-/* global Variables */
-static	int8_t *array = NULL;
-static	int arrayIndex;
-static	int arrayLength;
+#include "bit-array.h"
 
 
 /* Initializes the bit array                                                  */
 /* This procedure must be called once before using the other procedures.      */
 /*----------------------------------------------------------------------------*/
-/* IN length: Length of the new bit array.                                    */
+/* OUT bits: State of the bit array.                                          */
+/* IN length: Maximum number of bits of the bit array.                        */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	initializeBitArray(int length)
+int	initializeBitArray(bitArray *bits, int length)
 {
-	int i;
-
-
-	arrayLength = length;
-	arrayIndex = 0;
-
-	/* allocate memory for the array and an additional buffer for */
-	/* temporarily storing parts of the bit array */
-	array = malloc(arrayLength*sizeof(int8_t));
-	if(array == NULL)
-	{
-		fprintf(stderr, "ERROR: Could not allocate memory for bit "
-			"array.\r\n");
-		return EXIT_FAILURE;
-	}
-
-	/* initialize the array with unused bits */
-	for(i=0; i<arrayLength; i++)
-		array[i] = UNUSED_BIT;
+	bits->arrayLength = length;
+	bits->runs.length = 0;
+	bits->runs.runNum = 0;
 
 	return EXIT_SUCCESS;
 }
@@ -85,73 +71,216 @@ int	initializeBitArray(int length)
 /* Disposes the bit array                                                     */
 /* This procedure must be called once when the bit array is no longer used.   */
 /*----------------------------------------------------------------------------*/
+/* IN bits: State of the bit array.                                           */
 /*----------------------------------------------------------------------------*/
-void	disposeBitArray()
+void	disposeBitArray(bitArray *bits)
 {
-	if(array != NULL)
-		free(array);
+	bits->arrayLength = 0;
+	bits->runs.length = 0;
+	bits->runs.runNum = 0;
 }
 
 
 /* Get the bit array                                                          */
-/* The returned bit array must not be written.                                */
+/* The returned runs must not be written.                                     */
 /*----------------------------------------------------------------------------*/
-/* RETURNS: The bit array.                                                    */
+/* IN bits: State of the bit array.                                           */
+/* RETURNS: The runs of the bit array.                                        */
 /*----------------------------------------------------------------------------*/
-int8_t*	getBitArray()
+bitOrderRuns*	getBitArray(bitArray *bits)
 {
-	return array;
+	return &bits->runs;
 }
 
 
 /* Get the current index.                                                     */
 /*----------------------------------------------------------------------------*/
-/* RETURNS: Current index within the bit array.                               */
+/* IN bits: State of the bit array.                                           */
+/* RETURNS: Current index within the bit array (number of bits).              */
+/*----------------------------------------------------------------------------*/
+int	bitArrayGetCurrentIndex(bitArray *bits)
+{
+	return bits->runs.length;
+}
+
+
+/* Append a bit to the runs                                                   */
+/*----------------------------------------------------------------------------*/
+/* The bit continues the last run if possible, the runs are the same as the   */
+/* ones encodeBitOrderRuns splits a bit order array into.                     */
+/* IN runs: Runs to append the bit to.                                        */
+/* IN bit: Bit, LITERAL0_BIT or LITERAL1_BIT.                                 */
+/* RETURNS: EXIT_FAILURE if there are too many runs, EXIT_SUCCESS otherwise.  */
 /*----------------------------------------------------------------------------*/
-int	bitArrayGetCurrentIndex()
+static int	appendBit(bitOrderRuns *runs, int bit)
 {
-	return arrayIndex;
+	bitRun *last;
+
+
+	last = NULL;
+	if((runs->runNum > 0) && 
+		(runs->run[runs->runNum - 1].length < MAX_RUN_LENGTH))
+		last = &runs->run[runs->runNum - 1];
+
+	if((bit == LITERAL0_BIT) || (bit == LITERAL1_BIT))
+	{
+		if((last != NULL) && (last->type == LITERAL_RUN) &&
+				(last->first == (bit == LITERAL1_BIT)))
+		{
+			last->length++;
+			runs->length++;
+			return EXIT_SUCCESS;
+		}
+	}
+	else if(last != NULL)
+	{
+		/* a single bit followed by the bit below is descending */
+		if((last->type == ASCENDING_RUN) && (last->length == 1) &&
+						(bit == last->first - 1))
+			last->type = DESCENDING_RUN;
+
+		if(((last->type == ASCENDING_RUN) && 
+				(bit == last->first + last->length)) ||
+			((last->type == DESCENDING_RUN) && 
+				(bit == last->first - last->length)))
+		{
+			last->length++;
+			runs->length++;
+			return EXIT_SUCCESS;
+		}
+	}
+
+	/* start a new run */
+	if(runs->runNum >= MAX_BIT_ORDER_RUN_NUM)
+		return EXIT_FAILURE;
+
+	last = &runs->run[runs->runNum++];
+	last->type = ASCENDING_RUN;
+	last->first = bit;
+	last->length = 1;
+	last->count = 0;
+	if((bit == LITERAL0_BIT) || (bit == LITERAL1_BIT))
+	{
+		last->type = LITERAL_RUN;
+		last->first = (bit == LITERAL1_BIT);
+	}
+	runs->length++;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Split the runs at a bit                                                    */
+/*----------------------------------------------------------------------------*/
+/* The run containing the bit is split into two runs, so a run starts at the  */
+/* bit afterwards.                                                            */
+/* IN runs: Runs to split.                                                    */
+/* IN index: Index of the bit.                                                */
+/* RETURNS: Index of the run starting at the bit (runNum if the bit is the    */
+/*          end of the runs) or -1 if the bit is within a repeat or there are */
+/*          too many runs.                                                    */
+/*----------------------------------------------------------------------------*/
+static int	splitRuns(bitOrderRuns *runs, int index)
+{
+	bitRun *current;
+	int run;
+	int bit;
+	int length;
+
+
+	current = NULL;
+	length = 0;
+	bit = 0;
+	for(run=0; run < runs->runNum; run++)
+	{
+		current = &runs->run[run];
+		length = current->length;
+		if(current->type == REPEAT_RUN)
+			length = current->length * current->count;
+
+		if(bit == index)
+			return run;
+
+		if(index < bit + length)
+			break;
+
+		bit = bit + length;
+	}
+
+	if(run == runs->runNum)
+		return (bit == index) ? run : -1;
+
+	if((current->type == REPEAT_RUN) || 
+				(runs->runNum >= MAX_BIT_ORDER_RUN_NUM))
+		return -1;
+
+	/* the second part follows the first one */
+	memmove(current + 1, current, 
+			(runs->runNum - run) * sizeof(bitRun));
+	runs->runNum++;
+
+	current->length = index - bit;
+	current[1].length = length - current->length;
+	if(current->type == ASCENDING_RUN)
+		current[1].first = current->first + current->length;
+	else if(current->type == DESCENDING_RUN)
+		current[1].first = current->first - current->length;
+
+	/* a single ascending or descending bit is an ascending run */
+	if(current->length == 1)
+		current->type = (current->type == LITERAL_RUN) ? 
+						LITERAL_RUN : ASCENDING_RUN;
+	if(current[1].length == 1)
+		current[1].type = (current[1].type == LITERAL_RUN) ? 
+						LITERAL_RUN : ASCENDING_RUN;
+
+	return run + 1;
 }
 
 
 /* Appends a bit range to the bit array                                       */
 /* e.g.: When startBit=3 and endBit=5 then 3,4,5 is added to the array.       */
 /*----------------------------------------------------------------------------*/
+/* IN bits: State of the bit array.                                           */
 /* IN startBit: Start bit of the range.                                       */
 /* IN endBit: End bit of the range.                                           */
-/* RETURNS: EXIT_FAILURE if the result exceeded the length of the array,      */
+/* RETURNS: EXIT_FAILURE if the result exceeded the length of the array or    */
+/*          needs more than MAX_BIT_ORDER_RUN_NUM runs,                       */
 /*          EXIT_SUCCESS otherwise.                                           */
 /*          If EXIT_FAILURE is returned the bit array will be left unchanged. */
 /*----------------------------------------------------------------------------*/
-int	bitArrayAdd(int8_t startBit, int8_t endBit)
+int	bitArrayAdd(bitArray *bits, int8_t startBit, int8_t endBit)
 {
+	bitOrderRuns *runs = &bits->runs;
+	bitRun last;
+	int runNum;
+	int length;
+	int step;
 	int i;
 
 
-	if(endBit >= startBit)
-	{
-		/* check if the length of the array will be exceeded */
-		if(arrayIndex + endBit-startBit+1 > arrayLength)
-			return EXIT_FAILURE;
+	step = (endBit >= startBit) ? 1 : -1;
 
-		/* add the bits to the array */
-		for(i=startBit; i<=endBit; i++)
-		{
-			array[arrayIndex] = i;
-			arrayIndex++;
-		}
-	}
-	else
-	{
-		/* check if the length of the array will be exceeded */
-		if(arrayIndex + startBit-endBit+1 > arrayLength)
-			return EXIT_FAILURE;
+	/* check if the length of the array will be exceeded */
+	if(runs->length + (endBit - startBit) * step + 1 > bits->arrayLength)
+		return EXIT_FAILURE;
+
+	/* remember the runs to undo the bits on a failure */
+	runNum = runs->runNum;
+	length = runs->length;
+	if(runNum > 0)
+		last = runs->run[runNum - 1];
 
-		/* add the bits to the array */
-		for(i=startBit; i>=endBit; i--)
+	/* add the bits to the runs */
+	for(i=startBit; i != endBit + step; i += step)
+	{
+		if(appendBit(runs, i) != EXIT_SUCCESS)
 		{
-			array[arrayIndex] = i;
-			arrayIndex++;
+			runs->runNum = runNum;
+			runs->length = length;
+			if(runNum > 0)
+				runs->run[runNum - 1] = last;
+			return EXIT_FAILURE;
 		}
 	}
 
@@ -159,48 +288,98 @@ int	bitArrayAdd(int8_t startBit, int8_t endBit)
 }
 
 
-/* Repeat parts of the array.                                                 */
+/* Repeat the end of the array.                                               */
 /*----------------------------------------------------------------------------*/
+/* The repeated part of the array is followed by one repeat run.              */
+/* IN bits: State of the bit array.                                           */
 /* IN startIndex: Start index of the array part to repeat.                    */
 /*                (The repeat includes the element at this index.)            */
-/* IN endIndex: End index of the array part to repeat.                        */
-/*              (The repeat includes the element at this index.)              */
+/* IN endIndex: End index of the array part to repeat, the last element of    */
+/*              the array. (The repeat includes the element at this index.)   */
 /* IN repeatNum: Number of repeats.                                           */
-/* RETURNS: EXIT_FAILURE if the result exceeded the length of the array,      */
+/* RETURNS: EXIT_FAILURE if the result exceeded the length of the array, the  */
+/*          part isn't the end of the array or there are too many runs,       */
 /*          EXIT_SUCCESS otherwise.                                           */
-/*          If EXIT_FAILURE is returned the bit array will be left unchanged. */
+/*          If EXIT_FAILURE is returned the bits of the array will be left    */
+/*          unchanged.                                                        */
 /*----------------------------------------------------------------------------*/
-int	bitArrayRepeat(int startIndex, int endIndex, int repeatNum)
+int	bitArrayRepeat(bitArray *bits, int startIndex, int endIndex,
+						uint32_64_t repeatNum)
 {
-	int i;
+	bitOrderRuns *runs = &bits->runs;
+	bitRun *repeat;
 	int sequenceLength;
+	int run;
 
 
 	/* calculate the length of the sequence */
 	sequenceLength = endIndex - startIndex + 1;
 
 	/* exit if there is nothing to repeat (return no failure) */
-	if(sequenceLength < 1)
+	if((sequenceLength < 1) || (repeatNum == 0))
 		return EXIT_SUCCESS;
 
 	/* check if the length of the array will be exceeded */
-	if(arrayIndex + sequenceLength*repeatNum > arrayLength)
+	if((startIndex < 0) || (endIndex + 1 != runs->length) ||
+		(repeatNum > (uint32_64_t) (bits->arrayLength - runs->length) /
+							sequenceLength))
 		return EXIT_FAILURE;
 
-	/* shift the part which follows the repeat section */
-	/* to the end of the array */
-	memcpy(array+endIndex+1+sequenceLength*repeatNum, array+endIndex+1, 
-		arrayIndex-endIndex-1);
+	/* the repeated runs have to start at the start index */
+	if(runs->runNum >= MAX_BIT_ORDER_RUN_NUM)
+		return EXIT_FAILURE;
+
+	run = splitRuns(runs, startIndex);
+	if((run < 0) || (runs->runNum >= MAX_BIT_ORDER_RUN_NUM))
+		return EXIT_FAILURE;
 
 	/* repeat the given bit sequence */
-	for(i=0; i<repeatNum; i++)
-	{
-		memcpy(array+endIndex+1+i*sequenceLength, array+startIndex,
-			sequenceLength);
-		arrayIndex += sequenceLength;
-	}
+	repeat = &runs->run[runs->runNum];
+	repeat->type = REPEAT_RUN;
+	repeat->first = runs->runNum - run;
+	repeat->length = sequenceLength;
+	repeat->count = repeatNum;
+	runs->runNum++;
+	runs->length += sequenceLength * repeatNum;
 
 	return EXIT_SUCCESS;
 }
 
 
+/* Split the array into two bit orders.                                       */
+/*----------------------------------------------------------------------------*/
+/* IN bits: State of the bit array.                                           */
+/* IN index: Index of the first element of the second bit order.              */
+/* OUT head: Elements before the index.                                       */
+/* OUT tail: Elements from the index to the end of the array.                 */
+/* RETURNS: EXIT_FAILURE if the index is outside of the array, within a       */
+/*          repeat or there are too many runs, EXIT_SUCCESS otherwise.        */
+/*----------------------------------------------------------------------------*/
+int	bitArraySplit(bitArray *bits, int index, bitOrderRuns *head,
+							bitOrderRuns *tail)
+{
+	bitOrderRuns *runs = &bits->runs;
+	int run;
+
+
+	if((index < 0) || (index > runs->length))
+		return EXIT_FAILURE;
+
+	run = splitRuns(runs, index);
+	if(run < 0)
+		return EXIT_FAILURE;
+
+	/* repeats only refer to runs of their own part */
+	memset(head, 0, sizeof(bitOrderRuns));
+	memcpy(head->run, runs->run, run * sizeof(bitRun));
+	head->runNum = run;
+	head->length = index;
+
+	memset(tail, 0, sizeof(bitOrderRuns));
+	memcpy(tail->run, runs->run + run, 
+				(runs->runNum - run) * sizeof(bitRun));
+	tail->runNum = runs->runNum - run;
+	tail->length = runs->length - index;
+
+	return EXIT_SUCCESS;
+}
@@ -48,12 +48,22 @@
 #include "device-description.h"
 
 
-extern	int	initializeBitArray(int);
-extern	void	disposeBitArray(void);
-extern	int8_t*	getBitArray(void);
-extern	int	bitArrayGetCurrentIndex(void);
-extern	int	bitArrayAdd(int8_t, int8_t);
-extern	int	bitArrayRepeat(int, int, int);
+/* state of a bit array, the bits are kept as runs (see bit-runs.c) */
+typedef struct
+{
+	bitOrderRuns runs;
+	int arrayLength;
+}
+bitArray;
+
+
+extern	int	initializeBitArray(bitArray *, int);
+extern	void	disposeBitArray(bitArray *);
+extern	bitOrderRuns*	getBitArray(bitArray *);
+extern	int	bitArrayGetCurrentIndex(bitArray *);
+extern	int	bitArrayAdd(bitArray *, int8_t, int8_t);
+extern	int	bitArrayRepeat(bitArray *, int, int, uint32_64_t);
+extern	int	bitArraySplit(bitArray *, int, bitOrderRuns *, bitOrderRuns *);
 
 
 #endif /* _BIT_ARRAY_H */
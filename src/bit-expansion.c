@@ -0,0 +1,687 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* Most bit orders consist of whole bytes of the word, each of them either in */
+/* ascending (0-7) or in descending (7-0) order. For these bit orders each    */
+/* byte of the word is expanded into its 8 output symbols at once instead of  */
+/* rendering bit by bit. The output symbols are generated by flipping the     */
+/* symbols of a cleared byte, so every kernel works with any symbols.         */
+/* Other bit orders can be expanded by the run kernel, which takes each run   */
+/* of the bit order from the word with one shift and mask and expands it byte */
+/* by byte the same way.                                                      */
+/*----------------------------------------------------------------------------*/
+
+#include "bit-expansion.h"
+
+
+/* x86 kernels are only available for gcc compatible compilers */
+#if(USING_SIMD==1) && defined(__GNUC__) && \
+				(defined(__x86_64__) || defined(__i386__))
+	#define X86_KERNELS	1
+	#include <immintrin.h>
+#else
+	#define X86_KERNELS	0
+#endif
+
+
+/* spread the 4 bits of a nibble to bit 0 of every second or every byte */
+#define NIBBLE_TO_PAIRS		UINT64_C(0x0000200040008001)
+#define PAIRS_MASK		UINT64_C(0x0001000100010001)
+#define NIBBLE_TO_BYTES		UINT64_C(0x0000000000204081)
+#define BYTES_MASK		UINT64_C(0x0000000001010101)
+
+/* repeat a byte in all bytes of a 64 bit chunk */
+#define REPEAT_BYTE		UINT64_C(0x0101010101010101)
+
+/* reverse the bits of a byte */
+#define REVERSE_BYTE(byte)	((((((byte) * 0x0802) & 0x22110) | \
+				(((byte) * 0x8020) & 0x88440)) * 0x10101 \
+								>> 16) & 0xFF)
+
+
+/* Store 8 bytes of output                                                    */
+/*----------------------------------------------------------------------------*/
+/* The least significant byte of the chunk is stored first.                   */
+/* OUT string: Position where to store the chunk.                             */
+/* IN chunk: Bytes to be stored.                                              */
+/*----------------------------------------------------------------------------*/
+static void	storeChunk(char *string, uint64_t chunk)
+{
+#ifdef WORDS_BIGENDIAN
+	chunk = ((chunk & UINT64_C(0x00000000FFFFFFFF)) << 32) |
+		((chunk & UINT64_C(0xFFFFFFFF00000000)) >> 32);
+	chunk = ((chunk & UINT64_C(0x0000FFFF0000FFFF)) << 16) |
+		((chunk & UINT64_C(0xFFFF0000FFFF0000)) >> 16);
+	chunk = ((chunk & UINT64_C(0x00FF00FF00FF00FF)) << 8) |
+		((chunk & UINT64_C(0xFF00FF00FF00FF00)) >> 8);
+#endif
+
+	memcpy(string, &chunk, sizeof(chunk));
+}
+
+
+/* Expand the 8 bits of a byte into one symbol per bit                        */
+/*----------------------------------------------------------------------------*/
+/* Every nibble is spread to 4 bytes with a single multiplication.            */
+/* IN expansion: Expansion to be used.                                        */
+/* IN byte: Byte in output order (first output bit in bit 0).                 */
+/* OUT string: Position of the 8 symbols.                                     */
+/*----------------------------------------------------------------------------*/
+#define EXPAND_DENSE_BYTE(expansion, byte, string) \
+	storeChunk((string), (((((byte) & 0x0F) * NIBBLE_TO_BYTES) & BYTES_MASK)\
+		| (((((byte) >> 4) * NIBBLE_TO_BYTES) & BYTES_MASK) << 32)) * \
+		(expansion)->flip ^ (expansion)->base)
+
+
+/* Expand the 8 bits of a byte into a symbol and a separator per bit          */
+/*----------------------------------------------------------------------------*/
+/* Like EXPAND_DENSE_BYTE, but the nibbles are spread to every second byte.   */
+/* IN expansion: Expansion to be used.                                        */
+/* IN byte: Byte in output order (first output bit in bit 0).                 */
+/* OUT string: Position of the 16 symbols and separators.                     */
+/*----------------------------------------------------------------------------*/
+#define EXPAND_PAIRED_BYTE(expansion, byte, string) \
+	storeChunk((string), ((((byte) & 0x0F) * NIBBLE_TO_PAIRS) & PAIRS_MASK) \
+			* (expansion)->flip ^ (expansion)->base); \
+	storeChunk((string) + 8, ((((byte) >> 4) * NIBBLE_TO_PAIRS) & \
+			PAIRS_MASK) * (expansion)->flip ^ (expansion)->base)
+
+
+/* Define a kernel expanding a word with 64 bit integer operations            */
+/*----------------------------------------------------------------------------*/
+/* Every symbol layout gets its own kernel, so the loop doesn't check the     */
+/* layout for every byte.                                                     */
+/* IN name: Name of the kernel function.                                      */
+/* IN groupLength: Length of the output of one byte.                          */
+/* IN expandByte: Macro expanding one byte (see EXPAND_DENSE_BYTE).           */
+/*----------------------------------------------------------------------------*/
+#define DEFINE_SWAR_KERNEL(name, groupLength, expandByte) \
+static int	name(bitExpansion *expansion, uint32_64_t word, char *string) \
+{ \
+	int group; \
+	uint64_t byte; \
+\
+\
+	for(group=0; group < expansion->groupNum; group++) \
+	{ \
+		byte = (word >> (8*expansion->groupByte[group])) & 0xFF; \
+\
+		/* reverse the bits of descending bytes */ \
+		if(expansion->groupDescending[group] == true) \
+			byte = REVERSE_BYTE(byte); \
+\
+		expandByte(expansion, byte, string + (groupLength)*group); \
+	} \
+\
+	/* add the terminator */ \
+	memcpy(string + (groupLength)*expansion->groupNum, \
+		expansion->terminator, expansion->terminatorLength); \
+\
+	return expansion->length; \
+}
+
+
+/* kernels for one symbol per bit and for a symbol and a separator per bit */
+DEFINE_SWAR_KERNEL(expandWordDense, 8, EXPAND_DENSE_BYTE)
+DEFINE_SWAR_KERNEL(expandWordPaired, 16, EXPAND_PAIRED_BYTE)
+
+
+/* Define a kernel expanding a word run by run                                */
+/*----------------------------------------------------------------------------*/
+/* The bits of every run are taken from the word at once and expanded 8 at a  */
+/* time in the order of the sequence. The last byte of a run is expanded      */
+/* completely and overwritten by the next run, only the last byte of the      */
+/* output is expanded into a copy first, so nothing is written behind it.     */
+/* IN name: Name of the kernel function.                                      */
+/* IN symbolLength: Length of the output of one bit.                          */
+/* IN expandByte: Macro expanding one byte (see EXPAND_DENSE_BYTE).           */
+/*----------------------------------------------------------------------------*/
+#define DEFINE_RUN_KERNEL(name, symbolLength, expandByte) \
+static int	name(bitExpansion *expansion, uint32_64_t word, char *string) \
+{ \
+	int run; \
+	int entry; \
+	int bit; \
+	int end; \
+	char *output; \
+	uint64_t bits; \
+	uint64_t runBits[MAX_BIT_ORDER_RUN_NUM]; \
+	bitRun *current; \
+	char last[8*(symbolLength)]; \
+\
+\
+	for(run=0; run < expansion->runs.runNum; run++) \
+	{ \
+		current = &expansion->runs.run[run]; \
+		if(current->type != REPEAT_RUN) \
+			runBits[run] = takeRunBits(current, word); \
+	} \
+\
+	end = expansion->length - expansion->terminatorLength; \
+	output = string; \
+	for(entry=0; entry < expansion->sequenceNum; entry++) \
+	{ \
+		current = &expansion->runs.run[expansion->sequence[entry]]; \
+		bits = runBits[expansion->sequence[entry]]; \
+		for(bit=0; bit < current->length; bit += 8) \
+		{ \
+			if(output + 8*(symbolLength) <= string + end) \
+			{ \
+				expandByte(expansion, bits & 0xFF, output); \
+			} \
+			else \
+			{ \
+				expandByte(expansion, bits & 0xFF, last); \
+				memcpy(output, last, string + end - output); \
+			} \
+			bits >>= 8; \
+			output += 8*(symbolLength); \
+		} \
+\
+		/* go back to the end of the run */ \
+		output -= (symbolLength) * (bit - current->length); \
+	} \
+\
+	/* add the terminator */ \
+	memcpy(string + end, expansion->terminator, \
+					expansion->terminatorLength); \
+\
+	return expansion->length; \
+}
+
+
+/* run kernels for one symbol per bit and for a symbol and a separator */
+DEFINE_RUN_KERNEL(expandRunsDense, 1, EXPAND_DENSE_BYTE)
+DEFINE_RUN_KERNEL(expandRunsPaired, 2, EXPAND_PAIRED_BYTE)
+
+
+/* Gather the bytes of a word into packed output                              */
+/*----------------------------------------------------------------------------*/
+/* Packed output starts with the most significant bit, so descending bytes    */
+/* are copied and ascending bytes are reversed.                               */
+/* IN expansion: Expansion to be used.                                        */
+/* IN word: Word to convert into a string.                                    */
+/* OUT string: String containing the packed bit sequence.                     */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+static int	expandWordPacked(bitExpansion *expansion, uint32_64_t word,
+								char *string)
+{
+	int group;
+	uint64_t byte;
+
+
+	for(group=0; group < expansion->groupNum; group++)
+	{
+		byte = (word >> (8*expansion->groupByte[group])) & 0xFF;
+
+		if(expansion->groupDescending[group] != true)
+			byte = REVERSE_BYTE(byte);
+
+		string[group] = byte;
+	}
+
+	return expansion->length;
+}
+
+
+#if(X86_KERNELS==1)
+
+/* Expand a word with SSE2 instructions                                       */
+/*----------------------------------------------------------------------------*/
+/* The byte is broadcasted to all lanes, the bit of each even lane is         */
+/* selected by the mask and compared to the mask. The result flips the symbol */
+/* of a cleared bit while the odd lanes keep the separators.                  */
+/* IN expansion: Expansion to be used (paired symbols only).                  */
+/* IN word: Word to convert into a string.                                    */
+/* OUT string: String containing the output bit sequence.                     */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+__attribute__((target("sse2")))
+static int	expandWordSSE2(bitExpansion *expansion, uint32_64_t word,
+								char *string)
+{
+	int group;
+	__m128i base;
+	__m128i flip;
+	__m128i mask;
+	__m128i bits;
+
+
+	base = _mm_set1_epi16((short) (expansion->base & 0xFFFF));
+	flip = _mm_set1_epi16((short) expansion->flip);
+
+	for(group=0; group < expansion->groupNum; group++)
+	{
+		mask = _mm_loadu_si128((__m128i *) expansion->mask[group]);
+		bits = _mm_set1_epi8((char) 
+			((word >> (8*expansion->groupByte[group])) & 0xFF));
+
+		bits = _mm_cmpeq_epi8(_mm_and_si128(bits, mask), mask);
+		bits = _mm_xor_si128(base, _mm_and_si128(bits, flip));
+
+		_mm_storeu_si128((__m128i *) (string + 16*group), bits);
+	}
+
+	memcpy(string + 16*expansion->groupNum, expansion->terminator,
+					expansion->terminatorLength);
+
+	return expansion->length;
+}
+
+
+/* Expand a word with AVX2 instructions                                       */
+/*----------------------------------------------------------------------------*/
+/* Like expandWordSSE2, but two bytes are expanded at once. The bytes are     */
+/* selected from the broadcasted word by a byte shuffle.                      */
+/* IN expansion: Expansion to be used (paired symbols only).                  */
+/* IN word: Word to convert into a string.                                    */
+/* OUT string: String containing the output bit sequence.                     */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+__attribute__((target("avx2")))
+static int	expandWordAVX2(bitExpansion *expansion, uint32_64_t word,
+								char *string)
+{
+	int group;
+	__m256i base;
+	__m256i flip;
+	__m256i mask;
+	__m256i bits;
+	__m256i source;
+	__m128i mask128;
+	__m128i bits128;
+
+
+	base = _mm256_set1_epi16((short) (expansion->base & 0xFFFF));
+	flip = _mm256_set1_epi16((short) expansion->flip);
+	source = _mm256_set1_epi64x((long long) word);
+
+	/* expand two bytes at once */
+	for(group=0; group+1 < expansion->groupNum; group+=2)
+	{
+		mask = _mm256_loadu_si256((__m256i *) expansion->mask[group]);
+		bits = _mm256_shuffle_epi8(source, _mm256_loadu_si256(
+				(__m256i *) expansion->shuffle[group]));
+
+		bits = _mm256_cmpeq_epi8(_mm256_and_si256(bits, mask), mask);
+		bits = _mm256_xor_si256(base, _mm256_and_si256(bits, flip));
+
+		_mm256_storeu_si256((__m256i *) (string + 16*group), bits);
+	}
+
+	/* expand the last byte of an odd number of bytes */
+	if(group < expansion->groupNum)
+	{
+		mask128 = _mm_loadu_si128((__m128i *) expansion->mask[group]);
+		bits128 = _mm_shuffle_epi8(_mm256_castsi256_si128(source),
+			_mm_loadu_si128((__m128i *) expansion->shuffle[group]));
+
+		bits128 = _mm_cmpeq_epi8(_mm_and_si128(bits128, mask128), 
+								mask128);
+		bits128 = _mm_xor_si128(_mm256_castsi256_si128(base),
+			_mm_and_si128(bits128, _mm256_castsi256_si128(flip)));
+
+		_mm_storeu_si128((__m128i *) (string + 16*group), bits128);
+	}
+
+	memcpy(string + 16*expansion->groupNum, expansion->terminator,
+					expansion->terminatorLength);
+
+	return expansion->length;
+}
+
+#endif /* X86_KERNELS */
+
+
+/* Check if a kernel can be used on this machine                              */
+/*----------------------------------------------------------------------------*/
+/* IN kernel: Kernel to check.                                                */
+/* RETURNS: true if the kernel is supported, false otherwise.                 */
+/*----------------------------------------------------------------------------*/
+int	kernelIsSupported(int kernel)
+{
+	switch(kernel)
+	{
+		case NO_KERNEL:
+		case SWAR_KERNEL:
+		case RUN_KERNEL:
+		return true;
+
+#if(X86_KERNELS==1)
+		case SSE2_KERNEL:
+		return __builtin_cpu_supports("sse2") ? true : false;
+
+		case AVX2_KERNEL:
+		return __builtin_cpu_supports("avx2") ? true : false;
+#endif
+
+		default:
+		return false;
+	}
+}
+
+
+/* Check the bytes of a bit order                                             */
+/*----------------------------------------------------------------------------*/
+/* Check if the bit order consists of whole ascending or descending bytes of  */
+/* the word and generate the groups of the byte kernels.                      */
+/* OUT expansion: Expansion whose groups are initialized.                     */
+/* IN bitOrder: Bit order to be expanded.                                     */
+/* IN wordLength: Length of the words to convert in bits.                     */
+/* RETURNS: EXIT_FAILURE if the bit order doesn't consist of whole bytes,     */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+static int	initializeGroups(bitExpansion *expansion, bitOrderRuns *runs,
+								int wordLength)
+{
+	int group;
+	int bit;
+	int first;
+	int length;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+
+
+	/* the bit order must consist of whole bytes */
+	length = bitOrderLength(runs);
+	if((length == 0) || (length % 8 != 0))
+		return EXIT_FAILURE;
+
+	expandBitOrderRuns(runs, bitOrder, MAX_BIT_ORDER_LENGTH);
+
+	expansion->groupNum = length / 8;
+	for(group=0; group < expansion->groupNum; group++)
+	{
+		first = bitOrder[8*group];
+
+		/* the first bit must be the lowest or highest bit of a byte */
+		if((first < 0) || (first >= wordLength))
+			return EXIT_FAILURE;
+
+		if(first % 8 == 0)
+			expansion->groupDescending[group] = false;
+		else if(first % 8 == 7)
+			expansion->groupDescending[group] = true;
+		else
+			return EXIT_FAILURE;
+
+		/* check the other bits of the byte and generate the masks */
+		for(bit=0; bit < 8; bit++)
+		{
+			if(expansion->groupDescending[group] == true)
+			{
+				if(bitOrder[8*group + bit] != first - bit)
+					return EXIT_FAILURE;
+
+				expansion->mask[group][2*bit] = 0x80 >> bit;
+			}
+			else
+			{
+				if(bitOrder[8*group + bit] != first + bit)
+					return EXIT_FAILURE;
+
+				expansion->mask[group][2*bit] = 0x01 << bit;
+			}
+
+			expansion->mask[group][2*bit + 1] = 0;
+		}
+
+		expansion->groupByte[group] = first / 8;
+		memset(expansion->shuffle[group], first / 8, 16);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Add a run to the sequence of the run kernel                                */
+/*----------------------------------------------------------------------------*/
+/* A repeat is replaced by the runs it repeats, repeats within them are       */
+/* replaced as well.                                                          */
+/* IN/OUT expansion: Expansion whose sequence is extended.                    */
+/* IN run: Index of the run to add.                                           */
+/*----------------------------------------------------------------------------*/
+static void	addRunToSequence(bitExpansion *expansion, int run)
+{
+	int copy;
+	int repeated;
+	bitRun *current;
+
+
+	current = &expansion->runs.run[run];
+	if(current->type != REPEAT_RUN)
+	{
+		expansion->sequence[expansion->sequenceNum++] = run;
+		return;
+	}
+
+	for(copy=0; copy < current->count; copy++)
+	{
+		for(repeated=run - current->first; repeated < run; repeated++)
+			addRunToSequence(expansion, repeated);
+	}
+}
+
+
+/* Check the runs of a bit order                                              */
+/*----------------------------------------------------------------------------*/
+/* The run kernel only takes runs from the word which are within the word     */
+/* length.                                                                    */
+/* OUT expansion: Expansion whose runs are initialized.                       */
+/* IN bitOrder: Bit order to be expanded.                                     */
+/* IN wordLength: Length of the words to convert in bits.                     */
+/* RETURNS: EXIT_FAILURE if a run isn't within the word,                      */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+static int	initializeRuns(bitExpansion *expansion, bitOrderRuns *bitOrder,
+								int wordLength)
+{
+	int run;
+	int lowest;
+	int highest;
+	bitRun *current;
+
+
+	expansion->groupNum = 0;
+	if(bitOrder->length == 0)
+		return EXIT_FAILURE;
+
+	expansion->runs = *bitOrder;
+
+	for(run=0; run < expansion->runs.runNum; run++)
+	{
+		current = &expansion->runs.run[run];
+		if((current->type == REPEAT_RUN) || 
+					(current->type == LITERAL_RUN))
+			continue;
+
+		getRunRange(current, &lowest, &highest);
+		if((lowest < 0) || (highest >= wordLength))
+			return EXIT_FAILURE;
+	}
+
+	/* the runs in the order of the output */
+	expansion->sequenceNum = 0;
+	for(run=0; run < expansion->runs.runNum; run++)
+		addRunToSequence(expansion, run);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Initialize the expansion of a bit order                                    */
+/*----------------------------------------------------------------------------*/
+/* Set up the given kernel for the bit order. The byte kernels need whole     */
+/* bytes of the word (see initializeGroups), the run kernel needs runs of     */
+/* bits which can be shifted out of the word (see initializeRuns).            */
+/* The simd kernels only generate symbols followed by a one character         */
+/* separator, the run kernel doesn't generate packed output and longer        */
+/* separators are not expanded at all.                                        */
+/* OUT expansion: Expansion to be initialized.                                */
+/* IN bitOrder: Bit order to be expanded.                                     */
+/* IN wordLength: Length of the words to convert in bits.                     */
+/* IN format: Output format (see formatWordToOutputString).                   */
+/* IN kernel: Kernel to use or BEST_KERNEL to select the fastest byte kernel  */
+/*            supported by the machine.                                       */
+/* RETURNS: EXIT_FAILURE if the bit order can't be expanded with the kernel,  */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+int	initializeBitExpansion(bitExpansion *expansion, bitOrderRuns *bitOrder,
+				int wordLength, outputFormat *format, int kernel)
+{
+	int length;
+	int result;
+
+
+	expansion->kernel = NO_KERNEL;
+
+	if(kernel == RUN_KERNEL)
+		result = initializeRuns(expansion, bitOrder, wordLength);
+	else
+		result = initializeGroups(expansion, bitOrder, wordLength);
+
+	if(result != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* select the symbol layout */
+	if(format->type == PACKED_OUTPUT)
+		expansion->layout = PACKED_BITS;
+	else if(format->separatorLength == 0)
+		expansion->layout = DENSE_SYMBOLS;
+	else if(format->separatorLength == 1)
+		expansion->layout = PAIRED_SYMBOLS;
+	else
+		return EXIT_FAILURE;
+
+	/* select the kernel */
+	if(kernel == BEST_KERNEL)
+	{
+		if(expansion->layout == PAIRED_SYMBOLS && 
+				kernelIsSupported(AVX2_KERNEL) == true)
+			kernel = AVX2_KERNEL;
+		else if(expansion->layout == PAIRED_SYMBOLS && 
+				kernelIsSupported(SSE2_KERNEL) == true)
+			kernel = SSE2_KERNEL;
+		else
+			kernel = SWAR_KERNEL;
+	}
+
+	if((kernelIsSupported(kernel) != true) || (kernel == NO_KERNEL) ||
+		(kernel == RUN_KERNEL && expansion->layout == PACKED_BITS) ||
+		(kernel != SWAR_KERNEL && kernel != RUN_KERNEL && 
+				expansion->layout != PAIRED_SYMBOLS))
+		return EXIT_FAILURE;
+
+	expansion->kernel = kernel;
+
+	/* symbols of cleared bits and the bits flipped by set bits */
+	expansion->flip = (uint8_t) (format->symbol[0] ^ format->symbol[1]);
+	if(expansion->layout == PAIRED_SYMBOLS)
+		expansion->base = ((uint8_t) format->symbol[0] | 
+				(uint8_t) format->separator[0] << 8) * 
+								PAIRS_MASK;
+	else
+		expansion->base = (uint8_t) format->symbol[0] * REPEAT_BYTE;
+
+	/* packed output has no terminator */
+	expansion->terminatorLength = 0;
+	if(expansion->layout != PACKED_BITS)
+	{
+		memcpy(expansion->terminator, format->terminator,
+						format->terminatorLength);
+		expansion->terminatorLength = format->terminatorLength;
+	}
+
+	length = bitOrderLength(bitOrder);
+	if(expansion->layout == PAIRED_SYMBOLS)
+		expansion->length = 2*length;
+	else if(expansion->layout == DENSE_SYMBOLS)
+		expansion->length = length;
+	else
+		expansion->length = length / 8;
+	expansion->length += expansion->terminatorLength;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Converts a word into a bit sequence with the kernel of the expansion.      */
+/*----------------------------------------------------------------------------*/
+/* The output string is not terminated.                                       */
+/* IN expansion: Initialized expansion of the bit order.                      */
+/* IN word: Word to convert into a string.                                    */
+/* OUT string: String containing the output bit sequence.                     */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+int	expandWordToOutputString(bitExpansion *expansion, uint32_64_t word,
+								char *string)
+{
+	switch(expansion->kernel)
+	{
+#if(X86_KERNELS==1)
+		case AVX2_KERNEL:
+		return expandWordAVX2(expansion, word, string);
+
+		case SSE2_KERNEL:
+		return expandWordSSE2(expansion, word, string);
+#endif
+
+		case RUN_KERNEL:
+		if(expansion->layout == PAIRED_SYMBOLS)
+			return expandRunsPaired(expansion, word, string);
+		else
+			return expandRunsDense(expansion, word, string);
+
+		case SWAR_KERNEL:
+		if(expansion->layout == PAIRED_SYMBOLS)
+			return expandWordPaired(expansion, word, string);
+		else if(expansion->layout == DENSE_SYMBOLS)
+			return expandWordDense(expansion, word, string);
+		else
+			return expandWordPacked(expansion, word, string);
+
+		default:
+		return 0;
+	}
+}
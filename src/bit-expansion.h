@@ -0,0 +1,105 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _BIT_EXPANSION_H
+#define _BIT_EXPANSION_H
+
+#include "device-description.h"
+#include "output-format.h"
+#include "bit-runs.h"
+
+
+/* maximum number of byte groups of a bit order that can be expanded */
+#define MAX_EXPANSION_GROUP_NUM		(MAX_BIT_ORDER_LENGTH/8)
+
+
+/* kernels for expanding the bytes of a word into an output string, the */
+/* run kernel expands bit orders of any shape and is never the best one */
+enum {NO_KERNEL, SWAR_KERNEL, SSE2_KERNEL, AVX2_KERNEL, RUN_KERNEL, 
+					BEST_KERNEL};
+
+/* symbol layouts the kernels are specialized for (one symbol per bit, */
+/* a symbol and a one character separator per bit or 8 bits per byte) */
+enum {DENSE_SYMBOLS, PAIRED_SYMBOLS, PACKED_BITS};
+
+
+/* datatype for expanding words whose bit order consists of whole bytes */
+/* or of runs (see bit-runs.c) */
+typedef struct
+{
+	int kernel;
+	int layout;
+	int length;
+
+	/* 8 bytes of output of cleared bits and the bits changed by set bits */
+	uint64_t base;
+	uint64_t flip;
+
+	/* text following the bit sequence */
+	char terminator[MAX_TERMINATOR_LENGTH];
+	int terminatorLength;
+
+	/* source byte and bit direction of each group of 8 output bits */
+	int groupNum;
+	uint8_t groupByte[MAX_EXPANSION_GROUP_NUM];
+	uint8_t groupDescending[MAX_EXPANSION_GROUP_NUM];
+
+	/* bit select masks and byte shuffle controls of the simd kernels */
+	uint8_t mask[MAX_EXPANSION_GROUP_NUM][16];
+	uint8_t shuffle[MAX_EXPANSION_GROUP_NUM][16];
+
+	/* runs of the bit order expanded by the run kernel and the order */
+	/* they are expanded in, repeated runs are expanded again */
+	bitOrderRuns runs;
+	int sequenceNum;
+	uint8_t sequence[MAX_BIT_ORDER_LENGTH];
+}
+bitExpansion;
+
+
+extern	int	kernelIsSupported(int);
+extern	int	initializeBitExpansion(bitExpansion *, bitOrderRuns *, int, 
+						outputFormat *, int);
+extern	int	expandWordToOutputString(bitExpansion *, uint32_64_t, char *);
+
+#endif /* _BIT_EXPANSION_H */
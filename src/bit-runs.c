@@ -0,0 +1,537 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* The bit orders of a device are described by runs from the parser on.       */
+/* Written down, they consist of few ranges, literals and repeats: a run of   */
+/* ascending or descending bits is taken from the word with one shift and     */
+/* mask, a literal run is a constant and a repeat copies the output of the    */
+/* bits before it. Flat arrays with one entry per output bit are only used    */
+/* by device description files and to set up the tables of the converter.     */
+/*----------------------------------------------------------------------------*/
+
+#include "bit-runs.h"
+
+
+/* Compare runs                                                               */
+/*----------------------------------------------------------------------------*/
+/* IN first: First runs.                                                      */
+/* IN second: Second runs.                                                    */
+/* IN runNum: Number of runs to compare.                                      */
+/* RETURNS: true if the runs are equal, false otherwise.                      */
+/*----------------------------------------------------------------------------*/
+static int	runsAreEqual(bitRun *first, bitRun *second, int runNum)
+{
+	int run;
+
+
+	for(run=0; run < runNum; run++)
+	{
+		if((first[run].type != second[run].type) ||
+			(first[run].first != second[run].first) ||
+			(first[run].length != second[run].length))
+			return false;
+	}
+
+	return true;
+}
+
+
+/* Encode a bit order array into runs                                         */
+/*----------------------------------------------------------------------------*/
+/* The bit order is split into the longest ascending, descending and literal  */
+/* runs of at most MAX_RUN_LENGTH bits. Runs following the same runs are      */
+/* replaced by a repeat afterwards.                                           */
+/* OUT runs: Runs of the bit order.                                           */
+/* IN bitOrder: Bit order array to encode, it ends with the first unused bit  */
+/*              or after arrayLength entries.                                 */
+/* IN arrayLength: Length of the bit order array.                             */
+/* RETURNS: EXIT_FAILURE if the bit order is longer than MAX_BIT_ORDER_LENGTH */
+/*          or needs more than MAX_BIT_ORDER_RUN_NUM runs,                    */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+int	encodeBitOrderRuns(bitOrderRuns *runs, int8_t *bitOrder, int arrayLength)
+{
+	bitRun plain[MAX_BIT_ORDER_LENGTH];
+	bitRun *current;
+	int plainNum;
+	int entry;
+	int step;
+	int run;
+	int size;
+	int copies;
+	int bestSize;
+	int bestCopies;
+	int saving;
+	int length;
+
+
+	runs->length = 0;
+	runs->runNum = 0;
+	while((runs->length < arrayLength) && 
+				(bitOrder[runs->length] != UNUSED_BIT))
+		runs->length++;
+
+	if(runs->length > MAX_BIT_ORDER_LENGTH)
+		return EXIT_FAILURE;
+
+	/* split the bit order into runs */
+	plainNum = 0;
+	for(entry=0; entry < runs->length; entry += current->length)
+	{
+		current = &plain[plainNum++];
+		current->first = bitOrder[entry];
+		current->length = 1;
+		current->count = 0;
+
+		if((bitOrder[entry] == LITERAL0_BIT) ||
+					(bitOrder[entry] == LITERAL1_BIT))
+		{
+			current->type = LITERAL_RUN;
+			current->first = (bitOrder[entry] == LITERAL1_BIT);
+
+			while((entry + current->length < runs->length) &&
+				(current->length < MAX_RUN_LENGTH) &&
+				(bitOrder[entry + current->length] ==
+							bitOrder[entry]))
+				current->length++;
+
+			continue;
+		}
+
+		/* a single bit is an ascending run */
+		current->type = ASCENDING_RUN;
+		step = 1;
+		if((entry + 1 < runs->length) && (bitOrder[entry+1] >= 0) &&
+				(bitOrder[entry+1] == bitOrder[entry] - 1))
+		{
+			current->type = DESCENDING_RUN;
+			step = -1;
+		}
+
+		if(bitOrder[entry] < 0)
+			continue;
+
+		while((entry + current->length < runs->length) &&
+			(current->length < MAX_RUN_LENGTH) &&
+			(current->first + step * current->length >= 0) &&
+			(bitOrder[entry + current->length] ==
+				current->first + step * current->length))
+			current->length++;
+	}
+
+	/* replace repeated runs */
+	for(run=0; run < plainNum; run += bestSize * (bestCopies + 1))
+	{
+		/* find the runs at this position which save the most runs */
+		/* if they are repeated */
+		bestSize = 1;
+		bestCopies = 0;
+		saving = 0;
+		for(size=1; run + 2*size <= plainNum; size++)
+		{
+			copies = 0;
+			while((run + (copies + 2) * size <= plainNum) &&
+				(runsAreEqual(plain + run, plain + run +
+					(copies + 1) * size, size) == true))
+				copies++;
+
+			/* the copies are replaced by one repeat */
+			if(copies * size - 1 > saving)
+			{
+				bestSize = size;
+				bestCopies = copies;
+				saving = copies * size - 1;
+			}
+		}
+
+		if(runs->runNum + bestSize + (bestCopies > 0) > 
+						MAX_BIT_ORDER_RUN_NUM)
+		{
+			runs->runNum = 0;
+			return EXIT_FAILURE;
+		}
+
+		memcpy(runs->run + runs->runNum, plain + run,
+						bestSize * sizeof(bitRun));
+		runs->runNum += bestSize;
+
+		if(bestCopies > 0)
+		{
+			length = 0;
+			for(size=0; size < bestSize; size++)
+				length += plain[run + size].length;
+
+			current = &runs->run[runs->runNum++];
+			current->type = REPEAT_RUN;
+			current->first = bestSize;
+			current->length = length;
+			current->count = bestCopies;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Expand runs into a bit order array                                         */
+/*----------------------------------------------------------------------------*/
+/* The entries following the bit order are set to UNUSED_BIT.                 */
+/* IN runs: Runs of the bit order.                                            */
+/* OUT bitOrder: Bit order array with one entry per output bit.               */
+/* IN arrayLength: Length of the bit order array.                             */
+/* RETURNS: EXIT_FAILURE if the bit order is longer than the array,           */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+int	expandBitOrderRuns(bitOrderRuns *runs, int8_t *bitOrder, int arrayLength)
+{
+	bitRun *current;
+	int run;
+	int entry;
+	int i;
+
+
+	memset(bitOrder, UNUSED_BIT, arrayLength);
+	if(runs->length > arrayLength)
+		return EXIT_FAILURE;
+
+	entry = 0;
+	for(run=0; run < runs->runNum; run++)
+	{
+		current = &runs->run[run];
+
+		for(i=0; i < current->length * 
+			((current->type == REPEAT_RUN) ? current->count : 1);
+									i++)
+		{
+			if(current->type == REPEAT_RUN)
+				bitOrder[entry] = bitOrder[entry - 
+							current->length];
+			else if(current->type == LITERAL_RUN)
+				bitOrder[entry] = (current->first != 0) ? 
+						LITERAL1_BIT : LITERAL0_BIT;
+			else if(current->type == ASCENDING_RUN)
+				bitOrder[entry] = current->first + i;
+			else
+				bitOrder[entry] = current->first - i;
+
+			entry++;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Check runs                                                                 */
+/*----------------------------------------------------------------------------*/
+/* Runs read from a file are checked before they are used, so expanding or    */
+/* rendering them stays within the bit order.                                 */
+/* IN runs: Runs of the bit order.                                            */
+/* RETURNS: true if the runs describe a bit order of at most                  */
+/*          MAX_BIT_ORDER_LENGTH bits, false otherwise.                       */
+/*----------------------------------------------------------------------------*/
+int	bitOrderRunsAreValid(bitOrderRuns *runs)
+{
+	int runLength[MAX_BIT_ORDER_RUN_NUM];
+	bitRun *current;
+	int bitNum;
+	int length;
+	int run;
+	int i;
+
+
+	if((runs->runNum < 0) || (runs->runNum > MAX_BIT_ORDER_RUN_NUM) ||
+		(runs->length < 0) || (runs->length > MAX_BIT_ORDER_LENGTH))
+		return false;
+
+	bitNum = 0;
+	for(run=0; run < runs->runNum; run++)
+	{
+		current = &runs->run[run];
+		if((current->length == 0) || ((current->type != REPEAT_RUN) &&
+				(current->length > MAX_RUN_LENGTH)))
+			return false;
+
+		switch(current->type)
+		{
+			case ASCENDING_RUN:
+				if((current->first < 0) || (current->first + 
+					current->length > MAX_WORD_LENGTH64))
+					return false;
+				break;
+
+			case DESCENDING_RUN:
+				if((current->first >= MAX_WORD_LENGTH64) ||
+					(current->first - current->length < -1))
+					return false;
+				break;
+
+			case LITERAL_RUN:
+				if((current->first != 0) && 
+							(current->first != 1))
+					return false;
+				break;
+
+			case REPEAT_RUN:
+				/* the repeated runs must be as long as the */
+				/* repeat */
+				if((current->first < 1) || 
+					(current->first > run) ||
+					(current->count == 0))
+					return false;
+
+				length = 0;
+				for(i=run - current->first; i < run; i++)
+					length = length + runLength[i];
+				if(length != current->length)
+					return false;
+				break;
+
+			default:
+				return false;
+		}
+
+		runLength[run] = current->length;
+		if(current->type == REPEAT_RUN)
+		{
+			if(current->count > (MAX_BIT_ORDER_LENGTH - bitNum) / 
+							current->length)
+				return false;
+			runLength[run] = current->length * current->count;
+		}
+
+		bitNum = bitNum + runLength[run];
+		if(bitNum > MAX_BIT_ORDER_LENGTH)
+			return false;
+	}
+
+	return (bitNum == runs->length);
+}
+
+
+/* Reverse the bits of a run                                                  */
+/*----------------------------------------------------------------------------*/
+/* IN bits: Bits of the run.                                                  */
+/* IN length: Number of bits of the run.                                      */
+/* RETURNS: Bits in reversed order.                                           */
+/*----------------------------------------------------------------------------*/
+static uint64_t	reverseRunBits(uint64_t bits, int length)
+{
+	bits = ((bits >> 1) & UINT64_C(0x5555555555555555)) |
+		((bits & UINT64_C(0x5555555555555555)) << 1);
+	bits = ((bits >> 2) & UINT64_C(0x3333333333333333)) |
+		((bits & UINT64_C(0x3333333333333333)) << 2);
+	bits = ((bits >> 4) & UINT64_C(0x0F0F0F0F0F0F0F0F)) |
+		((bits & UINT64_C(0x0F0F0F0F0F0F0F0F)) << 4);
+	bits = ((bits >> 8) & UINT64_C(0x00FF00FF00FF00FF)) |
+		((bits & UINT64_C(0x00FF00FF00FF00FF)) << 8);
+	bits = ((bits >> 16) & UINT64_C(0x0000FFFF0000FFFF)) |
+		((bits & UINT64_C(0x0000FFFF0000FFFF)) << 16);
+	bits = (bits >> 32) | (bits << 32);
+
+	return bits >> (64 - length);
+}
+
+
+/* Get the range of the bits of a run                                         */
+/*----------------------------------------------------------------------------*/
+/* IN run: Ascending or descending run.                                       */
+/* OUT lowest: Lowest bit of the run.                                         */
+/* OUT highest: Highest bit of the run.                                       */
+/*----------------------------------------------------------------------------*/
+void	getRunRange(bitRun *run, int *lowest, int *highest)
+{
+	if(run->type == ASCENDING_RUN)
+	{
+		*lowest = run->first;
+		*highest = run->first + run->length - 1;
+	}
+	else
+	{
+		*lowest = run->first - run->length + 1;
+		*highest = run->first;
+	}
+}
+
+
+/* Take the bits of a run from a word                                         */
+/*----------------------------------------------------------------------------*/
+/* The bits are taken with one shift and mask, the bits of descending runs    */
+/* are reversed afterwards. Bits outside of the word are 0.                   */
+/* IN run: Ascending, descending or literal run.                              */
+/* IN word: Word to take the bits from.                                       */
+/* RETURNS: Bits of the run, the first output bit in bit 0.                   */
+/*----------------------------------------------------------------------------*/
+uint64_t	takeRunBits(bitRun *run, uint32_64_t word)
+{
+	uint64_t mask;
+	uint64_t bits;
+	int lowest;
+	int highest;
+
+
+	mask = (run->length >= 64) ? ~UINT64_C(0) :
+					(UINT64_C(1) << run->length) - 1;
+
+	if(run->type == LITERAL_RUN)
+		return (run->first != 0) ? mask : 0;
+
+	getRunRange(run, &lowest, &highest);
+	if((lowest < 0) || (highest >= 64))
+		return 0;
+
+	bits = ((uint64_t) word >> lowest) & mask;
+
+	if(run->type == DESCENDING_RUN)
+		return reverseRunBits(bits, run->length);
+
+	return bits;
+}
+
+
+/* Converts a word into a bit sequence with the runs of a bit order           */
+/*----------------------------------------------------------------------------*/
+/* The result is the same as the one of formatWordToOutputString with the     */
+/* bit order the runs have been encoded from.                                 */
+/* IN runs: Runs of the bit order.                                            */
+/* IN word: Data word to convert into a string.                               */
+/* IN format: Output format.                                                  */
+/* OUT string: String containing the output bit sequence. Ascii strings are   */
+/*             terminated.                                                    */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+int	renderBitOrderRuns(bitOrderRuns *runs, uint32_64_t word,
+					outputFormat *format, char *string)
+{
+	bitRun *current;
+	uint64_t bits;
+	int run;
+	int bit;
+	int i;
+	int value;
+	int source;
+	int step;
+	int length;
+
+
+	step = 1 + format->separatorLength;
+	bit = 0;
+	length = 0;
+
+	for(run=0; run < runs->runNum; run++)
+	{
+		current = &runs->run[run];
+
+		/* copy the output of the repeated bits */
+		if(current->type == REPEAT_RUN)
+		{
+			for(i=0; i < current->length * current->count; i++)
+			{
+				if(format->type == PACKED_OUTPUT)
+				{
+					source = bit - current->length;
+					value = (string[source/8] >>
+						(7 - source % 8)) & 1;
+
+					if(bit % 8 == 0)
+						string[bit/8] = 0;
+
+					string[bit/8] |= value << (7 - bit % 8);
+				}
+				bit++;
+			}
+
+			if(format->type != PACKED_OUTPUT)
+			{
+				for(i=0; i < current->count; i++)
+				{
+					memcpy(string + length, string + length
+						- current->length * step,
+						current->length * step);
+					length += current->length * step;
+				}
+			}
+
+			continue;
+		}
+
+		/* render the bits of the run */
+		bits = takeRunBits(current, word);
+		for(i=0; i < current->length; i++, bits >>= 1)
+		{
+			if(format->type == PACKED_OUTPUT)
+			{
+				if(bit % 8 == 0)
+					string[bit/8] = 0;
+
+				string[bit/8] |= (bits & 1) << (7 - bit % 8);
+			}
+			else
+			{
+				string[length] = format->symbol[bits & 1];
+				memcpy(string + length + 1, format->separator,
+						format->separatorLength);
+				length += step;
+			}
+			bit++;
+		}
+	}
+
+	/* return length of the string */
+	if(format->type == PACKED_OUTPUT)
+		return (bit + 7) / 8;
+
+	/* add the terminator if the output string is not empty */
+	if(bit > 0)
+	{
+		memcpy(string + length, format->terminator,
+						format->terminatorLength);
+		length += format->terminatorLength;
+	}
+
+	if(format->type == ASCII_OUTPUT)
+		string[length] = '\0';
+
+	return length;
+}
@@ -42,495 +42,1304 @@
 
 
 #include "converter.h"
+#include "address-cache.h"
 
 
-/* Write the usage of the memory blocks to an array                           */
+/* Find the used blocks of a memory image                                     */
 /*----------------------------------------------------------------------------*/
-/* Run through the data and check if there are blocks containing only 0xFF.   */
-/* Those blocks are marked as unused in the array.                            */
-/* IN device: Description of the device whose data to be checked.             */
-/* IN programData: Byte array that contains the data to be checked.           */
-/* OUT usedBlocks: Array indicating whether a specific memory block is used   */
-/*                 or not. The array must be at least as long as the number   */
-/*                 of blocks of the device                                    */
-/*                 (device.memorySize / device.blockSize).                    */
+/* Run through the allocated blocks and check if there are blocks containing  */
+/* only 0xFF. Those blocks are released, so the allocated blocks of the image */
+/* are exactly the used blocks afterwards. readBinFile and readHexFile do     */
+/* this while reading.                                                        */
+/* INOUT image: Memory image whose blocks to be checked.                      */
 /*----------------------------------------------------------------------------*/
-void	findUsedBlocks(deviceData *device, uint8_t *programData,int *usedBlocks)
+void	findUsedBlocks(memoryImage *image)
 {
-	uint32_64_t block;
-	uint32_64_t byte;
-
-
-	/* check block after block */
-	for(block=0; block<(device->memorySize/device->blockSize); block++)
-	{
-		/* initialize block to be used */
-		usedBlocks[block] = true;
+	releaseBlankBlocks(image, 0, image->blockNum);
+}
 
-		/* loop until the first byte not equal to 0xFF */
-		byte = 0;
-		while((byte < device->blockSize) && 
-			(programData[block*device->blockSize+byte] == 0xFF))
-			byte++;
 
-		/* set block to be unused if all bytes of the block are 0xFF */
-		if(byte >= device->blockSize)
-			usedBlocks[block] = false;
-	}
+/* Converts data or address word into a bit sequence with the given bit order */
+/* and output format.                                                         */
+/*----------------------------------------------------------------------------*/
+/* Unless the output is packed, every bit is written as the symbol of its     */
+/* value followed by the separator of the format, and the terminator of the   */
+/* format is appended to a non empty bit sequence. Packed output contains the */
+/* bit sequence packed into bytes starting with the most significant bit, the */
+/* last byte is padded with 0 bits. The bit order is rendered from its runs   */
+/* (see renderBitOrderRuns).                                                  */
+/* IN word: Data word to convert into a string.                               */
+/* IN bitOrder: Bit order describing how to convert the word into a string.   */
+/* IN format: Output format.                                                  */
+/* OUT string: String containing the output bit sequence. Ascii strings are   */
+/*             terminated.                                                    */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+int	formatWordToOutputString(uint32_64_t word, bitOrderRuns *bitOrder, 
+					outputFormat *format, char *string)
+{
+	return renderBitOrderRuns(bitOrder, word, format, string);
 }
 
 
-/* Converts data or address word into a space separated bit sequence with     */
-/* the given bit order.                                                       */
+/* Converts data or address word into a bit sequence with the given bit order */
+/* and the default layout of an output format.                                */
 /*----------------------------------------------------------------------------*/
 /* IN word: Data word to convert into a string.                               */
 /* IN bitOrder: Bit order describing how to convert the word into a string.   */
-/* IN ascii: If ascii is true, the output string will be a space separated    */
-/*           bit sequence (0 or 1 ascii symbols) in the right order (defined  */
-/*           by bitOrder) with a line break at the end. If ascii is false,    */ 
-/*           the output string will be in binary format (one byte represents  */
-/*           one bit).                                                        */
+/* IN format: If format is ASCII_OUTPUT, the output string will be a space    */
+/*            separated bit sequence (0 or 1 ascii symbols) in the right      */
+/*            order (defined by bitOrder) with a line break at the end. If    */ 
+/*            format is BINARY_OUTPUT, the output string will be in binary    */
+/*            format (one byte represents one bit). If format is              */
+/*            PACKED_OUTPUT, the bit sequence is packed into bytes starting   */
+/*            with the most significant bit and the last byte is padded with  */
+/*            0 bits.                                                         */
 /* OUT string: String containing the output bit sequence.                     */
 /* RETURNS: Length of the string.                                             */
 /*----------------------------------------------------------------------------*/
-int	wordToOutputString(uint32_64_t word, int8_t *bitOrder, int ascii, 
-				char *string)
+int	wordToOutputString(uint32_64_t word, bitOrderRuns *bitOrder, 
+				int format, char *string)
 {
-	int bit;
+	outputFormat defaultFormat;
 
 
-	bit = 0;
-	/* bit order ends if bitOrder[bit] == UNUSED_BIT */
-	while(bitOrder[bit] != UNUSED_BIT)
+	initializeOutputFormat(&defaultFormat, format);
+
+	return formatWordToOutputString(word, bitOrder, &defaultFormat, string);
+}
+
+
+/* Compile a bit order into per byte lookup tables                            */
+/*----------------------------------------------------------------------------*/
+/* For every byte of the word the output depends on, a table with the         */
+/* rendered output of all 256 byte values is generated. The tables only       */
+/* contain the bits in which the rendered fragments differ from the rendering */
+/* of a cleared word. Every output symbol is either the symbol of a cleared   */
+/* or of a set bit, so its difference is always the same and the output of a  */
+/* complete word is the rendering of a cleared word flipped by the bitwise or */
+/* of the differences of its bytes for any symbols. Literals, separators and  */
+/* the terminator are only contained in the cleared word.                     */
+/* Byte aligned bit orders are expanded without tables, bit orders of few     */
+/* runs are expanded from their runs if that is cheaper than or-ing the       */
+/* tables (see RUN_EXPANSION_COST).                                           */
+/* The compiled bit order must be disposed with disposeCompiledBitOrder.      */
+/* OUT compiled: Compiled bit order.                                          */
+/* IN bitOrder: Bit order to compile.                                         */
+/* IN wordLength: Length of the words to convert in bits. Bytes above this    */
+/*                length are ignored.                                         */
+/* IN format: Output format (see formatWordToOutputString).                   */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	compileBitOrder(compiledBitOrder *compiled, bitOrderRuns *bitOrder,
+					int wordLength, outputFormat *format)
+{
+	int position;
+	int positionNum;
+	int value;
+	int used;
+	int chunk;
+	uint64_t *base;
+	uint64_t fragment[MAX_OUTPUT_CHUNK_NUM];
+	uint64_t *table;
+
+
+	compiled->byteNum = 0;
+	compiled->fragments = NULL;
+	compiled->ownsFragments = true;
+	compiled->expansion.kernel = NO_KERNEL;
+
+	/* render a word with all bits cleared */
+	base = compiled->base;
+	memset(base, 0, sizeof(compiled->base));
+	compiled->length = renderBitOrderRuns(bitOrder, 0, format, 
+								(char *)base);
+	compiled->chunkNum = (compiled->length + 7) / 8;
+
+	/* nothing to do for an empty bit order */
+	if(compiled->length == 0)
+		return EXIT_SUCCESS;
+
+	/* no tables are needed if the bit order can be expanded directly */
+	if(initializeBitExpansion(&compiled->expansion, bitOrder, wordLength,
+					format, BEST_KERNEL) == EXIT_SUCCESS)
+		return EXIT_SUCCESS;
+
+	compiled->fragments = malloc(sizeof(uint32_64_t) * 256 *
+				compiled->chunkNum * sizeof(uint64_t));
+	if(compiled->fragments == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	/* number of bytes of the word (at least one table is generated) */
+	positionNum = (wordLength + 7) / 8;
+	if(positionNum > (int) sizeof(uint32_64_t))
+		positionNum = sizeof(uint32_64_t);
+	if(positionNum < 1)
+		positionNum = 1;
+
+	/* generate a table for each byte of the word */
+	for(position=0; position < positionNum; position++)
 	{
-		/* check if the output string should be an ascii string */
-		if(ascii == true)
+		table = compiled->fragments + 
+				compiled->byteNum * 256 * compiled->chunkNum;
+		used = false;
+
+		for(value=0; value < 256; value++)
 		{
-			/* convert literals */
-			if(bitOrder[bit] == LITERAL0_BIT)
-				string[bit*2] = '0';
+			memset(fragment, 0, sizeof(fragment));
+			renderBitOrderRuns(bitOrder, (uint32_64_t) value << 
+				(8*position), format, (char *)fragment);
 
-			if(bitOrder[bit] == LITERAL1_BIT)
-				string[bit*2] = '1';
+			/* the byte is used if any output symbol depends on it */
+			if(memcmp(fragment, base, compiled->chunkNum * 
+						sizeof(uint64_t)) != 0)
+				used = true;
 
-			/* convert word bits */
-			if(word & (1 << bitOrder[bit]))
-				string[bit*2] = '1';
-			else
-				string[bit*2] = '0';
+			/* keep the difference to the cleared word */
+			for(chunk=0; chunk < compiled->chunkNum; chunk++)
+				fragment[chunk] ^= base[chunk];
 
-			string[bit*2+1] = ' ';
+			memcpy(table + value * compiled->chunkNum, fragment,
+				compiled->chunkNum * sizeof(uint64_t));
 		}
-		else
+
+		/* keep the table only if the byte is used */
+		if(used == true)
 		{
-			/* convert literals */
-			if(bitOrder[bit] == LITERAL0_BIT)
-				string[bit] = 0;
+			compiled->bytePosition[compiled->byteNum] = position;
+			compiled->byteNum++;
+		}
+	}
 
-			if(bitOrder[bit] == LITERAL1_BIT)
-				string[bit] = 1;
+	/* if the output doesn't depend on the word at all, the last */
+	/* (unused) table contains the constant output for every value */
+	if(compiled->byteNum == 0)
+	{
+		compiled->bytePosition[0] = positionNum - 1;
+		compiled->byteNum = 1;
+	}
 
-			/* convert word bits */
-			if(word & (1 << bitOrder[bit]))
-				string[bit] = 1;
-			else
-				string[bit] = 0;
-		}
+	/* long output of few runs is expanded from the runs faster than */
+	/* it is put together from many tables */
+	if((initializeBitExpansion(&compiled->expansion, bitOrder, wordLength,
+					format, RUN_KERNEL) == EXIT_SUCCESS) &&
+		(compiled->expansion.sequenceNum * RUN_EXPANSION_COST < 
+				compiled->byteNum * compiled->chunkNum))
+	{
+		free(compiled->fragments);
+		compiled->fragments = NULL;
+		compiled->byteNum = 0;
+		return EXIT_SUCCESS;
+	}
 
-		bit++;
+	compiled->expansion.kernel = NO_KERNEL;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Compile a bit order of a device                                            */
+/*----------------------------------------------------------------------------*/
+/* The bit order compiled in advance is used if it has been compiled for the  */
+/* same format, otherwise the bit order is compiled with compileBitOrder.     */
+/* OUT compiled: Compiled bit order.                                          */
+/* IN bitOrder: Bit order to compile.                                         */
+/* IN wordLength: Length of the words to convert in bits.                     */
+/* IN format: Output format (see formatWordToOutputString).                   */
+/* IN precompiled: Bit orders compiled in advance or NULL.                    */
+/* IN kind: Kind of the bit order (WORD_BIT_ORDER, ...).                      */
+/* IN mode: PROGRAM or VERIFY.                                                */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	compileDeviceBitOrder(compiledBitOrder *compiled, 
+		bitOrderRuns *bitOrder, int wordLength, outputFormat *format, 
+		precompiledBitOrders *precompiled, int kind, int mode)
+{
+	if((precompiled != NULL) && 
+		(precompiled->available[kind][mode] == true) &&
+		(outputFormatsAreEqual(&precompiled->format, format) == true))
+	{
+		*compiled = precompiled->bitOrder[kind][mode];
+		compiled->ownsFragments = false;
+		return EXIT_SUCCESS;
 	}
 
-	/* add a line break if the output string is an ascii string */
-	if(ascii == true && bit > 0)
+	return compileBitOrder(compiled, bitOrder, wordLength, format);
+}
+
+
+/* Dispose a compiled bit order                                               */
+/*----------------------------------------------------------------------------*/
+/* IN compiled: Compiled bit order to dispose.                                */
+/*----------------------------------------------------------------------------*/
+void	disposeCompiledBitOrder(compiledBitOrder *compiled)
+{
+	if((compiled->fragments != NULL) && (compiled->ownsFragments == true))
+		free(compiled->fragments);
+
+	compiled->fragments = NULL;
+	compiled->byteNum = 0;
+	compiled->expansion.kernel = NO_KERNEL;
+}
+
+
+/* Converts data or address word into the output string of a compiled bit     */
+/* order.                                                                     */
+/*----------------------------------------------------------------------------*/
+/* The result is the same as the one of wordToOutputString with the bit order */
+/* and format the compiled bit order was generated from. The output string is */
+/* not terminated.                                                            */
+/* IN compiled: Compiled bit order describing how to convert the word.        */
+/* IN word: Data word to convert into a string.                               */
+/* OUT string: String containing the output bit sequence.                     */
+/* RETURNS: Length of the string.                                             */
+/*----------------------------------------------------------------------------*/
+int	compiledWordToOutputString(compiledBitOrder *compiled, uint32_64_t word,
+								char *string)
+{
+	int byte;
+	int chunk;
+	uint64_t *fragment;
+	uint64_t output[MAX_OUTPUT_CHUNK_NUM];
+
+
+	if(compiled->expansion.kernel != NO_KERNEL)
+		return expandWordToOutputString(&compiled->expansion, word,
+								string);
+
+	if(compiled->byteNum == 0)
+		return 0;
+
+	/* copy the difference of the first byte */
+	fragment = compiled->fragments + compiled->chunkNum * 
+		((word >> (8*compiled->bytePosition[0])) & 0xFF);
+
+	for(chunk=0; chunk < compiled->chunkNum; chunk++)
+		output[chunk] = fragment[chunk];
+
+	/* or the differences of the other bytes */
+	for(byte=1; byte < compiled->byteNum; byte++)
 	{
-		string[bit*2] = '\r';
-		string[bit*2+1] = '\n';
-		bit++;
-		string[bit*2] = '\0';
+		fragment = compiled->fragments + compiled->chunkNum * 
+			(byte * 256 + 
+			((word >> (8*compiled->bytePosition[byte])) & 0xFF));
 
-		/* return length of the string */
-		return bit*2;
+		for(chunk=0; chunk < compiled->chunkNum; chunk++)
+			output[chunk] |= fragment[chunk];
 	}
-	else
+
+	/* flip the cleared word */
+	for(chunk=0; chunk < compiled->chunkNum; chunk++)
+		output[chunk] ^= compiled->base[chunk];
+
+	memcpy(string, output, compiled->length);
+
+	return compiled->length;
+}
+
+
+/* Compile a bit order for incremental rendering                              */
+/*----------------------------------------------------------------------------*/
+/* For every bit of the word the positions of its output symbols are          */
+/* collected, so a rendered word can be turned into the rendering of another  */
+/* word by rewriting the symbols of the changed bits only.                    */
+/* Packed output shares bytes between bits, so it is always rendered          */
+/* completely.                                                                */
+/* OUT incremental: Compiled bit order.                                       */
+/* IN bitOrder: Bit order to compile.                                         */
+/* IN format: Output format (see formatWordToOutputString).                   */
+/* RETURNS: EXIT_FAILURE if the bit order contains bits above 63 or the       */
+/*          output is packed, EXIT_SUCCESS otherwise.                         */
+/*----------------------------------------------------------------------------*/
+int	compileIncrementalBitOrder(incrementalBitOrder *incremental, 
+				bitOrderRuns *runs, outputFormat *format)
+{
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	int bit;
+	int entry;
+	int positionNum;
+
+
+	if(format->type == PACKED_OUTPUT)
+		return EXIT_FAILURE;
+
+	expandBitOrderRuns(runs, bitOrder, MAX_BIT_ORDER_LENGTH);
+
+	incremental->symbol[0] = format->symbol[0];
+	incremental->symbol[1] = format->symbol[1];
+
+	/* collect the positions bit by bit */
+	positionNum = 0;
+	for(bit=0; bit < MAX_WORD_LENGTH64; bit++)
 	{
-		/* return length of the string */
-		return bit;
+		incremental->firstPosition[bit] = positionNum;
+
+		for(entry=0; (entry < MAX_BIT_ORDER_LENGTH) && 
+				(bitOrder[entry] != UNUSED_BIT); entry++)
+		{
+			/* bits above 63 are not supported */
+			if(bitOrder[entry] >= MAX_WORD_LENGTH64)
+				return EXIT_FAILURE;
+
+			if(bitOrder[entry] == bit)
+			{
+				incremental->position[positionNum] = entry *
+					(1 + format->separatorLength);
+				positionNum++;
+			}
+		}
 	}
+	incremental->firstPosition[MAX_WORD_LENGTH64] = positionNum;
 
+	return EXIT_SUCCESS;
 }
 
 
-/* Write the address file                                                     */
+/* Turn a rendered word into the rendering of another word                    */
 /*----------------------------------------------------------------------------*/
-/* Write a file with program and verify addresses depending on the value of   */
-/* mode.                                                                      */
-/* IN fileNameBase: First part of the output file name. If mode is PROGRAM,   */
-/*                  "_program_address" is appended to fileNameBase. If mode   */
-/*                  is VERIFY, "_verify_address" is appended to fileNameBase. */
-/*                  If mode is PROGRAM_VERIFY, "_address" is appended to      */
-/*                  fileNameBase.                                             */
-/* IN device: Device structure that contains all needed information about the */
-/*            device.                                                         */
-/* IN usedBlocks: Array indicating whether a specific memory block is used or */
-/*                not.                                                        */
-/* IN mode: If mode is PROGRAM, the program bit order is used for generating  */
-/*          the address data. If mode is VERIFY, the verify bit order is used.*/
-/*          If mode is PROGRAM_VERIFY, it will be assumed that the program    */
-/*          and verify bit orders are equal.                                  */
-/* IN ascii: If ascii is true, the output format will be a space separated    */
-/*           bit sequence (0 or 1 ascii symbols). If ascii is false, the      */
-/*           output format will be binary (one byte represents one bit).      */
-/* IN generateAllBlocks: If generateAllBlocks is false, only used data blocks */
-/*                       are written to the output files. If generateAllBlocks*/
-/*                       is true, all data blocks will be written.            */
-/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/* Only the output symbols of the bits differing between the two words are    */
+/* rewritten.                                                                 */
+/* IN incremental: Compiled bit order the string was rendered with.           */
+/* IN previousWord: Word the string contains.                                 */
+/* IN word: Word to be rendered.                                              */
+/* IN/OUT string: Rendered previous word, rendered word after the call.       */
 /*----------------------------------------------------------------------------*/
-int	writeAddressFile(char *fileNameBase, deviceData *device, 
-				int *usedBlocks, int mode, int ascii, 
-				int generateAllBlocks)
+void	updateOutputString(incrementalBitOrder *incremental, 
+			uint32_64_t previousWord, uint32_64_t word, 
+			char *string)
 {
-	int writtenBytes;
-	int bufferLength;
-	char buffer[MAX_BIT_ORDER_LENGTH*2 + 3];
-	char fileName[FILENAME_MAX];
-	FILE *file;
+	int bit;
+	int position;
+	int value;
+	uint32_64_t changedBits;
 
-	uint32_64_t byte;
-	uint32_64_t addressWord;
-	uint32_64_t blockAddressWord;
+
+	changedBits = previousWord ^ word;
+
+	/* rewrite the symbols of the changed bits */
+	bit = 0;
+	while(changedBits != 0)
+	{
+		/* skip unchanged bits */
+		while((changedBits & 0xFF) == 0)
+		{
+			changedBits >>= 8;
+			bit += 8;
+		}
+		while((changedBits & 1) == 0)
+		{
+			changedBits >>= 1;
+			bit++;
+		}
+
+		value = (int) ((word >> bit) & 1);
+
+		for(position=incremental->firstPosition[bit]; 
+			position < incremental->firstPosition[bit+1];
+			position++)
+			string[incremental->position[position]] = 
+						incremental->symbol[value];
+
+		changedBits >>= 1;
+		bit++;
+	}
+}
 
 
-	/* set output file name */
+/* Set the name of an output file                                             */
+/*----------------------------------------------------------------------------*/
+/* OUT fileName: Name of the output file.                                     */
+/* IN fileNameBase: First part of the output file name. Depending on type and */
+/*                  mode "_program_data", "_verify_data", "_data",            */
+/*                  "_program_address", "_verify_address" or "_address" is    */
+/*                  appended to fileNameBase.                                 */
+/* IN type: DATA_STREAM or ADDRESS_STREAM.                                    */
+/* IN mode: PROGRAM, VERIFY or PROGRAM_VERIFY.                                */
+/*----------------------------------------------------------------------------*/
+void	setOutputFileName(char *fileName, char *fileNameBase, int type, 
+								int mode)
+{
 	strcpy(fileName, fileNameBase);
 	switch(mode)
 	{
 		case PROGRAM:
-		strcpy(fileName + strlen(fileName), "_program_address");
+		strcpy(fileName + strlen(fileName), "_program");
 		break;
 
 		case VERIFY:
-		strcpy(fileName + strlen(fileName), "_verify_address");
-		break;
-
-		case PROGRAM_VERIFY:
-		strcpy(fileName + strlen(fileName), "_address");
-		mode = PROGRAM; /* overwrite mode */
+		strcpy(fileName + strlen(fileName), "_verify");
 		break;
 
 		default:
 		break;
 	}
 
-	/* create file */
-	file = fopen(fileName, "w");
-	if(file == NULL)
+	if(type == DATA_STREAM)
+		strcpy(fileName + strlen(fileName), "_data");
+	else
+		strcpy(fileName + strlen(fileName), "_address");
+}
+
+
+/* Calculate the length of the output of one block                            */
+/*----------------------------------------------------------------------------*/
+/* The output of a block has a fixed length: the block addresses and all      */
+/* words of the block. If a line contains several words, the words are        */
+/* written without terminator and every line of the block (the last one may   */
+/* be shorter) is followed by the terminator.                                 */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN type: DATA_STREAM or ADDRESS_STREAM.                                    */
+/* IN mode: PROGRAM, VERIFY or PROGRAM_VERIFY.                                */
+/* IN format: Output format.                                                  */
+/* RETURNS: Length of the output of one block in bytes.                       */
+/*----------------------------------------------------------------------------*/
+size_t	calculateBlockLength(deviceData *device, int type, int mode, 
+							outputFormat *format)
+{
+	int wordLength;
+	size_t wordNum;
+	size_t length;
+	char buffer[MAX_OUTPUT_STRING_LENGTH];
+	outputFormat wordFormat;
+
+
+	if(mode == PROGRAM_VERIFY)
+		mode = PROGRAM;
+
+	wordFormat = *format;
+	if(format->wordsPerLine > 1)
+		wordFormat.terminatorLength = 0;
+
+	/* words of the block */
+	wordNum = device->blockSize / (device->wordLength/8);
+	if(type == DATA_STREAM)
+		wordLength = formatWordToOutputString(0, 
+				&device->wordBitOrder[mode], &wordFormat, buffer);
+	else
+		wordLength = formatWordToOutputString(0, 
+				&device->wordAddressBitOrder[mode], &wordFormat,
+								buffer);
+	length = wordNum * wordLength;
+
+	/* terminators of the lines */
+	if((format->wordsPerLine > 1) && (wordLength > 0))
+		length += (wordNum + format->wordsPerLine - 1) / 
+			format->wordsPerLine * format->terminatorLength;
+
+	/* block addresses */
+	if(type == ADDRESS_STREAM)
 	{
-		fprintf(stderr, "ERROR: Could not create file \"%s\"!\r\n",
-			fileName);
-		return EXIT_FAILURE;
+		length += formatWordToOutputString(0, 
+				&device->preDataBlockAddrBitOrder[mode], format,
+								buffer);
+		length += formatWordToOutputString(0, 
+				&device->postDataBlockAddrBitOrder[mode], format,
+								buffer);
 	}
 
-	/* write addesses to file */
-	byte = 0;
-	while(byte < device->memorySize)
+	return length;
+}
+
+
+/* Open an output stream                                                      */
+/*----------------------------------------------------------------------------*/
+/* Compile the bit orders of the stream and create its output file.           */
+/* OUT stream: Output stream to be opened.                                    */
+/* IN fileName: Name of the output file (see setOutputFileName).              */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN type: DATA_STREAM for program or verify data, ADDRESS_STREAM for        */
+/*          program or verify addresses.                                      */
+/* IN mode: If mode is PROGRAM, the program bit orders are used. If mode is   */
+/*          VERIFY, the verify bit orders are used. If mode is PROGRAM_VERIFY,*/
+/*          it will be assumed that the program and verify bit orders are     */
+/*          equal.                                                            */
+/* IN format: Output format (see formatWordToOutputString and                 */
+/*            calculateBlockLength).                                          */
+/* IN precompiled: Bit orders of the device compiled in advance or NULL (see  */
+/*                 compileDeviceBitOrder).                                    */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	openOutputStream(outputStream *stream, char *fileName, 
+		deviceData *device, int type, int mode, outputFormat *format,
+		precompiledBitOrders *precompiled)
+{
+	bitOrderRuns emptyBitOrder;
+	outputFormat wordFormat;
+
+
+	if(mode == PROGRAM_VERIFY)
+		mode = PROGRAM;
+
+	/* with several words per line the terminator is not part of the */
+	/* words, it is added by writeOutputBlock after every line */
+	wordFormat = *format;
+	stream->wordsPerLine = 1;
+	stream->terminatorLength = 0;
+	if(format->wordsPerLine > 1)
+	{
+		wordFormat.terminatorLength = 0;
+		stream->wordsPerLine = format->wordsPerLine;
+		memcpy(stream->terminator, format->terminator, 
+						format->terminatorLength);
+		stream->terminatorLength = format->terminatorLength;
+	}
+
+	/* compile the bit orders, data words have no block addresses */
+	stream->type = type;
+	emptyBitOrder.length = 0;
+	emptyBitOrder.runNum = 0;
+
+	if(type == DATA_STREAM)
+	{
+		if(compileDeviceBitOrder(&stream->wordBitOrder, 
+				&device->wordBitOrder[mode], device->wordLength,
+				&wordFormat, precompiled, WORD_BIT_ORDER, 
+						mode) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+
+		compileBitOrder(&stream->preBlockBitOrder, &emptyBitOrder, 0,
+									format);
+		compileBitOrder(&stream->postBlockBitOrder, &emptyBitOrder, 0,
+									format);
+	}
+	else
 	{
-		/* go to the next block if the current byte is the start */
-		/* of a new unused block */
-		if(((byte % device->blockSize) == 0) && 
-			(usedBlocks[byte / device->blockSize] == false) &&
-			(generateAllBlocks != true))
+		if(compileDeviceBitOrder(&stream->wordBitOrder, 
+				&device->wordAddressBitOrder[mode],
+				device->addressLength, &wordFormat, precompiled,
+				WORD_ADDRESS_BIT_ORDER, mode) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+
+		if(compileDeviceBitOrder(&stream->preBlockBitOrder, 
+				&device->preDataBlockAddrBitOrder[mode],
+				device->addressLength, format, precompiled,
+				PRE_BLOCK_BIT_ORDER, mode) != EXIT_SUCCESS)
 		{
-			byte = byte + device->blockSize;
+			disposeCompiledBitOrder(&stream->wordBitOrder);
+			return EXIT_FAILURE;
 		}
-		else
+
+		if(compileDeviceBitOrder(&stream->postBlockBitOrder, 
+				&device->postDataBlockAddrBitOrder[mode],
+				device->addressLength, format, precompiled,
+				POST_BLOCK_BIT_ORDER, mode) != EXIT_SUCCESS)
 		{
-			/* calculate address word */
-			addressWord = device->startAddress + (byte / 
-					(device->wordLength/8) *
-					device->addressStepPerWord);
+			disposeCompiledBitOrder(&stream->wordBitOrder);
+			disposeCompiledBitOrder(&stream->preBlockBitOrder);
+			return EXIT_FAILURE;
+		}
+	}
 
-			/* start of a new memory block... */
-			if((byte % device->blockSize) == 0)
-			{
-				/* save start address of block */
-				blockAddressWord = addressWord;
+	/* address words can be rendered incrementally */
+	stream->incremental = false;
+	if((type == ADDRESS_STREAM) && (compileIncrementalBitOrder(
+			&stream->incrementalOrder, 
+			&device->wordAddressBitOrder[mode], &wordFormat) == 
+							EXIT_SUCCESS))
+		stream->incremental = true;
 
-				/* write block address at the beginning */
-				/* of a new block to the file */
-				bufferLength = wordToOutputString(
-					blockAddressWord, 
-					device->preDataBlockAddrBitOrder[mode],
-					ascii, buffer);
+	/* empty words have no lines */
+	if(stream->wordBitOrder.length == 0)
+		stream->terminatorLength = 0;
 
-				writtenBytes = fwrite(buffer, sizeof(*buffer),
-							bufferLength, file);
+	/* the output of a block has a fixed length */
+	stream->blockLength = calculateBlockLength(device, type, mode, format);
 
-				if(writtenBytes != bufferLength)
-				{
-					fclose(file);
-					fprintf(stderr, "ERROR: Could not write"
-						"to file \"%s\"! (wrote %i "
-						"bytes)\r\n", fileName, 
-						writtenBytes);
-					return EXIT_FAILURE;
-				}
-			}
+	/* create file */
+	if(openOutputBuffer(&stream->output, fileName, stream->blockLength)
+							!= EXIT_SUCCESS)
+	{
+		disposeCompiledBitOrder(&stream->wordBitOrder);
+		disposeCompiledBitOrder(&stream->preBlockBitOrder);
+		disposeCompiledBitOrder(&stream->postBlockBitOrder);
+		return EXIT_FAILURE;
+	}
 
+	return EXIT_SUCCESS;
+}
 
-			/* write the address word to the file */
-			bufferLength = wordToOutputString(addressWord,
-					device->wordAddressBitOrder[mode],
-								ascii, buffer);
 
-			writtenBytes = fwrite(buffer, sizeof(*buffer),
-						bufferLength, file);
-			if(writtenBytes != bufferLength)
-			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Could not write to file"
-					" \"%s\"! (wrote %i bytes)\r\n",
-					fileName, writtenBytes);
-				return EXIT_FAILURE;
-			}
+/* Close an output stream                                                     */
+/*----------------------------------------------------------------------------*/
+/* The rest of the buffered output is written to the file.                    */
+/* IN stream: Output stream to close.                                         */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	closeOutputStream(outputStream *stream)
+{
+	disposeCompiledBitOrder(&stream->wordBitOrder);
+	disposeCompiledBitOrder(&stream->preBlockBitOrder);
+	disposeCompiledBitOrder(&stream->postBlockBitOrder);
 
-			/* increment byte */
-			byte = byte + device->wordLength / 8;
+	return closeOutputBuffer(&stream->output);
+}
 
 
-			/* end of a memory block... */
-			if((byte % device->blockSize) == 0)
-			{
-				/* write block address at the end */
-				/* of the old block to the file */
-				bufferLength = wordToOutputString(
-					blockAddressWord,
-					device->postDataBlockAddrBitOrder[mode],
-					ascii, buffer);
+/* Dispose an output stream without writing the buffered output               */
+/*----------------------------------------------------------------------------*/
+/* IN stream: Output stream to dispose.                                       */
+/*----------------------------------------------------------------------------*/
+void	disposeOutputStream(outputStream *stream)
+{
+	disposeCompiledBitOrder(&stream->wordBitOrder);
+	disposeCompiledBitOrder(&stream->preBlockBitOrder);
+	disposeCompiledBitOrder(&stream->postBlockBitOrder);
+	disposeOutputBuffer(&stream->output);
+}
 
-				writtenBytes = fwrite(buffer, sizeof(*buffer),
-							bufferLength, file);
 
-				if(writtenBytes != bufferLength)
-				{
-					fclose(file);
-					fprintf(stderr, "ERROR: Could not write"
-						"to file \"%s\"! (wrote %i "
-						"bytes)\r\n", fileName, 
-						writtenBytes);
-					return EXIT_FAILURE;
-				}
+/* Write a block to the output streams                                        */
+/*----------------------------------------------------------------------------*/
+/* Every data and address word of the block is put together once and          */
+/* rendered into all streams. The line terminators of streams with several    */
+/* words per line are added between the words.                                */
+/* IN streams: Opened output streams.                                         */
+/* IN streamNum: Number of streams.                                           */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN block: Number of the block.                                             */
+/* IN blockData: Data of the block (blockSize bytes).                         */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	writeOutputBlock(outputStream *streams, int streamNum, 
+		deviceData *device, uint32_64_t block, uint8_t *blockData)
+{
+	int i;
+	int stream;
+	int length;
+	int wordNum;
+	char *string[MAX_OUTPUT_STREAM_NUM];
+	char *previous[MAX_OUTPUT_STREAM_NUM];
+
+	uint32_64_t byte;
+	uint32_64_t word[2];
+	uint32_64_t blockAddressWord;
+	uint32_64_t previousAddressWord;
+
+
+	/* calculate start address of block */
+	byte = block * device->blockSize;
+	blockAddressWord = device->startAddress + (byte /
+			(device->wordLength/8) *
+			device->addressStepPerWord);
+
+	/* reserve the block in all streams and write the block */
+	/* address at the beginning of the block */
+	for(stream=0; stream < streamNum; stream++)
+	{
+		string[stream] = reserveOutputBuffer(&streams[stream].output,
+					streams[stream].blockLength);
+		if(string[stream] == NULL)
+			return EXIT_FAILURE;
+
+		string[stream] += compiledWordToOutputString(
+				&streams[stream].preBlockBitOrder,
+				blockAddressWord, string[stream]);
+	}
+
+	word[ADDRESS_STREAM] = blockAddressWord;
+	previousAddressWord = blockAddressWord;
+	wordNum = 0;
+	for(; byte < (block+1) * device->blockSize; 
+					byte += device->wordLength/8)
+	{
+		/* put together data word */
+		word[DATA_STREAM] = 0;
+		for(i=0; i < device->wordLength/8; i++)
+		{
+			word[DATA_STREAM] += ((uint32_64_t) blockData[byte - 
+				block * device->blockSize + i] << 8*i);
+		}
+
+		for(stream=0; stream < streamNum; stream++)
+		{
+			/* the first address of the block is rendered */
+			/* completely, the others are derived from the */
+			/* previous address */
+			length = streams[stream].wordBitOrder.length;
+			if((streams[stream].incremental == true) && 
+				(byte != block * device->blockSize))
+			{
+				memcpy(string[stream], previous[stream],
+								length);
+				updateOutputString(
+					&streams[stream].incrementalOrder,
+					previousAddressWord, 
+					word[ADDRESS_STREAM], string[stream]);
+			}
+			else
+				compiledWordToOutputString(
+					&streams[stream].wordBitOrder,
+					word[streams[stream].type], 
+					string[stream]);
+
+			previous[stream] = string[stream];
+			string[stream] += length;
+
+			/* end the line after wordsPerLine words and after */
+			/* the last word of the block */
+			if((streams[stream].terminatorLength > 0) &&
+				(((wordNum + 1) % streams[stream].wordsPerLine == 0) 
+				|| (byte + device->wordLength/8 >= 
+						(block+1) * device->blockSize)))
+			{
+				memcpy(string[stream], streams[stream].terminator,
+					streams[stream].terminatorLength);
+				string[stream] += streams[stream].terminatorLength;
 			}
 		}
+		wordNum++;
+
+		/* next address word */
+		previousAddressWord = word[ADDRESS_STREAM];
+		word[ADDRESS_STREAM] += device->addressStepPerWord;
 	}
 
-	/* close file */
-	fclose(file);
+	/* write block address at the end of the block */
+	for(stream=0; stream < streamNum; stream++)
+	{
+		compiledWordToOutputString(&streams[stream].postBlockBitOrder,
+					blockAddressWord, string[stream]);
+
+		streams[stream].output.length += streams[stream].blockLength;
+	}
 
 	return EXIT_SUCCESS;
 }
 
 
-/* Write a data file                                                          */
+/* Write the output streams                                                   */
 /*----------------------------------------------------------------------------*/
-/* Writes a file with program or verify data depending on the value of        */
-/* mode.                                                                      */
-/* IN fileNameBase: First part of the output file name. If mode is PROGRAM,   */
-/*                  "_program_data" is appended to fileNameBase. If mode is   */
-/*                  VERIFY, "_verify_data" is appended to fileNameBase. If    */
-/*                  mode is PROGRAM_VERIFY, "_data" is appended to            */
-/*                  fileNameBase.                                             */
+/* The memory is walked once and every block is written by writeOutputBlock.  */
+/* IN streams: Opened output streams.                                         */
+/* IN streamNum: Number of streams.                                           */
 /* IN device: Device structure that contains all needed information about the */
 /*            device.                                                         */
-/* IN programData: Byte array that contains the data.                         */
-/* IN usedBlocks: Array indicating whether a specific memory block is used or */
-/*                not.                                                        */
-/* IN mode: If mode is PROGRAM, the program bit order is used for generating  */
-/*          the data. If mode is VERIFY, the verify bit order is used.        */
-/*          If mode is PROGRAM_VERIFY, it will be assumed that the program and*/
-/*          verify bit orders are equal.                                      */
-/* IN ascii: If ascii is true, the output format will be a space separated    */
-/*           bit sequence (0 or 1 ascii symbols). If ascii is false, the      */
-/*           output format will be binary (one byte represents one bit).      */
+/* IN image: Memory image that contains the data. Its allocated blocks are the*/
+/*           used blocks (see findUsedBlocks).                                */
 /* IN generateAllBlocks: If generateAllBlocks is false, only used data blocks */
 /*                       are written to the output files. If generateAllBlocks*/
 /*                       is true, all data blocks will be written.            */
+/* IN firstBlock: First block to be written.                                  */
+/* IN endBlock: Block after the last block to be written.                     */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	writeDataFile(char *fileNameBase, deviceData *device,
-				uint8_t *programData, int *usedBlocks, int mode,
-				int ascii, int generateAllBlocks)
+int	writeOutputStreams(outputStream *streams, int streamNum, 
+			deviceData *device, memoryImage *image, 
+			int generateAllBlocks, uint32_64_t firstBlock, 
+			uint32_64_t endBlock)
 {
-	int i;
-	int writtenBytes;
-	int bufferLength;
-	char buffer[MAX_BIT_ORDER_LENGTH*2 + 3];
-	char fileName[FILENAME_MAX];
-	FILE *file;
+	uint32_64_t block;
 
-	uint32_64_t byte;
-	uint32_64_t dataWord;
 
+	for(block=firstBlock; block < endBlock; block++)
+	{
+		/* skip unused blocks without looking at them */
+		if((generateAllBlocks != true) && 
+			(memoryBlockIsAllocated(image, block) == false))
+			continue;
+
+		/* unused blocks read as 0xFF */
+		if(writeOutputBlock(streams, streamNum, device, block, 
+				getMemoryBlock(image, block)) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+	}
 
-	/* set output file name */
-	strcpy(fileName, fileNameBase);
-	switch(mode)
+	return EXIT_SUCCESS;
+}
+
+
+/* Run a conversion task                                                      */
+/*----------------------------------------------------------------------------*/
+/* Thread function writing the blocks of a task to the buffers of its         */
+/* streams. The buffers are flushed and disposed at the end.                  */
+/* IN argument: Conversion task (the result is stored in the task).           */
+/* RETURNS: NULL                                                              */
+/*----------------------------------------------------------------------------*/
+void	*runConversionTask(void *argument)
+{
+	int stream;
+	conversionTask *task;
+
+
+	task = (conversionTask *) argument;
+
+	task->result = writeOutputStreams(task->streams, task->streamNum,
+			task->device, task->image, task->generateAllBlocks, 
+			task->firstBlock, task->endBlock);
+
+	for(stream=0; stream < task->streamNum; stream++)
 	{
-		case PROGRAM:
-		strcpy(fileName + strlen(fileName), "_program_data");
-		break;
+		if(task->result == EXIT_SUCCESS)
+			task->result = closeOutputBuffer(
+					&task->streams[stream].output);
+		else
+			disposeOutputBuffer(&task->streams[stream].output);
+	}
 
-		case VERIFY:
-		strcpy(fileName + strlen(fileName), "_verify_data");
-		break;
+	return NULL;
+}
 
-		case PROGRAM_VERIFY:
-		strcpy(fileName + strlen(fileName), "_data");
-		mode = PROGRAM; /* overwrite mode */
-		break;
 
-		default:
-		break;
+/* Count the blocks written to the output files                               */
+/*----------------------------------------------------------------------------*/
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN image: Memory image that contains the data. Its allocated blocks are the*/
+/*           used blocks (see findUsedBlocks).                                */
+/* IN generateAllBlocks: If generateAllBlocks is true, all blocks are counted.*/
+/* RETURNS: Number of blocks written to the output files.                     */
+/*----------------------------------------------------------------------------*/
+uint32_64_t	countOutputBlocks(deviceData *device, memoryImage *image, 
+							int generateAllBlocks)
+{
+	uint32_64_t block;
+	uint32_64_t blockNum;
+	uint32_64_t usedBlockNum;
+
+
+	blockNum = device->memorySize / device->blockSize;
+	if(generateAllBlocks == true)
+		return blockNum;
+
+	usedBlockNum = 0;
+	for(block=0; block < blockNum; block++)
+	{
+		if(memoryBlockIsAllocated(image, block) == true)
+			usedBlockNum++;
 	}
 
-	/* create file */
-	file = fopen(fileName, "w");
-	if(file == NULL)
+	return usedBlockNum;
+}
+
+
+/* Write the output streams with several threads                              */
+/*----------------------------------------------------------------------------*/
+/* The used blocks are split into threadNum ranges of about the same size.    */
+/* The output of every block has a fixed length, so the file position of each */
+/* range is known in advance. Every thread renders its range into its own     */
+/* buffers and writes them at these positions, so the files are the same as   */
+/* the ones written by writeOutputStreams.                                    */
+/* IN streams: Opened output streams (nothing written so far).                */
+/* IN streamNum: Number of streams.                                           */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN image: Memory image that contains the data. Its allocated blocks are the*/
+/*           used blocks (see findUsedBlocks).                                */
+/* IN generateAllBlocks: If generateAllBlocks is false, only used data blocks */
+/*                       are written to the output files. If generateAllBlocks*/
+/*                       is true, all data blocks will be written.            */
+/* IN threadNum: Number of threads to be used.                                */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	writeOutputStreamsParallel(outputStream *streams, int streamNum,
+			deviceData *device, memoryImage *image, 
+			int generateAllBlocks, int threadNum)
+{
+	int task;
+	int stream;
+	int result;
+	int *threadStarted;
+	pthread_t *threads;
+	conversionTask *tasks;
+
+	uint32_64_t block;
+	uint32_64_t blockNum;
+	uint32_64_t usedBlockNum;
+	uint32_64_t usedBlocksBefore;
+
+
+	/* count the used blocks */
+	blockNum = device->memorySize / device->blockSize;
+	usedBlockNum = countOutputBlocks(device, image, generateAllBlocks);
+
+	/* every thread gets at least one block */
+	if((uint32_64_t) threadNum > usedBlockNum)
+		threadNum = (int) usedBlockNum;
+
+	if(threadNum <= 1)
+		return writeOutputStreams(streams, streamNum, device, image,
+				generateAllBlocks, 0, blockNum);
+
+	tasks = malloc(threadNum * sizeof(*tasks));
+	threads = malloc(threadNum * sizeof(*threads));
+	threadStarted = malloc(threadNum * sizeof(*threadStarted));
+	if(tasks == NULL || threads == NULL || threadStarted == NULL)
 	{
-		fprintf(stderr, "ERROR: Could not create file \"%s\"!\r\n",
-			fileName);
+		free(tasks);
+		free(threads);
+		free(threadStarted);
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
 		return EXIT_FAILURE;
 	}
 
-
-	/* write data to file */
-	byte = 0;
-	while(byte < device->memorySize)
+	/* split the used blocks and calculate the file positions */
+	result = EXIT_SUCCESS;
+	task = 0;
+	usedBlocksBefore = 0;
+	for(block=0; block < blockNum; block++)
 	{
-		/* go to the next block if the current byte is the start */
-		/* of a new unused block */
-		if(((byte % device->blockSize) == 0) &&
-			(usedBlocks[byte / device->blockSize] == false) &&
-			(generateAllBlocks != true))
-		{
-			byte = byte + device->blockSize;
-		}
-		else
+		/* start the next task at this block */
+		if((task < threadNum) && 
+			(usedBlocksBefore == usedBlockNum * task / threadNum))
 		{
-			/* put together data word */
-			dataWord = 0;
-			for(i=0; i < device->wordLength/8; i++)
+			tasks[task].streamNum = streamNum;
+			tasks[task].device = device;
+			tasks[task].image = image;
+			tasks[task].generateAllBlocks = generateAllBlocks;
+			tasks[task].firstBlock = block;
+			tasks[task].result = EXIT_FAILURE;
+			if(task > 0)
+				tasks[task-1].endBlock = block;
+
+			/* the bit orders are shared, the buffers are not */
+			for(stream=0; stream < streamNum; stream++)
 			{
-				dataWord += (programData[byte+i] << 8*i);
+				tasks[task].streams[stream] = streams[stream];
+
+				if(shareOutputBuffer(
+					&tasks[task].streams[stream].output,
+					&streams[stream].output,
+					streams[stream].blockLength,
+					streams[stream].output.offset +
+					usedBlocksBefore * 
+					streams[stream].blockLength) != 
+								EXIT_SUCCESS)
+				{
+					tasks[task].streamNum = stream;
+					result = EXIT_FAILURE;
+					break;
+				}
 			}
 
-			/* write the data word to the file */
-			bufferLength = wordToOutputString(dataWord,
-						device->wordBitOrder[mode],
-						ascii, buffer);
-			writtenBytes = fwrite(buffer, sizeof(*buffer),
-						bufferLength, file);
-			if(writtenBytes != bufferLength)
-			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Could not write to file"
-					" \"%s\"! (wrote %i bytes)\r\n", 
-					fileName, writtenBytes);
-				return EXIT_FAILURE;
-			}
+			task++;
+			if(result != EXIT_SUCCESS)
+				break;
+		}
 
-			byte = byte + device->wordLength/8;
+		if((generateAllBlocks == true) || 
+				(memoryBlockIsAllocated(image, block) == true))
+			usedBlocksBefore++;
+	}
+	tasks[threadNum-1].endBlock = blockNum;
+
+	/* dispose the buffers shared so far */
+	if(result != EXIT_SUCCESS)
+	{
+		while(task > 0)
+		{
+			task--;
+			for(stream=0; stream < tasks[task].streamNum; stream++)
+				disposeOutputBuffer(
+					&tasks[task].streams[stream].output);
 		}
+
+		free(tasks);
+		free(threads);
+		free(threadStarted);
+		return EXIT_FAILURE;
 	}
 
-	/* close file */
-	fclose(file);
+	/* run the tasks (in this thread if a thread can't be created) */
+	for(task=0; task < threadNum; task++)
+	{
+		threadStarted[task] = (pthread_create(&threads[task], NULL,
+				runConversionTask, &tasks[task]) == 0);
+
+		if(threadStarted[task] != true)
+			runConversionTask(&tasks[task]);
+	}
+
+	/* wait for all threads */
+	for(task=0; task < threadNum; task++)
+	{
+		if(threadStarted[task] == true)
+			pthread_join(threads[task], NULL);
+
+		if(tasks[task].result != EXIT_SUCCESS)
+			result = EXIT_FAILURE;
+
+		for(stream=0; stream < tasks[task].streamNum; stream++)
+			addOutputStatistics(&streams[stream].output, 
+					&tasks[task].streams[stream].output);
+	}
+
+	/* the output of the streams ends after all blocks */
+	for(stream=0; stream < streamNum; stream++)
+		streams[stream].output.offset += usedBlockNum * 
+						streams[stream].blockLength;
+
+	free(tasks);
+	free(threads);
+	free(threadStarted);
+
+	return result;
+}
+
+
+/* Initialize the options of the output generation                            */
+/*----------------------------------------------------------------------------*/
+/* OUT options: Options to be set to their default values.                    */
+/*----------------------------------------------------------------------------*/
+void	initializeOutputOptions(outputOptions *options)
+{
+	initializeOutputFormat(&options->format, ASCII_OUTPUT);
+	options->generateAllBlocks = false;
+	options->recordCoverage = false;
+	options->threadNum = 1;
+	strcpy(options->cacheDirectory, "");
+	options->mapOutput = false;
+	options->queueOutput = false;
+	options->uncacheOutput = false;
+	options->printStatistics = false;
+	options->precompiled = NULL;
+}
+
+
+/* Check if the output can be generated for a device                          */
+/*----------------------------------------------------------------------------*/
+/* The output is generated block by block and word by word, so the memory     */
+/* size must be a multiple of the block size and the block size must be a     */
+/* multiple of the word size.                                                 */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* RETURNS: EXIT_FAILURE if the output can't be generated, EXIT_SUCCESS       */
+/*          otherwise.                                                        */
+/*----------------------------------------------------------------------------*/
+int	checkOutputLayout(deviceData *device)
+{
+	if((device->wordLength < 8) || (device->blockSize < 1) ||
+		(device->blockSize % (device->wordLength/8) != 0) ||
+		(device->memorySize % device->blockSize != 0))
+	{
+		fprintf(stderr, "ERROR: The memory size must be a multiple of "
+			"the block size and the block size must be a multiple "
+			"of the word size!\r\n");
+		return EXIT_FAILURE;
+	}
 
 	return EXIT_SUCCESS;
 }
 
 
-/* Write all output files                                                     */
+/* Open all output files                                                      */
 /*----------------------------------------------------------------------------*/
-/* Four files will be generated by default.                                   */
+/* Four files will be opened by default.                                      */
 /* (program data, program address, verify data, verify address)               */
-/* If the PROGRAM and VERIFY bit orders are equal the function generates just */
-/* two files.                                                                 */
+/* If the PROGRAM and VERIFY bit orders are equal the function opens just two */
+/* files. Address files copied from the cache are not opened. If the output   */
+/* is mapped (see outputOptions), the files get their final size and are      */
+/* mapped if the image is known, the data is buffered if this fails. The other */
+/* files are kept out of the page cache and their writes are queued if this   */
+/* is selected and supported.                                                 */
 /* IN fileNameBase: First part of the output file names.                      */
 /* IN device: Device structure that contains all needed information about the */
 /*            device.                                                         */
-/* IN programData: Byte array that contains the data.                         */
-/* IN ascii: If ascii is true, the output format will be a space separated    */
-/*           bit sequence (0 or 1 ascii symbols). If ascii is false, the      */
-/*           output format will be binary (one byte represents one bit).      */
-/* IN generateAllBlocks: If generateAllBlocks is false, only used data blocks */
-/*                       are written to the output files. If generateAllBlocks*/
-/*                       is true, all data blocks will be written.            */
+/* IN image: Memory image that contains the data or NULL if the used blocks   */
+/*           are not known in advance (the cache is not used then).           */
+/* IN options: Options of the output generation (see outputOptions).          */
+/* OUT streams: Opened output streams.                                        */
+/* OUT openedStreamNum: Number of opened streams.                             */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	generateOutputFiles(char *fileNameBase, deviceData *device, 
-					uint8_t *programData, int ascii,
-					int generateAllBlocks)
+int	openOutputFiles(char *fileNameBase, deviceData *device, 
+			memoryImage *image, outputOptions *options, 
+			outputStream *streams, int *openedStreamNum)
 {
 	int bitOrdersEqual;
-	int *usedBlocks;
+	int stream;
+	int streamNum;
+	int cachedStreamNum;
+	uint32_64_t usedBlockNum;
+	int type[MAX_OUTPUT_STREAM_NUM];
+	int mode[MAX_OUTPUT_STREAM_NUM];
+	char fileName[FILENAME_MAX];
+
+
+	*openedStreamNum = 0;
 
+	/* the output is generated block by block and word by word */
+	if(checkOutputLayout(device) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
 
-	usedBlocks = malloc(device->memorySize/device->blockSize);
-	if(usedBlocks == NULL)
+	/* the blocks of the image must be the blocks of the device */
+	if((image != NULL) && (image->blockSize != device->blockSize))
 	{
-		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		fprintf(stderr, "ERROR: The memory image doesn't match the "
+			"device!\r\n");
 		return EXIT_FAILURE;
 	}
 
-	/* find used blocks */
-	if(generateAllBlocks != true)
-		findUsedBlocks(device, programData, usedBlocks);
-
 	/* check if program and verify bit orders are equal */
 	bitOrdersEqual = programAndVerfiyBitOrdersAreEqual(device);
 
-	/* write data files */
+	/* select the streams (data files first, then address files) */
+	streamNum = 0;
 	if(bitOrdersEqual == true)
 	{
-		if(writeDataFile(fileNameBase, device, programData,
-					usedBlocks, PROGRAM_VERIFY, ascii,
-					generateAllBlocks) == EXIT_FAILURE)
-			return EXIT_FAILURE;
+		type[streamNum] = DATA_STREAM;
+		mode[streamNum++] = PROGRAM_VERIFY;
+		type[streamNum] = ADDRESS_STREAM;
+		mode[streamNum++] = PROGRAM_VERIFY;
 	}
 	else
 	{
-		if(writeDataFile(fileNameBase, device, programData, 
-					usedBlocks, PROGRAM, ascii,
-					generateAllBlocks) == EXIT_FAILURE)
-			return EXIT_FAILURE;
+		type[streamNum] = DATA_STREAM;
+		mode[streamNum++] = PROGRAM;
+		type[streamNum] = DATA_STREAM;
+		mode[streamNum++] = VERIFY;
+		type[streamNum] = ADDRESS_STREAM;
+		mode[streamNum++] = PROGRAM;
+		type[streamNum] = ADDRESS_STREAM;
+		mode[streamNum++] = VERIFY;
+	}
 
-		if(writeDataFile(fileNameBase, device, programData,
-					usedBlocks, VERIFY, ascii,
-					generateAllBlocks) == EXIT_FAILURE)
-			return EXIT_FAILURE;
+	/* copy the address files from the cache, the address streams are */
+	/* generated as usual if this fails */
+	if((image != NULL) && (strcmp(options->cacheDirectory, "") != 0))
+	{
+		cachedStreamNum = 0;
+		for(stream=streamNum-1; (stream >= 0) && 
+				(type[stream] == ADDRESS_STREAM); stream--)
+		{
+			setOutputFileName(fileName, fileNameBase, type[stream],
+								mode[stream]);
+			if(writeCachedAddressFile(options->cacheDirectory, 
+					fileName, device, image, 
+					mode[stream], options) == EXIT_SUCCESS)
+				cachedStreamNum++;
+			else
+				break;
+		}
+
+		/* cached streams are at the end of the stream list */
+		streamNum -= cachedStreamNum;
 	}
 
-	/* write address files */
-	if(bitOrdersEqual == true)
+	/* open all streams */
+	for(stream=0; stream < streamNum; stream++)
 	{
-		if(writeAddressFile(fileNameBase, device, usedBlocks,
-					PROGRAM_VERIFY, ascii,
-					generateAllBlocks) == EXIT_FAILURE)
+		setOutputFileName(fileName, fileNameBase, type[stream], 
+								mode[stream]);
+		if(openOutputStream(&streams[stream], fileName, device,
+				type[stream], mode[stream], &options->format,
+				options->precompiled) != EXIT_SUCCESS)
+		{
+			/* dispose the streams opened so far */
+			while(stream > 0)
+				disposeOutputStream(&streams[--stream]);
 			return EXIT_FAILURE;
+		}
 	}
-	else
+
+	/* the size of the files is known if the used blocks are known */
+	if((image != NULL) && (options->mapOutput == true))
 	{
-		if(writeAddressFile(fileNameBase, device, usedBlocks,
-					PROGRAM, ascii,
-					generateAllBlocks) == EXIT_FAILURE)
-			return EXIT_FAILURE;
+		usedBlockNum = countOutputBlocks(device, image, 
+						options->generateAllBlocks);
+		for(stream=0; stream < streamNum; stream++)
+			mapOutputBuffer(&streams[stream].output, usedBlockNum *
+						streams[stream].blockLength);
+	}
 
-		if(writeAddressFile(fileNameBase, device, usedBlocks,
-					VERIFY, ascii,
-					generateAllBlocks) == EXIT_FAILURE)
-			return EXIT_FAILURE;
+	/* the page cache is used if O_DIRECT and posix_fadvise aren't */
+	/* available, pwrite is used if io_uring isn't available */
+	for(stream=0; stream < streamNum; stream++)
+	{
+		if(streams[stream].output.map != NULL)
+			continue;
+
+		if(options->uncacheOutput == true)
+			uncacheOutputBuffer(&streams[stream].output);
+		if(options->queueOutput == true)
+			queueOutputBuffer(&streams[stream].output);
 	}
 
+	*openedStreamNum = streamNum;
 	return EXIT_SUCCESS;
 }
 
+
+/* Print the statistics of the output files                                   */
+/*----------------------------------------------------------------------------*/
+/* IN streams: Output streams (may be closed already).                        */
+/* IN streamNum: Number of streams.                                           */
+/*----------------------------------------------------------------------------*/
+void	printOutputStatistics(outputStream *streams, int streamNum)
+{
+	int stream;
+
+
+	for(stream=0; stream < streamNum; stream++)
+		printOutputBufferStatistics(&streams[stream].output);
+}
+
+
+/* Close all output files                                                     */
+/*----------------------------------------------------------------------------*/
+/* The streams are flushed and closed if the output has been written          */
+/* successfully, otherwise they are just disposed.                            */
+/* INOUT streams: Output streams opened by openOutputFiles.                   */
+/* IN streamNum: Number of streams.                                           */
+/* IN options: Options of the output generation (see outputOptions).          */
+/* IN result: Result of writing the output.                                   */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	closeOutputFiles(outputStream *streams, int streamNum, 
+				outputOptions *options, int result)
+{
+	int stream;
+
+
+	for(stream=streamNum-1; stream >= 0; stream--)
+	{
+		if(result == EXIT_SUCCESS)
+			result = closeOutputStream(&streams[stream]);
+		else
+			disposeOutputStream(&streams[stream]);
+	}
+
+	if((result == EXIT_SUCCESS) && (options->printStatistics == true))
+		printOutputStatistics(streams, streamNum);
+
+	return result;
+}
+
+
+/* Write all output files                                                     */
+/*----------------------------------------------------------------------------*/
+/* Four files will be generated by default.                                   */
+/* (program data, program address, verify data, verify address)               */
+/* If the PROGRAM and VERIFY bit orders are equal the function generates just */
+/* two files.                                                                 */
+/* IN fileNameBase: First part of the output file names.                      */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN image: Memory image that contains the data. Its allocated blocks are the*/
+/*           used blocks (see findUsedBlocks).                                */
+/* IN options: Options of the output generation (see outputOptions).          */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	generateOutputFiles(char *fileNameBase, deviceData *device, 
+			memoryImage *image, outputOptions *options)
+{
+	int result;
+	int streamNum;
+	outputStream streams[MAX_OUTPUT_STREAM_NUM];
+
+
+	if(openOutputFiles(fileNameBase, device, image, options, streams, 
+						&streamNum) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* write all streams in a single pass */
+	result = writeOutputStreamsParallel(streams, streamNum, device, image,
+			options->generateAllBlocks, options->threadNum);
+
+	return closeOutputFiles(streams, streamNum, options, result);
+}
@@ -45,8 +45,210 @@
 #define _CONVERTER_H
 
 #include "device-description.h"
+#include "bit-expansion.h"
+#include "output-buffer.h"
+#include "memory-image.h"
+#include "used-blocks.h"
+#include <pthread.h>
 
 
-extern	int	generateOutputFiles(char *, deviceData *, uint8_t *, int, int);
+/* maximum length of one rendered word (bits, separators and terminator) */
+#define MAX_OUTPUT_STRING_LENGTH	(MAX_BIT_ORDER_LENGTH * \
+			(1 + MAX_SEPARATOR_LENGTH) + MAX_TERMINATOR_LENGTH + 1)
+
+/* number of 64 bit chunks needed to hold one rendered word */
+#define MAX_OUTPUT_CHUNK_NUM	((MAX_OUTPUT_STRING_LENGTH + 7) / 8)
+
+/* cost of expanding a run of a bit order compared to or-ing a 64 bit */
+/* chunk of a table (see compileBitOrder) */
+#define RUN_EXPANSION_COST	16
+
+
+/* datatype for a bit order compiled into per byte lookup tables */
+typedef struct
+{
+	/* length of one rendered word in bytes */
+	int length;
+	int chunkNum;
+
+	/* positions of the word bytes the output depends on */
+	int byteNum;
+	int bytePosition[sizeof(uint32_64_t)];
+
+	/* rendering of a cleared word and the differences of the rendered */
+	/* output fragments to it ([byteNum][256][chunkNum]), the tables are */
+	/* freed by disposeCompiledBitOrder if they are owned */
+	uint64_t base[MAX_OUTPUT_CHUNK_NUM];
+	uint64_t *fragments;
+	int ownsFragments;
+
+	/* expansion of byte aligned bit orders or of the runs of a bit */
+	/* order (replaces the tables) */
+	bitExpansion expansion;
+}
+compiledBitOrder;
+
+
+/* datatype for a bit order compiled for incremental rendering */
+typedef struct
+{
+	/* symbols of 0 and 1 bits */
+	char symbol[2];
+
+	/* output positions of the bits ([firstPosition[bit]] up to, but */
+	/* not including [firstPosition[bit+1]]) */
+	int firstPosition[MAX_WORD_LENGTH64 + 1];
+	int position[MAX_BIT_ORDER_LENGTH];
+}
+incrementalBitOrder;
+
+
+/* kinds of the bit orders of a device */
+enum {WORD_BIT_ORDER, WORD_ADDRESS_BIT_ORDER, PRE_BLOCK_BIT_ORDER, 
+					POST_BLOCK_BIT_ORDER, BIT_ORDER_KIND_NUM};
+
+
+/* datatype for the bit orders of a device compiled in advance */
+typedef struct
+{
+	/* format the bit orders have been compiled for */
+	outputFormat format;
+
+	/* compiled bit orders ([kind][PROGRAM or VERIFY]), only the ones */
+	/* marked as available are used, their tables are not owned */
+	int available[BIT_ORDER_KIND_NUM][2];
+	compiledBitOrder bitOrder[BIT_ORDER_KIND_NUM][2];
+}
+precompiledBitOrders;
+
+
+/* stream types */
+enum {DATA_STREAM, ADDRESS_STREAM};
+
+/* maximum number of output streams (data and address for program and verify) */
+#define MAX_OUTPUT_STREAM_NUM	4
+
+
+/* datatype for an output file generated block by block */
+typedef struct
+{
+	/* DATA_STREAM or ADDRESS_STREAM */
+	int type;
+
+	/* length of the output of one block in bytes */
+	size_t blockLength;
+
+	/* bit orders of the words and of the block addresses */
+	compiledBitOrder wordBitOrder;
+	compiledBitOrder preBlockBitOrder;
+	compiledBitOrder postBlockBitOrder;
+
+	/* incremental rendering of address words (if incremental is true) */
+	int incremental;
+	incrementalBitOrder incrementalOrder;
+
+	/* terminator added after every line (if a line has several words) */
+	int wordsPerLine;
+	char terminator[MAX_TERMINATOR_LENGTH];
+	int terminatorLength;
+
+	outputBuffer output;
+}
+outputStream;
+
+
+/* datatype for the options of the output generation */
+typedef struct
+{
+	/* layout of the output files */
+	outputFormat format;
+
+	/* write unused blocks too */
+	int generateAllBlocks;
+
+	/* blocks written by hex records are used, even if they are blank */
+	int recordCoverage;
+
+	/* number of threads used for the conversion */
+	int threadNum;
+
+	/* directory of the address cache ("" if no cache is used) */
+	char cacheDirectory[FILENAME_MAX];
+
+	/* render into memory mappings of the output files */
+	int mapOutput;
+
+	/* write the output files with queued asynchronous writes */
+	int queueOutput;
+
+	/* keep the output files out of the page cache */
+	int uncacheOutput;
+
+	/* print how the output files have been written */
+	int printStatistics;
+
+	/* bit orders compiled in advance (NULL if there are none) */
+	precompiledBitOrders *precompiled;
+}
+outputOptions;
+
+
+/* datatype for a range of blocks converted by one thread */
+typedef struct
+{
+	/* streams sharing the bit orders and files of the output streams */
+	outputStream streams[MAX_OUTPUT_STREAM_NUM];
+	int streamNum;
+
+	deviceData *device;
+	memoryImage *image;
+	int generateAllBlocks;
+
+	/* blocks to convert (firstBlock up to, but not including endBlock) */
+	uint32_64_t firstBlock;
+	uint32_64_t endBlock;
+
+	int result;
+}
+conversionTask;
+
+
+extern	void	findUsedBlocks(memoryImage *);
+extern	int	formatWordToOutputString(uint32_64_t, bitOrderRuns *, 
+						outputFormat *, char *);
+extern	int	wordToOutputString(uint32_64_t, bitOrderRuns *, int, char *);
+extern	int	compileBitOrder(compiledBitOrder *, bitOrderRuns *, int, 
+							outputFormat *);
+extern	int	compileDeviceBitOrder(compiledBitOrder *, bitOrderRuns *, int, 
+			outputFormat *, precompiledBitOrders *, int, int);
+extern	void	disposeCompiledBitOrder(compiledBitOrder *);
+extern	int	compiledWordToOutputString(compiledBitOrder *, uint32_64_t,
+						char *);
+extern	int	compileIncrementalBitOrder(incrementalBitOrder *, 
+					bitOrderRuns *, outputFormat *);
+extern	void	updateOutputString(incrementalBitOrder *, uint32_64_t, uint32_64_t,
+								char *);
+extern	void	setOutputFileName(char *, char *, int, int);
+extern	size_t	calculateBlockLength(deviceData *, int, int, outputFormat *);
+extern	int	openOutputStream(outputStream *, char *, deviceData *, int, int,
+					outputFormat *, precompiledBitOrders *);
+extern	int	closeOutputStream(outputStream *);
+extern	void	disposeOutputStream(outputStream *);
+extern	int	writeOutputBlock(outputStream *, int, deviceData *, uint32_64_t,
+							uint8_t *);
+extern	int	writeOutputStreams(outputStream *, int, deviceData *, 
+				memoryImage *, int, uint32_64_t, uint32_64_t);
+extern	void	*runConversionTask(void *);
+extern	int	writeOutputStreamsParallel(outputStream *, int, deviceData *,
+						memoryImage *, int, int);
+extern	uint32_64_t	countOutputBlocks(deviceData *, memoryImage *, int);
+extern	void	initializeOutputOptions(outputOptions *);
+extern	int	checkOutputLayout(deviceData *);
+extern	int	openOutputFiles(char *, deviceData *, memoryImage *,
+				outputOptions *, outputStream *, int *);
+extern	void	printOutputStatistics(outputStream *, int);
+extern	int	closeOutputFiles(outputStream *, int, outputOptions *, int);
+extern	int	generateOutputFiles(char *, deviceData *, memoryImage *,
+							outputOptions *);
 
 #endif /* _CONVERTER_H */
@@ -66,9 +66,30 @@ typedef struct
 	uint8_t addressLength;
 
 	/* data and address bit orders ([2] -> program and verify) */
-	int8_t wordBitOrder[2][MAX_BIT_ORDER_LENGTH];
-	int8_t wordAddressBitOrder[2][MAX_BIT_ORDER_LENGTH];
-	int8_t preDataBlockAddrBitOrder[2][MAX_BIT_ORDER_LENGTH];
-	int8_t postDataBlockAddrBitOrder[2][MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns wordBitOrder[2];
+	bitOrderRuns wordAddressBitOrder[2];
+	bitOrderRuns preDataBlockAddrBitOrder[2];
+	bitOrderRuns postDataBlockAddrBitOrder[2];
 } deviceData;
 
+
+/* Datatype for device description files (version 1)                          */
+/*----------------------------------------------------------------------------*/
+/* The files contain this structure as a whole, the bit orders are stored as  */
+/* arrays with one entry per output bit (see saveDeviceDescription).          */
+/*----------------------------------------------------------------------------*/
+typedef struct
+{
+	char name[MAX_DEVICE_NAME_LENGTH];
+	uint32_64_t memorySize;
+	uint32_64_t blockSize;
+	uint32_64_t startAddress;
+	uint8_t addressStepPerWord;
+	uint8_t wordLength;
+	uint8_t addressLength;
+	int8_t wordBitOrder[2][MAX_FILE_BIT_ORDER_LENGTH];
+	int8_t wordAddressBitOrder[2][MAX_FILE_BIT_ORDER_LENGTH];
+	int8_t preDataBlockAddrBitOrder[2][MAX_FILE_BIT_ORDER_LENGTH];
+	int8_t postDataBlockAddrBitOrder[2][MAX_FILE_BIT_ORDER_LENGTH];
+} deviceFileData;
+
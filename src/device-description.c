@@ -42,6 +42,7 @@
 
 
 #include "device-description.h"
+#include "bit-runs.h"
 
 
 /* version of deviceData for checking compatibility with files */
@@ -53,58 +54,51 @@ const uint8_t maxWordLength = sizeof(uint32_64_t)*8;
 
 /* Get the length of a BitOrder.                                              */
 /*----------------------------------------------------------------------------*/
-/* This function searches for the first unused bit and returns its index + 1. */
-/* IN bitOrder: Array whose length to be returned.                            */
-/* RETURNS: Length of the bit order.                                          */
+/* IN bitOrder: Bit order whose length to be returned.                        */
+/* RETURNS: Number of output bits of the bit order.                           */
 /*----------------------------------------------------------------------------*/
-uint8_t	bitOrderLength(int8_t *bitOrder)
+int	bitOrderLength(bitOrderRuns *bitOrder)
 {
-	uint8_t length;
-
-
-	length = 0;
-	while((length<MAX_BIT_ORDER_LENGTH) && (bitOrder[length] != UNUSED_BIT))
-		length++;
-
-	return length;
+	return bitOrder->length;
 }
 
 
 /* Check whether a BitOrder is completely empty or not.                       */
 /*----------------------------------------------------------------------------*/
-/* IN bitOrder: Array to check if it is empty.                                */
-/* RETURNS: true if the first element of the array are set to UNUSED_BIT,     */ 
-/*          false otherwise.                                                  */
+/* IN bitOrder: Bit order to check if it is empty.                            */
+/* RETURNS: true if the bit order has no bits, false otherwise.               */
 /*----------------------------------------------------------------------------*/
-int	bitOrderIsEmpty(int8_t *bitOrder)
+int	bitOrderIsEmpty(bitOrderRuns *bitOrder)
 {
-	if(bitOrder[0] == UNUSED_BIT)
+	if(bitOrder->length == 0)
 		return true;
 	else
 		return false;
 }
 
 
-/* Check whether two BitOrder arrays are equal or not.                        */
+/* Check whether two BitOrders are equal or not.                              */
 /*----------------------------------------------------------------------------*/
-/* IN bitOrder1: Array to compare                                             */
-/* IN bitOrder2: Array to compare                                             */
+/* The bit orders are compared bit by bit, so the same bits described by      */
+/* different runs (e.g. with or without a repeat) are equal.                  */
+/* IN bitOrder1: Bit order to compare                                         */
+/* IN bitOrder2: Bit order to compare                                         */
 /* RETURNS: true if the bit orders are equal, false otherwise.                */
 /*----------------------------------------------------------------------------*/
-int	bitOrdersAreEqual(int8_t *bitOrder1, int8_t *bitOrder2)
+int	bitOrdersAreEqual(bitOrderRuns *bitOrder1, bitOrderRuns *bitOrder2)
 {
-	int i;
+	int8_t bits1[MAX_BIT_ORDER_LENGTH];
+	int8_t bits2[MAX_BIT_ORDER_LENGTH];
 
 
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
-	{
-		/* compare bit by bit */
-		if(bitOrder1[i] != bitOrder2[i])
-		{
-			printf("Index: %i\t %i\t %i\r\n", i, bitOrder1[i], bitOrder2[i]);
-			return false;
-		}
-	}
+	if(bitOrder1->length != bitOrder2->length)
+		return false;
+
+	/* compare bit by bit */
+	expandBitOrderRuns(bitOrder1, bits1, MAX_BIT_ORDER_LENGTH);
+	expandBitOrderRuns(bitOrder2, bits2, MAX_BIT_ORDER_LENGTH);
+	if(memcmp(bits1, bits2, bitOrder1->length) != 0)
+		return false;
 
 	return true;
 }
@@ -118,55 +112,36 @@ int	bitOrdersAreEqual(int8_t *bitOrder1, int8_t *bitOrder2)
 /*----------------------------------------------------------------------------*/
 int	programAndVerfiyBitOrdersAreEqual(deviceData *device)
 {
-	int bitOrdersAreEqual;
-	int i;
-
-
-	/* loop till the end of the arrays is reached */
-	/* or till a difference is found */
-	i=0;
-	bitOrdersAreEqual = true;
-	while((i < MAX_BIT_ORDER_LENGTH) && (bitOrdersAreEqual == true))
-	{
-		if(device->wordBitOrder[PROGRAM][i] != 
-						device->wordBitOrder[VERIFY][i])
-			bitOrdersAreEqual = false;
-		
-		if(device->wordAddressBitOrder[PROGRAM][i] != 
-					device->wordAddressBitOrder[VERIFY][i])
-			bitOrdersAreEqual = false;
-
-		if(device->preDataBlockAddrBitOrder[PROGRAM][i] != 
-				device->preDataBlockAddrBitOrder[VERIFY][i])
-			bitOrdersAreEqual = false;
-
-		if(device->postDataBlockAddrBitOrder[PROGRAM][i] != 
-				device->postDataBlockAddrBitOrder[VERIFY][i])
-			bitOrdersAreEqual = false;
-
-		i++;
-	}
-
-	return bitOrdersAreEqual;
+	return (bitOrdersAreEqual(&device->wordBitOrder[PROGRAM], 
+				&device->wordBitOrder[VERIFY]) == true) &&
+		(bitOrdersAreEqual(&device->wordAddressBitOrder[PROGRAM], 
+			&device->wordAddressBitOrder[VERIFY]) == true) &&
+		(bitOrdersAreEqual(&device->preDataBlockAddrBitOrder[PROGRAM], 
+			&device->preDataBlockAddrBitOrder[VERIFY]) == true) &&
+		(bitOrdersAreEqual(&device->postDataBlockAddrBitOrder[PROGRAM],
+			&device->postDataBlockAddrBitOrder[VERIFY]) == true);
 }
 
 
-/* Print a BitOrder array                                                     */
+/* Print a BitOrder                                                           */
 /*----------------------------------------------------------------------------*/
-/* Print the content of the complete array.                                   */
-/* IN bitOrder: Array to print                                                */
+/* Print the bits of the complete bit order.                                  */
+/* IN runs: Bit order to print                                                */
 /*----------------------------------------------------------------------------*/
-void	printBitOrder(int8_t bitOrder[])
+void	printBitOrder(bitOrderRuns *runs)
 {
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
 	int i;
 
 
+	expandBitOrderRuns(runs, bitOrder, MAX_BIT_ORDER_LENGTH);
+
 	/* start line with 3 spaces */
 	printf("   ");
 
 	/* print all but one bits */
 	i=0;
-	while((bitOrder[i+1] != UNUSED_BIT) && (i+1 < MAX_BIT_ORDER_LENGTH))
+	while((i+1 < MAX_BIT_ORDER_LENGTH) && (bitOrder[i+1] != UNUSED_BIT))
 	{
 		/* print bit by bit separated by a comma and a space */
 		if(bitOrder[i] == LITERAL0_BIT)
@@ -208,21 +183,21 @@ void	printDeviceDescription(deviceData *device)
 
 
 	printf("program word bit order: \r\n");
-	printBitOrder(device->wordBitOrder[PROGRAM]);
+	printBitOrder(&device->wordBitOrder[PROGRAM]);
 	printf("program word address bit order: \r\n");
-	printBitOrder(device->wordAddressBitOrder[PROGRAM]);
+	printBitOrder(&device->wordAddressBitOrder[PROGRAM]);
 	printf("program block address bit order before data: \r\n");
-	printBitOrder(device->preDataBlockAddrBitOrder[PROGRAM]);
+	printBitOrder(&device->preDataBlockAddrBitOrder[PROGRAM]);
 	printf("program block address bit order after data: \r\n");
-	printBitOrder(device->postDataBlockAddrBitOrder[PROGRAM]);
+	printBitOrder(&device->postDataBlockAddrBitOrder[PROGRAM]);
 	printf("verify word bit order: \r\n");
-	printBitOrder(device->wordBitOrder[VERIFY]);
+	printBitOrder(&device->wordBitOrder[VERIFY]);
 	printf("verify word address bit order: \r\n");
-	printBitOrder(device->wordAddressBitOrder[VERIFY]);
+	printBitOrder(&device->wordAddressBitOrder[VERIFY]);
 	printf("verify block address bit order before data: \r\n");
-	printBitOrder(device->preDataBlockAddrBitOrder[VERIFY]);
+	printBitOrder(&device->preDataBlockAddrBitOrder[VERIFY]);
 	printf("verify block address bit order after data: \r\n");
-	printBitOrder(device->postDataBlockAddrBitOrder[VERIFY]);
+	printBitOrder(&device->postDataBlockAddrBitOrder[VERIFY]);
 }
 
 
@@ -233,9 +208,6 @@ void	printDeviceDescription(deviceData *device)
 /*----------------------------------------------------------------------------*/
 void	initializeDeviceData(deviceData *device)
 {
-	int i;
-
-
 	/* set all characters of the name array to '\0' */
 	strncpy(device->name, "", MAX_DEVICE_NAME_LENGTH);
 
@@ -247,18 +219,14 @@ void	initializeDeviceData(deviceData *device)
 	device->wordLength = DEFAULT_WORD_LENGTH;
 	device->addressLength = DEFAULT_ADDRESS_LENGTH;
 
-	/* set all elements of the bit order arrays to -1 */
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
-	{
-		device->wordBitOrder[PROGRAM][i] = UNUSED_BIT;
-		device->wordBitOrder[VERIFY][i] = UNUSED_BIT;
-		device->wordAddressBitOrder[PROGRAM][i] = UNUSED_BIT;
-		device->wordAddressBitOrder[VERIFY][i] = UNUSED_BIT;
-		device->preDataBlockAddrBitOrder[PROGRAM][i] = UNUSED_BIT;
-		device->preDataBlockAddrBitOrder[VERIFY][i] = UNUSED_BIT;
-		device->postDataBlockAddrBitOrder[PROGRAM][i] = UNUSED_BIT;
-		device->postDataBlockAddrBitOrder[VERIFY][i] = UNUSED_BIT;
-	}
+	/* clear all bit orders */
+	memset(device->wordBitOrder, 0, sizeof(device->wordBitOrder));
+	memset(device->wordAddressBitOrder, 0, 
+					sizeof(device->wordAddressBitOrder));
+	memset(device->preDataBlockAddrBitOrder, 0, 
+				sizeof(device->preDataBlockAddrBitOrder));
+	memset(device->postDataBlockAddrBitOrder, 0, 
+				sizeof(device->postDataBlockAddrBitOrder));
 }
 
 
@@ -266,7 +234,8 @@ void	initializeDeviceData(deviceData *device)
 /*----------------------------------------------------------------------------*/
 /* Save the device description to a file.                                     */
 /* The first two bytes of the file are the deviceDataVersion and the          */
-/* maxWordLength. The rest of the structure is written as a whole.            */
+/* maxWordLength. The rest of the file is a deviceFileData structure written  */
+/* as a whole, so bit orders longer than the words can't be saved.            */
 /* IN device: Device description to be written to a file.                     */
 /* IN fileName: Name of the file to be written.                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
@@ -274,9 +243,48 @@ void	initializeDeviceData(deviceData *device)
 int	saveDeviceDescription(deviceData *device, char *fileName)
 {
 	int writtenBytes;
+	int mode;
+	int result;
+	deviceFileData fileData;
 	FILE *file;
 
 
+	/* fill the structure of the file */
+	memset(&fileData, 0, sizeof(fileData));
+	memcpy(fileData.name, device->name, MAX_DEVICE_NAME_LENGTH);
+	fileData.memorySize = device->memorySize;
+	fileData.blockSize = device->blockSize;
+	fileData.startAddress = device->startAddress;
+	fileData.addressStepPerWord = device->addressStepPerWord;
+	fileData.wordLength = device->wordLength;
+	fileData.addressLength = device->addressLength;
+
+	result = EXIT_SUCCESS;
+	for(mode=PROGRAM; mode <= VERIFY; mode++)
+	{
+		result |= expandBitOrderRuns(&device->wordBitOrder[mode],
+			fileData.wordBitOrder[mode], MAX_FILE_BIT_ORDER_LENGTH);
+		result |= expandBitOrderRuns(&device->wordAddressBitOrder[mode],
+			fileData.wordAddressBitOrder[mode], 
+						MAX_FILE_BIT_ORDER_LENGTH);
+		result |= expandBitOrderRuns(
+			&device->preDataBlockAddrBitOrder[mode],
+			fileData.preDataBlockAddrBitOrder[mode], 
+						MAX_FILE_BIT_ORDER_LENGTH);
+		result |= expandBitOrderRuns(
+			&device->postDataBlockAddrBitOrder[mode],
+			fileData.postDataBlockAddrBitOrder[mode], 
+						MAX_FILE_BIT_ORDER_LENGTH);
+	}
+
+	if(result != EXIT_SUCCESS)
+	{
+		fprintf(stderr, "ERROR: Bit orders longer than %i bits can not "
+			"be saved to the device file \"%s\"!\r\n", 
+			MAX_FILE_BIT_ORDER_LENGTH, fileName);
+		return EXIT_FAILURE;
+	}
+
 	/* create the file */
 	file = fopen(fileName, "wb+");
 	if(file == NULL)
@@ -305,10 +313,11 @@ int	saveDeviceDescription(deviceData *device, char *fileName)
 	}
 
 	/* write the complete structure to the file */
-	writtenBytes = fwrite(device, sizeof(uint8_t), sizeof(deviceData),file);
+	writtenBytes = fwrite(&fileData, sizeof(uint8_t), sizeof(fileData), 
+									file);
 	fclose(file);
 
-	if(writtenBytes != sizeof(deviceData))
+	if(writtenBytes != sizeof(fileData))
 	{
 		fprintf(stderr, "ERROR: Could not write to device file \"%s\"! "
 			"(wrote %u bytes)\r\n", fileName, writtenBytes);
@@ -326,7 +335,7 @@ int	saveDeviceDescription(deviceData *device, char *fileName)
 /* The function tries to load the file no matter if it is a 32 or 64 bit file.*/
 /* The function exits with a failure if the current structure is 32 bit,      */
 /* the file is 64 bit and the data of the file does not fit into a 32 bit     */
-/* structure.                                                                 */
+/* structure. The bit order arrays of the file are encoded into runs.         */
 /* OUT device: Device description read out from the file.                     */
 /* IN fileName: Name of the file to be read.                                  */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
@@ -336,16 +345,28 @@ int	loadDeviceDescription(deviceData *device, char *fileName)
 	uint8_t	fileMaxBitOrderLength;
 	uint8_t fileVersion;
 	uint8_t fileWordLength;
-	uint8_t	readBuffer[sizeof(deviceData64)];
+	uint8_t	readBuffer[sizeof(deviceFileData64)];
 	uint8_t *readPointer;
 	int readBytes;
 	uint64_t upper4Bytes;
+	bitOrderRuns *bitOrder[8];
+	int i;
 	FILE *file;
 
 
 	/* initialize the device data structure */
 	initializeDeviceData(device);
 
+	/* bit orders in the order of the file */
+	bitOrder[0] = &device->wordBitOrder[PROGRAM];
+	bitOrder[1] = &device->wordBitOrder[VERIFY];
+	bitOrder[2] = &device->wordAddressBitOrder[PROGRAM];
+	bitOrder[3] = &device->wordAddressBitOrder[VERIFY];
+	bitOrder[4] = &device->preDataBlockAddrBitOrder[PROGRAM];
+	bitOrder[5] = &device->preDataBlockAddrBitOrder[VERIFY];
+	bitOrder[6] = &device->postDataBlockAddrBitOrder[PROGRAM];
+	bitOrder[7] = &device->postDataBlockAddrBitOrder[VERIFY];
+
 	/* open the file */
 	file = fopen(fileName, "rb");
 	if(file == NULL)
@@ -399,13 +420,13 @@ int	loadDeviceDescription(deviceData *device, char *fileName)
 	{
 		/* read a 32 bit file */
 		readBytes = fread(readBuffer, sizeof(uint8_t), 
-						sizeof(deviceData32), file);
-		if(readBytes != sizeof(deviceData32))
+						sizeof(deviceFileData32), file);
+		if(readBytes != sizeof(deviceFileData32))
 		{
 			fclose(file);
 			fprintf(stderr, "ERROR: Could not read from device "
 				"file \"%s\"! (read %u bytes of %lu)\r\n", 
-				fileName, readBytes, sizeof(deviceData32));
+				fileName, readBytes, sizeof(deviceFileData32));
 			return EXIT_FAILURE;
 		}
 
@@ -415,13 +436,13 @@ int	loadDeviceDescription(deviceData *device, char *fileName)
 	{
 		/* read a 64 bit file */
 		readBytes = fread(readBuffer, sizeof(uint8_t), 
-						sizeof(deviceData64), file);
-		if(readBytes != sizeof(deviceData64))
+						sizeof(deviceFileData64), file);
+		if(readBytes != sizeof(deviceFileData64))
 		{
 			fclose(file);
 			fprintf(stderr, "ERROR: Could not read from device "
 				"file \"%s\"! (read %u bytes of %lu)\r\n", 
-				fileName, readBytes, sizeof(deviceData64));
+				fileName, readBytes, sizeof(deviceFileData64));
 			return EXIT_FAILURE;
 		}
 
@@ -519,58 +540,23 @@ int	loadDeviceDescription(deviceData *device, char *fileName)
 	device->addressLength = (uint8_t) *readPointer;
 	readPointer = readPointer + sizeof(uint8_t);
 
-	/* wordBitOrder PROGRAM */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
-		{
-			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
-				fileName);
-			return EXIT_FAILURE;
-		}
-		else
-		{
-			memcpy(device->wordBitOrder[PROGRAM], readPointer, 
-							MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->wordBitOrder[PROGRAM], readPointer, 
-							fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
-
-	/* wordBitOrder VERIFY */
-	if(fileWordLength > maxWordLength)
+	/* bit orders */
+	for(i=0; i < 8; i++)
 	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
+		if(encodeBitOrderRuns(bitOrder[i], (int8_t *) readPointer, 
+					fileMaxBitOrderLength) != EXIT_SUCCESS)
 		{
 			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
+			fprintf(stderr, "ERROR: The device file \"%s\" has an "
+				"invalid bit order and could not be read!\r\n",
 				fileName);
 			return EXIT_FAILURE;
 		}
-		else
-		{
-			memcpy(device->wordBitOrder[VERIFY], readPointer, 
-							MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->wordBitOrder[VERIFY], readPointer, 
-							fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
+		readPointer = readPointer + fileMaxBitOrderLength;
 
-	/* wordAddressBitOrder PROGRAM */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
+		/* the bit orders of a 64 bit file must fit into 32 bit */
+		if(fileWordLength > maxWordLength && 
+		   bitOrderLength(bitOrder[i]) > MAX_FILE_BIT_ORDER_LENGTH)
 		{
 			fclose(file);
 			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
@@ -578,138 +564,7 @@ int	loadDeviceDescription(deviceData *device, char *fileName)
 				fileName);
 			return EXIT_FAILURE;
 		}
-		else
-		{
-			memcpy(device->wordAddressBitOrder[PROGRAM], 
-					readPointer, MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->wordAddressBitOrder[PROGRAM], 
-					readPointer, fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
-
-	/* wordAddressBitOrder VERIFY */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
-		{
-			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
-				fileName);
-			return EXIT_FAILURE;
-		}
-		else
-		{
-			memcpy(device->wordAddressBitOrder[VERIFY], 
-					readPointer, MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->wordAddressBitOrder[VERIFY], 
-					readPointer, fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
-
-	/* blockAddressBeforeDataBitOrder PROGRAM */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
-		{
-			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
-				fileName);
-			return EXIT_FAILURE;
-		}
-		else
-		{
-			memcpy(device->preDataBlockAddrBitOrder[PROGRAM], 
-					readPointer, MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->preDataBlockAddrBitOrder[PROGRAM], 
-					readPointer, fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
-
-	/* blockAddressBeforeDataBitOrder VERIFY */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
-		{
-			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
-				fileName);
-			return EXIT_FAILURE;
-		}
-		else
-		{
-			memcpy(device->preDataBlockAddrBitOrder[VERIFY], 
-					readPointer, MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->preDataBlockAddrBitOrder[VERIFY], 
-					readPointer, fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
-
-	/* blockAddressAfterDataBitOrder PROGRAM */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
-		{
-			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
-				fileName);
-			return EXIT_FAILURE;
-		}
-		else
-		{
-			memcpy(device->postDataBlockAddrBitOrder[PROGRAM], 
-					readPointer, MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->postDataBlockAddrBitOrder[PROGRAM], 
-					readPointer, fileMaxBitOrderLength);
-	}
-	readPointer = readPointer + fileMaxBitOrderLength;
-
-	/* blockAddressBeforeDataBitOrder VERIFY */
-	if(fileWordLength > maxWordLength)
-	{
-		if(bitOrderLength((int8_t *)readPointer) > MAX_BIT_ORDER_LENGTH)
-		{
-			fclose(file);
-			fprintf(stdout, "Can not use 64 bit device file \"%s\" "
-				"with 32 bit version of this program!\r\n", 
-				fileName);
-			return EXIT_FAILURE;
-		}
-		else
-		{
-			memcpy(device->postDataBlockAddrBitOrder[VERIFY], 
-					readPointer, MAX_BIT_ORDER_LENGTH);
-		}
-	}
-	else
-	{
-		memcpy(device->postDataBlockAddrBitOrder[VERIFY], 
-					readPointer, fileMaxBitOrderLength);
 	}
-	readPointer = readPointer + fileMaxBitOrderLength;
 
 	fclose(file);
 
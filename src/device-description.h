@@ -63,11 +63,18 @@
 #define LITERAL1_BIT	-3
 
 
-/* define maximum lengths of words and bit orders */
+/* define maximum lengths of words and bit orders, bit order arrays of */
+/* device description files (version 1) have the length of the words */
 #define MAX_WORD_LENGTH32	((signed int)(8*sizeof(uint32_t)))
 #define MAX_WORD_LENGTH64	((signed int)(8*sizeof(uint64_t)))
 #define MAX_BIT_ORDER_LENGTH32	MAX_WORD_LENGTH32
 #define MAX_BIT_ORDER_LENGTH64	MAX_WORD_LENGTH64
+#define MAX_BIT_ORDER_LENGTH	1024
+
+/* define maximum number of runs of a bit order and bits of a run (the */
+/* bits of a run are taken from a word at once) */
+#define MAX_BIT_ORDER_RUN_NUM	256
+#define MAX_RUN_LENGTH		MAX_WORD_LENGTH64
 
 
 /* define default values for device data attributes */
@@ -77,32 +84,73 @@
 #define DEFAULT_ADDRESS_LENGTH		8
 
 
+/* kinds of the runs of a bit order */
+enum {ASCENDING_RUN, DESCENDING_RUN, LITERAL_RUN, REPEAT_RUN};
+
+
+/* datatype for a run of a bit order */
+typedef struct
+{
+	/* ASCENDING_RUN, DESCENDING_RUN, LITERAL_RUN or REPEAT_RUN */
+	uint8_t type;
+
+	/* first bit of ascending and descending runs, value of literals, */
+	/* number of preceding runs repeated by a repeat */
+	int16_t first;
+
+	/* number of bits, a repeat repeats the preceding length bits */
+	uint16_t length;
+
+	/* number of copies added by a repeat */
+	uint16_t count;
+}
+bitRun;
+
+
+/* datatype for a bit order described by runs (see bit-runs.c) */
+typedef struct
+{
+	/* number of bits of the whole bit order */
+	int length;
+
+	int runNum;
+	bitRun run[MAX_BIT_ORDER_RUN_NUM];
+}
+bitOrderRuns;
+
+
 /* declare 2 deviceData structures for 32 and 64 bit */
 #define uint32_64_t uint32_t
 #define deviceData deviceData32
-#define MAX_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH32
+#define deviceFileData deviceFileData32
+#define MAX_FILE_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH32
 #include "device-data.h"
 #undef uint32_64_t
 #undef deviceData
-#undef MAX_BIT_ORDER_LENGTH
+#undef deviceFileData
+#undef MAX_FILE_BIT_ORDER_LENGTH
 
 #define uint32_64_t uint64_t
 #define deviceData deviceData64
-#define MAX_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH64
+#define deviceFileData deviceFileData64
+#define MAX_FILE_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH64
 #include "device-data.h"
 #undef uint32_64_t
 #undef deviceData
-#undef MAX_BIT_ORDER_LENGTH
+#undef deviceFileData
+#undef MAX_FILE_BIT_ORDER_LENGTH
 
 /* define datatype for 32 or 64 bit depending on the definition of USING_64BIT*/
 #if(USING_64BIT==1)
 	#define uint32_64_t	uint64_t
 	#define deviceData	deviceData64
-	#define MAX_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH64
+	#define deviceFileData	deviceFileData64
+	#define MAX_FILE_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH64
 #else
 	#define uint32_64_t	uint32_t
 	#define deviceData	deviceData32
-	#define MAX_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH32
+	#define deviceFileData	deviceFileData32
+	#define MAX_FILE_BIT_ORDER_LENGTH	MAX_BIT_ORDER_LENGTH32
 #endif /* USING_64BIT */
 
 
@@ -114,9 +162,9 @@ extern const uint8_t deviceDataVersion;
 extern const uint8_t maxWordLength;
 
 
-extern	uint8_t	bitOrderLength(int8_t *);
-extern	int	bitOrderIsEmpty(int8_t *);
-extern	int	bitOrdersAreEqual(int8_t *, int8_t *);
+extern	int	bitOrderLength(bitOrderRuns *);
+extern	int	bitOrderIsEmpty(bitOrderRuns *);
+extern	int	bitOrdersAreEqual(bitOrderRuns *, bitOrderRuns *);
 extern	int	programAndVerfiyBitOrdersAreEqual(deviceData *);
 extern	void	printDeviceDescription(deviceData *);
 extern	void	initializeDeviceData(deviceData *);
@@ -0,0 +1,1210 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* Compiled device files (version 3) start with a header, followed by a table */
+/* of sections. The device description is stored in a fixed little endian     */
+/* layout, so the files can be used on every platform. The bit orders of the  */
+/* device are also stored compiled into lookup tables for the default ascii   */
+/* and binary formats. The tables are used directly from the mapped file, so  */
+/* generating output doesn't have to compile them again. Version 1 files are  */
+/* still loaded with loadDeviceDescription.                                   */
+/*                                                                            */
+/* Header (64 bytes):                                                         */
+/*   0 magic "01ASCII\0", 8 version, 12 header size, 16 file size,            */
+/*   24 number of sections, 28 offset of the section table, 32 checksum       */
+/*   (FNV-1a of the file with the checksum cleared), 40 hash of the source    */
+/*   the file has been compiled from (FNV-1a, 0 if unknown)                   */
+/* Section table entries (24 bytes):                                          */
+/*   0 type, 4 parameter, 8 offset, 16 length                                 */
+/* Description section:                                                       */
+/*   0 name, followed by the memory size, block size and start address (8     */
+/*   bytes each), the address step per word, word length, address length and */
+/*   word length of the program (1 byte each) and 4 unused bytes. Each bit    */
+/*   order follows with its length and number of runs (4 bytes each) and its */
+/*   runs (8 bytes each: 0 type, 2 first, 4 length, 6 count). Version 2 files */
+/*   store 64 bytes per bit order instead, one per bit.                       */
+/* Table sections (parameter: format << 16 | kind << 8 | PROGRAM or VERIFY):  */
+/*   0 length, 4 number of chunks, 8 number of bytes, 12 byte positions,      */
+/*   24 base, followed by the fragments (see compileBitOrder)                 */
+/*----------------------------------------------------------------------------*/
+
+#include "device-file.h"
+
+
+/* offsets of the header entries */
+#define MAGIC_OFFSET		0
+#define VERSION_OFFSET		8
+#define HEADER_SIZE_OFFSET	12
+#define FILE_SIZE_OFFSET	16
+#define SECTION_NUM_OFFSET	24
+#define SECTION_TABLE_OFFSET	28
+#define CHECKSUM_OFFSET		32
+#define SOURCE_HASH_OFFSET	40
+
+
+/* Store a value in little endian byte order                                  */
+/*----------------------------------------------------------------------------*/
+/* OUT data: Destination of the value.                                        */
+/* IN value: Value to store.                                                  */
+/* IN length: Number of bytes to store.                                       */
+/*----------------------------------------------------------------------------*/
+void	putLittleEndian(uint8_t *data, uint64_t value, int length)
+{
+	int i;
+
+
+	for(i=0; i < length; i++)
+		data[i] = (uint8_t) (value >> (8*i));
+}
+
+
+/* Read a value stored in little endian byte order                            */
+/*----------------------------------------------------------------------------*/
+/* IN data: Stored value.                                                     */
+/* IN length: Number of bytes of the value.                                   */
+/* RETURNS: Value.                                                            */
+/*----------------------------------------------------------------------------*/
+uint64_t	getLittleEndian(uint8_t *data, int length)
+{
+	uint64_t value;
+	int i;
+
+
+	value = 0;
+	for(i=length-1; i >= 0; i--)
+		value = (value << 8) | data[i];
+
+	return value;
+}
+
+
+/* Round a size up to the alignment of the sections                           */
+/*----------------------------------------------------------------------------*/
+/* IN size: Size in bytes.                                                    */
+/* RETURNS: Aligned size.                                                     */
+/*----------------------------------------------------------------------------*/
+static uint64_t	alignSection(uint64_t size)
+{
+	return (size + DEVICE_FILE_ALIGNMENT - 1) & 
+					~((uint64_t) DEVICE_FILE_ALIGNMENT - 1);
+}
+
+
+/* Get a bit order of a device                                                */
+/*----------------------------------------------------------------------------*/
+/* IN device: Device structure containing the bit order.                      */
+/* IN kind: Kind of the bit order (WORD_BIT_ORDER, ...).                      */
+/* IN mode: PROGRAM or VERIFY.                                                */
+/* OUT wordLength: Length of the words the bit order is used for in bits.     */
+/* RETURNS: Bit order.                                                        */
+/*----------------------------------------------------------------------------*/
+static bitOrderRuns	*getDeviceBitOrder(deviceData *device, int kind, 
+						int mode, int *wordLength)
+{
+	*wordLength = device->addressLength;
+
+	switch(kind)
+	{
+		case WORD_BIT_ORDER:
+			*wordLength = device->wordLength;
+			return &device->wordBitOrder[mode];
+
+		case WORD_ADDRESS_BIT_ORDER:
+			return &device->wordAddressBitOrder[mode];
+
+		case PRE_BLOCK_BIT_ORDER:
+			return &device->preDataBlockAddrBitOrder[mode];
+
+		default:
+			return &device->postDataBlockAddrBitOrder[mode];
+	}
+}
+
+
+/* Hash the content of a device file                                          */
+/*----------------------------------------------------------------------------*/
+/* The checksum stored in the header is hashed as if it was cleared.          */
+/* IN data: Content of the file.                                              */
+/* IN size: Size of the file in bytes (at least DEVICE_FILE_HEADER_SIZE).     */
+/* RETURNS: Checksum of the file.                                             */
+/*----------------------------------------------------------------------------*/
+static uint64_t	hashDeviceFile(uint8_t *data, size_t size)
+{
+	uint8_t clearedChecksum[sizeof(uint64_t)];
+	uint64_t hash;
+
+
+	memset(clearedChecksum, 0, sizeof(clearedChecksum));
+
+	hash = hashBytes(FNV_OFFSET_BASIS, data, CHECKSUM_OFFSET);
+	hash = hashBytes(hash, clearedChecksum, sizeof(clearedChecksum));
+	hash = hashBytes(hash, data + CHECKSUM_OFFSET + sizeof(uint64_t),
+				size - CHECKSUM_OFFSET - sizeof(uint64_t));
+
+	return hash;
+}
+
+
+/* Calculate the size of the description of a device                          */
+/*----------------------------------------------------------------------------*/
+/* IN device: Device structure to store.                                      */
+/* RETURNS: Size of the description section in bytes.                         */
+/*----------------------------------------------------------------------------*/
+static uint64_t	descriptionSize(deviceData *device)
+{
+	bitOrderRuns *bitOrder;
+	uint64_t size;
+	int kind;
+	int mode;
+	int wordLength;
+
+
+	size = DEVICE_FILE_DESCRIPTION_SIZE;
+	for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+	{
+		for(mode=PROGRAM; mode <= VERIFY; mode++)
+		{
+			bitOrder = getDeviceBitOrder(device, kind, mode, 
+								&wordLength);
+			size = size + DEVICE_FILE_BIT_ORDER_SIZE + 
+				bitOrder->runNum * DEVICE_FILE_RUN_SIZE;
+		}
+	}
+
+	return size;
+}
+
+
+/* Store the description of a device                                          */
+/*----------------------------------------------------------------------------*/
+/* OUT data: Description section (see descriptionSize).                       */
+/* IN device: Device structure to store.                                      */
+/*----------------------------------------------------------------------------*/
+static void	putDescription(uint8_t *data, deviceData *device)
+{
+	bitOrderRuns *bitOrder;
+	bitRun *current;
+	int kind;
+	int mode;
+	int wordLength;
+	int run;
+
+
+	memcpy(data, device->name, MAX_DEVICE_NAME_LENGTH);
+	data = data + MAX_DEVICE_NAME_LENGTH;
+
+	putLittleEndian(data, device->memorySize, sizeof(uint64_t));
+	data = data + sizeof(uint64_t);
+	putLittleEndian(data, device->blockSize, sizeof(uint64_t));
+	data = data + sizeof(uint64_t);
+	putLittleEndian(data, device->startAddress, sizeof(uint64_t));
+	data = data + sizeof(uint64_t);
+
+	data[0] = device->addressStepPerWord;
+	data[1] = device->wordLength;
+	data[2] = device->addressLength;
+	data[3] = maxWordLength;
+	data = data + 2*sizeof(uint32_t);
+
+	for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+	{
+		for(mode=PROGRAM; mode <= VERIFY; mode++)
+		{
+			bitOrder = getDeviceBitOrder(device, kind, mode,
+								&wordLength);
+			putLittleEndian(data, bitOrder->length, 
+							sizeof(uint32_t));
+			putLittleEndian(data + 4, bitOrder->runNum, 
+							sizeof(uint32_t));
+			data = data + DEVICE_FILE_BIT_ORDER_SIZE;
+
+			for(run=0; run < bitOrder->runNum; run++)
+			{
+				current = &bitOrder->run[run];
+				data[0] = current->type;
+				putLittleEndian(data + 2, 
+					(uint16_t) current->first, 
+							sizeof(uint16_t));
+				putLittleEndian(data + 4, current->length, 
+							sizeof(uint16_t));
+				putLittleEndian(data + 6, current->count, 
+							sizeof(uint16_t));
+				data = data + DEVICE_FILE_RUN_SIZE;
+			}
+		}
+	}
+}
+
+
+/* Read the bit orders of a device                                            */
+/*----------------------------------------------------------------------------*/
+/* Version 2 files store the bit orders with one byte per bit, they are       */
+/* encoded into runs.                                                         */
+/* IN data: Bit orders of the description section.                            */
+/* IN length: Number of bytes of the bit orders.                              */
+/* IN version: Version of the device file.                                    */
+/* OUT device: Device structure.                                              */
+/* RETURNS: EXIT_FAILURE if the bit orders are invalid,                       */
+/*          EXIT_SUCCESS otherwise.                                           */
+/*----------------------------------------------------------------------------*/
+static int	getBitOrders(uint8_t *data, uint64_t length, int version, 
+							deviceData *device)
+{
+	bitOrderRuns *bitOrder;
+	bitRun *current;
+	int kind;
+	int mode;
+	int wordLength;
+	int run;
+
+
+	for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+	{
+		for(mode=PROGRAM; mode <= VERIFY; mode++)
+		{
+			bitOrder = getDeviceBitOrder(device, kind, mode, 
+								&wordLength);
+
+			if(version == DEVICE_FILE_VERSION2)
+			{
+				if((length < MAX_BIT_ORDER_LENGTH64) || 
+					(encodeBitOrderRuns(bitOrder, 
+					(int8_t *) data, MAX_BIT_ORDER_LENGTH64)
+							!= EXIT_SUCCESS))
+					return EXIT_FAILURE;
+
+				data = data + MAX_BIT_ORDER_LENGTH64;
+				length = length - MAX_BIT_ORDER_LENGTH64;
+				continue;
+			}
+
+			if(length < DEVICE_FILE_BIT_ORDER_SIZE)
+				return EXIT_FAILURE;
+
+			bitOrder->length = getLittleEndian(data, 
+							sizeof(uint32_t));
+			bitOrder->runNum = getLittleEndian(data + 4, 
+							sizeof(uint32_t));
+			data = data + DEVICE_FILE_BIT_ORDER_SIZE;
+			length = length - DEVICE_FILE_BIT_ORDER_SIZE;
+
+			if((bitOrder->runNum < 0) || 
+				(bitOrder->runNum > MAX_BIT_ORDER_RUN_NUM) ||
+				((uint64_t) bitOrder->runNum * 
+					DEVICE_FILE_RUN_SIZE > length))
+				return EXIT_FAILURE;
+
+			for(run=0; run < bitOrder->runNum; run++)
+			{
+				current = &bitOrder->run[run];
+				current->type = data[0];
+				current->first = (int16_t) getLittleEndian(
+						data + 2, sizeof(uint16_t));
+				current->length = getLittleEndian(data + 4, 
+							sizeof(uint16_t));
+				current->count = getLittleEndian(data + 6, 
+							sizeof(uint16_t));
+				data = data + DEVICE_FILE_RUN_SIZE;
+				length = length - DEVICE_FILE_RUN_SIZE;
+			}
+
+			if(bitOrderRunsAreValid(bitOrder) != true)
+				return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Read the description of a device                                           */
+/*----------------------------------------------------------------------------*/
+/* IN data: Description section.                                              */
+/* IN length: Length of the description section in bytes.                     */
+/* IN version: Version of the device file.                                    */
+/* OUT device: Device structure.                                              */
+/* IN fileName: Name of the device file for error messages.                   */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	getDescription(uint8_t *data, uint64_t length, int version, 
+					deviceData *device, char *fileName)
+{
+	uint64_t value[3];
+	int i;
+
+
+	initializeDeviceData(device);
+
+	if(length < DEVICE_FILE_DESCRIPTION_SIZE)
+	{
+		fprintf(stderr, "ERROR: The device file \"%s\" is corrupt!"
+							"\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	memcpy(device->name, data, MAX_DEVICE_NAME_LENGTH);
+	device->name[MAX_DEVICE_NAME_LENGTH - 1] = '\0';
+	data = data + MAX_DEVICE_NAME_LENGTH;
+
+	for(i=0; i < 3; i++)
+	{
+		value[i] = getLittleEndian(data, sizeof(uint64_t));
+		data = data + sizeof(uint64_t);
+	}
+
+	device->memorySize = (uint32_64_t) value[0];
+	device->blockSize = (uint32_64_t) value[1];
+	device->startAddress = (uint32_64_t) value[2];
+	device->addressStepPerWord = data[0];
+	device->wordLength = data[1];
+	device->addressLength = data[2];
+	data = data + 2*sizeof(uint32_t);
+
+	/* check if the values fit into this version of the program */
+	if((device->memorySize != value[0]) || 
+		(device->blockSize != value[1]) ||
+		(device->startAddress != value[2]))
+	{
+		fprintf(stderr, "ERROR: Can not use 64 bit device file \"%s\" "
+			"with 32 bit version of this program!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	if(getBitOrders(data, length - DEVICE_FILE_DESCRIPTION_SIZE, version,
+						device) != EXIT_SUCCESS)
+	{
+		fprintf(stderr, "ERROR: The device file \"%s\" contains an "
+			"invalid bit order!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Store an output format                                                     */
+/*----------------------------------------------------------------------------*/
+/* OUT data: Format section (DEVICE_FILE_FORMAT_SIZE bytes).                  */
+/* IN format: Output format the tables are compiled for.                      */
+/*----------------------------------------------------------------------------*/
+static void	putFormat(uint8_t *data, outputFormat *format)
+{
+	putLittleEndian(data, format->type, sizeof(uint32_t));
+	data[4] = format->symbol[0];
+	data[5] = format->symbol[1];
+	data[6] = format->separatorLength;
+	data[7] = format->terminatorLength;
+	memcpy(data + 8, format->separator, MAX_SEPARATOR_LENGTH);
+	memcpy(data + 8 + MAX_SEPARATOR_LENGTH, format->terminator, 
+						MAX_TERMINATOR_LENGTH);
+
+	/* tables depend on the width of the words they are compiled for */
+	data[8 + MAX_SEPARATOR_LENGTH + MAX_TERMINATOR_LENGTH] = maxWordLength;
+}
+
+
+/* Check if a stored output format can be used                                */
+/*----------------------------------------------------------------------------*/
+/* IN data: Format section (DEVICE_FILE_FORMAT_SIZE bytes).                   */
+/* IN format: Requested output format.                                        */
+/* RETURNS: true if the tables compiled for the stored format can be used     */
+/*          for the requested format, false otherwise.                        */
+/*----------------------------------------------------------------------------*/
+static int	formatIsUsable(uint8_t *data, outputFormat *format)
+{
+	outputFormat storedFormat;
+
+
+	if(data[8 + MAX_SEPARATOR_LENGTH + MAX_TERMINATOR_LENGTH] != 
+								maxWordLength)
+		return false;
+
+	if((data[6] > MAX_SEPARATOR_LENGTH) || 
+					(data[7] > MAX_TERMINATOR_LENGTH))
+		return false;
+
+	memset(&storedFormat, 0, sizeof(storedFormat));
+	storedFormat.type = getLittleEndian(data, sizeof(uint32_t));
+	storedFormat.symbol[0] = data[4];
+	storedFormat.symbol[1] = data[5];
+	storedFormat.separatorLength = data[6];
+	storedFormat.terminatorLength = data[7];
+	memcpy(storedFormat.separator, data + 8, MAX_SEPARATOR_LENGTH);
+	memcpy(storedFormat.terminator, data + 8 + MAX_SEPARATOR_LENGTH, 
+						MAX_TERMINATOR_LENGTH);
+
+	return outputFormatsAreEqual(&storedFormat, format);
+}
+
+
+/* Get the size of a table section                                            */
+/*----------------------------------------------------------------------------*/
+/* IN chunkNum: Number of 64 bit chunks of a rendered word.                   */
+/* IN byteNum: Number of tables.                                              */
+/* RETURNS: Size of the section in bytes.                                     */
+/*----------------------------------------------------------------------------*/
+static uint64_t	tableSize(uint64_t chunkNum, uint64_t byteNum)
+{
+	return DEVICE_FILE_TABLE_HEADER_SIZE + chunkNum * sizeof(uint64_t) +
+				byteNum * 256 * chunkNum * sizeof(uint64_t);
+}
+
+
+/* Store a compiled bit order                                                 */
+/*----------------------------------------------------------------------------*/
+/* OUT data: Table section (see tableSize).                                   */
+/* IN compiled: Bit order compiled into lookup tables.                        */
+/*----------------------------------------------------------------------------*/
+static void	putTable(uint8_t *data, compiledBitOrder *compiled)
+{
+	int i;
+
+
+	putLittleEndian(data, compiled->length, sizeof(uint32_t));
+	putLittleEndian(data + 4, compiled->chunkNum, sizeof(uint32_t));
+	putLittleEndian(data + 8, compiled->byteNum, sizeof(uint32_t));
+	for(i=0; i < compiled->byteNum; i++)
+		data[12 + i] = compiled->bytePosition[i];
+
+	/* the rendered output is stored as bytes, independent of the */
+	/* byte order of the platform */
+	data = data + DEVICE_FILE_TABLE_HEADER_SIZE;
+	memcpy(data, compiled->base, compiled->chunkNum * sizeof(uint64_t));
+	data = data + compiled->chunkNum * sizeof(uint64_t);
+	memcpy(data, compiled->fragments, compiled->byteNum * 256 * 
+				compiled->chunkNum * sizeof(uint64_t));
+}
+
+
+/* Use a stored compiled bit order                                            */
+/*----------------------------------------------------------------------------*/
+/* The fragments are used in place, they are not owned by the compiled bit    */
+/* order.                                                                     */
+/* OUT compiled: Compiled bit order.                                          */
+/* IN data: Table section.                                                    */
+/* IN length: Length of the table section in bytes.                           */
+/* RETURNS: EXIT_FAILURE if the table is invalid, EXIT_SUCCESS otherwise.     */
+/*----------------------------------------------------------------------------*/
+static int	getTable(compiledBitOrder *compiled, uint8_t *data, 
+							uint64_t length)
+{
+	uint64_t chunkNum;
+	uint64_t byteNum;
+	uint64_t outputLength;
+	int i;
+
+
+	if(length < DEVICE_FILE_TABLE_HEADER_SIZE)
+		return EXIT_FAILURE;
+
+	outputLength = getLittleEndian(data, sizeof(uint32_t));
+	chunkNum = getLittleEndian(data + 4, sizeof(uint32_t));
+	byteNum = getLittleEndian(data + 8, sizeof(uint32_t));
+
+	if((outputLength == 0) || (chunkNum > MAX_OUTPUT_CHUNK_NUM) ||
+		(chunkNum != (outputLength + 7) / 8) || (byteNum < 1) || 
+		(byteNum > sizeof(uint32_64_t)) || 
+		(length != tableSize(chunkNum, byteNum)))
+		return EXIT_FAILURE;
+
+	compiled->length = outputLength;
+	compiled->chunkNum = chunkNum;
+	compiled->byteNum = byteNum;
+	for(i=0; i < compiled->byteNum; i++)
+	{
+		compiled->bytePosition[i] = data[12 + i];
+		if(compiled->bytePosition[i] >= (int) sizeof(uint32_64_t))
+			return EXIT_FAILURE;
+	}
+
+	data = data + DEVICE_FILE_TABLE_HEADER_SIZE;
+	memset(compiled->base, 0, sizeof(compiled->base));
+	memcpy(compiled->base, data, chunkNum * sizeof(uint64_t));
+	compiled->fragments = (uint64_t *) (data + chunkNum*sizeof(uint64_t));
+	compiled->ownsFragments = false;
+	compiled->expansion.kernel = NO_KERNEL;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Build the content of a compiled device file                                */
+/*----------------------------------------------------------------------------*/
+/* The bit orders are compiled for the default ascii and binary formats,      */
+/* only the ones that need lookup tables (see compileBitOrder) are stored.    */
+/* IN device: Device structure to store.                                      */
+/* IN sourceHash: Hash of the source (see hashDeviceSource) or 0.             */
+/* OUT content: Allocated content of the file (free it with free).            */
+/* OUT contentSize: Size of the content in bytes.                             */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	buildDeviceFile(deviceData *device, uint64_t sourceHash,
+				uint8_t **content, uint64_t *contentSize)
+{
+	static const int formatType[DEVICE_FILE_FORMAT_NUM] = 
+						{ASCII_OUTPUT, BINARY_OUTPUT};
+	compiledBitOrder compiled[DEVICE_FILE_FORMAT_NUM][BIT_ORDER_KIND_NUM]
+									[2];
+	uint64_t offset[DEVICE_FILE_FORMAT_NUM][BIT_ORDER_KIND_NUM][2];
+	outputFormat format[DEVICE_FILE_FORMAT_NUM];
+	bitOrderRuns *bitOrder[2];
+	int wordLength;
+	int formatIndex;
+	int kind;
+	int mode;
+	int result;
+	uint32_t sectionNum;
+	uint64_t size;
+	uint8_t *data;
+	uint8_t *entry;
+
+
+	/* compile the bit orders */
+	result = EXIT_SUCCESS;
+	sectionNum = 1 + DEVICE_FILE_FORMAT_NUM;
+	for(formatIndex=0; formatIndex < DEVICE_FILE_FORMAT_NUM; formatIndex++)
+	{
+		initializeOutputFormat(&format[formatIndex], 
+						formatType[formatIndex]);
+
+		for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+		{
+			for(mode=PROGRAM; mode <= VERIFY; mode++)
+			{
+				bitOrder[mode] = getDeviceBitOrder(device, kind,
+							mode, &wordLength);
+				if(compileBitOrder(&compiled[formatIndex][kind]
+					[mode], bitOrder[mode], wordLength,
+					&format[formatIndex]) != EXIT_SUCCESS)
+				{
+					compiled[formatIndex][kind][mode].
+							fragments = NULL;
+					result = EXIT_FAILURE;
+				}
+
+				if(compiled[formatIndex][kind][mode].fragments 
+								!= NULL)
+					sectionNum++;
+			}
+		}
+	}
+
+	/* lay out the sections, equal bit orders share their tables */
+	size = alignSection(DEVICE_FILE_HEADER_SIZE + 
+				sectionNum * DEVICE_FILE_ENTRY_SIZE);
+	size = size + alignSection(descriptionSize(device));
+	size = size + DEVICE_FILE_FORMAT_NUM * 
+				alignSection(DEVICE_FILE_FORMAT_SIZE);
+	for(formatIndex=0; formatIndex < DEVICE_FILE_FORMAT_NUM; formatIndex++)
+	{
+		for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+		{
+			bitOrder[PROGRAM] = getDeviceBitOrder(device, kind,
+						PROGRAM, &wordLength);
+			bitOrder[VERIFY] = getDeviceBitOrder(device, kind,
+						VERIFY, &wordLength);
+
+			for(mode=PROGRAM; mode <= VERIFY; mode++)
+			{
+				if(compiled[formatIndex][kind][mode].fragments 
+								== NULL)
+					continue;
+
+				if((mode == VERIFY) && (bitOrdersAreEqual(
+					bitOrder[PROGRAM], bitOrder[VERIFY]) 
+								== true))
+				{
+					offset[formatIndex][kind][VERIFY] = 
+					offset[formatIndex][kind][PROGRAM];
+					continue;
+				}
+
+				offset[formatIndex][kind][mode] = size;
+				size = size + alignSection(tableSize(
+				compiled[formatIndex][kind][mode].chunkNum, 
+				compiled[formatIndex][kind][mode].byteNum));
+			}
+		}
+	}
+
+	data = NULL;
+	if(result == EXIT_SUCCESS)
+	{
+		data = calloc(size, sizeof(uint8_t));
+		if(data == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+							"memory!\r\n");
+			result = EXIT_FAILURE;
+		}
+	}
+
+	if(result == EXIT_SUCCESS)
+	{
+		/* header */
+		memcpy(data + MAGIC_OFFSET, DEVICE_FILE_MAGIC, 
+						sizeof(DEVICE_FILE_MAGIC));
+		putLittleEndian(data + VERSION_OFFSET, DEVICE_FILE_VERSION, 
+							sizeof(uint32_t));
+		putLittleEndian(data + HEADER_SIZE_OFFSET, 
+				DEVICE_FILE_HEADER_SIZE, sizeof(uint32_t));
+		putLittleEndian(data + FILE_SIZE_OFFSET, size, 
+							sizeof(uint64_t));
+		putLittleEndian(data + SECTION_NUM_OFFSET, sectionNum, 
+							sizeof(uint32_t));
+		putLittleEndian(data + SECTION_TABLE_OFFSET, 
+				DEVICE_FILE_HEADER_SIZE, sizeof(uint32_t));
+		putLittleEndian(data + SOURCE_HASH_OFFSET, sourceHash,
+							sizeof(uint64_t));
+
+		/* description */
+		entry = data + DEVICE_FILE_HEADER_SIZE;
+		size = alignSection(DEVICE_FILE_HEADER_SIZE + 
+				sectionNum * DEVICE_FILE_ENTRY_SIZE);
+		putLittleEndian(entry, DESCRIPTION_SECTION, sizeof(uint32_t));
+		putLittleEndian(entry + 8, size, sizeof(uint64_t));
+		putLittleEndian(entry + 16, descriptionSize(device), 
+							sizeof(uint64_t));
+		putDescription(data + size, device);
+		entry = entry + DEVICE_FILE_ENTRY_SIZE;
+		size = size + alignSection(descriptionSize(device));
+
+		/* formats */
+		for(formatIndex=0; formatIndex < DEVICE_FILE_FORMAT_NUM; 
+								formatIndex++)
+		{
+			putLittleEndian(entry, FORMAT_SECTION, 
+							sizeof(uint32_t));
+			putLittleEndian(entry + 4, formatIndex, 
+							sizeof(uint32_t));
+			putLittleEndian(entry + 8, size, sizeof(uint64_t));
+			putLittleEndian(entry + 16, DEVICE_FILE_FORMAT_SIZE, 
+							sizeof(uint64_t));
+			putFormat(data + size, &format[formatIndex]);
+			entry = entry + DEVICE_FILE_ENTRY_SIZE;
+			size = size + alignSection(DEVICE_FILE_FORMAT_SIZE);
+		}
+
+		/* tables */
+		for(formatIndex=0; formatIndex < DEVICE_FILE_FORMAT_NUM; 
+								formatIndex++)
+		{
+			for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+			{
+				for(mode=PROGRAM; mode <= VERIFY; mode++)
+				{
+					if(compiled[formatIndex][kind][mode].
+							fragments == NULL)
+						continue;
+
+					putLittleEndian(entry, TABLE_SECTION, 
+							sizeof(uint32_t));
+					putLittleEndian(entry + 4, 
+						(formatIndex << 16) | 
+						(kind << 8) | mode, 
+							sizeof(uint32_t));
+					putLittleEndian(entry + 8, 
+						offset[formatIndex][kind][mode],
+							sizeof(uint64_t));
+					putLittleEndian(entry + 16, tableSize(
+						compiled[formatIndex][kind]
+						[mode].chunkNum, compiled
+						[formatIndex][kind][mode].
+						byteNum), sizeof(uint64_t));
+					putTable(data + offset[formatIndex]
+						[kind][mode], &compiled
+						[formatIndex][kind][mode]);
+					entry = entry + DEVICE_FILE_ENTRY_SIZE;
+				}
+			}
+		}
+
+		size = getLittleEndian(data + FILE_SIZE_OFFSET, 
+							sizeof(uint64_t));
+		putLittleEndian(data + CHECKSUM_OFFSET, 
+			hashDeviceFile(data, size), sizeof(uint64_t));
+	}
+
+	for(formatIndex=0; formatIndex < DEVICE_FILE_FORMAT_NUM; formatIndex++)
+		for(kind=0; kind < BIT_ORDER_KIND_NUM; kind++)
+			for(mode=PROGRAM; mode <= VERIFY; mode++)
+				disposeCompiledBitOrder(&compiled[formatIndex]
+								[kind][mode]);
+
+	if(result != EXIT_SUCCESS)
+	{
+		if(data != NULL)
+			free(data);
+		return EXIT_FAILURE;
+	}
+
+	*content = data;
+	*contentSize = size;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Save a compiled device file                                                */
+/*----------------------------------------------------------------------------*/
+/* IN device: Device structure to save.                                       */
+/* IN sourceHash: Hash of the source (see hashDeviceSource) or 0.             */
+/* IN fileName: Name of the device file.                                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	saveDeviceFile(deviceData *device, uint64_t sourceHash, char *fileName)
+{
+	uint8_t *data;
+	uint64_t size;
+	size_t writtenBytes;
+	FILE *file;
+
+
+	if(buildDeviceFile(device, sourceHash, &data, &size) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* create the file */
+	file = fopen(fileName, "wb+");
+	if(file == NULL)
+	{
+		free(data);
+		fprintf(stderr, "ERROR: Could not create device file "
+			"\"%s\"!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	writtenBytes = fwrite(data, sizeof(uint8_t), size, file);
+	free(data);
+	if(fclose(file) != 0)
+		writtenBytes = 0;
+
+	if(writtenBytes != size)
+	{
+		fprintf(stderr, "ERROR: Could not write to device file \"%s\"!"
+						"\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Hash the source of a device description                                    */
+/*----------------------------------------------------------------------------*/
+/* The version of the program is hashed as well, so files compiled by another */
+/* version never match the source.                                            */
+/* IN source: Content of the source file.                                     */
+/* IN size: Size of the source in bytes.                                      */
+/* RETURNS: Hash of the source (never 0).                                     */
+/*----------------------------------------------------------------------------*/
+uint64_t	hashDeviceSource(uint8_t *source, size_t size)
+{
+	uint64_t hash;
+
+
+	hash = hashBytes(FNV_OFFSET_BASIS, PACKAGE_VERSION, 
+						sizeof(PACKAGE_VERSION));
+	hash = hashBytes(hash, source, size);
+
+	/* 0 is used for files with an unknown source */
+	if(hash == 0)
+		hash = 1;
+
+	return hash;
+}
+
+
+/* Check if a compiled device file has been compiled from a source            */
+/*----------------------------------------------------------------------------*/
+/* IN fileName: Name of the device file (it doesn't need to exist).           */
+/* IN sourceHash: Hash of the source (see hashDeviceSource).                  */
+/* RETURNS: true if the file is an intact device file of this version         */
+/*          compiled from the source, false otherwise.                        */
+/*----------------------------------------------------------------------------*/
+int	deviceFileMatchesSource(char *fileName, uint64_t sourceHash)
+{
+	struct stat fileStatus;
+	uint8_t *data;
+	size_t size;
+	int descriptor;
+	int mapped;
+	int matches;
+
+
+	descriptor = open(fileName, O_RDONLY);
+	if(descriptor < 0)
+		return false;
+
+	if((fstat(descriptor, &fileStatus) != 0) || 
+		(fileStatus.st_size < DEVICE_FILE_HEADER_SIZE) ||
+		(mapFileContent(descriptor, fileStatus.st_size, &data, 
+					&mapped, fileName) != EXIT_SUCCESS))
+	{
+		close(descriptor);
+		return false;
+	}
+	close(descriptor);
+	size = fileStatus.st_size;
+
+	matches = (memcmp(data + MAGIC_OFFSET, DEVICE_FILE_MAGIC, 
+				DEVICE_FILE_MAGIC_LENGTH) == 0) &&
+		(getLittleEndian(data + VERSION_OFFSET, sizeof(uint32_t)) == 
+						DEVICE_FILE_VERSION) &&
+		(getLittleEndian(data + FILE_SIZE_OFFSET, sizeof(uint64_t)) == 
+								size) &&
+		(getLittleEndian(data + SOURCE_HASH_OFFSET, sizeof(uint64_t)) ==
+							sourceHash) &&
+		(getLittleEndian(data + CHECKSUM_OFFSET, sizeof(uint64_t)) == 
+						hashDeviceFile(data, size));
+
+	unmapFileContent(data, size, mapped);
+
+	return matches;
+}
+
+
+/* Check and parse the content of a compiled device file                      */
+/*----------------------------------------------------------------------------*/
+/* The content is set by the caller, the compiled bit orders point into it.   */
+/* OUT device: Device structure to fill.                                      */
+/* IN file: Device file with the content set (data and size).                 */
+/* IN fileName: Name of the device file for error messages.                   */
+/* IN format: Output format the bit orders are used for.                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	parseDeviceFile(deviceData *device, deviceFile *file, char *fileName,
+							outputFormat *format)
+{
+	uint8_t *entry;
+	uint32_t sectionNum;
+	uint64_t tableOffset;
+	uint32_t type;
+	uint32_t parameter;
+	uint64_t offset;
+	uint64_t length;
+	int version;
+	int descriptionFound;
+	int formatIndex;
+	int kind;
+	int mode;
+	int pass;
+	uint32_t section;
+
+
+	memset(&file->bitOrders, 0, sizeof(file->bitOrders));
+	file->bitOrders.format = *format;
+
+	if((file->size < DEVICE_FILE_HEADER_SIZE) || 
+		(memcmp(file->data + MAGIC_OFFSET, DEVICE_FILE_MAGIC, 
+					DEVICE_FILE_MAGIC_LENGTH) != 0))
+	{
+		fprintf(stderr, "ERROR: \"%s\" is not a compiled device "
+						"file!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	version = getLittleEndian(file->data + VERSION_OFFSET, 
+							sizeof(uint32_t));
+	if((version != DEVICE_FILE_VERSION) && 
+				(version != DEVICE_FILE_VERSION2))
+	{
+		fprintf(stderr, "ERROR: The device file \"%s\" has a wrong "
+			"version and could not be loaded!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	sectionNum = getLittleEndian(file->data + SECTION_NUM_OFFSET, 
+							sizeof(uint32_t));
+	tableOffset = getLittleEndian(file->data + SECTION_TABLE_OFFSET, 
+							sizeof(uint32_t));
+	if((getLittleEndian(file->data + HEADER_SIZE_OFFSET, 
+				sizeof(uint32_t)) < DEVICE_FILE_HEADER_SIZE) ||
+		(getLittleEndian(file->data + FILE_SIZE_OFFSET, 
+				sizeof(uint64_t)) != file->size) ||
+		(tableOffset < DEVICE_FILE_HEADER_SIZE) ||
+		(tableOffset + (uint64_t) sectionNum * DEVICE_FILE_ENTRY_SIZE >
+							file->size) ||
+		(getLittleEndian(file->data + CHECKSUM_OFFSET, 
+				sizeof(uint64_t)) != 
+				hashDeviceFile(file->data, file->size)))
+	{
+		fprintf(stderr, "ERROR: The device file \"%s\" is corrupt!"
+							"\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	/* the description and the formats are needed for the tables */
+	descriptionFound = false;
+	formatIndex = -1;
+	for(pass=0; pass < 2; pass++)
+	{
+		entry = file->data + tableOffset;
+		for(section=0; section < sectionNum; section++)
+		{
+			type = getLittleEndian(entry, sizeof(uint32_t));
+			parameter = getLittleEndian(entry + 4, 
+							sizeof(uint32_t));
+			offset = getLittleEndian(entry + 8, sizeof(uint64_t));
+			length = getLittleEndian(entry + 16, sizeof(uint64_t));
+			entry = entry + DEVICE_FILE_ENTRY_SIZE;
+
+			if((offset > file->size) || 
+					(length > file->size - offset))
+			{
+				fprintf(stderr, "ERROR: The device file \"%s\" "
+					"is corrupt!\r\n", fileName);
+				return EXIT_FAILURE;
+			}
+
+			if((pass == 0) && (type == DESCRIPTION_SECTION))
+			{
+				if(getDescription(file->data + offset, length,
+					version, device, fileName) 
+							!= EXIT_SUCCESS)
+					return EXIT_FAILURE;
+				descriptionFound = true;
+			}
+			else if((pass == 0) && (type == FORMAT_SECTION) &&
+				(length >= DEVICE_FILE_FORMAT_SIZE) &&
+				(formatIsUsable(file->data + offset, format) 
+								== true))
+			{
+				formatIndex = parameter;
+			}
+			else if((pass == 1) && (type == TABLE_SECTION) &&
+				((int) (parameter >> 16) == formatIndex))
+			{
+				kind = (parameter >> 8) & 0xFF;
+				mode = parameter & 0xFF;
+				if((kind >= BIT_ORDER_KIND_NUM) || 
+							(mode > VERIFY))
+					continue;
+
+				if(getTable(&file->bitOrders.bitOrder[kind]
+					[mode], file->data + offset, length) 
+							!= EXIT_SUCCESS)
+				{
+					fprintf(stderr, "ERROR: The device file"
+						" \"%s\" contains an invalid "
+						"table!\r\n", fileName);
+					return EXIT_FAILURE;
+				}
+				file->bitOrders.available[kind][mode] = true;
+			}
+		}
+	}
+
+	if(descriptionFound == false)
+	{
+		fprintf(stderr, "ERROR: The device file \"%s\" has no device "
+			"description!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Map or read the whole content of a file                                    */
+/*----------------------------------------------------------------------------*/
+/* The file is mapped into memory if possible, otherwise it is read into      */
+/* allocated memory.                                                          */
+/* IN descriptor: Opened file.                                                */
+/* IN size: Size of the file in bytes (greater than 0).                       */
+/* OUT data: Content of the file.                                             */
+/* OUT mapped: true if the file has been mapped, false if it has been read.   */
+/* IN fileName: Name of the file for error messages.                          */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	mapFileContent(int descriptor, size_t size, uint8_t **data, int *mapped,
+							char *fileName)
+{
+	ssize_t readBytes;
+	size_t offset;
+
+
+	*data = NULL;
+	*mapped = false;
+
+#ifdef HAVE_MMAP
+	*data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if(*data == MAP_FAILED)
+		*data = NULL;
+	else
+		*mapped = true;
+#endif
+
+	/* read the whole file if it can't be mapped */
+	if(*data == NULL)
+	{
+		*data = malloc(size);
+		if(*data == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+							"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+
+		for(offset=0; offset < size; offset += readBytes)
+		{
+			readBytes = pread(descriptor, *data + offset,
+						size - offset, offset);
+			if(readBytes <= 0)
+			{
+				free(*data);
+				*data = NULL;
+				fprintf(stderr, "ERROR: Could not read from "
+					"file \"%s\"!\r\n", fileName);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Release the content of a file                                              */
+/*----------------------------------------------------------------------------*/
+/* IN data: Content of the file (see mapFileContent).                         */
+/* IN size: Size of the file in bytes.                                        */
+/* IN mapped: true if the file has been mapped, false if it has been read.    */
+/*----------------------------------------------------------------------------*/
+void	unmapFileContent(uint8_t *data, size_t size, int mapped)
+{
+#ifdef HAVE_MMAP
+	if(mapped == true)
+	{
+		munmap(data, size);
+		return;
+	}
+#endif
+
+	free(data);
+}
+
+
+/* Load a device file                                                         */
+/*----------------------------------------------------------------------------*/
+/* Compiled device files are mapped into memory if possible and the bit       */
+/* orders compiled for the requested format are prepared to be used by        */
+/* openOutputStream. Version 1 files are loaded with loadDeviceDescription,   */
+/* no bit orders are available then.                                          */
+/* OUT device: Device structure.                                              */
+/* OUT file: Loaded device file (dispose with disposeDeviceFile).             */
+/* IN fileName: Name of the device file.                                      */
+/* IN format: Output format the bit orders are used for.                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	loadDeviceFile(deviceData *device, deviceFile *file, char *fileName,
+							outputFormat *format)
+{
+	uint8_t magic[DEVICE_FILE_MAGIC_LENGTH];
+	struct stat fileStatus;
+	int descriptor;
+	int result;
+
+
+	file->data = NULL;
+	file->size = 0;
+	file->mapped = false;
+	file->ownsData = false;
+	memset(&file->bitOrders, 0, sizeof(file->bitOrders));
+	file->bitOrders.format = *format;
+
+	/* open the file */
+	descriptor = open(fileName, O_RDONLY);
+	if(descriptor < 0)
+	{
+		fprintf(stderr, "ERROR: Could not open device file "
+			"\"%s\"!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	/* files without the magic number are version 1 files */
+	if((fstat(descriptor, &fileStatus) != 0) || 
+		(fileStatus.st_size < DEVICE_FILE_HEADER_SIZE) ||
+		(read(descriptor, magic, sizeof(magic)) != sizeof(magic)) ||
+		(memcmp(magic, DEVICE_FILE_MAGIC, sizeof(magic)) != 0))
+	{
+		close(descriptor);
+		return loadDeviceDescription(device, fileName);
+	}
+
+	/* the tables are used directly from the content */
+	file->size = fileStatus.st_size;
+	result = mapFileContent(descriptor, file->size, &file->data, 
+						&file->mapped, fileName);
+	close(descriptor);
+	if(result != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+	file->ownsData = true;
+
+	if(parseDeviceFile(device, file, fileName, format) != EXIT_SUCCESS)
+	{
+		disposeDeviceFile(file);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Dispose a loaded device file                                               */
+/*----------------------------------------------------------------------------*/
+/* The compiled bit orders of the file can't be used afterwards.              */
+/* IN file: Loaded device file.                                               */
+/*----------------------------------------------------------------------------*/
+void	disposeDeviceFile(deviceFile *file)
+{
+	if((file->data != NULL) && (file->ownsData == true))
+		unmapFileContent(file->data, file->size, file->mapped);
+
+	file->data = NULL;
+	file->size = 0;
+	file->mapped = false;
+	file->ownsData = false;
+	memset(file->bitOrders.available, 0, 
+				sizeof(file->bitOrders.available));
+}
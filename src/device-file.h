@@ -0,0 +1,114 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _DEVICE_FILE_H
+#define _DEVICE_FILE_H
+
+#include "address-cache.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+
+/* identification of compiled device files (version 1 files start with */
+/* deviceDataVersion instead, version 2 files are still loaded) */
+#define DEVICE_FILE_MAGIC		"01ASCII"
+#define DEVICE_FILE_MAGIC_LENGTH	8
+#define DEVICE_FILE_VERSION		3
+
+/* sizes of the header, the section table entries and the sections (the */
+/* description is followed by the runs of its bit orders) */
+#define DEVICE_FILE_HEADER_SIZE		64
+#define DEVICE_FILE_ENTRY_SIZE		24
+#define DEVICE_FILE_ALIGNMENT		64
+#define DEVICE_FILE_DESCRIPTION_SIZE	(MAX_DEVICE_NAME_LENGTH + 32)
+#define DEVICE_FILE_BIT_ORDER_SIZE	8
+#define DEVICE_FILE_RUN_SIZE		8
+#define DEVICE_FILE_FORMAT_SIZE		32
+#define DEVICE_FILE_TABLE_HEADER_SIZE	24
+
+/* version 2 files store the bit orders with one byte per bit */
+#define DEVICE_FILE_VERSION2		2
+#define DEVICE_FILE_VERSION2_DESCRIPTION_SIZE	\
+			(DEVICE_FILE_DESCRIPTION_SIZE + 8 * MAX_BIT_ORDER_LENGTH64)
+
+/* number of output formats the bit orders are compiled for */
+#define DEVICE_FILE_FORMAT_NUM		2
+
+/* section types */
+enum {DESCRIPTION_SECTION = 1, FORMAT_SECTION, TABLE_SECTION};
+
+
+/* datatype for a loaded device file */
+typedef struct
+{
+	/* content of the file (mapped or read), the content of files in a */
+	/* library is owned by the library */
+	uint8_t *data;
+	size_t size;
+	int mapped;
+	int ownsData;
+
+	/* bit orders compiled in advance for the requested format, the */
+	/* tables point into the content of the file */
+	precompiledBitOrders bitOrders;
+}
+deviceFile;
+
+
+extern	void	putLittleEndian(uint8_t *, uint64_t, int);
+extern	uint64_t	getLittleEndian(uint8_t *, int);
+extern	int	buildDeviceFile(deviceData *, uint64_t, uint8_t **, uint64_t *);
+extern	int	saveDeviceFile(deviceData *, uint64_t, char *);
+extern	uint64_t	hashDeviceSource(uint8_t *, size_t);
+extern	int	deviceFileMatchesSource(char *, uint64_t);
+extern	int	parseDeviceFile(deviceData *, deviceFile *, char *, 
+							outputFormat *);
+extern	int	mapFileContent(int, size_t, uint8_t **, int *, char *);
+extern	void	unmapFileContent(uint8_t *, size_t, int);
+extern	int	loadDeviceFile(deviceData *, deviceFile *, char *, 
+							outputFormat *);
+extern	void	disposeDeviceFile(deviceFile *);
+
+#endif /* _DEVICE_FILE_H */
@@ -0,0 +1,502 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* A device library holds many compiled device files (see device-file.c) in   */
+/* one file. A hash index keyed by the device name follows the header, the    */
+/* device files follow the index. A library is mapped once and every device   */
+/* is found with a lookup in the index, its device file is used in place.     */
+/*                                                                            */
+/* Header (64 bytes):                                                         */
+/*   0 magic "01ASCLB\0", 8 version, 12 header size, 16 file size,            */
+/*   24 number of devices, 28 number of buckets, 32 checksum (FNV-1a of the   */
+/*   header and the index with the checksum cleared), 40 offset of the index  */
+/* Buckets (24 bytes, linear probing, an offset of 0 marks an empty bucket):  */
+/*   0 hash of the device name, 8 offset of the device file, 16 its length    */
+/*----------------------------------------------------------------------------*/
+
+#include "device-library.h"
+
+
+/* offsets of the header entries */
+#define VERSION_OFFSET		8
+#define HEADER_SIZE_OFFSET	12
+#define FILE_SIZE_OFFSET	16
+#define DEVICE_NUM_OFFSET	24
+#define BUCKET_NUM_OFFSET	28
+#define CHECKSUM_OFFSET		32
+#define INDEX_OFFSET		40
+
+
+/* Hash the name of a device                                                  */
+/*----------------------------------------------------------------------------*/
+/* IN name: Name of the device.                                               */
+/* RETURNS: Hash of the name.                                                 */
+/*----------------------------------------------------------------------------*/
+uint64_t	hashDeviceName(char *name)
+{
+	return hashBytes(FNV_OFFSET_BASIS, name, strlen(name));
+}
+
+
+/* Hash the header and the index of a library                                 */
+/*----------------------------------------------------------------------------*/
+/* The checksum stored in the header is hashed as if it was cleared.          */
+/* IN header: Header of the library.                                          */
+/* IN index: Index of the library.                                            */
+/* IN bucketNum: Number of buckets of the index.                              */
+/* RETURNS: Checksum of the library.                                          */
+/*----------------------------------------------------------------------------*/
+static uint64_t	hashDeviceLibrary(uint8_t *header, uint8_t *index, 
+							uint32_t bucketNum)
+{
+	uint8_t clearedChecksum[sizeof(uint64_t)];
+	uint64_t hash;
+
+
+	memset(clearedChecksum, 0, sizeof(clearedChecksum));
+
+	hash = hashBytes(FNV_OFFSET_BASIS, header, CHECKSUM_OFFSET);
+	hash = hashBytes(hash, clearedChecksum, sizeof(clearedChecksum));
+	hash = hashBytes(hash, header + CHECKSUM_OFFSET + sizeof(uint64_t),
+			DEVICE_LIBRARY_HEADER_SIZE - CHECKSUM_OFFSET - 
+							sizeof(uint64_t));
+	hash = hashBytes(hash, index, 
+			(size_t) bucketNum * DEVICE_LIBRARY_BUCKET_SIZE);
+
+	return hash;
+}
+
+
+/* Write zeros up to the alignment of the device files                        */
+/*----------------------------------------------------------------------------*/
+/* IN file: Library file.                                                     */
+/* IN offset: Current position in the file.                                   */
+/* RETURNS: Aligned position in the file or 0 if a failure occurred.          */
+/*----------------------------------------------------------------------------*/
+static uint64_t	alignLibraryFile(FILE *file, uint64_t offset)
+{
+	uint8_t zeros[DEVICE_FILE_ALIGNMENT];
+	size_t length;
+
+
+	memset(zeros, 0, sizeof(zeros));
+	length = (DEVICE_FILE_ALIGNMENT - offset % DEVICE_FILE_ALIGNMENT) % 
+							DEVICE_FILE_ALIGNMENT;
+	if(fwrite(zeros, sizeof(uint8_t), length, file) != length)
+		return 0;
+
+	return offset + length;
+}
+
+
+/* Save a device library                                                      */
+/*----------------------------------------------------------------------------*/
+/* Every device needs a unique name.                                          */
+/* IN devices: Devices to save.                                               */
+/* IN deviceNum: Number of devices.                                           */
+/* IN fileName: Name of the library file.                                     */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	saveDeviceLibrary(deviceData *devices, int deviceNum, char *fileName)
+{
+	uint8_t header[DEVICE_LIBRARY_HEADER_SIZE];
+	uint8_t *index;
+	uint8_t *bucket;
+	int *bucketDevice;
+	uint32_t bucketNum;
+	uint64_t hash;
+	uint64_t offset;
+	uint64_t size;
+	uint8_t *data;
+	int device;
+	int result;
+	FILE *file;
+
+
+	/* at most half of the buckets are used */
+	bucketNum = 2;
+	while(bucketNum < 2 * (uint32_t) deviceNum)
+		bucketNum = 2 * bucketNum;
+
+	index = calloc(bucketNum, DEVICE_LIBRARY_BUCKET_SIZE);
+	bucketDevice = malloc(bucketNum * sizeof(int));
+	if((index == NULL) || (bucketDevice == NULL))
+	{
+		free(index);
+		free(bucketDevice);
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	/* create the file */
+	file = fopen(fileName, "wb+");
+	if(file == NULL)
+	{
+		free(index);
+		free(bucketDevice);
+		fprintf(stderr, "ERROR: Could not create device library "
+			"\"%s\"!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	/* the header and the index are written after the device files */
+	result = EXIT_SUCCESS;
+	memset(header, 0, sizeof(header));
+	offset = 0;
+	if(fseek(file, DEVICE_LIBRARY_HEADER_SIZE + (long) bucketNum * 
+				DEVICE_LIBRARY_BUCKET_SIZE, SEEK_SET) == 0)
+		offset = alignLibraryFile(file, DEVICE_LIBRARY_HEADER_SIZE + 
+			(uint64_t) bucketNum * DEVICE_LIBRARY_BUCKET_SIZE);
+	if(offset == 0)
+		result = EXIT_FAILURE;
+
+	for(device=0; (device < deviceNum) && (result == EXIT_SUCCESS); 
+								device++)
+	{
+		if(strcmp(devices[device].name, "") == 0)
+		{
+			fprintf(stderr, "ERROR: A device of the library \"%s\" "
+				"has no devicename!\r\n", fileName);
+			result = EXIT_FAILURE;
+			break;
+		}
+
+		/* find a free bucket */
+		hash = hashDeviceName(devices[device].name);
+		bucket = index + (hash & (bucketNum - 1)) * 
+						DEVICE_LIBRARY_BUCKET_SIZE;
+		while(getLittleEndian(bucket + 8, sizeof(uint64_t)) != 0)
+		{
+			if((getLittleEndian(bucket, sizeof(uint64_t)) == 
+								hash) &&
+				(strcmp(devices[bucketDevice[(bucket - index) /
+				DEVICE_LIBRARY_BUCKET_SIZE]].name, 
+				devices[device].name) == 0))
+			{
+				fprintf(stderr, "ERROR: The device \"%s\" is "
+					"defined twice!\r\n", 
+					devices[device].name);
+				result = EXIT_FAILURE;
+				break;
+			}
+
+			bucket = bucket + DEVICE_LIBRARY_BUCKET_SIZE;
+			if(bucket == index + bucketNum * 
+						DEVICE_LIBRARY_BUCKET_SIZE)
+				bucket = index;
+		}
+
+		if(result != EXIT_SUCCESS)
+			break;
+
+		/* append the device file */
+		if(buildDeviceFile(&devices[device], 0, &data, &size) != 
+								EXIT_SUCCESS)
+		{
+			result = EXIT_FAILURE;
+			break;
+		}
+
+		if(fwrite(data, sizeof(uint8_t), size, file) != size)
+			result = EXIT_FAILURE;
+		free(data);
+
+		putLittleEndian(bucket, hash, sizeof(uint64_t));
+		putLittleEndian(bucket + 8, offset, sizeof(uint64_t));
+		putLittleEndian(bucket + 16, size, sizeof(uint64_t));
+		bucketDevice[(bucket - index) / DEVICE_LIBRARY_BUCKET_SIZE] = 
+									device;
+
+		if(result == EXIT_SUCCESS)
+			offset = alignLibraryFile(file, offset + size);
+		if(offset == 0)
+			result = EXIT_FAILURE;
+	}
+
+	/* header and index */
+	if(result == EXIT_SUCCESS)
+	{
+		memcpy(header, DEVICE_LIBRARY_MAGIC, 
+					sizeof(DEVICE_LIBRARY_MAGIC));
+		putLittleEndian(header + VERSION_OFFSET, 
+				DEVICE_LIBRARY_VERSION, sizeof(uint32_t));
+		putLittleEndian(header + HEADER_SIZE_OFFSET, 
+				DEVICE_LIBRARY_HEADER_SIZE, sizeof(uint32_t));
+		putLittleEndian(header + FILE_SIZE_OFFSET, offset, 
+							sizeof(uint64_t));
+		putLittleEndian(header + DEVICE_NUM_OFFSET, deviceNum, 
+							sizeof(uint32_t));
+		putLittleEndian(header + BUCKET_NUM_OFFSET, bucketNum, 
+							sizeof(uint32_t));
+		putLittleEndian(header + INDEX_OFFSET, 
+			DEVICE_LIBRARY_HEADER_SIZE, sizeof(uint64_t));
+		putLittleEndian(header + CHECKSUM_OFFSET, hashDeviceLibrary(
+			header, index, bucketNum), sizeof(uint64_t));
+
+		if((fseek(file, 0, SEEK_SET) != 0) ||
+			(fwrite(header, sizeof(uint8_t), sizeof(header), file) 
+							!= sizeof(header)) ||
+			(fwrite(index, DEVICE_LIBRARY_BUCKET_SIZE, bucketNum, 
+						file) != bucketNum))
+			result = EXIT_FAILURE;
+	}
+
+	free(index);
+	free(bucketDevice);
+	if(fclose(file) != 0)
+		result = EXIT_FAILURE;
+
+	if(result != EXIT_SUCCESS)
+	{
+		fprintf(stderr, "ERROR: Could not write the device library "
+			"\"%s\"!\r\n", fileName);
+		remove(fileName);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Open a device library                                                      */
+/*----------------------------------------------------------------------------*/
+/* The library is mapped into memory if possible and the header and the index */
+/* are checked. The device files are checked when they are loaded.            */
+/* OUT library: Opened library (close it with closeDeviceLibrary).            */
+/* IN fileName: Name of the library file.                                     */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	openDeviceLibrary(deviceLibrary *library, char *fileName)
+{
+	struct stat fileStatus;
+	uint64_t indexOffset;
+	int descriptor;
+	int result;
+
+
+	library->data = NULL;
+	library->size = 0;
+	library->mapped = false;
+	strncpy(library->fileName, fileName, FILENAME_MAX - 1);
+	library->fileName[FILENAME_MAX - 1] = '\0';
+
+	/* open the file */
+	descriptor = open(fileName, O_RDONLY);
+	if(descriptor < 0)
+	{
+		fprintf(stderr, "ERROR: Could not open device library "
+			"\"%s\"!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	if((fstat(descriptor, &fileStatus) != 0) || 
+		(fileStatus.st_size < DEVICE_LIBRARY_HEADER_SIZE))
+	{
+		close(descriptor);
+		fprintf(stderr, "ERROR: \"%s\" is not a device library!\r\n",
+								fileName);
+		return EXIT_FAILURE;
+	}
+
+	library->size = fileStatus.st_size;
+	result = mapFileContent(descriptor, library->size, &library->data,
+						&library->mapped, fileName);
+	close(descriptor);
+	if(result != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	if(memcmp(library->data, DEVICE_LIBRARY_MAGIC, 
+					DEVICE_LIBRARY_MAGIC_LENGTH) != 0)
+	{
+		closeDeviceLibrary(library);
+		fprintf(stderr, "ERROR: \"%s\" is not a device library!\r\n",
+								fileName);
+		return EXIT_FAILURE;
+	}
+
+	if(getLittleEndian(library->data + VERSION_OFFSET, sizeof(uint32_t)) 
+						!= DEVICE_LIBRARY_VERSION)
+	{
+		closeDeviceLibrary(library);
+		fprintf(stderr, "ERROR: The device library \"%s\" has a wrong "
+			"version and could not be loaded!\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	/* check the header and the index */
+	library->deviceNum = getLittleEndian(library->data + 
+					DEVICE_NUM_OFFSET, sizeof(uint32_t));
+	library->bucketNum = getLittleEndian(library->data + 
+					BUCKET_NUM_OFFSET, sizeof(uint32_t));
+	indexOffset = getLittleEndian(library->data + INDEX_OFFSET, 
+							sizeof(uint64_t));
+	if((getLittleEndian(library->data + HEADER_SIZE_OFFSET, 
+			sizeof(uint32_t)) < DEVICE_LIBRARY_HEADER_SIZE) ||
+		(getLittleEndian(library->data + FILE_SIZE_OFFSET, 
+				sizeof(uint64_t)) != library->size) ||
+		(library->bucketNum == 0) || 
+		((library->bucketNum & (library->bucketNum - 1)) != 0) ||
+		(library->deviceNum > library->bucketNum) ||
+		(indexOffset < DEVICE_LIBRARY_HEADER_SIZE) ||
+		(indexOffset > library->size) ||
+		((uint64_t) library->bucketNum * DEVICE_LIBRARY_BUCKET_SIZE > 
+					library->size - indexOffset))
+	{
+		closeDeviceLibrary(library);
+		fprintf(stderr, "ERROR: The device library \"%s\" is corrupt!"
+							"\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	library->index = library->data + indexOffset;
+	if(getLittleEndian(library->data + CHECKSUM_OFFSET, sizeof(uint64_t))
+			!= hashDeviceLibrary(library->data, library->index,
+							library->bucketNum))
+	{
+		closeDeviceLibrary(library);
+		fprintf(stderr, "ERROR: The device library \"%s\" is corrupt!"
+							"\r\n", fileName);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Load a device of a library                                                 */
+/*----------------------------------------------------------------------------*/
+/* The device file is used in place, the library has to stay open as long as */
+/* the device file is used.                                                   */
+/* OUT device: Device structure.                                              */
+/* OUT file: Device file of the device (dispose with disposeDeviceFile).      */
+/* IN library: Opened library.                                                */
+/* IN name: Name of the device.                                               */
+/* IN format: Output format the bit orders are used for.                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	loadLibraryDevice(deviceData *device, deviceFile *file, 
+		deviceLibrary *library, char *name, outputFormat *format)
+{
+	uint8_t *bucket;
+	uint32_t probe;
+	uint64_t hash;
+	uint64_t offset;
+	uint64_t length;
+
+
+	file->data = NULL;
+	file->size = 0;
+	file->mapped = false;
+	file->ownsData = false;
+
+	hash = hashDeviceName(name);
+	bucket = library->index + (hash & (library->bucketNum - 1)) * 
+						DEVICE_LIBRARY_BUCKET_SIZE;
+
+	for(probe=0; probe < library->bucketNum; probe++)
+	{
+		offset = getLittleEndian(bucket + 8, sizeof(uint64_t));
+		length = getLittleEndian(bucket + 16, sizeof(uint64_t));
+
+		/* an empty bucket ends the search */
+		if(offset == 0)
+			break;
+
+		if(getLittleEndian(bucket, sizeof(uint64_t)) == hash)
+		{
+			if((offset > library->size) || 
+					(length > library->size - offset))
+			{
+				fprintf(stderr, "ERROR: The device library "
+					"\"%s\" is corrupt!\r\n", 
+					library->fileName);
+				return EXIT_FAILURE;
+			}
+
+			file->data = library->data + offset;
+			file->size = length;
+			if(parseDeviceFile(device, file, library->fileName, 
+							format) != EXIT_SUCCESS)
+			{
+				disposeDeviceFile(file);
+				return EXIT_FAILURE;
+			}
+
+			/* different names may have the same hash */
+			if(strcmp(device->name, name) == 0)
+				return EXIT_SUCCESS;
+
+			disposeDeviceFile(file);
+		}
+
+		bucket = bucket + DEVICE_LIBRARY_BUCKET_SIZE;
+		if(bucket == library->index + library->bucketNum * 
+						DEVICE_LIBRARY_BUCKET_SIZE)
+			bucket = library->index;
+	}
+
+	fprintf(stderr, "ERROR: The device \"%s\" is not part of the device "
+			"library \"%s\"!\r\n", name, library->fileName);
+	return EXIT_FAILURE;
+}
+
+
+/* Close a device library                                                     */
+/*----------------------------------------------------------------------------*/
+/* The device files loaded from the library can't be used afterwards.         */
+/* IN library: Opened library.                                                */
+/*----------------------------------------------------------------------------*/
+void	closeDeviceLibrary(deviceLibrary *library)
+{
+	if(library->data != NULL)
+		unmapFileContent(library->data, library->size, 
+							library->mapped);
+
+	library->data = NULL;
+	library->index = NULL;
+	library->size = 0;
+	library->mapped = false;
+	library->bucketNum = 0;
+	library->deviceNum = 0;
+}
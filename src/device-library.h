@@ -0,0 +1,86 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _DEVICE_LIBRARY_H
+#define _DEVICE_LIBRARY_H
+
+#include "device-file.h"
+
+
+/* identification of device libraries */
+#define DEVICE_LIBRARY_MAGIC		"01ASCLB"
+#define DEVICE_LIBRARY_MAGIC_LENGTH	8
+#define DEVICE_LIBRARY_VERSION		1
+
+/* sizes of the header and the buckets of the index */
+#define DEVICE_LIBRARY_HEADER_SIZE	64
+#define DEVICE_LIBRARY_BUCKET_SIZE	24
+
+
+/* datatype for an opened device library */
+typedef struct
+{
+	/* content of the library (mapped or read) */
+	uint8_t *data;
+	size_t size;
+	int mapped;
+
+	/* hash index of the devices (the number of buckets is a power of 2) */
+	uint8_t *index;
+	uint32_t bucketNum;
+	uint32_t deviceNum;
+
+	/* name of the library for error messages */
+	char fileName[FILENAME_MAX];
+}
+deviceLibrary;
+
+
+extern	uint64_t	hashDeviceName(char *);
+extern	int	saveDeviceLibrary(deviceData *, int, char *);
+extern	int	openDeviceLibrary(deviceLibrary *, char *);
+extern	int	loadLibraryDevice(deviceData *, deviceFile *, deviceLibrary *, 
+						char *, outputFormat *);
+extern	void	closeDeviceLibrary(deviceLibrary *);
+
+#endif /* _DEVICE_LIBRARY_H */
@@ -77,38 +77,325 @@ uint8_t	calculateChecksum(hexFileLine line)
 }
 
 
-/* Save the hex line to the program data                                      */
+/* value of the hex digits (0xFF for characters that are no hex digits) */
+static const uint8_t hexDigitValue[256] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+/* Check if a hex line is within the address boundaries of the device         */
 /*----------------------------------------------------------------------------*/
-/* Save the data of the hex file line to programData at the appropriate       */
-/* address.                                                                   */
-/* IN line: Line to be saved.                                                 */
+/* IN line: Line to be checked.                                               */
+/* IN device: Description of the device whose data to be stored.              */
+/* RETURNS: true if all bytes of the line are within the memory of the device,*/
+/*          false otherwise.                                                  */
+/*----------------------------------------------------------------------------*/
+int	hexLineIsWithinDevice(hexFileLine *line, deviceData *device)
+{
+	/* check if the addresses are within the address boundaries */
+	if(device->startAddress > line->extendedAddress + line->address)
+		return false;
+
+	if((line->extendedAddress + line->address + line->byteCount)
+				>= (device->startAddress + device->memorySize))
+		return false;
+
+	/* the end of the line must not wrap around */
+	if((line->extendedAddress + line->address + line->byteCount) <
+				(line->extendedAddress + line->address))
+		return false;
+
+	return true;
+}
+
+
+/* Initialize a hex decoding task                                             */
+/*----------------------------------------------------------------------------*/
+/* The task covers no text and starts without an extended address.            */
+/* OUT task: Task to be initialized.                                          */
+/* IN fileName: Name of the hex file (for error messages).                    */
 /* IN device: Description of the device whose data to be stored.              */
-/* OUT programData: Program data where to store the line.                     */
+/* INOUT image: Memory image where the data is stored or NULL if the data     */
+/*              records are indexed.                                          */
+/* IN imageLock: Lock for allocating blocks of the image or NULL if the image */
+/*               is only written by this task.                                */
+/*----------------------------------------------------------------------------*/
+void	initializeHexDecodingTask(hexDecodingTask *task, char *fileName,
+			deviceData *device, memoryImage *image, 
+			pthread_mutex_t *imageLock)
+{
+	task->fileName = fileName;
+	task->device = device;
+	task->image = image;
+	task->imageLock = imageLock;
+
+	task->text = NULL;
+	task->start = 0;
+	task->end = 0;
+	task->lastChunk = true;
+
+	task->extendedAddress = 0;
+	task->lineNumber = 0;
+
+	task->lastBlock = 0;
+	task->lastBlockData = NULL;
+
+	task->ranges = NULL;
+	task->rangeNum = 0;
+	task->rangeSize = 0;
+
+	task->notices = NULL;
+	task->noticeNum = 0;
+
+	task->records = NULL;
+	task->recordNum = 0;
+	task->recordSize = 0;
+
+	task->endOfFile = false;
+	task->error = NO_HEX_ERROR;
+	task->errorLine = 0;
+}
+
+
+/* Dispose a hex decoding task                                                */
+/*----------------------------------------------------------------------------*/
+/* INOUT task: Task whose lists are freed.                                    */
+/*----------------------------------------------------------------------------*/
+void	disposeHexDecodingTask(hexDecodingTask *task)
+{
+	free(task->ranges);
+	free(task->notices);
+	free(task->records);
+	task->ranges = NULL;
+	task->notices = NULL;
+	task->records = NULL;
+	task->recordNum = 0;
+	task->recordSize = 0;
+	task->rangeNum = 0;
+	task->rangeSize = 0;
+	task->noticeNum = 0;
+}
+
+
+/* Get a block of the memory image of a hex decoding task for writing         */
+/*----------------------------------------------------------------------------*/
+/* The block written last is remembered, so the lock of a shared image is     */
+/* only taken when a task moves on to another block.                          */
+/* INOUT task: Task writing the block.                                        */
+/* IN block: Number of the block.                                             */
+/* RETURNS: Pointer to the data of the block or NULL if the block could not   */
+/*          be allocated.                                                     */
+/*----------------------------------------------------------------------------*/
+uint8_t	*getHexDecodingBlock(hexDecodingTask *task, uint32_64_t block)
+{
+	if((task->lastBlockData == NULL) || (task->lastBlock != block))
+	{
+		if(task->imageLock != NULL)
+			pthread_mutex_lock(task->imageLock);
+
+		task->lastBlockData = allocateMemoryBlock(task->image, block);
+
+		if(task->imageLock != NULL)
+			pthread_mutex_unlock(task->imageLock);
+
+		task->lastBlock = block;
+	}
+
+	return task->lastBlockData;
+}
+
+
+/* Add a memory range to the ranges written by a hex decoding task            */
+/*----------------------------------------------------------------------------*/
+/* A range continuing the range added last is merged with it.                 */
+/* INOUT task: Task writing the range.                                        */
+/* IN offset: Start of the range relative to the start of the memory.         */
+/* IN length: Length of the range in bytes.                                   */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	saveHexLineToProgramData(hexFileLine line, deviceData *device,
-							uint8_t *programData)
+int	addHexRange(hexDecodingTask *task, uint32_64_t offset, 
+							uint32_64_t length)
 {
-	int	byte;
+	uint32_64_t *ranges;
 
 
-	/* check if the addresses are within the address boundaries */
-	if(device->startAddress > line.extendedAddress + line.address)
+	if((task->rangeNum > 0) && 
+			(task->ranges[2*task->rangeNum-1] == offset))
+	{
+		task->ranges[2*task->rangeNum-1] = offset + length;
+		return EXIT_SUCCESS;
+	}
+
+	if(task->rangeNum == task->rangeSize)
+	{
+		ranges = realloc(task->ranges, 2 * (2*task->rangeSize + 16) * 
+							sizeof(*ranges));
+		if(ranges == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+				"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+
+		task->ranges = ranges;
+		task->rangeSize = 2*task->rangeSize + 16;
+	}
+
+	task->ranges[2*task->rangeNum] = offset;
+	task->ranges[2*task->rangeNum+1] = offset + length;
+	task->rangeNum++;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Store the data of a hex line                                               */
+/*----------------------------------------------------------------------------*/
+/* The data is copied block by block to the memory image of the task.         */
+/* INOUT task: Task storing the line.                                         */
+/* IN line: Line to be stored.                                                */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	storeHexLine(hexDecodingTask *task, hexFileLine *line)
+{
+	uint8_t *data;
+	uint32_64_t byte;
+	uint32_64_t length;
+	uint32_64_t offset;
+	memoryImage *image;
+
+
+	if(hexLineIsWithinDevice(line, task->device) != true)
 		return EXIT_FAILURE;
 
-	if((line.extendedAddress + line.address + line.byteCount)
-				>= (device->startAddress + device->memorySize))
+	/* copy bytes to the memory image */
+	image = task->image;
+	offset = (uint32_t) (line->extendedAddress + line->address) - 
+						task->device->startAddress;
+	for(byte=0; byte < line->byteCount; byte += length)
+	{
+		length = image->blockSize - (offset + byte) % image->blockSize;
+		if(length > line->byteCount - byte)
+			length = line->byteCount - byte;
+
+		data = getHexDecodingBlock(task, (offset + byte) / 
+							image->blockSize);
+		if(data == NULL)
+			return EXIT_FAILURE;
+
+		memcpy(data + (offset + byte) % image->blockSize, 
+					line->data + byte, length);
+	}
+
+	if(line->byteCount > 0)
+		return addHexRange(task, offset, line->byteCount);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Add a hex line to the record index of a hex decoding task                  */
+/*----------------------------------------------------------------------------*/
+/* Only the location of the data is stored, the data is decoded again when it */
+/* is needed.                                                                 */
+/* INOUT task: Task indexing the line.                                        */
+/* IN line: Decoded data record.                                              */
+/* IN position: Position of the data digits of the line in the file.          */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	indexHexLine(hexDecodingTask *task, hexFileLine *line, size_t position)
+{
+	hexRecord *record;
+	hexRecord *records;
+
+
+	if(hexLineIsWithinDevice(line, task->device) != true)
 		return EXIT_FAILURE;
 
-	/* copy bytes to programData */
-	for(byte=0; byte < line.byteCount; byte++)
-		programData[line.extendedAddress + line.address + byte - 
-					device->startAddress] = line.data[byte];
+	if(line->byteCount == 0)
+		return EXIT_SUCCESS;
+
+	if(task->recordNum == task->recordSize)
+	{
+		records = realloc(task->records, (2*task->recordSize + 64) * 
+							sizeof(*records));
+		if(records == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+				"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+
+		task->records = records;
+		task->recordSize = 2*task->recordSize + 64;
+	}
+
+	record = &task->records[task->recordNum++];
+	record->offset = (uint32_t) (line->extendedAddress + line->address) - 
+						task->device->startAddress;
+	record->position = position;
+	record->length = line->byteCount;
 
 	return EXIT_SUCCESS;
 }
 
 
+/* Save the hex line to the program data                                      */
+/*----------------------------------------------------------------------------*/
+/* Save the data of the hex file line to the memory image at the appropriate  */
+/* address.                                                                   */
+/* IN line: Line to be saved.                                                 */
+/* IN device: Description of the device whose data to be stored.              */
+/* INOUT image: Memory image where to store the line.                         */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	saveHexLineToProgramData(hexFileLine *line, deviceData *device,
+							memoryImage *image)
+{
+	int result;
+	hexDecodingTask task;
+
+
+	initializeHexDecodingTask(&task, "", device, image, NULL);
+	result = storeHexLine(&task, line);
+	disposeHexDecodingTask(&task);
+
+	return result;
+}
+
+
 /* Convert hex data into decimal data                                         */
 /*----------------------------------------------------------------------------*/
 /* Converts the hexadecimal data in hexBuffer into decimal data by combining  */
@@ -126,135 +413,322 @@ int	convertHexToDecBuffer(uint8_t *hexBuffer, uint8_t *decBuffer,
 							uint8_t hexBufferLength)
 {
 	uint8_t digit;
-	uint8_t offset;
+	uint8_t value;
 
 
 	for(digit=0; digit<hexBufferLength; digit++)
 	{
 		/* check for invalid characters */
-		if(isxdigit(hexBuffer[digit]) == 0)
+		value = hexDigitValue[hexBuffer[digit]];
+		if(value == 0xFF)
 			return EXIT_FAILURE;
 
-		/* distinguish between digits and letters */
-		hexBuffer[digit] = toupper(hexBuffer[digit]);
-		if(isdigit(hexBuffer[digit]) != 0)
-			offset = '0';
-		else
-			offset = 'A' - 10;
-
 		/* convert digit */
 		if(digit % 2)
-			decBuffer[digit/2] += (hexBuffer[digit] - offset);
+			decBuffer[digit/2] += value;
 		else
-			decBuffer[digit/2] = (hexBuffer[digit] - offset) << 4;
+			decBuffer[digit/2] = value << 4;
 	}
 
 	return EXIT_SUCCESS;
 }
 
 
-/* Read a complete hex file and stores it into an array                       */
+/* Decode bytes of a hex file line                                            */
 /*----------------------------------------------------------------------------*/
-/* The function converts the data of the hex file into binary data and stores */ 
-/* it in programData. programData must be a byte array with at least of       */
-/* device->memorySize bytes size.                                             */
-/* A failure is returned if the hex is inconsistent or can not be read.       */
-/* IN fileName: Name of the hex file to be read.                              */
-/* IN device: Description of the device whose data to be stored.              */
-/* OUT programData: Byte array that contains the read data.                   */
+/* Two hex digits are decoded to one byte at once. The decoded bytes are      */
+/* added to a checksum on the fly.                                            */
+/* IN text: Hex digits to be decoded.                                         */
+/* IN textLength: Number of characters left in the line.                      */
+/* OUT bytes: Array where the decoded bytes are stored.                       */
+/* IN byteNum: Number of bytes to be decoded.                                 */
+/* INOUT sum: Sum of the bytes decoded so far.                                */
+/* RETURNS: EXIT_FAILURE if the line is too short or contains a character     */
+/*          that is no hex digit, EXIT_SUCCESS otherwise.                     */
+/*----------------------------------------------------------------------------*/
+int	decodeHexBytes(uint8_t *text, size_t textLength, uint8_t *bytes, 
+						int byteNum, uint8_t *sum)
+{
+	int byte;
+	uint8_t high;
+	uint8_t low;
+
+
+	if(textLength < 2 * (size_t) byteNum)
+		return EXIT_FAILURE;
+
+	for(byte=0; byte < byteNum; byte++)
+	{
+		high = hexDigitValue[text[2*byte]];
+		low = hexDigitValue[text[2*byte+1]];
+
+		/* invalid characters have the upper bits set */
+		if((high | low) & 0xF0)
+			return EXIT_FAILURE;
+
+		bytes[byte] = (high << 4) | low;
+		*sum += bytes[byte];
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Map a complete input file into memory                                      */
+/*----------------------------------------------------------------------------*/
+/* Regular files are mapped read-only. Other files (like pipes) are read      */
+/* into an allocated buffer.                                                  */
+/* IN fileName: Name of the file to be mapped.                                */
+/* OUT text: Content of the file.                                             */
+/* OUT length: Length of the file in bytes.                                   */
+/* OUT mapped: true if the file is mapped, false if it has been read.         */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	readHexFile(char *fileName, deviceData *device, uint8_t *programData)
+int	mapInputFile(char *fileName, uint8_t **text, size_t *length, 
+								int *mapped)
 {
-	int endOfFile;
-	uint8_t	decBuffer[MAX_LINE_DATA_LENGTH];
-	uint8_t	hexBuffer[MAX_LINE_LENGTH];
-	uint32_64_t lineNumber;
-	FILE *file;
-	hexFileLine line;
+	int file;
+	size_t size;
+	ssize_t readBytes;
+	uint8_t *newText;
+	struct stat fileStatus;
 
 
-	/* open input file */
-	file = fopen(fileName, "rb");
-	if(file == NULL)
+	file = open(fileName, O_RDONLY);
+	if(file < 0)
 	{
 		fprintf(stderr, "ERROR: Could not open file \"%s\"!\r\n", 
 			fileName);
 		return EXIT_FAILURE;
 	}
 
-	line.extendedAddress = 0;
+#ifdef HAVE_POSIX_FADVISE
+	/* the file is read once from the first to the last byte */
+	posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
 
-	lineNumber = 0;
-	endOfFile = false;
-	while(endOfFile == false)
+#ifdef HAVE_MMAP
+	if((fstat(file, &fileStatus) == 0) && (S_ISREG(fileStatus.st_mode))
+		&& (fileStatus.st_size > 0) && 
+		((off_t) (size_t) fileStatus.st_size == fileStatus.st_size))
+	{
+		*text = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE,
+								file, 0);
+		if(*text != MAP_FAILED)
+		{
+#ifdef HAVE_MADVISE
+			madvise(*text, fileStatus.st_size, MADV_SEQUENTIAL);
+			madvise(*text, fileStatus.st_size, MADV_WILLNEED);
+#endif
+			close(file);
+			*length = fileStatus.st_size;
+			*mapped = true;
+			return EXIT_SUCCESS;
+		}
+	}
+#endif
+
+	/* read the file if it can't be mapped (a read error ends the data) */
+	*text = NULL;
+	*length = 0;
+	*mapped = false;
+	size = 0;
+	do
+	{
+		if(*length == size)
+		{
+			size = 2 * size + INPUT_CHUNK_SIZE;
+			newText = realloc(*text, size);
+			if(newText == NULL)
+			{
+				free(*text);
+				close(file);
+				fprintf(stderr, "ERROR: Could not allocate "
+					"enough memory!\r\n");
+				return EXIT_FAILURE;
+			}
+			*text = newText;
+		}
+
+		readBytes = read(file, *text + *length, size - *length);
+		if(readBytes > 0)
+			*length += readBytes;
+	}
+	while((readBytes > 0) || ((readBytes < 0) && (errno == EINTR)));
+
+	close(file);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Unmap an input file                                                        */
+/*----------------------------------------------------------------------------*/
+/* IN text: Content of the file (see mapInputFile).                           */
+/* IN length: Length of the file in bytes.                                    */
+/* IN mapped: true if the file is mapped, false if it has been read.          */
+/*----------------------------------------------------------------------------*/
+void	unmapInputFile(uint8_t *text, size_t length, int mapped)
+{
+#ifdef HAVE_MMAP
+	if(mapped == true)
+	{
+		munmap(text, length);
+		return;
+	}
+#endif
+
+	free(text);
+}
+
+
+/* Find the length of the next line of a hex file                             */
+/*----------------------------------------------------------------------------*/
+/* The lines are split the way fgets splits them into a buffer of             */
+/* MAX_LINE_LENGTH bytes (a line ends after a line feed or when the buffer is */
+/* full).                                                                     */
+/* IN text: Start of the line.                                                */
+/* IN length: Number of characters left in the file.                          */
+/* RETURNS: Length of the line including the line feed.                       */
+/*----------------------------------------------------------------------------*/
+size_t	findHexLineLength(uint8_t *text, size_t length)
+{
+	uint8_t *lineEnd;
+
+
+	if(length > MAX_LINE_LENGTH - 1)
+		length = MAX_LINE_LENGTH - 1;
+
+	lineEnd = memchr(text, '\n', length);
+	if(lineEnd != NULL)
+		length = lineEnd - text + 1;
+
+	return length;
+}
+
+
+/* Decode the records of a part of a hex file                                 */
+/*----------------------------------------------------------------------------*/
+/* Empty lines are skipped, so the line numbers count the non-empty lines.    */
+/* The digits are decoded with a lookup table and the checksum is calculated  */
+/* while decoding. Data records within a single block are decoded straight    */
+/* into the memory image. Without a memory image the data records are only    */
+/* indexed (see indexHexLine).                                                */
+/* Nothing is printed, failures and start address records are stored in the */
+/* task (see reportHexDecodingTasks).                                         */
+/* INOUT task: Task describing the part of the file to be decoded.            */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	decodeHexChunk(hexDecodingTask *task)
+{
+	uint8_t sum;
+	uint8_t *data;
+	uint8_t *lineStart;
+	uint8_t *notices;
+	uint8_t header[LINE_HEADER_BYTE_NUM];
+	size_t position;
+	size_t lineLength;
+	uint32_64_t offset;
+	uint32_64_t lineNumber;
+	memoryImage *image;
+	hexFileLine line;
+
+
+	image = task->image;
+	line.extendedAddress = task->extendedAddress;
+
+	position = task->start;
+	lineNumber = task->lineNumber;
+	while(task->endOfFile == false)
 	{
 		lineNumber++;
 
-		/* read line */
-		hexBuffer[0] = '\r';
-		while(hexBuffer[0] == '\r' || hexBuffer[0] == '\n')
+		/* find the next line (empty lines are skipped) */
+		do
 		{
-			if(fgets((char *)hexBuffer, MAX_LINE_LENGTH, file) == 0)
+			/* the file must end with an end of file record */
+			if(position >= task->end)
 			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Could not read from "
-					"file \"%s\"!\r\n       Maybe an End Of"
-					" File record is missing.\r\n", 
-					fileName);
+				if(task->lastChunk != true)
+					return EXIT_SUCCESS;
+
+				task->error = HEX_READ_ERROR;
+				task->errorLine = lineNumber;
 				return EXIT_FAILURE;
 			}
+
+			lineStart = task->text + position;
+			lineLength = findHexLineLength(lineStart, 
+							task->end - position);
+			position += lineLength;
 		}
+		while(lineStart[0] == '\r' || lineStart[0] == '\n');
+
+		/* failures are reported at this line from now on */
+		task->errorLine = lineNumber;
 
 		/* check for start code */
-		if(hexBuffer[0] != START_CODE)
+		if(lineStart[0] != START_CODE)
 		{
-			fclose(file);
-			fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
-				"       No start code found at line %lu!\r\n", 
-				fileName, lineNumber);
+			task->error = HEX_START_CODE_ERROR;
 			return EXIT_FAILURE;
 		}
 
-		/* convert data to decimal numbers */
-		if(convertHexToDecBuffer(hexBuffer+1, decBuffer, 
-					LINE_HEADER_LENGTH-1) != EXIT_SUCCESS)
+		/* decode and save header data */
+		sum = 0;
+		if(decodeHexBytes(lineStart + 1, lineLength - 1, header, 
+				LINE_HEADER_BYTE_NUM, &sum) != EXIT_SUCCESS)
 		{
-			fclose(file);
-			fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
-				"       Invalid character at line %lu!\r\n", 
-				fileName, lineNumber);
+			task->error = HEX_CHARACTER_ERROR;
 			return EXIT_FAILURE;
 		}
 
-		/* save header data */
-		line.byteCount = decBuffer[BYTE_COUNT_POS];
-		line.recordType = decBuffer[RECORD_TYPE_POS];
-		line.address = decBuffer[ADDRESS_POS+1] + 
-						(decBuffer[ADDRESS_POS] << 8);
+		line.byteCount = header[BYTE_COUNT_POS];
+		line.recordType = header[RECORD_TYPE_POS];
+		line.address = header[ADDRESS_POS+1] + 
+						(header[ADDRESS_POS] << 8);
 
-		/* convert data to decimal numbers */
-		if(convertHexToDecBuffer(hexBuffer + LINE_HEADER_LENGTH,
-			decBuffer, (line.byteCount+1)*2) != EXIT_SUCCESS)
+		/* data within a single block is decoded into the image */
+		data = line.data;
+		if((image != NULL) && (line.recordType == DATA_RECORD) && 
+			(line.byteCount > 0) &&
+			(hexLineIsWithinDevice(&line, task->device) == true))
 		{
-			fclose(file);
-			fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
-				"       Invalid character at line %lu!\r\n", 
-				fileName, lineNumber);
-			return EXIT_FAILURE;
+			offset = (uint32_t) (line.extendedAddress + 
+				line.address) - task->device->startAddress;
+			if(offset % image->blockSize + line.byteCount <= 
+							image->blockSize)
+			{
+				data = getHexDecodingBlock(task, 
+						offset / image->blockSize);
+				if((data == NULL) || (addHexRange(task, offset,
+					line.byteCount) != EXIT_SUCCESS))
+				{
+					task->error = HEX_MEMORY_ERROR;
+					return EXIT_FAILURE;
+				}
+
+				data += offset % image->blockSize;
+			}
 		}
 
-		/* save data and checksum */
-		memcpy(line.data, decBuffer, line.byteCount);
-		line.checksum = decBuffer[line.byteCount];
+		/* decode data and checksum */
+		if((decodeHexBytes(lineStart + LINE_HEADER_LENGTH, 
+			lineLength - LINE_HEADER_LENGTH, data, 
+			line.byteCount, &sum) != EXIT_SUCCESS) ||
+			(decodeHexBytes(lineStart + LINE_HEADER_LENGTH + 
+			2 * line.byteCount, lineLength - LINE_HEADER_LENGTH - 
+			2 * line.byteCount, &line.checksum, 1, &sum) 
+							!= EXIT_SUCCESS))
+		{
+			task->error = HEX_CHARACTER_ERROR;
+			return EXIT_FAILURE;
+		}
 
-		/* check for correct checksum */
-		if(line.checksum != calculateChecksum(line))
+		/* check for correct checksum (all bytes add up to 0) */
+		if(sum != 0)
 		{
-			fclose(file);
-			fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
-				"       Invalid checksum at line %lu!\r\n", 
-				fileName, lineNumber);
+			task->error = HEX_CHECKSUM_ERROR;
 			return EXIT_FAILURE;
 		}
 
@@ -262,16 +736,20 @@ int	readHexFile(char *fileName, deviceData *device, uint8_t *programData)
 		switch(line.recordType)
 		{
 			case DATA_RECORD:
-			/* save data to device structure */
-			if(saveHexLineToProgramData(line, device, programData) 
-								!= EXIT_SUCCESS)
+			/* index the data if there is no image */
+			if((image == NULL) && (indexHexLine(task, &line, 
+				lineStart + LINE_HEADER_LENGTH - task->text) 
+							!= EXIT_SUCCESS))
+			{
+				task->error = HEX_ADDRESS_ERROR;
+				return EXIT_FAILURE;
+			}
+
+			/* save data not decoded into the image so far */
+			if((image != NULL) && (data == line.data) && 
+				(storeHexLine(task, &line) != EXIT_SUCCESS))
 			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Failure in hex file "
-					"\"%s\"!\r\n       The address at line "
-					"%lu is not within the address "
-					"boundaries of the device!\r\n", 
-					fileName, lineNumber);
+				task->error = HEX_ADDRESS_ERROR;
 				return EXIT_FAILURE;
 			}
 			break;
@@ -280,28 +758,19 @@ int	readHexFile(char *fileName, deviceData *device, uint8_t *programData)
 			/* byte count must be 0x00 and address must be 0x0000 */
 			if(line.byteCount != 0 || line.address != 0)
 			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Failure in hex file "
-					"\"%s\"!\r\n       Invalid end of file "
-					"record at line %lu!\r\n", fileName, 
-					lineNumber);
+				task->error = HEX_END_OF_FILE_ERROR;
 				return EXIT_FAILURE;
 			}
 
 			/* last record -> exit loop */
-			endOfFile = true;
+			task->endOfFile = true;
 			break;
 
 			case EXTENDED_SEGMENT_ADDRESS_RECORD:
 			/* byte count must be 0x02 and address must be 0x0000 */
 			if(line.byteCount != 2 || line.address != 0)
 			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Failure in hex file \" "
-					"%s\"!\r\n       Invalid extended "
-					"segment address record at line %lu!\r"
-					"\n", fileName, 
-					lineNumber);
+				task->error = HEX_EXTENDED_SEGMENT_ERROR;
 				return EXIT_FAILURE;
 			}
 
@@ -310,36 +779,11 @@ int	readHexFile(char *fileName, deviceData *device, uint8_t *programData)
 							(line.data[1] << 4);
 			break;
 
-			case START_SEGMENT_ADDRESS_RECORD:
-			/* byte count must be 0x04 and address must be 0x0000 */
-			if(line.byteCount != 4 || line.address != 0)
-			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Failure in hex file "
-					"\"%s\"!\r\n       Invalid start "
-					"segment address record at line %lu!\r"
-					"\n", fileName, 
-					lineNumber);
-				return EXIT_FAILURE;
-			}
-
-			/* ignore start segment address record */
-			/* (not needed for programming flash) */
-			fprintf(stdout, "Found \"start segment address\" "
-				"record in hex file!\r\n       The record is "
-				"not needed for flash programming and "
-				"therefore will be ignored!\r\n");
-			break;
-
 			case EXTENDED_LINEAR_ADDRESS_RECORD:
 			/* byte count must be 0x02 and address must be 0x0000 */
 			if(line.byteCount != 2 || line.address != 0)
 			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Failure in hex file \" "
-					"%s\"!\r\n       Invalid extended "
-					"linear address record at line %lu!\r\n"
-					, fileName, lineNumber);
+				task->error = HEX_EXTENDED_LINEAR_ERROR;
 				return EXIT_FAILURE;
 			}
 
@@ -348,37 +792,592 @@ int	readHexFile(char *fileName, deviceData *device, uint8_t *programData)
 							(line.data[1] << 16);
 			break;
 
+			case START_SEGMENT_ADDRESS_RECORD:
 			case START_LINEAR_ADDRESS_RECORD:
 			/* byte count must be 0x04 and address must be 0x0000 */
 			if(line.byteCount != 4 || line.address != 0)
 			{
-				fclose(file);
-				fprintf(stderr, "ERROR: Failure in hex file "
-					"\"%s\"!\r\n       Invalid start "
-					"linear address record at line %lu!\r\n"
-					, fileName, lineNumber);
+				if(line.recordType == START_SEGMENT_ADDRESS_RECORD)
+					task->error = HEX_START_SEGMENT_ERROR;
+				else
+					task->error = HEX_START_LINEAR_ERROR;
 				return EXIT_FAILURE;
 			}
 
-			/* ignore start linear address record */
-			/* (not needed for programming flash) */
-			fprintf(stdout, "Found \"start linear address\" "
-				"record in hex file!\r\n       The record is "
-				"not needed for flash programming and "
-				"therefore will be ignored!\r\n");
+			/* remember the record for the notice */
+			notices = realloc(task->notices, task->noticeNum + 1);
+			if(notices == NULL)
+			{
+				task->error = HEX_MEMORY_ERROR;
+				return EXIT_FAILURE;
+			}
+			task->notices = notices;
+			task->notices[task->noticeNum++] = line.recordType;
 			break;
 
 			default:
-			fclose(file);
-			fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
-				"       Invalid record type at line %lu!\r\n",
-				fileName, lineNumber);
+			task->error = HEX_RECORD_TYPE_ERROR;
 			return EXIT_FAILURE;
 		}
 	}
 
-	fclose(file);
+	return EXIT_SUCCESS;
+}
+
+
+/* Run a hex decoding task                                                    */
+/*----------------------------------------------------------------------------*/
+/* Thread function decoding the part of a hex file described by a task.       */
+/* IN argument: Hex decoding task (the result is stored in the task).         */
+/* RETURNS: NULL                                                              */
+/*----------------------------------------------------------------------------*/
+void	*runHexDecodingTask(void *argument)
+{
+	decodeHexChunk((hexDecodingTask *) argument);
+
+	return NULL;
+}
+
+
+/* Split a hex file into parts decoded by different tasks                     */
+/*----------------------------------------------------------------------------*/
+/* The file is split into parts of about the same size at line feeds, where   */
+/* fgets would start a new line too. The lines are scanned once to count the  */
+/* non-empty lines and to find the extended address records before each part. */
+/* An invalid extended address record doesn't matter, because decoding fails  */
+/* at this record before any later part is reported.                          */
+/* INOUT tasks: Initialized tasks to be assigned to the parts.                */
+/* IN taskNum: Number of tasks.                                               */
+/* IN text: Content of the hex file.                                          */
+/* IN textLength: Length of the content in bytes.                             */
+/*----------------------------------------------------------------------------*/
+void	splitHexFile(hexDecodingTask *tasks, int taskNum, uint8_t *text,
+							size_t textLength)
+{
+	int task;
+	uint8_t sum;
+	uint8_t bytes[LINE_HEADER_BYTE_NUM + 2];
+	size_t position;
+	size_t lineLength;
+	uint32_t extendedAddress;
+	uint32_64_t lineNumber;
+
+
+	position = 0;
+	lineNumber = 0;
+	extendedAddress = 0;
+	for(task=0; task < taskNum; task++)
+	{
+		tasks[task].text = text;
+		tasks[task].start = position;
+		tasks[task].lastChunk = (task == taskNum-1);
+		tasks[task].extendedAddress = extendedAddress;
+		tasks[task].lineNumber = lineNumber;
+
+		/* the last part ends with the file */
+		if(task == taskNum-1)
+		{
+			tasks[task].end = textLength;
+			break;
+		}
+
+		/* scan the lines up to the next line feed after the split */
+		while((position < textLength) && 
+			((position < textLength / taskNum * (task+1)) ||
+					(text[position-1] != '\n')))
+		{
+			lineLength = findHexLineLength(text + position, 
+						textLength - position);
+
+			if(text[position] != '\r' && text[position] != '\n')
+				lineNumber++;
+
+			/* extended address records (":02000002" and ":02000004") */
+			if((lineLength >= LINE_HEADER_LENGTH + 4) &&
+				(text[position] == START_CODE) &&
+				(text[position+7] == '0') &&
+				((text[position+8] == '2') || 
+					(text[position+8] == '4')) &&
+				(decodeHexBytes(text + position + 1, 
+					lineLength - 1, bytes, 
+					LINE_HEADER_BYTE_NUM + 2, &sum) 
+							== EXIT_SUCCESS))
+			{
+				if(bytes[RECORD_TYPE_POS] == 
+					EXTENDED_SEGMENT_ADDRESS_RECORD)
+					extendedAddress = 
+					(bytes[LINE_HEADER_BYTE_NUM] << 12) +
+					(bytes[LINE_HEADER_BYTE_NUM+1] << 4);
+				else
+					extendedAddress = 
+					(bytes[LINE_HEADER_BYTE_NUM] << 24) +
+					(bytes[LINE_HEADER_BYTE_NUM+1] << 16);
+			}
+
+			position += lineLength;
+		}
+
+		tasks[task].end = position;
+	}
+}
+
+
+/* Print a failure found while decoding a hex file                            */
+/*----------------------------------------------------------------------------*/
+/* IN fileName: Name of the hex file.                                         */
+/* IN error: Failure (see hexDecodingTask).                                   */
+/* IN lineNumber: Line where the failure was found.                           */
+/*----------------------------------------------------------------------------*/
+void	printHexError(char *fileName, int error, uint32_64_t lineNumber)
+{
+	switch(error)
+	{
+		case HEX_READ_ERROR:
+		fprintf(stderr, "ERROR: Could not read from file \"%s\"!\r\n"
+			"       Maybe an End Of File record is missing.\r\n", 
+			fileName);
+		break;
+
+		case HEX_START_CODE_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       No start code found at line %lu!\r\n", 
+			fileName, lineNumber);
+		break;
+
+		case HEX_CHARACTER_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       Invalid character at line %lu!\r\n", 
+			fileName, lineNumber);
+		break;
+
+		case HEX_CHECKSUM_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       Invalid checksum at line %lu!\r\n", 
+			fileName, lineNumber);
+		break;
+
+		case HEX_ADDRESS_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       The address at line %lu is not within the "
+			"address boundaries of the device!\r\n", 
+			fileName, lineNumber);
+		break;
+
+		case HEX_END_OF_FILE_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       Invalid end of file record at line %lu!\r\n", 
+			fileName, lineNumber);
+		break;
+
+		case HEX_EXTENDED_SEGMENT_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \" %s\"!\r\n"
+			"       Invalid extended segment address record at "
+			"line %lu!\r\n", fileName, lineNumber);
+		break;
+
+		case HEX_START_SEGMENT_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       Invalid start segment address record at line "
+			"%lu!\r\n", fileName, lineNumber);
+		break;
+
+		case HEX_EXTENDED_LINEAR_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \" %s\"!\r\n"
+			"       Invalid extended linear address record at line"
+			" %lu!\r\n", fileName, lineNumber);
+		break;
+
+		case HEX_START_LINEAR_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       Invalid start linear address record at line "
+			"%lu!\r\n", fileName, lineNumber);
+		break;
+
+		case HEX_RECORD_TYPE_ERROR:
+		fprintf(stderr, "ERROR: Failure in hex file \"%s\"!\r\n"
+			"       Invalid record type at line %lu!\r\n",
+			fileName, lineNumber);
+		break;
+
+		/* allocation failures have been reported already */
+		default:
+		break;
+	}
+}
+
+
+/* Compare two memory ranges by their start                                   */
+/*----------------------------------------------------------------------------*/
+/* Comparison function for qsort.                                             */
+/* IN first: First range.                                                     */
+/* IN second: Second range.                                                   */
+/* RETURNS: Negative, zero or positive if the first range starts before, at   */
+/*          or after the second range.                                        */
+/*----------------------------------------------------------------------------*/
+int	compareHexRanges(const void *first, const void *second)
+{
+	const hexRange *firstRange = first;
+	const hexRange *secondRange = second;
+
+
+	if(firstRange->start < secondRange->start)
+		return -1;
+
+	return (firstRange->start > secondRange->start);
+}
+
+
+/* Check if the memory ranges of different hex decoding tasks overlap         */
+/*----------------------------------------------------------------------------*/
+/* The ranges are sorted and every range is compared with the end of the    */
+/* range of another task reaching furthest so far.                            */
+/* IN tasks: Tasks whose ranges to be checked.                                */
+/* IN taskNum: Number of tasks.                                               */
+/* OUT overlap: true if ranges of different tasks overlap, false otherwise.   */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	findHexRangeOverlap(hexDecodingTask *tasks, int taskNum, int *overlap)
+{
+	int task;
+	int firstTask;
+	size_t range;
+	size_t rangeNum;
+	hexRange *ranges;
+	uint32_64_t firstEnd;
+	uint32_64_t secondEnd;
+
+
+	rangeNum = 0;
+	for(task=0; task < taskNum; task++)
+		rangeNum += tasks[task].rangeNum;
+
+	ranges = malloc((rangeNum + 1) * sizeof(*ranges));
+	if(ranges == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	rangeNum = 0;
+	for(task=0; task < taskNum; task++)
+	{
+		for(range=0; range < tasks[task].rangeNum; range++)
+		{
+			ranges[rangeNum].start = tasks[task].ranges[2*range];
+			ranges[rangeNum].end = tasks[task].ranges[2*range+1];
+			ranges[rangeNum].task = task;
+			rangeNum++;
+		}
+	}
+
+	qsort(ranges, rangeNum, sizeof(*ranges), compareHexRanges);
+
+	/* range reaching furthest and furthest range of another task */
+	*overlap = false;
+	firstTask = -1;
+	firstEnd = 0;
+	secondEnd = 0;
+	for(range=0; (range < rangeNum) && (*overlap == false); range++)
+	{
+		if(ranges[range].task != firstTask)
+			*overlap = (ranges[range].start < firstEnd);
+		else
+			*overlap = (ranges[range].start < secondEnd);
+
+		if(ranges[range].end > firstEnd)
+		{
+			if(ranges[range].task != firstTask)
+				secondEnd = firstEnd;
+			firstTask = ranges[range].task;
+			firstEnd = ranges[range].end;
+		}
+		else if((ranges[range].task != firstTask) && 
+					(ranges[range].end > secondEnd))
+			secondEnd = ranges[range].end;
+	}
+
+	free(ranges);
 
 	return EXIT_SUCCESS;
 }
 
+
+/* Report the results of hex decoding tasks                                   */
+/*----------------------------------------------------------------------------*/
+/* The results are reported in the order of the file, so the notices and the  */
+/* failure are the same as if the file was decoded by a single task.          */
+/* The tasks must be decoded again by a single task if a part before the last */
+/* one contains the end of file record (the following parts must be ignored)  */
+/* or if the tasks wrote overlapping ranges (the order of writing matters).   */
+/* IN fileName: Name of the hex file.                                         */
+/* IN tasks: Decoded tasks.                                                   */
+/* IN taskNum: Number of tasks.                                               */
+/* OUT decodeAgain: true if the file must be decoded by a single task.        */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	reportHexDecodingTasks(char *fileName, hexDecodingTask *tasks,
+					int taskNum, int *decodeAgain)
+{
+	int task;
+	int lastTask;
+	size_t notice;
+
+
+	*decodeAgain = false;
+
+	/* find the first part ending the decoding */
+	for(lastTask=0; lastTask < taskNum-1; lastTask++)
+	{
+		if((tasks[lastTask].error != NO_HEX_ERROR) || 
+					(tasks[lastTask].endOfFile == true))
+			break;
+	}
+
+	if((tasks[lastTask].error == NO_HEX_ERROR) && (lastTask < taskNum-1))
+	{
+		*decodeAgain = true;
+		return EXIT_SUCCESS;
+	}
+
+	if((tasks[lastTask].error == NO_HEX_ERROR) && (taskNum > 1))
+	{
+		if(findHexRangeOverlap(tasks, taskNum, decodeAgain) 
+							!= EXIT_SUCCESS)
+			return EXIT_FAILURE;
+
+		if(*decodeAgain == true)
+			return EXIT_SUCCESS;
+	}
+
+	/* notices of the parts before the end */
+	for(task=0; task <= lastTask; task++)
+	{
+		for(notice=0; notice < tasks[task].noticeNum; notice++)
+		{
+			/* ignore start address records */
+			/* (not needed for programming flash) */
+			if(tasks[task].notices[notice] == 
+						START_SEGMENT_ADDRESS_RECORD)
+				fprintf(stdout, "Found \"start segment "
+					"address\" record in hex file!\r\n"
+					"       The record is not needed for "
+					"flash programming and therefore will "
+					"be ignored!\r\n");
+			else
+				fprintf(stdout, "Found \"start linear "
+					"address\" record in hex file!\r\n"
+					"       The record is not needed for "
+					"flash programming and therefore will "
+					"be ignored!\r\n");
+		}
+	}
+
+	if(tasks[lastTask].error != NO_HEX_ERROR)
+	{
+		printHexError(fileName, tasks[lastTask].error, 
+						tasks[lastTask].errorLine);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Decode the records of a hex file                                           */
+/*----------------------------------------------------------------------------*/
+/* The file is split into parts decoded by several threads, which write to    */
+/* the memory image directly. Blocks are allocated under a lock.              */
+/* If the parts can not be decoded independently, the image is cleared and    */
+/* the file is decoded again by a single thread.                              */
+/* IN fileName: Name of the hex file (for error messages).                    */
+/* IN text: Content of the hex file.                                          */
+/* IN textLength: Length of the content in bytes.                             */
+/* IN device: Description of the device whose data to be stored.              */
+/* INOUT image: Empty memory image where the decoded data is stored.          */
+/* IN threadNum: Maximal number of threads to be used.                        */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	decodeHexFile(char *fileName, uint8_t *text, size_t textLength,
+		deviceData *device, memoryImage *image, int threadNum)
+{
+	int task;
+	int taskNum;
+	int result;
+	int decodeAgain;
+	uint32_64_t block;
+	pthread_t *threads;
+	int *threadStarted;
+	hexDecodingTask *tasks;
+	pthread_mutex_t imageLock;
+
+
+	taskNum = threadNum;
+	if((size_t) taskNum > textLength / HEX_CHUNK_MIN_SIZE)
+		taskNum = textLength / HEX_CHUNK_MIN_SIZE;
+	if(taskNum < 1)
+		taskNum = 1;
+
+	tasks = malloc(taskNum * sizeof(*tasks));
+	threads = malloc(taskNum * sizeof(*threads));
+	threadStarted = malloc(taskNum * sizeof(*threadStarted));
+	if((tasks == NULL) || (threads == NULL) || (threadStarted == NULL))
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		free(tasks);
+		free(threads);
+		free(threadStarted);
+		return EXIT_FAILURE;
+	}
+
+	pthread_mutex_init(&imageLock, NULL);
+
+	for(task=0; task < taskNum; task++)
+		initializeHexDecodingTask(&tasks[task], fileName, device, 
+			image, (taskNum > 1) ? &imageLock : NULL);
+
+	splitHexFile(tasks, taskNum, text, textLength);
+
+	/* the calling thread decodes a part if a thread can not be started */
+	for(task=1; task < taskNum; task++)
+		threadStarted[task] = (pthread_create(&threads[task], NULL, 
+			runHexDecodingTask, &tasks[task]) == 0);
+
+	decodeHexChunk(&tasks[0]);
+
+	for(task=1; task < taskNum; task++)
+	{
+		if(threadStarted[task])
+			pthread_join(threads[task], NULL);
+		else
+			decodeHexChunk(&tasks[task]);
+	}
+
+	result = reportHexDecodingTasks(fileName, tasks, taskNum, 
+								&decodeAgain);
+
+	for(task=0; task < taskNum; task++)
+		disposeHexDecodingTask(&tasks[task]);
+
+	if((result == EXIT_SUCCESS) && (decodeAgain == true))
+	{
+		for(block=0; block < image->blockNum; block++)
+			releaseMemoryBlock(image, block);
+
+		initializeHexDecodingTask(&tasks[0], fileName, device, image,
+									NULL);
+		splitHexFile(tasks, 1, text, textLength);
+		decodeHexChunk(&tasks[0]);
+		result = reportHexDecodingTasks(fileName, tasks, 1, 
+								&decodeAgain);
+		disposeHexDecodingTask(&tasks[0]);
+	}
+
+	pthread_mutex_destroy(&imageLock);
+
+	free(tasks);
+	free(threads);
+	free(threadStarted);
+
+	return result;
+}
+
+
+/* Index the data records of a hex file                                       */
+/*----------------------------------------------------------------------------*/
+/* The file is checked like it is checked by readHexFile, but the data is not */
+/* stored. Instead the memory offset, the position in the file and the length */
+/* of each data record are collected in file order.                           */
+/* IN fileName: Name of the hex file (for error messages).                    */
+/* IN text: Content of the hex file.                                          */
+/* IN textLength: Length of the content in bytes.                             */
+/* IN device: Description of the device whose data to be stored.              */
+/* OUT records: Allocated list of the records (to be freed by the caller).    */
+/* OUT recordNum: Number of records.                                          */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	indexHexFile(char *fileName, uint8_t *text, size_t textLength,
+		deviceData *device, hexRecord **records, size_t *recordNum)
+{
+	int result;
+	int decodeAgain;
+	hexDecodingTask task;
+
+
+	initializeHexDecodingTask(&task, fileName, device, NULL, NULL);
+	splitHexFile(&task, 1, text, textLength);
+	decodeHexChunk(&task);
+	result = reportHexDecodingTasks(fileName, &task, 1, &decodeAgain);
+
+	/* hand over the records */
+	*records = task.records;
+	*recordNum = task.recordNum;
+	task.records = NULL;
+	disposeHexDecodingTask(&task);
+
+	if(result != EXIT_SUCCESS)
+	{
+		free(*records);
+		*records = NULL;
+		*recordNum = 0;
+	}
+
+	return result;
+}
+
+
+/* Read a complete hex file using several threads                             */
+/*----------------------------------------------------------------------------*/
+/* The function converts the data of the hex file into binary data and stores */ 
+/* it in the memory image. Only the blocks written by data records are        */
+/* allocated, so only these blocks have to be checked at the end. If the      */
+/* record coverage is used, the check is skipped and the blocks written by    */
+/* data records are the used blocks (blank blocks written explicitly are      */
+/* used too).                                                                 */
+/* The file is mapped into memory and decoded by decodeHexFile.               */
+/* A failure is returned if the hex is inconsistent or can not be read.       */
+/* IN fileName: Name of the hex file to be read.                              */
+/* IN device: Description of the device whose data to be stored.              */
+/* INOUT image: Empty memory image where the read data is stored.             */
+/* IN threadNum: Maximal number of threads to be used.                        */
+/* IN recordCoverage: If recordCoverage is true, blank blocks are not         */
+/*                    released.                                               */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	readHexFileParallel(char *fileName, deviceData *device, 
+			memoryImage *image, int threadNum, int recordCoverage)
+{
+	int mapped;
+	int result;
+	uint8_t *text;
+	size_t textLength;
+
+
+	/* map input file */
+	if(mapInputFile(fileName, &text, &textLength, &mapped) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	result = decodeHexFile(fileName, text, textLength, device, image, 
+								threadNum);
+
+	unmapInputFile(text, textLength, mapped);
+
+	/* blocks may have been overwritten with 0xFF */
+	if((result == EXIT_SUCCESS) && (recordCoverage != true))
+		releaseBlankBlocks(image, 0, image->blockNum);
+
+	return result;
+}
+
+
+/* Read a complete hex file and stores it into an array                       */
+/*----------------------------------------------------------------------------*/
+/* The file is decoded by a single thread (see readHexFileParallel).          */
+/* IN fileName: Name of the hex file to be read.                              */
+/* IN device: Description of the device whose data to be stored.              */
+/* INOUT image: Empty memory image where the read data is stored.             */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	readHexFile(char *fileName, deviceData *device, memoryImage *image)
+{
+	return readHexFileParallel(fileName, device, image, 1, false);
+}
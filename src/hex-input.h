@@ -44,6 +44,8 @@
 #ifndef _HEX_INPUT_H
 #define _HEX_INPUT_H
 
+#include <pthread.h>
+
 
 #define START_CODE				':'
 
@@ -56,6 +58,7 @@
 #define MAX_RECORD_TYPE				5
 
 #define	LINE_HEADER_LENGTH			9
+#define	LINE_HEADER_BYTE_NUM			((LINE_HEADER_LENGTH-1)/2)
 
 #define BYTE_COUNT_POS				0
 #define ADDRESS_POS				1
@@ -65,6 +68,16 @@
 #define MAX_LINE_DATA_LENGTH			255
 #define MAX_LINE_LENGTH		(MAX_LINE_DATA_LENGTH+LINE_HEADER_LENGTH+1)*2
 
+/* minimal size of the part of a hex file decoded by one thread */
+#define	HEX_CHUNK_MIN_SIZE			(64*1024)
+
+/* failures found while decoding a hex file */
+enum {NO_HEX_ERROR, HEX_READ_ERROR, HEX_START_CODE_ERROR, HEX_CHARACTER_ERROR,
+	HEX_CHECKSUM_ERROR, HEX_ADDRESS_ERROR, HEX_END_OF_FILE_ERROR, 
+	HEX_EXTENDED_SEGMENT_ERROR, HEX_START_SEGMENT_ERROR, 
+	HEX_EXTENDED_LINEAR_ERROR, HEX_START_LINEAR_ERROR, 
+	HEX_RECORD_TYPE_ERROR, HEX_MEMORY_ERROR};
+
 
 /* datatype for storing information of one hex file line */
 typedef struct
@@ -80,5 +93,79 @@ typedef struct
 hexFileLine;
 
 
+/* datatype for the location of the data of a data record */
+typedef struct
+{
+	/* offset of the data from the start of the memory */
+	uint32_64_t offset;
+
+	/* position of the data digits in the file */
+	size_t position;
+
+	uint8_t length;
+}
+hexRecord;
+
+
+/* datatype for a part of a hex file decoded by one thread */
+typedef struct
+{
+	char *fileName;
+	deviceData *device;
+	memoryImage *image;
+
+	/* lock for allocating blocks (NULL if the image is not shared) */
+	pthread_mutex_t *imageLock;
+
+	/* text of the part (start up to, but not including end) */
+	uint8_t *text;
+	size_t start;
+	size_t end;
+	int lastChunk;
+
+	/* extended address and number of lines before the part */
+	uint32_t extendedAddress;
+	uint32_64_t lineNumber;
+
+	/* block written last */
+	uint32_64_t lastBlock;
+	uint8_t *lastBlockData;
+
+	/* memory ranges written (pairs of start and end offsets) */
+	uint32_64_t *ranges;
+	size_t rangeNum;
+	size_t rangeSize;
+
+	/* data records found if there is no image (see indexHexLine) */
+	hexRecord *records;
+	size_t recordNum;
+	size_t recordSize;
+
+	/* start address records found (reported after decoding) */
+	uint8_t *notices;
+	size_t noticeNum;
+
+	/* state at the end of the part */
+	int endOfFile;
+	int error;
+	uint32_64_t errorLine;
+}
+hexDecodingTask;
+
+
+/* datatype for a memory range written by a hex decoding task */
+typedef struct
+{
+	uint32_64_t start;
+	uint32_64_t end;
+	int task;
+}
+hexRange;
+
+
+extern	int	decodeHexBytes(uint8_t *, size_t, uint8_t *, int, uint8_t *);
+extern	int	indexHexFile(char *, uint8_t *, size_t, deviceData *, hexRecord **,
+								size_t *);
+
 #endif /* _HEX_INPUT_H */
 
@@ -0,0 +1,267 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "hex-stream.h"
+
+
+/* Compare two hex records by their memory offset                             */
+/*----------------------------------------------------------------------------*/
+/* Comparison function for qsort. Records at the same offset are sorted in    */
+/* file order.                                                                */
+/* IN first: First record.                                                    */
+/* IN second: Second record.                                                  */
+/* RETURNS: Negative, zero or positive if the first record is sorted before,  */
+/*          at or after the second record.                                    */
+/*----------------------------------------------------------------------------*/
+int	compareHexRecords(const void *first, const void *second)
+{
+	const hexRecord *firstRecord = first;
+	const hexRecord *secondRecord = second;
+
+
+	if(firstRecord->offset != secondRecord->offset)
+		return (firstRecord->offset < secondRecord->offset) ? -1 : 1;
+
+	return compareHexRecordPositions(first, second);
+}
+
+
+/* Compare two hex records by their position in the file                      */
+/*----------------------------------------------------------------------------*/
+/* Comparison function for qsort.                                             */
+/* IN first: First record.                                                    */
+/* IN second: Second record.                                                  */
+/* RETURNS: Negative, zero or positive if the first record is located before, */
+/*          at or after the second record.                                    */
+/*----------------------------------------------------------------------------*/
+int	compareHexRecordPositions(const void *first, const void *second)
+{
+	const hexRecord *firstRecord = first;
+	const hexRecord *secondRecord = second;
+
+
+	if(firstRecord->position < secondRecord->position)
+		return -1;
+
+	return (firstRecord->position > secondRecord->position);
+}
+
+
+/* Generate the output files from a hex file block by block                  */
+/*----------------------------------------------------------------------------*/
+/* A first pass checks the file and indexes its data records. The index is    */
+/* sorted by memory offset, then every used block is put together from the   */
+/* records overlapping it (in file order, so later records overwrite earlier  */
+/* ones) and rendered at once. The memory needed is proportional to the index */
+/* instead of the memory size of the device and unused blocks are skipped     */
+/* without being looked at.                                                   */
+/* The address cache is not used, because the used blocks are not known       */
+/* before the output is generated.                                            */
+/* IN inputFileName: Name of the hex file to be read.                         */
+/* IN fileNameBase: First part of the output file names.                      */
+/* IN device: Device structure that contains all needed information about the */
+/*            device.                                                         */
+/* IN options: Options of the output generation (see outputOptions).          */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	streamHexFile(char *inputFileName, char *fileNameBase, 
+				deviceData *device, outputOptions *options)
+{
+	int mapped;
+	int result;
+	int streamNum;
+	uint8_t sum;
+	uint8_t *text;
+	uint8_t *blockData;
+	uint8_t data[MAX_LINE_DATA_LENGTH];
+	size_t textLength;
+	size_t record;
+	size_t recordNum;
+	size_t firstRecord;
+	size_t overlapNum;
+	size_t overlapSize;
+	uint32_64_t byte;
+	uint32_64_t block;
+	uint32_64_t blockNum;
+	uint32_64_t blockStart;
+	uint32_64_t blockEnd;
+	uint32_64_t start;
+	uint32_64_t end;
+	hexRecord *records;
+	hexRecord *overlaps;
+	hexRecord *moreOverlaps;
+	outputStream streams[MAX_OUTPUT_STREAM_NUM];
+
+
+	if(checkOutputLayout(device) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* map input file */
+	if(mapInputFile(inputFileName, &text, &textLength, &mapped) 
+							!= EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* check the file and index its data records */
+	if(indexHexFile(inputFileName, text, textLength, device, &records, 
+						&recordNum) != EXIT_SUCCESS)
+	{
+		unmapInputFile(text, textLength, mapped);
+		return EXIT_FAILURE;
+	}
+
+	qsort(records, recordNum, sizeof(*records), compareHexRecords);
+
+	blockData = malloc(device->blockSize);
+	overlapSize = 16;
+	overlaps = malloc(overlapSize * sizeof(*overlaps));
+	if((blockData == NULL) || (overlaps == NULL) || 
+		(openOutputFiles(fileNameBase, device, NULL, options, streams, 
+						&streamNum) != EXIT_SUCCESS))
+	{
+		if((blockData == NULL) || (overlaps == NULL))
+			fprintf(stderr, "ERROR: Could not allocate enough "
+				"memory!\r\n");
+		free(blockData);
+		free(overlaps);
+		free(records);
+		unmapInputFile(text, textLength, mapped);
+		return EXIT_FAILURE;
+	}
+
+	result = EXIT_SUCCESS;
+	firstRecord = 0;
+	blockNum = device->memorySize / device->blockSize;
+	for(block=0; (block < blockNum) && (result == EXIT_SUCCESS); block++)
+	{
+		blockStart = block * device->blockSize;
+		blockEnd = blockStart + device->blockSize;
+
+		/* records starting this far before the block end before it */
+		while((firstRecord < recordNum) && (records[firstRecord].offset
+				+ MAX_LINE_DATA_LENGTH <= blockStart))
+			firstRecord++;
+
+		/* collect the records overlapping the block */
+		overlapNum = 0;
+		for(record=firstRecord; (record < recordNum) && 
+			(records[record].offset < blockEnd); record++)
+		{
+			if(records[record].offset + records[record].length <= 
+								blockStart)
+				continue;
+
+			if(overlapNum == overlapSize)
+			{
+				moreOverlaps = realloc(overlaps, 2 * 
+					overlapSize * sizeof(*overlaps));
+				if(moreOverlaps == NULL)
+				{
+					fprintf(stderr, "ERROR: Could not "
+						"allocate enough memory!\r\n");
+					result = EXIT_FAILURE;
+					break;
+				}
+
+				overlaps = moreOverlaps;
+				overlapSize *= 2;
+			}
+
+			overlaps[overlapNum++] = records[record];
+		}
+
+		if(result != EXIT_SUCCESS)
+			break;
+
+		/* skip the unused blocks up to the next record */
+		if((overlapNum == 0) && (options->generateAllBlocks != true))
+		{
+			if(record >= recordNum)
+				break;
+
+			if(records[record].offset / device->blockSize > block)
+				block = records[record].offset / 
+						device->blockSize - 1;
+			continue;
+		}
+
+		/* put together the block in file order */
+		qsort(overlaps, overlapNum, sizeof(*overlaps), 
+						compareHexRecordPositions);
+
+		memset(blockData, 0xFF, device->blockSize);
+		for(record=0; record < overlapNum; record++)
+		{
+			/* the file has been checked already */
+			decodeHexBytes(text + overlaps[record].position, 
+				2 * overlaps[record].length, data, 
+				overlaps[record].length, &sum);
+
+			start = overlaps[record].offset;
+			end = start + overlaps[record].length;
+			if(start < blockStart)
+				start = blockStart;
+			if(end > blockEnd)
+				end = blockEnd;
+
+			for(byte=start; byte < end; byte++)
+				blockData[byte - blockStart] = 
+					data[byte - overlaps[record].offset];
+		}
+
+		/* blocks written with 0xFF are unused by default */
+		if((options->generateAllBlocks == true) || 
+			((overlapNum > 0) && 
+			((options->recordCoverage == true) ||
+			(isBlankMemory(blockData, device->blockSize) != true))))
+			result = writeOutputBlock(streams, streamNum, device,
+							block, blockData);
+	}
+
+	free(blockData);
+	free(overlaps);
+	free(records);
+	unmapInputFile(text, textLength, mapped);
+
+	return closeOutputFiles(streams, streamNum, options, result);
+}
+
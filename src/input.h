@@ -46,10 +46,23 @@
 
 
 #include "device-description.h"
+#include "used-blocks.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
 
 
-extern	int	readBinFile(char *, deviceData *, uint8_t *);
-extern	int	readHexFile(char *, deviceData *, uint8_t *);
+/* size of the pieces of a bin file read at once (rounded down to blocks) */
+#define INPUT_CHUNK_SIZE	(1024*1024)
+
+
+extern	int	mapBinFile(char *, deviceData *, memoryImage *);
+extern	int	readBinFile(char *, deviceData *, memoryImage *);
+extern	int	mapInputFile(char *, uint8_t **, size_t *, int *);
+extern	void	unmapInputFile(uint8_t *, size_t, int);
+extern	int	readHexFile(char *, deviceData *, memoryImage *);
+extern	int	readHexFileParallel(char *, deviceData *, memoryImage *, int, int);
 
 #endif /* _INPUT_H */
 
@@ -44,43 +44,136 @@
 #include "input.h"
 #include "parser.h"
 #include "converter.h"
+#include "bin-stream.h"
+#include "hex-stream.h"
+#include "device-library.h"
+#include "batch-compile.h"
 
 
 #define COMMAND_POSITION			1
 
 #define	COMPILE_COMMAND				"compile"
+#define COMPILE_LIBRARY_OPTION			"--library"
 #define COMPILE_MIN_ARGUMENT_NUM		4
 
+#define COMPILE_ALL_COMMAND			"compile-all"
+#define COMPILE_ALL_THREADS_OPTION		"-j"
+#define COMPILE_ALL_MIN_ARGUMENT_NUM		4
+
 #define GENERATE_COMMAND			"generate"
 #define GENERATE_ALL_OPTION			"-a"
 #define GENERATE_BINARY_OPTION			"-b"
+#define GENERATE_PACKED_OPTION			"-p"
+#define GENERATE_FORMAT_OPTION			"-f"
 #define GENERATE_HEX_INPUT_OPTION		"-h"
+#define GENERATE_THREADS_OPTION			"-j"
+#define GENERATE_CACHE_OPTION			"-c"
+#define GENERATE_COVERAGE_OPTION		"-r"
+#define GENERATE_STREAM_OPTION			"-s"
+#define GENERATE_MAP_OPTION			"-m"
+#define GENERATE_QUEUE_OPTION			"-u"
+#define GENERATE_STATISTICS_OPTION		"-v"
+#define GENERATE_UNCACHED_OPTION		"-d"
+#define GENERATE_LIBRARY_OPTION			"--library"
+#define GENERATE_DEVICE_OPTION			"--device"
 #define	GENERATE_MIN_ARGUMENT_NUM		5
 
 #define USAGE_STRING "Usage: 01ASCII compile INPUTFILE OUTPUTFILE\r\n"\
+			"       01ASCII compile --library LIBRARYFILE "\
+			"INPUTFILE...\r\n"\
+			"       01ASCII compile-all [-j N] SOURCES "\
+			"OUTPUTDIRECTORY\r\n"\
 			"       01ASCII generate [OPTION] DEVICEFILE INPUTFILE"\
-			" OUTPUTFILE\r\n\r\n       Options:\r\n       -a   "\
+			" OUTPUTFILE\r\n"\
+			"       01ASCII generate [OPTION] --library "\
+			"LIBRARYFILE --device NAME\r\n                        "\
+			"INPUTFILE OUTPUTFILE\r\n\r\n       Options:\r\n       -a   "\
 			"Generate programming data for the whole memory space."\
 			"\r\n            Default is to skip empty blocks.\r\n"\
 			"\r\n       -b   Generate binary output files.\r\n"\
 			"            Default is to generate space separated "\
-			"ascii files.\r\n\r\n       -h   Input file is an "\
+			"ascii files.\r\n\r\n       -p   Generate packed "\
+			"binary output files (most\r\n            significant "\
+			"bit first, every word padded with 0\r\n            "\
+			"bits to whole bytes).\r\n\r\n       -f FORMAT Layout of "\
+			"the ascii output files, a comma\r\n            "\
+			"separated list of bits=01, separator=NAME (none,\r\n"\
+			"            space, tab, comma, semicolon), terminator="\
+			"NAME (none,\r\n            crlf, lf, cr) and words=N "\
+			"(words per line).\r\n            Default is \"bits=01,"\
+			"separator=space,terminator=crlf,\r\n            "\
+			"words=1\".\r\n\r\n       -h   Input file is an "\
 			"intel hex file.\r\n            Default is a binary "\
-			"file.\r\n\r\n\r\n"
+			"file.\r\n\r\n       -j N Use N threads to decode hex "\
+			"files and N threads\r\n            to convert the "\
+			"memory into the output files\r\n            (not "\
+			"with -s). Default is to use a single\r\n            "\
+			"thread.\r\n"\
+			"\r\n       -c DIR Cache the address files in DIR (devices "\
+			"with up to\r\n            256 MiB of address output)."\
+			" Default is to\r\n            generate them every "\
+			"time.\r\n"\
+			"\r\n       -r   Blocks written by hex records are used,"\
+			" even if\r\n            they are empty (only with "\
+			"-h). Default is to\r\n            check the data.\r\n"\
+			"\r\n       -s   Convert the input file block by block "\
+			"(single\r\n            thread, no cache). Default is "\
+			"to read the whole\r\n            file into memory "\
+			"first.\r\n"\
+			"\r\n       -m   Write the output files through memory "\
+			"mappings\r\n            (not with -s). Default is to "\
+			"write them in\r\n            buffered chunks.\r\n"\
+			"\r\n       -u   Queue the writes of the output files "\
+			"with io_uring\r\n            (pwrite if not "\
+			"supported). Default is to write\r\n            "\
+			"synchronously.\r\n"\
+			"\r\n       -d   Keep the output files out of the page "\
+			"cache with\r\n            O_DIRECT or posix_fadvise "\
+			"(not with -m). Default\r\n            is to write "\
+			"them through the page cache.\r\n"\
+			"\r\n       -v   Print how the output files have been "\
+			"written.\r\n"\
+			"\r\n       --library LIBRARYFILE --device NAME\r\n"\
+			"            Use the device NAME of a device library "\
+			"instead\r\n            of a DEVICEFILE.\r\n"\
+			"\r\n       compile-all compiles every source of SOURCES "\
+			"(a directory\r\n       with *.dev files or a file "\
+			"with one source per line)\r\n       into OUTPUTDIRECTORY"\
+			", sources which haven't changed\r\n       since their "\
+			"last compile are skipped. -j N compiles with\r\n"\
+			"       N threads, default is one thread per processor."\
+			"\r\n"\
+			"\r\n\r\n"
 
 
 int main(int argc, char *argv[])
 {
 	int commandFound;
 	int nextArgument;
-	int ascii;
 	int hexInput;
-	int generateAllBlocks;
+	int streamInput;
+	int outputType;
+	char *numberEnd;
+	char *formatDescription;
 	char deviceFileName[FILENAME_MAX];
+	char libraryFileName[FILENAME_MAX];
+	char *deviceName;
+	char **inputFileNames;
+	int inputFileNum;
+	int input;
 	char inputFileName[FILENAME_MAX];
 	char outputFileName[FILENAME_MAX];
 	deviceData device;
-	uint8_t *programData;
+	deviceData *devices;
+	char **sourceNames;
+	int sourceNum;
+	int threadNum;
+	compileStatistics statistics;
+	deviceFile descriptionFile;
+	deviceLibrary library;
+	outputOptions options;
+	memoryImage image;
+	int result;
 
 
 	/* check for minimal number of arguments */
@@ -94,6 +187,7 @@ int main(int argc, char *argv[])
 	commandFound = false;
 	nextArgument = 1;
 	strcpy(deviceFileName, "");
+	strcpy(libraryFileName, "");
 	strcpy(inputFileName, "");
 	strcpy(outputFileName, "");
 
@@ -112,26 +206,103 @@ int main(int argc, char *argv[])
 			return EXIT_FAILURE;
 		}
 
+		/* all arguments except options are input and output files */
+		inputFileNames = malloc(argc * sizeof(char *));
+		if(inputFileNames == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+							"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+		inputFileNum = 0;
+
 		/* process command line arguments */
 		while(nextArgument < argc)
 		{
-			/* input file name */
-			if(strcmp(inputFileName, "") == 0)
-				strcpy(inputFileName, argv[nextArgument]);
-			/* output file name */
-			else if(strcmp(outputFileName, "") == 0)
-				strcpy(outputFileName, argv[nextArgument]);
-			/* unknown argument */
+			/* device library option */
+			if(strcmp(argv[nextArgument], COMPILE_LIBRARY_OPTION) 
+									== 0)
+			{
+				nextArgument++;
+				if(nextArgument >= argc)
+				{
+					free(inputFileNames);
+					fprintf(stderr, "ERROR: Option \"%s\" "
+						"needs a file!\r\n", 
+						COMPILE_LIBRARY_OPTION);
+					fprintf(stderr, USAGE_STRING);
+					return EXIT_FAILURE;
+				}
+				strncpy(libraryFileName, argv[nextArgument],
+							FILENAME_MAX - 1);
+			}
+			/* input or output file name */
 			else
+				inputFileNames[inputFileNum++] = 
+							argv[nextArgument];
+
+			nextArgument++;
+		}
+
+		/* compile all input files into one device library */
+		if(strcmp(libraryFileName, "") != 0)
+		{
+			if(inputFileNum == 0)
 			{
-				fprintf(stderr, "ERROR: Unknown argument \"%s\""
-					"!\r\n", argv[nextArgument]);
+				free(inputFileNames);
+				fprintf(stderr, "ERROR: Missing INPUTFILE!"
+								"\r\n");
 				fprintf(stderr, USAGE_STRING);
 				return EXIT_FAILURE;
 			}
 
-			nextArgument++;
+			devices = malloc(inputFileNum * sizeof(deviceData));
+			if(devices == NULL)
+			{
+				free(inputFileNames);
+				fprintf(stderr, "ERROR: Could not allocate "
+						"enough memory!\r\n");
+				return EXIT_FAILURE;
+			}
+
+			/* parse the source files */
+			result = EXIT_SUCCESS;
+			for(input=0; (input < inputFileNum) && 
+					(result == EXIT_SUCCESS); input++)
+				result = parseSourceFile(inputFileNames[input],
+						&devices[input], stdout);
+
+			/* generate the device library */
+			if(result == EXIT_SUCCESS)
+				result = saveDeviceLibrary(devices, 
+					inputFileNum, libraryFileName);
+
+			free(devices);
+			free(inputFileNames);
+			if(result != EXIT_SUCCESS)
+				return EXIT_FAILURE;
+
+			return EXIT_SUCCESS;
+		}
+
+		/* input file name */
+		if(inputFileNum > 0)
+			strcpy(inputFileName, inputFileNames[0]);
+
+		/* output file name */
+		if(inputFileNum > 1)
+			strcpy(outputFileName, inputFileNames[1]);
+
+		/* unknown argument */
+		if(inputFileNum > 2)
+		{
+			fprintf(stderr, "ERROR: Unknown argument \"%s\"!\r\n",
+							inputFileNames[2]);
+			fprintf(stderr, USAGE_STRING);
+			free(inputFileNames);
+			return EXIT_FAILURE;
 		}
+		free(inputFileNames);
 
 		/* check if input file name has been set */
 		if(strcmp(inputFileName, "") == 0)
@@ -149,10 +320,76 @@ int main(int argc, char *argv[])
 			return EXIT_FAILURE;
 		}
 
-		/* compile source file */
-		if(compileSourceFile(inputFileName, outputFileName) != 
+		/* parse the source file */
+		if(parseSourceFile(inputFileName, &device, stdout) != 
 								EXIT_SUCCESS)
 			return EXIT_FAILURE;
+
+		/* generate the compiled device file */
+		if(saveDeviceFile(&device, 0, outputFileName) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+	}
+
+	/* compile many source files */
+	if(strcmp(argv[COMMAND_POSITION], COMPILE_ALL_COMMAND) == 0)
+	{
+		commandFound = true;
+		nextArgument++;
+
+		/* check the number of arguments for this command */
+		if(argc < COMPILE_ALL_MIN_ARGUMENT_NUM)
+		{
+			fprintf(stderr, "ERROR: Wrong number of arguments!"
+				"\r\n");
+			fprintf(stderr, USAGE_STRING);
+			return EXIT_FAILURE;
+		}
+
+		/* one thread per processor by default */
+		threadNum = sysconf(_SC_NPROCESSORS_ONLN);
+		if(threadNum < 1)
+			threadNum = 1;
+
+		/* number of threads option */
+		if(strcmp(argv[nextArgument], COMPILE_ALL_THREADS_OPTION) == 0)
+		{
+			nextArgument++;
+			threadNum = strtol(argv[nextArgument], &numberEnd, 10);
+
+			if((threadNum < 1) || (*numberEnd != '\0'))
+			{
+				fprintf(stderr, "ERROR: Option \"%s\" needs a "
+					"number of threads greater than 0!\r\n",
+					COMPILE_ALL_THREADS_OPTION);
+				fprintf(stderr, USAGE_STRING);
+				return EXIT_FAILURE;
+			}
+			nextArgument++;
+		}
+
+		/* sources and output directory */
+		if(argc - nextArgument != 2)
+		{
+			fprintf(stderr, "ERROR: Wrong number of arguments!"
+				"\r\n");
+			fprintf(stderr, USAGE_STRING);
+			return EXIT_FAILURE;
+		}
+
+		if(collectDeviceSources(argv[nextArgument], &sourceNames,
+						&sourceNum) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+
+		result = compileDeviceSources(sourceNames, sourceNum,
+				argv[nextArgument+1], threadNum, &statistics);
+		disposeDeviceSources(sourceNames, sourceNum);
+
+		fprintf(stdout, "%i compiled, %i up to date, %i failed\r\n",
+			statistics.compiledNum, statistics.skippedNum,
+			statistics.failedNum);
+
+		if(result != EXIT_SUCCESS)
+			return EXIT_FAILURE;
 	}
 
 	/* generate data and address files */
@@ -171,24 +408,138 @@ int main(int argc, char *argv[])
 		}
 
 		/* option default values */
-		ascii = true;
 		hexInput = false;
-		generateAllBlocks = false;
+		streamInput = false;
+		outputType = ASCII_OUTPUT;
+		formatDescription = NULL;
+		deviceName = NULL;
+		initializeOutputOptions(&options);
 
 		/* process command line arguments */
 		while(nextArgument < argc)
 		{
 			/* generate all blocks option */
 			if(strcmp(argv[nextArgument], GENERATE_ALL_OPTION) == 0)
-				generateAllBlocks = true;
+				options.generateAllBlocks = true;
 			/* generate binary data option */
 			else if(strcmp(argv[nextArgument],
 						GENERATE_BINARY_OPTION) == 0)
-				ascii = false;
+				outputType = BINARY_OUTPUT;
+			/* generate packed binary data option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_PACKED_OPTION) == 0)
+				outputType = PACKED_OUTPUT;
+			/* ascii output format option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_FORMAT_OPTION) == 0)
+			{
+				nextArgument++;
+				if(nextArgument >= argc)
+				{
+					fprintf(stderr, "ERROR: Option \"%s\" "
+						"needs a format!\r\n", 
+						GENERATE_FORMAT_OPTION);
+					fprintf(stderr, USAGE_STRING);
+					return EXIT_FAILURE;
+				}
+				formatDescription = argv[nextArgument];
+			}
 			/* hex file input option */
 			else if(strcmp(argv[nextArgument],
 						GENERATE_HEX_INPUT_OPTION) == 0)
 				hexInput = true;
+			/* number of threads option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_THREADS_OPTION) == 0)
+			{
+				nextArgument++;
+				if(nextArgument < argc)
+					options.threadNum = strtol(
+						argv[nextArgument], &numberEnd,
+									10);
+
+				if((nextArgument >= argc) || (options.threadNum < 1) ||
+					(*numberEnd != '\0'))
+				{
+					fprintf(stderr, "ERROR: Option \"%s\" "
+						"needs a number of threads "
+						"greater than 0!\r\n", 
+						GENERATE_THREADS_OPTION);
+					fprintf(stderr, USAGE_STRING);
+					return EXIT_FAILURE;
+				}
+			}
+			/* hex record coverage option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_COVERAGE_OPTION) == 0)
+				options.recordCoverage = true;
+			/* streaming binary input option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_STREAM_OPTION) == 0)
+				streamInput = true;
+			/* memory mapped output option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_MAP_OPTION) == 0)
+				options.mapOutput = true;
+			/* queued output option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_QUEUE_OPTION) == 0)
+				options.queueOutput = true;
+			/* output statistics option */
+			else if(strcmp(argv[nextArgument],
+					GENERATE_STATISTICS_OPTION) == 0)
+				options.printStatistics = true;
+			/* uncached output option */
+			else if(strcmp(argv[nextArgument],
+					GENERATE_UNCACHED_OPTION) == 0)
+				options.uncacheOutput = true;
+			/* address cache option */
+			else if(strcmp(argv[nextArgument],
+						GENERATE_CACHE_OPTION) == 0)
+			{
+				nextArgument++;
+				if(nextArgument >= argc)
+				{
+					fprintf(stderr, "ERROR: Option \"%s\" "
+						"needs a directory!\r\n", 
+						GENERATE_CACHE_OPTION);
+					fprintf(stderr, USAGE_STRING);
+					return EXIT_FAILURE;
+				}
+				strncpy(options.cacheDirectory, 
+					argv[nextArgument], FILENAME_MAX - 1);
+			}
+			/* device library option */
+			else if(strcmp(argv[nextArgument],
+					GENERATE_LIBRARY_OPTION) == 0)
+			{
+				nextArgument++;
+				if(nextArgument >= argc)
+				{
+					fprintf(stderr, "ERROR: Option \"%s\" "
+						"needs a file!\r\n", 
+						GENERATE_LIBRARY_OPTION);
+					fprintf(stderr, USAGE_STRING);
+					return EXIT_FAILURE;
+				}
+				strncpy(libraryFileName, argv[nextArgument],
+							FILENAME_MAX - 1);
+			}
+			/* device of the library option */
+			else if(strcmp(argv[nextArgument],
+					GENERATE_DEVICE_OPTION) == 0)
+			{
+				nextArgument++;
+				if(nextArgument >= argc)
+				{
+					fprintf(stderr, "ERROR: Option \"%s\" "
+						"needs a device name!\r\n", 
+						GENERATE_DEVICE_OPTION);
+					fprintf(stderr, USAGE_STRING);
+					return EXIT_FAILURE;
+				}
+				deviceName = argv[nextArgument];
+			}
 			/* device file name */
 			else if(strcmp(deviceFileName, "") == 0)
 				strcpy(deviceFileName, argv[nextArgument]);
@@ -210,6 +561,80 @@ int main(int argc, char *argv[])
 			nextArgument++;
 		}
 
+		/* set the output format */
+		initializeOutputFormat(&options.format, outputType);
+		if(formatDescription != NULL)
+		{
+			if(outputType != ASCII_OUTPUT)
+			{
+				fprintf(stderr, "ERROR: Option \"%s\" can only "
+					"be used for ascii output!\r\n", 
+					GENERATE_FORMAT_OPTION);
+				fprintf(stderr, USAGE_STRING);
+				return EXIT_FAILURE;
+			}
+
+			if(parseOutputFormat(&options.format, 
+					formatDescription) != EXIT_SUCCESS)
+				return EXIT_FAILURE;
+		}
+
+		/* the hex records only cover blocks of hex files */
+		if((options.recordCoverage == true) && (hexInput != true))
+		{
+			fprintf(stderr, "ERROR: Option \"%s\" can only be used "
+				"with option \"%s\"!\r\n", 
+				GENERATE_COVERAGE_OPTION, 
+				GENERATE_HEX_INPUT_OPTION);
+			fprintf(stderr, USAGE_STRING);
+			return EXIT_FAILURE;
+		}
+
+		/* streamed output is written block by block */
+		if((options.mapOutput == true) && (streamInput == true))
+		{
+			fprintf(stderr, "ERROR: Option \"%s\" can't be used "
+				"with option \"%s\"!\r\n", 
+				GENERATE_MAP_OPTION, GENERATE_STREAM_OPTION);
+			fprintf(stderr, USAGE_STRING);
+			return EXIT_FAILURE;
+		}
+
+		/* with a device library there is no device file name */
+		if(strcmp(libraryFileName, "") != 0)
+		{
+			if(strcmp(outputFileName, "") != 0)
+			{
+				fprintf(stderr, "ERROR: Unknown argument \"%s\""
+					"!\r\n", outputFileName);
+				fprintf(stderr, USAGE_STRING);
+				return EXIT_FAILURE;
+			}
+
+			if(deviceName == NULL)
+			{
+				fprintf(stderr, "ERROR: Option \"%s\" needs "
+					"option \"%s\"!\r\n", 
+					GENERATE_LIBRARY_OPTION, 
+					GENERATE_DEVICE_OPTION);
+				fprintf(stderr, USAGE_STRING);
+				return EXIT_FAILURE;
+			}
+
+			strcpy(outputFileName, inputFileName);
+			strcpy(inputFileName, deviceFileName);
+			strcpy(deviceFileName, libraryFileName);
+		}
+		else if(deviceName != NULL)
+		{
+			fprintf(stderr, "ERROR: Option \"%s\" can only be used "
+				"with option \"%s\"!\r\n", 
+				GENERATE_DEVICE_OPTION, 
+				GENERATE_LIBRARY_OPTION);
+			fprintf(stderr, USAGE_STRING);
+			return EXIT_FAILURE;
+		}
+
 		/* check if device file name has been set */
 		if(strcmp(deviceFileName, "") == 0)
 		{
@@ -234,53 +659,80 @@ int main(int argc, char *argv[])
 			return EXIT_FAILURE;
 		}
 
-		/* load device data */
-		if(loadDeviceDescription(&device, deviceFileName)!=EXIT_SUCCESS)
+		/* load device data and the bit orders compiled in advance */
+		if(deviceName != NULL)
+		{
+			if(openDeviceLibrary(&library, libraryFileName) != 
+								EXIT_SUCCESS)
+				return EXIT_FAILURE;
+
+			if(loadLibraryDevice(&device, &descriptionFile, 
+				&library, deviceName, &options.format) != 
+								EXIT_SUCCESS)
+			{
+				closeDeviceLibrary(&library);
+				return EXIT_FAILURE;
+			}
+		}
+		else if(loadDeviceFile(&device, &descriptionFile, 
+			deviceFileName, &options.format) != EXIT_SUCCESS)
 			return EXIT_FAILURE;
+		options.precompiled = &descriptionFile.bitOrders;
 
-		/* allocate memory for the input data */
-		if((programData = malloc(device.memorySize)) == NULL)
+		/* convert the input file block by block */
+		if(streamInput == true)
 		{
-			fprintf(stderr, "ERROR: Could not allocate %lu bytes "
-				"of data!\r\n", device.memorySize);
-			return EXIT_FAILURE;
+			if(hexInput == true)
+				result = streamHexFile(inputFileName, 
+					outputFileName, &device, &options);
+			else
+				result = streamBinFile(inputFileName, 
+					outputFileName, &device, &options);
+
+			disposeDeviceFile(&descriptionFile);
+			if(deviceName != NULL)
+				closeDeviceLibrary(&library);
+			if(result != EXIT_SUCCESS)
+				return EXIT_FAILURE;
+
+			return EXIT_SUCCESS;
 		}
 
-		/* initialize memory with 0xFF */
-		memset(programData, 0xFF, device.memorySize);
+		/* the blocks of the memory are allocated when they are read */
+		if(initializeMemoryImage(&image, &device) != EXIT_SUCCESS)
+		{
+			disposeDeviceFile(&descriptionFile);
+			if(deviceName != NULL)
+				closeDeviceLibrary(&library);
+			return EXIT_FAILURE;
+		}
 
 		/* read input file */
 		if(hexInput == true)
 		{
 			/* read input file as intel hex file */
-			if(readHexFile(inputFileName, &device, programData)
-								!= EXIT_SUCCESS)
-			{
-				free(programData);
-				return EXIT_FAILURE;
-			}
+			result = readHexFileParallel(inputFileName, &device, 
+				&image, options.threadNum, 
+				options.recordCoverage);
 		}
 		else
 		{
 			/* read input file as binary file */
-			if(readBinFile(inputFileName, &device, programData)
-								!= EXIT_SUCCESS)
-			{
-				free(programData);
-				return EXIT_FAILURE;
-			}
+			result = readBinFile(inputFileName, &device, &image);
 		}
 
-
 		/* write output files */
-		if(generateOutputFiles(outputFileName, &device, programData,
-				ascii, generateAllBlocks) != EXIT_SUCCESS)
-		{
-			free(programData);
-			return EXIT_FAILURE;
-		}
+		if(result == EXIT_SUCCESS)
+			result = generateOutputFiles(outputFileName, &device,
+							&image, &options);
 
-		free(programData);
+		disposeMemoryImage(&image);
+		disposeDeviceFile(&descriptionFile);
+		if(deviceName != NULL)
+			closeDeviceLibrary(&library);
+
+		if(result != EXIT_SUCCESS)
+			return EXIT_FAILURE;
 	}
 
 	/* check if one of the commands was executed */
@@ -0,0 +1,329 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "memory-image.h"
+
+
+/* Initialize an empty memory image                                           */
+/*----------------------------------------------------------------------------*/
+/* Only the block table is allocated, the blocks are allocated when they are  */
+/* written. If the device has no valid block size, the whole memory is a      */
+/* single block.                                                              */
+/* OUT image: Memory image to be initialized.                                 */
+/* IN device: Description of the device whose memory is stored in the image.  */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	initializeMemoryImage(memoryImage *image, deviceData *device)
+{
+	image->blockSize = device->blockSize;
+	if((image->blockSize < 1) || 
+			(device->memorySize % image->blockSize != 0))
+		image->blockSize = device->memorySize;
+
+	image->mapping = NULL;
+	image->mappingLength = 0;
+
+	image->blockNum = 0;
+	if(image->blockSize > 0)
+		image->blockNum = device->memorySize / image->blockSize;
+
+	image->blocks = calloc(image->blockNum + 1, sizeof(*image->blocks));
+	image->blankBlock = malloc(image->blockSize + 1);
+	if((image->blocks == NULL) || (image->blankBlock == NULL))
+	{
+		free(image->blocks);
+		free(image->blankBlock);
+		image->blocks = NULL;
+		image->blankBlock = NULL;
+		fprintf(stderr, "ERROR: Could not allocate memory for %lu "
+			"bytes of data!\r\n", device->memorySize);
+		return EXIT_FAILURE;
+	}
+
+	memset(image->blankBlock, 0xFF, image->blockSize);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Dispose a memory image                                                     */
+/*----------------------------------------------------------------------------*/
+/* INOUT image: Memory image whose blocks are freed.                          */
+/*----------------------------------------------------------------------------*/
+void	disposeMemoryImage(memoryImage *image)
+{
+	uint32_64_t block;
+
+
+	if(image->blocks != NULL)
+	{
+		detachMemoryMapping(image);
+
+		for(block=0; block < image->blockNum; block++)
+			free(image->blocks[block]);
+	}
+
+	free(image->blocks);
+	free(image->blankBlock);
+	image->blocks = NULL;
+	image->blankBlock = NULL;
+	image->blockNum = 0;
+}
+
+
+/* Get a block of a memory image for writing                                  */
+/*----------------------------------------------------------------------------*/
+/* A block not allocated so far is allocated and filled with 0xFF.            */
+/* INOUT image: Memory image containing the block.                            */
+/* IN block: Number of the block.                                             */
+/* RETURNS: Pointer to the data of the block or NULL if the block could not   */
+/*          be allocated.                                                     */
+/*----------------------------------------------------------------------------*/
+uint8_t	*allocateMemoryBlock(memoryImage *image, uint32_64_t block)
+{
+	uint8_t *data;
+
+
+	/* mapped blocks are read-only, they are copied before writing */
+	if((image->blocks[block] == NULL) || 
+			(memoryBlockIsMapped(image, block) == true))
+	{
+		data = malloc(image->blockSize);
+		if(data == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+				"memory!\r\n");
+			return NULL;
+		}
+
+		if(image->blocks[block] == NULL)
+			memset(data, 0xFF, image->blockSize);
+		else
+			memcpy(data, image->blocks[block], image->blockSize);
+
+		image->blocks[block] = data;
+	}
+
+	return image->blocks[block];
+}
+
+
+/* Store the data of a complete block in a memory image                       */
+/*----------------------------------------------------------------------------*/
+/* INOUT image: Memory image containing the block.                            */
+/* IN block: Number of the block.                                             */
+/* IN data: blockSize bytes to be copied to the block.                        */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	storeMemoryBlock(memoryImage *image, uint32_64_t block, uint8_t *data)
+{
+	/* the block is overwritten completely, no need to fill it */
+	if((image->blocks[block] == NULL) || 
+			(memoryBlockIsMapped(image, block) == true))
+	{
+		image->blocks[block] = malloc(image->blockSize);
+		if(image->blocks[block] == NULL)
+		{
+			fprintf(stderr, "ERROR: Could not allocate enough "
+				"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	memcpy(image->blocks[block], data, image->blockSize);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Release a block of a memory image                                          */
+/*----------------------------------------------------------------------------*/
+/* The block reads as 0xFF afterwards.                                        */
+/* INOUT image: Memory image containing the block.                            */
+/* IN block: Number of the block.                                             */
+/*----------------------------------------------------------------------------*/
+void	releaseMemoryBlock(memoryImage *image, uint32_64_t block)
+{
+	if(memoryBlockIsMapped(image, block) != true)
+		free(image->blocks[block]);
+
+	image->blocks[block] = NULL;
+}
+
+
+/* Check if a block of a memory image is allocated                            */
+/*----------------------------------------------------------------------------*/
+/* IN image: Memory image containing the block.                               */
+/* IN block: Number of the block.                                             */
+/* RETURNS: true if the block has been written, false otherwise.              */
+/*----------------------------------------------------------------------------*/
+int	memoryBlockIsAllocated(memoryImage *image, uint32_64_t block)
+{
+	return (image->blocks[block] != NULL) ? true : false;
+}
+
+
+/* Check if a block of a memory image points into the mapping of the image    */
+/*----------------------------------------------------------------------------*/
+/* IN image: Memory image containing the block.                               */
+/* IN block: Number of the block.                                             */
+/* RETURNS: true if the block is part of the mapping, false otherwise.        */
+/*----------------------------------------------------------------------------*/
+int	memoryBlockIsMapped(memoryImage *image, uint32_64_t block)
+{
+	if((image->mapping == NULL) || (image->blocks[block] == NULL))
+		return false;
+
+	return ((image->blocks[block] >= image->mapping) && 
+		(image->blocks[block] < image->mapping + image->mappingLength))
+		? true : false;
+}
+
+
+/* Attach a read-only mapping to a memory image                               */
+/*----------------------------------------------------------------------------*/
+/* Blocks of the image may point into the mapping afterwards (see             */
+/* referenceMemoryBlock). The mapping is unmapped with the image.             */
+/* INOUT image: Memory image without a mapping.                               */
+/* IN mapping: Mapped memory.                                                 */
+/* IN length: Length of the mapping in bytes.                                 */
+/*----------------------------------------------------------------------------*/
+void	attachMemoryMapping(memoryImage *image, uint8_t *mapping, 
+							size_t length)
+{
+	image->mapping = mapping;
+	image->mappingLength = length;
+}
+
+
+/* Let a block of a memory image point into its mapping                       */
+/*----------------------------------------------------------------------------*/
+/* The data is neither copied nor written. An allocated block is released.    */
+/* INOUT image: Memory image containing the block.                            */
+/* IN block: Number of the block.                                             */
+/* IN data: blockSize bytes of the mapping of the image.                      */
+/*----------------------------------------------------------------------------*/
+void	referenceMemoryBlock(memoryImage *image, uint32_64_t block, 
+							uint8_t *data)
+{
+	releaseMemoryBlock(image, block);
+	image->blocks[block] = data;
+}
+
+
+/* Detach the mapping of a memory image                                       */
+/*----------------------------------------------------------------------------*/
+/* The blocks pointing into the mapping read as 0xFF afterwards.              */
+/* INOUT image: Memory image whose mapping is unmapped.                       */
+/*----------------------------------------------------------------------------*/
+void	detachMemoryMapping(memoryImage *image)
+{
+	uint32_64_t block;
+
+
+	if(image->mapping == NULL)
+		return;
+
+	for(block=0; block < image->blockNum; block++)
+	{
+		if(memoryBlockIsMapped(image, block) == true)
+			image->blocks[block] = NULL;
+	}
+
+#ifdef HAVE_MMAP
+	munmap(image->mapping, image->mappingLength);
+#endif
+	image->mapping = NULL;
+	image->mappingLength = 0;
+}
+
+
+/* Get a block of a memory image for reading                                  */
+/*----------------------------------------------------------------------------*/
+/* IN image: Memory image containing the block.                               */
+/* IN block: Number of the block.                                             */
+/* RETURNS: Pointer to the data of the block. The data of blocks not          */
+/*          allocated is shared and must not be written.                      */
+/*----------------------------------------------------------------------------*/
+uint8_t	*getMemoryBlock(memoryImage *image, uint32_64_t block)
+{
+	if(image->blocks[block] == NULL)
+		return image->blankBlock;
+
+	return image->blocks[block];
+}
+
+
+/* Write a byte to a memory image                                             */
+/*----------------------------------------------------------------------------*/
+/* INOUT image: Memory image to be written.                                   */
+/* IN address: Address of the byte relative to the start of the memory.       */
+/* IN value: Value of the byte.                                               */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	writeMemoryByte(memoryImage *image, uint32_64_t address, uint8_t value)
+{
+	uint8_t *data;
+
+
+	data = allocateMemoryBlock(image, address / image->blockSize);
+	if(data == NULL)
+		return EXIT_FAILURE;
+
+	data[address % image->blockSize] = value;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Read a byte from a memory image                                            */
+/*----------------------------------------------------------------------------*/
+/* IN image: Memory image to be read.                                         */
+/* IN address: Address of the byte relative to the start of the memory.       */
+/* RETURNS: Value of the byte.                                                */
+/*----------------------------------------------------------------------------*/
+uint8_t	readMemoryByte(memoryImage *image, uint32_64_t address)
+{
+	return getMemoryBlock(image, address / image->blockSize)
+						[address % image->blockSize];
+}
@@ -0,0 +1,90 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _MEMORY_IMAGE_H
+#define _MEMORY_IMAGE_H
+
+#include "device-description.h"
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+
+/* datatype for the memory content of a device */
+/* The memory is divided into blocks of the device. A block is allocated when */
+/* it is written the first time, blocks never written read as 0xFF.           */
+typedef struct
+{
+	uint32_64_t blockSize;
+	uint32_64_t blockNum;
+
+	/* allocated blocks (NULL if a block has not been written) */
+	uint8_t **blocks;
+
+	/* block filled with 0xFF returned for blocks not allocated */
+	uint8_t *blankBlock;
+
+	/* read-only mapping of an input file blocks may point into */
+	/* (NULL if there is no mapping) */
+	uint8_t *mapping;
+	size_t mappingLength;
+}
+memoryImage;
+
+
+extern	int	initializeMemoryImage(memoryImage *, deviceData *);
+extern	void	disposeMemoryImage(memoryImage *);
+extern	uint8_t	*allocateMemoryBlock(memoryImage *, uint32_64_t);
+extern	int	storeMemoryBlock(memoryImage *, uint32_64_t, uint8_t *);
+extern	void	releaseMemoryBlock(memoryImage *, uint32_64_t);
+extern	int	memoryBlockIsAllocated(memoryImage *, uint32_64_t);
+extern	int	memoryBlockIsMapped(memoryImage *, uint32_64_t);
+extern	void	attachMemoryMapping(memoryImage *, uint8_t *, size_t);
+extern	void	referenceMemoryBlock(memoryImage *, uint32_64_t, uint8_t *);
+extern	void	detachMemoryMapping(memoryImage *);
+extern	uint8_t	*getMemoryBlock(memoryImage *, uint32_64_t);
+extern	int	writeMemoryByte(memoryImage *, uint32_64_t, uint8_t);
+extern	uint8_t	readMemoryByte(memoryImage *, uint32_64_t);
+
+#endif /* _MEMORY_IMAGE_H */
@@ -0,0 +1,854 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "output-buffer.h"
+
+
+/* Initialize the state of an output buffer                                   */
+/*----------------------------------------------------------------------------*/
+/* OUT buffer: Output buffer without data, file or mapping.                   */
+/* IN fileName: Name of the file the buffer is written to.                    */
+/*----------------------------------------------------------------------------*/
+static void	initializeOutputBuffer(outputBuffer *buffer, char *fileName)
+{
+	buffer->data = NULL;
+	buffer->size = 0;
+	buffer->length = 0;
+	buffer->offset = 0;
+	buffer->map = NULL;
+	buffer->mapOffset = 0;
+	buffer->mapLength = 0;
+	buffer->mapSize = 0;
+	buffer->ring.ring = -1;
+	buffer->ring.pending = 0;
+	buffer->bufferNum = 0;
+	buffer->currentBuffer = 0;
+	buffer->caching = PAGE_CACHE;
+	buffer->cacheStart = 0;
+	buffer->backend = WRITE_BACKEND;
+	buffer->writeNum = 0;
+	buffer->queueDepth = 0;
+	buffer->maxQueueDepth = 0;
+	buffer->file = -1;
+	buffer->ownsFile = false;
+	strncpy(buffer->fileName, fileName, FILENAME_MAX - 1);
+	buffer->fileName[FILENAME_MAX - 1] = '\0';
+}
+
+
+/* Set the size of an output buffer                                           */
+/*----------------------------------------------------------------------------*/
+/* The buffer holds as many whole chunks as fit into OUTPUT_BUFFER_SIZE       */
+/* bytes, but at least one. Mapped files are written in windows of this size. */
+/* OUT buffer: Output buffer.                                                 */
+/* IN chunkSize: Size of the largest chunk reserved at once.                  */
+/*----------------------------------------------------------------------------*/
+static void	setOutputBufferSize(outputBuffer *buffer, size_t chunkSize)
+{
+	if(chunkSize < 1)
+		chunkSize = 1;
+
+	buffer->size = chunkSize;
+	if(chunkSize < OUTPUT_BUFFER_SIZE)
+		buffer->size = (OUTPUT_BUFFER_SIZE / chunkSize) * chunkSize;
+}
+
+
+/* Allocate the memory of an output buffer                                    */
+/*----------------------------------------------------------------------------*/
+/* The data is collected in chunks of chunkSize bytes (see                    */
+/* setOutputBufferSize).                                                      */
+/* OUT buffer: Output buffer to be initialized.                               */
+/* IN fileName: Name of the file the buffer is written to.                    */
+/* IN chunkSize: Size of the largest chunk reserved at once.                  */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	allocateOutputBuffer(outputBuffer *buffer, char *fileName, 
+							size_t chunkSize)
+{
+	initializeOutputBuffer(buffer, fileName);
+	setOutputBufferSize(buffer, chunkSize);
+
+	/* allocate buffer */
+	buffer->data = malloc(buffer->size);
+	if(buffer->data == NULL)
+	{
+		fprintf(stderr, "ERROR: Could not allocate enough memory!\r\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Create an output file and its buffer                                       */
+/*----------------------------------------------------------------------------*/
+/* OUT buffer: Output buffer to be initialized.                               */
+/* IN fileName: Name of the file to be created.                               */
+/* IN chunkSize: Size of the largest chunk reserved at once (see              */
+/*               allocateOutputBuffer).                                       */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	openOutputBuffer(outputBuffer *buffer, char *fileName, size_t chunkSize)
+{
+	if(allocateOutputBuffer(buffer, fileName, chunkSize) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* create file (readable too, so it can be mapped) */
+	buffer->file = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0666);
+	if(buffer->file < 0)
+	{
+		free(buffer->data);
+		buffer->data = NULL;
+		fprintf(stderr, "ERROR: Could not create file \"%s\"!\r\n",
+			fileName);
+		return EXIT_FAILURE;
+	}
+	buffer->ownsFile = true;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Unmap the window of a mapped file                                          */
+/*----------------------------------------------------------------------------*/
+/* The written pages stay in the page cache until the kernel writes them.     */
+/* INOUT buffer: Output buffer, its window is unmapped if it has one.         */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	unmapOutputWindow(outputBuffer *buffer)
+{
+	int result;
+
+
+	result = EXIT_SUCCESS;
+#ifdef HAVE_MMAP
+	if((buffer->map != NULL) && 
+			(munmap(buffer->map, buffer->mapLength) != 0))
+		result = EXIT_FAILURE;
+#endif
+
+	buffer->map = NULL;
+	buffer->mapLength = 0;
+
+	return result;
+}
+
+
+/* Map the window of a mapped file that data is written to next               */
+/*----------------------------------------------------------------------------*/
+/* The window starts at the page of the given position and is as large as     */
+/* the buffer would be (or as large as the data, if that is larger), so only  */
+/* a bounded part of the file is mapped at once. The previous window is       */
+/* unmapped first.                                                            */
+/* INOUT buffer: Output buffer of a mapped file.                              */
+/* IN position: File position of the data.                                    */
+/* IN length: Number of bytes of the data.                                    */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	mapOutputWindow(outputBuffer *buffer, off_t position, 
+								size_t length)
+{
+#ifdef HAVE_MMAP
+	long pageSize;
+	off_t start;
+	size_t windowLength;
+	char *mapping;
+
+
+	if(unmapOutputWindow(buffer) != EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* mappings start at page boundaries */
+	pageSize = sysconf(_SC_PAGESIZE);
+	if(pageSize < 1)
+		pageSize = OUTPUT_DIRECT_ALIGNMENT;
+	start = position - position % pageSize;
+
+	windowLength = buffer->size + (position - start);
+	if(windowLength < length + (position - start))
+		windowLength = length + (position - start);
+	if(windowLength > buffer->mapSize - start)
+		windowLength = buffer->mapSize - start;
+
+	mapping = mmap(NULL, windowLength, PROT_READ | PROT_WRITE, MAP_SHARED,
+							buffer->file, start);
+	if(mapping == MAP_FAILED)
+		return EXIT_FAILURE;
+
+#ifdef HAVE_MADVISE
+	/* the window is written from the first to the last byte */
+	madvise(mapping, windowLength, MADV_SEQUENTIAL);
+#endif
+
+	buffer->map = mapping;
+	buffer->mapOffset = start;
+	buffer->mapLength = windowLength;
+
+	return EXIT_SUCCESS;
+#else
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Map the file of an output buffer                                           */
+/*----------------------------------------------------------------------------*/
+/* The file is resized to its final size and the data is rendered directly    */
+/* into a mapped window of the file instead of a buffer. The window moves on  */
+/* when the data reaches its end (see mapOutputWindow). Nothing must have     */
+/* been written to the buffer yet.                                            */
+/* INOUT buffer: Output buffer opened with openOutputBuffer.                  */
+/* IN fileSize: Final size of the file in bytes.                              */
+/* RETURNS: EXIT_FAILURE if the file could not be mapped (the buffer is left  */
+/*          unchanged), EXIT_SUCCESS otherwise.                               */
+/*----------------------------------------------------------------------------*/
+int	mapOutputBuffer(outputBuffer *buffer, size_t fileSize)
+{
+#ifdef HAVE_MMAP
+	/* empty files can't be mapped */
+	if((fileSize < 1) || (buffer->length != 0) || 
+		(buffer->ownsFile != true) || (buffer->bufferNum > 0) ||
+		(buffer->offset >= (off_t) fileSize))
+		return EXIT_FAILURE;
+
+	if(ftruncate(buffer->file, fileSize) != 0)
+		return EXIT_FAILURE;
+
+	buffer->mapSize = fileSize;
+	if(mapOutputWindow(buffer, buffer->offset, 0) != EXIT_SUCCESS)
+	{
+		buffer->mapSize = 0;
+		return EXIT_FAILURE;
+	}
+
+	free(buffer->data);
+	buffer->data = NULL;
+	buffer->backend = MAP_BACKEND;
+
+	return EXIT_SUCCESS;
+#else
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Allocate the data of an output buffer                                      */
+/*----------------------------------------------------------------------------*/
+/* The data written with O_DIRECT must be aligned in memory.                  */
+/* IN buffer: Output buffer.                                                  */
+/* RETURNS: Memory of buffer->size bytes or NULL if a failure occurred.       */
+/*----------------------------------------------------------------------------*/
+static char	*allocateOutputData(outputBuffer *buffer)
+{
+	void *data;
+
+
+	if(buffer->caching != DIRECT_IO)
+		return malloc(buffer->size);
+
+	if(posix_memalign(&data, OUTPUT_DIRECT_ALIGNMENT, buffer->size) != 0)
+		return NULL;
+
+	return data;
+}
+
+
+/* Write an output buffer through the page cache again                        */
+/*----------------------------------------------------------------------------*/
+/* Turns O_DIRECT off, the written data is dropped from the cache instead if  */
+/* this is supported.                                                         */
+/* INOUT buffer: Output buffer writing with O_DIRECT.                         */
+/*----------------------------------------------------------------------------*/
+static void	disableDirectOutput(outputBuffer *buffer)
+{
+#ifdef O_DIRECT
+	int flags;
+
+
+	flags = fcntl(buffer->file, F_GETFL);
+	if(flags >= 0)
+		fcntl(buffer->file, F_SETFL, flags & ~O_DIRECT);
+#endif
+
+#ifdef HAVE_POSIX_FADVISE
+	buffer->caching = DROP_CACHE;
+#else
+	buffer->caching = PAGE_CACHE;
+#endif
+}
+
+
+/* Drop the written data of an output buffer from the page cache              */
+/*----------------------------------------------------------------------------*/
+/* IN buffer: Output buffer.                                                  */
+/* IN end: File position after the data written so far.                       */
+/*----------------------------------------------------------------------------*/
+static void	dropOutputCache(outputBuffer *buffer, off_t end)
+{
+#ifdef HAVE_POSIX_FADVISE
+	/* the pages still written back are dropped the next time */
+	if((buffer->caching == DROP_CACHE) && (end > buffer->cacheStart))
+		posix_fadvise(buffer->file, buffer->cacheStart, 
+			end - buffer->cacheStart, POSIX_FADV_DONTNEED);
+#endif
+}
+
+
+/* Keep the data of an output buffer out of the page cache                    */
+/*----------------------------------------------------------------------------*/
+/* The file is written with O_DIRECT and an aligned buffer. The data is       */
+/* written in multiples of OUTPUT_DIRECT_ALIGNMENT bytes, the rest at the end */
+/* of the file is written without O_DIRECT when the buffer is closed. If      */
+/* O_DIRECT isn't supported, the data is dropped from the cache after it has  */
+/* been written (posix_fadvise). Nothing must have been written to the buffer */
+/* yet and its writes must not be queued yet (see queueOutputBuffer).         */
+/* INOUT buffer: Output buffer opened with openOutputBuffer.                  */
+/* RETURNS: EXIT_FAILURE if the page cache can't be avoided (the buffer is    */
+/*          left unchanged), EXIT_SUCCESS otherwise.                          */
+/*----------------------------------------------------------------------------*/
+int	uncacheOutputBuffer(outputBuffer *buffer)
+{
+#ifdef O_DIRECT
+	int flags;
+	char *data;
+#endif
+
+
+	if((buffer->map != NULL) || (buffer->bufferNum > 0) || 
+		(buffer->length != 0) || (buffer->caching != PAGE_CACHE))
+		return EXIT_FAILURE;
+
+	buffer->cacheStart = buffer->offset;
+
+#ifdef O_DIRECT
+	/* the buffer holds the rest of the previous write too */
+	flags = fcntl(buffer->file, F_GETFL);
+	if((flags >= 0) && (buffer->offset % OUTPUT_DIRECT_ALIGNMENT == 0) &&
+		(fcntl(buffer->file, F_SETFL, flags | O_DIRECT) == 0))
+	{
+		buffer->caching = DIRECT_IO;
+		buffer->size += OUTPUT_DIRECT_ALIGNMENT;
+		data = allocateOutputData(buffer);
+		if(data != NULL)
+		{
+			free(buffer->data);
+			buffer->data = data;
+			return EXIT_SUCCESS;
+		}
+
+		buffer->size -= OUTPUT_DIRECT_ALIGNMENT;
+		fcntl(buffer->file, F_SETFL, flags);
+	}
+#endif
+
+#ifdef HAVE_POSIX_FADVISE
+	buffer->caching = DROP_CACHE;
+	return EXIT_SUCCESS;
+#else
+	buffer->caching = PAGE_CACHE;
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Queue the writes of an output buffer                                       */
+/*----------------------------------------------------------------------------*/
+/* The filled buffer is written asynchronously with io_uring and the data is  */
+/* collected in the next one of OUTPUT_QUEUE_DEPTH buffers, so rendering and  */
+/* writing overlap. Nothing must have been written to the buffer yet.         */
+/* INOUT buffer: Output buffer opened with openOutputBuffer or                */
+/*               shareOutputBuffer.                                           */
+/* RETURNS: EXIT_FAILURE if the writes can't be queued (the buffer is left    */
+/*          unchanged and writes with pwrite), EXIT_SUCCESS otherwise.        */
+/*----------------------------------------------------------------------------*/
+int	queueOutputBuffer(outputBuffer *buffer)
+{
+	int index;
+
+
+	if((buffer->map != NULL) || (buffer->bufferNum > 0) || 
+					(buffer->length != 0))
+		return EXIT_FAILURE;
+
+	if(initializeOutputRing(&buffer->ring, OUTPUT_QUEUE_DEPTH) != 
+								EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* the current buffer is the first one of the queue */
+	buffer->buffers[0] = buffer->data;
+	buffer->bufferPending[0] = false;
+	for(index=1; index < OUTPUT_QUEUE_DEPTH; index++)
+	{
+		buffer->buffers[index] = allocateOutputData(buffer);
+		buffer->bufferPending[index] = false;
+		if(buffer->buffers[index] == NULL)
+		{
+			while(--index > 0)
+				free(buffer->buffers[index]);
+			disposeOutputRing(&buffer->ring);
+			return EXIT_FAILURE;
+		}
+	}
+
+	buffer->currentBuffer = 0;
+	buffer->bufferNum = OUTPUT_QUEUE_DEPTH;
+	buffer->backend = RING_BACKEND;
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Create a second buffer for the file of an output buffer                    */
+/*----------------------------------------------------------------------------*/
+/* The new buffer writes to the file from the given offset on. Buffers of the */
+/* same file can be written by different threads as long as they don't        */
+/* overlap. The file is closed by the original buffer. The new buffer of a    */
+/* mapped file writes to a window of its own, the writes of the new buffer    */
+/* are queued if the writes of the original buffer are queued.                */
+/* The buffers of a file written with O_DIRECT drop the data from the cache   */
+/* instead, because the buffers start at unaligned positions.                 */
+/* OUT buffer: Output buffer to be initialized.                               */
+/* IN original: Opened output buffer.                                         */
+/* IN chunkSize: Size of the largest chunk reserved at once (see              */
+/*               allocateOutputBuffer).                                       */
+/* IN offset: File position the new buffer starts at.                         */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	shareOutputBuffer(outputBuffer *buffer, outputBuffer *original,
+					size_t chunkSize, off_t offset)
+{
+	if(original->caching == DIRECT_IO)
+		disableDirectOutput(original);
+
+	if(original->map != NULL)
+	{
+		initializeOutputBuffer(buffer, original->fileName);
+		setOutputBufferSize(buffer, chunkSize);
+		buffer->file = original->file;
+		buffer->mapSize = original->mapSize;
+		buffer->backend = MAP_BACKEND;
+		if(mapOutputWindow(buffer, offset, 0) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+	}
+	else if(allocateOutputBuffer(buffer, original->fileName, chunkSize) != 
+								EXIT_SUCCESS)
+		return EXIT_FAILURE;
+
+	buffer->file = original->file;
+	buffer->offset = offset;
+	buffer->caching = original->caching;
+	buffer->cacheStart = offset;
+
+	/* pwrite is used if the writes can't be queued */
+	if(original->bufferNum > 0)
+		queueOutputBuffer(buffer);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Reserve space in an output buffer                                          */
+/*----------------------------------------------------------------------------*/
+/* The buffer is flushed if the space left is too small. The caller writes    */
+/* the data to the returned position and adds its length to buffer->length.   */
+/* IN buffer: Output buffer.                                                  */
+/* IN length: Number of bytes to be reserved (at most the chunk size).        */
+/* RETURNS: Position to write the data to, NULL if a failure occurred.        */
+/*----------------------------------------------------------------------------*/
+char	*reserveOutputBuffer(outputBuffer *buffer, size_t length)
+{
+	off_t position;
+
+
+	/* mapped files are written in place */
+	if(buffer->backend == MAP_BACKEND)
+	{
+		position = buffer->offset + buffer->length;
+		if(position + length > buffer->mapSize)
+		{
+			fprintf(stderr, "ERROR: Could not write to file \"%s\"!"
+				" (file size exceeded)\r\n", buffer->fileName);
+			return NULL;
+		}
+
+		/* the data before is complete, continue in the next window */
+		if((buffer->map == NULL) || (position + length > 
+				buffer->mapOffset + buffer->mapLength))
+		{
+			buffer->offset = position;
+			buffer->length = 0;
+			if(mapOutputWindow(buffer, position, length) != 
+								EXIT_SUCCESS)
+			{
+				fprintf(stderr, "ERROR: Could not write to file "
+					"\"%s\"!\r\n", buffer->fileName);
+				return NULL;
+			}
+		}
+
+		return buffer->map + (position - buffer->mapOffset);
+	}
+
+	if(buffer->size - buffer->length < length)
+	{
+		if(flushOutputBuffer(buffer) != EXIT_SUCCESS)
+			return NULL;
+	}
+
+	return buffer->data + buffer->length;
+}
+
+
+/* Write data to the file of an output buffer                                 */
+/*----------------------------------------------------------------------------*/
+/* IN buffer: Output buffer.                                                  */
+/* IN data: Data to be written.                                               */
+/* IN length: Number of bytes to be written.                                  */
+/* IN offset: File position of the data.                                      */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	writeOutputData(outputBuffer *buffer, char *data, 
+						size_t length, off_t offset)
+{
+	size_t writtenBytes;
+	ssize_t result;
+
+
+	writtenBytes = 0;
+	while(writtenBytes < length)
+	{
+		result = pwrite(buffer->file, data + writtenBytes,
+					length - writtenBytes,
+					offset + writtenBytes);
+
+		/* retry if the write was interrupted */
+		if(result < 0 && errno == EINTR)
+			continue;
+
+		/* retry without O_DIRECT if the file system rejects it */
+		if(result < 0 && errno == EINVAL && buffer->caching == DIRECT_IO)
+		{
+			disableDirectOutput(buffer);
+			continue;
+		}
+
+		if(result <= 0)
+		{
+			fprintf(stderr, "ERROR: Could not write to file \"%s\"!"
+				" (wrote %lu bytes)\r\n", buffer->fileName,
+				(unsigned long) writtenBytes);
+			return EXIT_FAILURE;
+		}
+
+		writtenBytes += result;
+	}
+
+	dropOutputCache(buffer, offset + length);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Complete a queued write                                                    */
+/*----------------------------------------------------------------------------*/
+/* Waits for the next completed write of the queue. Data that has not been    */
+/* written by the queue (short or failed write) is written with pwrite.       */
+/* INOUT buffer: Output buffer with at least one pending write.               */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	completeOutputWrite(outputBuffer *buffer)
+{
+	int index;
+	long result;
+
+
+	if(waitOutputRing(&buffer->ring, &index, &result) != EXIT_SUCCESS)
+	{
+		fprintf(stderr, "ERROR: Could not write to file \"%s\"!\r\n",
+			buffer->fileName);
+		return EXIT_FAILURE;
+	}
+
+	buffer->bufferPending[index] = false;
+	buffer->queueDepth--;
+
+	if(result < 0)
+		result = 0;
+	if((size_t) result >= buffer->bufferLength[index])
+	{
+		dropOutputCache(buffer, buffer->bufferOffset[index] + 
+						buffer->bufferLength[index]);
+		return EXIT_SUCCESS;
+	}
+
+	return writeOutputData(buffer, buffer->buffers[index] + result, 
+				buffer->bufferLength[index] - result,
+				buffer->bufferOffset[index] + result);
+}
+
+
+/* Complete all queued writes                                                 */
+/*----------------------------------------------------------------------------*/
+/* INOUT buffer: Output buffer.                                               */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	completeOutputBuffer(outputBuffer *buffer)
+{
+	int result;
+	int queueDepth;
+
+
+	result = EXIT_SUCCESS;
+	while((buffer->bufferNum > 0) && (buffer->queueDepth > 0))
+	{
+		queueDepth = buffer->queueDepth;
+		if(completeOutputWrite(buffer) != EXIT_SUCCESS)
+			result = EXIT_FAILURE;
+
+		/* the queue is broken if nothing can be completed */
+		if(buffer->queueDepth == queueDepth)
+			return EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
+/* Write the buffered data to the file                                        */
+/*----------------------------------------------------------------------------*/
+/* Queued buffers are submitted and the data is collected in the next free    */
+/* buffer (see queueOutputBuffer). With O_DIRECT only whole multiples of      */
+/* OUTPUT_DIRECT_ALIGNMENT bytes are written, the rest stays in the buffer.   */
+/* IN buffer: Output buffer.                                                  */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	flushOutputBuffer(outputBuffer *buffer)
+{
+	int index;
+	char *written;
+	size_t length;
+
+
+	/* the data of mapped files is already in place */
+	length = buffer->length;
+	if(buffer->map == NULL && buffer->caching == DIRECT_IO)
+		length -= length % OUTPUT_DIRECT_ALIGNMENT;
+
+	written = buffer->data;
+	if((buffer->backend != MAP_BACKEND) && (length > 0))
+	{
+		index = buffer->currentBuffer;
+		if((buffer->bufferNum > 0) && (submitOutputRing(&buffer->ring,
+				buffer->file, buffer->data, length,
+				buffer->offset, index) == EXIT_SUCCESS))
+		{
+			buffer->bufferLength[index] = length;
+			buffer->bufferOffset[index] = buffer->offset;
+			buffer->bufferPending[index] = true;
+			buffer->queueDepth++;
+			if(buffer->queueDepth > buffer->maxQueueDepth)
+				buffer->maxQueueDepth = buffer->queueDepth;
+		}
+		else if(writeOutputData(buffer, buffer->data, length,
+					buffer->offset) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+
+		buffer->writeNum++;
+	}
+
+	buffer->offset += length;
+	buffer->length -= length;
+
+	/* continue with a free buffer, wait for one if all are in flight */
+	while((buffer->bufferNum > 0) && 
+			(buffer->bufferPending[buffer->currentBuffer] == true))
+	{
+		for(index=0; index < buffer->bufferNum; index++)
+		{
+			if(buffer->bufferPending[index] == false)
+				break;
+		}
+
+		if(index < buffer->bufferNum)
+		{
+			buffer->currentBuffer = index;
+			buffer->data = buffer->buffers[index];
+		}
+		else if(completeOutputWrite(buffer) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+	}
+
+	/* the rest is written with the next data */
+	if(buffer->length > 0)
+		memmove(buffer->data, written + length, buffer->length);
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Flush and close an output buffer                                           */
+/*----------------------------------------------------------------------------*/
+/* The buffer is disposed in any case.                                        */
+/* IN buffer: Output buffer.                                                  */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	closeOutputBuffer(outputBuffer *buffer)
+{
+	int result;
+
+
+	result = flushOutputBuffer(buffer);
+	if(completeOutputBuffer(buffer) != EXIT_SUCCESS)
+		result = EXIT_FAILURE;
+
+	/* the end of a file written with O_DIRECT is not aligned */
+	if((result == EXIT_SUCCESS) && (buffer->length > 0))
+	{
+		disableDirectOutput(buffer);
+		result = writeOutputData(buffer, buffer->data, buffer->length,
+							buffer->offset);
+		buffer->writeNum++;
+		buffer->offset += buffer->length;
+		buffer->length = 0;
+	}
+
+	if(unmapOutputWindow(buffer) != EXIT_SUCCESS && result == EXIT_SUCCESS)
+	{
+		fprintf(stderr, "ERROR: Could not write to file \"%s\"!\r\n",
+			buffer->fileName);
+		result = EXIT_FAILURE;
+	}
+
+	if(buffer->ownsFile == true)
+	{
+		if(close(buffer->file) != 0 && result == EXIT_SUCCESS)
+		{
+			fprintf(stderr, "ERROR: Could not write to file "
+				"\"%s\"!\r\n", buffer->fileName);
+			result = EXIT_FAILURE;
+		}
+	}
+	buffer->file = -1;
+
+	disposeOutputBuffer(buffer);
+
+	return result;
+}
+
+
+/* Dispose an output buffer without writing the buffered data                 */
+/*----------------------------------------------------------------------------*/
+/* IN buffer: Output buffer.                                                  */
+/*----------------------------------------------------------------------------*/
+void	disposeOutputBuffer(outputBuffer *buffer)
+{
+	int index;
+
+
+	/* the kernel may still read the queued buffers */
+	if(buffer->bufferNum > 0)
+	{
+		if(completeOutputBuffer(buffer) == EXIT_SUCCESS)
+		{
+			for(index=0; index < buffer->bufferNum; index++)
+				free(buffer->buffers[index]);
+		}
+		disposeOutputRing(&buffer->ring);
+		buffer->data = NULL;
+		buffer->bufferNum = 0;
+	}
+
+	unmapOutputWindow(buffer);
+
+	if(buffer->file >= 0 && buffer->ownsFile == true)
+		close(buffer->file);
+
+	if(buffer->data != NULL)
+		free(buffer->data);
+
+	buffer->file = -1;
+	buffer->data = NULL;
+	buffer->length = 0;
+}
+
+
+/* Print how the file of an output buffer has been written                    */
+/*----------------------------------------------------------------------------*/
+/* IN buffer: Output buffer (may be closed already).                          */
+/*----------------------------------------------------------------------------*/
+void	printOutputBufferStatistics(outputBuffer *buffer)
+{
+	char *caching;
+
+
+	caching = "";
+	if(buffer->caching == DIRECT_IO)
+		caching = ", O_DIRECT";
+	else if(buffer->caching == DROP_CACHE)
+		caching = ", dropped from cache";
+
+	if(buffer->backend == MAP_BACKEND)
+		printf("%s: mapped\r\n", buffer->fileName);
+	else if(buffer->backend == RING_BACKEND)
+		printf("%s: %lu writes (io_uring%s), queue depth %i of %i\r\n",
+			buffer->fileName, buffer->writeNum, caching, 
+			buffer->maxQueueDepth, OUTPUT_QUEUE_DEPTH);
+	else
+		printf("%s: %lu writes (pwrite%s)\r\n", buffer->fileName,
+						buffer->writeNum, caching);
+}
+
+
+/* Add the statistics of an output buffer                                     */
+/*----------------------------------------------------------------------------*/
+/* Used to collect the statistics of buffers sharing a file.                  */
+/* INOUT total: Output buffer the statistics are added to.                    */
+/* IN part: Output buffer (may be closed already).                            */
+/*----------------------------------------------------------------------------*/
+void	addOutputStatistics(outputBuffer *total, outputBuffer *part)
+{
+	total->writeNum += part->writeNum;
+	if(part->maxQueueDepth > total->maxQueueDepth)
+		total->maxQueueDepth = part->maxQueueDepth;
+}
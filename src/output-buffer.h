@@ -0,0 +1,133 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _OUTPUT_BUFFER_H
+#define _OUTPUT_BUFFER_H
+
+#include "device-description.h"
+#include "output-ring.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+
+/* default size of an output buffer in bytes (rounded down to whole chunks) */
+#define OUTPUT_BUFFER_SIZE	(1024*1024)
+
+/* number of buffers in flight if the writes are queued */
+#define OUTPUT_QUEUE_DEPTH	4
+
+
+/* alignment of the data, the file positions and lengths with O_DIRECT */
+#define OUTPUT_DIRECT_ALIGNMENT	4096
+
+
+/* how the data gets into the file */
+enum {WRITE_BACKEND, MAP_BACKEND, RING_BACKEND};
+
+/* how the written data uses the page cache */
+enum {PAGE_CACHE, DIRECT_IO, DROP_CACHE};
+
+
+/* datatype for a file written in large chunks */
+typedef struct
+{
+	int file;
+	int ownsFile;
+	char fileName[FILENAME_MAX];
+
+	/* file position the buffered data is written to */
+	off_t offset;
+
+	/* buffered data (length of size bytes, length bytes are used) */
+	char *data;
+	size_t size;
+	size_t length;
+
+	/* mapped window of the file (NULL if the data is buffered), the */
+	/* window of mapLength bytes starts at mapOffset, the whole file */
+	/* has mapSize bytes */
+	char *map;
+	off_t mapOffset;
+	size_t mapLength;
+	size_t mapSize;
+
+	/* buffers of queued writes (bufferNum is 0 if the data is written */
+	/* directly), data is the current buffer being filled */
+	outputRing ring;
+	int bufferNum;
+	int currentBuffer;
+	char *buffers[OUTPUT_QUEUE_DEPTH];
+	size_t bufferLength[OUTPUT_QUEUE_DEPTH];
+	off_t bufferOffset[OUTPUT_QUEUE_DEPTH];
+	int bufferPending[OUTPUT_QUEUE_DEPTH];
+
+	/* page cache use (see uncacheOutputBuffer), the data written from */
+	/* cacheStart on is dropped from the cache */
+	int caching;
+	off_t cacheStart;
+
+	/* statistics (kept after the buffer is closed) */
+	int backend;
+	unsigned long writeNum;
+	int queueDepth;
+	int maxQueueDepth;
+}
+outputBuffer;
+
+
+extern	int	allocateOutputBuffer(outputBuffer *, char *, size_t);
+extern	int	openOutputBuffer(outputBuffer *, char *, size_t);
+extern	int	mapOutputBuffer(outputBuffer *, size_t);
+extern	int	uncacheOutputBuffer(outputBuffer *);
+extern	int	queueOutputBuffer(outputBuffer *);
+extern	int	shareOutputBuffer(outputBuffer *, outputBuffer *, size_t, off_t);
+extern	char	*reserveOutputBuffer(outputBuffer *, size_t);
+extern	int	flushOutputBuffer(outputBuffer *);
+extern	int	closeOutputBuffer(outputBuffer *);
+extern	void	disposeOutputBuffer(outputBuffer *);
+extern	void	printOutputBufferStatistics(outputBuffer *);
+extern	void	addOutputStatistics(outputBuffer *, outputBuffer *);
+
+#endif /* _OUTPUT_BUFFER_H */
@@ -0,0 +1,246 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*----------------------------------------------------------------------------*/
+/* The layout of ascii output files is described by the symbols of the bits,  */
+/* the separator following every bit, the terminator following every line     */
+/* and the number of words in one line. Binary and packed output have a fixed */
+/* layout.                                                                    */
+/*----------------------------------------------------------------------------*/
+
+#include "output-format.h"
+
+
+/* separators and terminators which can be selected by name */
+static formatText separators[] = {{"none", ""}, {"space", " "}, 
+			{"tab", "\t"}, {"comma", ","}, {"semicolon", ";"},
+			{NULL, NULL}};
+
+static formatText terminators[] = {{"none", ""}, {"crlf", "\r\n"}, 
+			{"lf", "\n"}, {"cr", "\r"}, {NULL, NULL}};
+
+
+/* Initialize an output format                                                */
+/*----------------------------------------------------------------------------*/
+/* Ascii output is a space separated bit sequence with a line break after     */
+/* every word. Binary output has one byte with the value 0 or 1 per bit and   */
+/* no separators.                                                             */
+/* OUT format: Output format to be initialized.                               */
+/* IN type: BINARY_OUTPUT, ASCII_OUTPUT or PACKED_OUTPUT.                     */
+/*----------------------------------------------------------------------------*/
+void	initializeOutputFormat(outputFormat *format, int type)
+{
+	memset(format, 0, sizeof(*format));
+
+	format->type = type;
+	format->wordsPerLine = 1;
+
+	if(type == ASCII_OUTPUT)
+	{
+		format->symbol[0] = '0';
+		format->symbol[1] = '1';
+		strcpy(format->separator, " ");
+		strcpy(format->terminator, "\r\n");
+	}
+	else
+	{
+		format->symbol[0] = 0;
+		format->symbol[1] = 1;
+	}
+
+	format->separatorLength = strlen(format->separator);
+	format->terminatorLength = strlen(format->terminator);
+}
+
+
+/* Find a named piece of text                                                 */
+/*----------------------------------------------------------------------------*/
+/* IN texts: Known texts (terminated by an entry without name).               */
+/* IN name: Name of the text.                                                 */
+/* OUT text: Text with the given name.                                        */
+/* RETURNS: EXIT_FAILURE if the name is unknown, EXIT_SUCCESS otherwise.      */
+/*----------------------------------------------------------------------------*/
+int	findFormatText(formatText *texts, char *name, char **text)
+{
+	for(; texts->name != NULL; texts++)
+	{
+		if(strcmp(texts->name, name) == 0)
+		{
+			*text = texts->text;
+			return EXIT_SUCCESS;
+		}
+	}
+
+	return EXIT_FAILURE;
+}
+
+
+/* Parse the description of an ascii output format                            */
+/*----------------------------------------------------------------------------*/
+/* The description is a comma separated list of the entries "bits=01",        */
+/* "separator=NAME" (none, space, tab, comma or semicolon), "terminator=NAME" */
+/* (none, crlf, lf or cr) and "words=N". Entries which are not given keep     */
+/* their value.                                                               */
+/* INOUT format: Ascii output format to be changed.                           */
+/* IN description: Description of the format.                                 */
+/* RETURNS: EXIT_FAILURE if the description is invalid, EXIT_SUCCESS          */
+/*          otherwise.                                                        */
+/*----------------------------------------------------------------------------*/
+int	parseOutputFormat(outputFormat *format, char *description)
+{
+	char entry[FILENAME_MAX];
+	char *value;
+	char *text;
+	char *end;
+	size_t length;
+	long wordsPerLine;
+
+
+	while(*description != '\0')
+	{
+		/* copy the next entry */
+		length = strcspn(description, ",");
+		if(length >= sizeof(entry))
+			length = sizeof(entry) - 1;
+		memcpy(entry, description, length);
+		entry[length] = '\0';
+
+		description += length;
+		if(*description == FORMAT_ENTRY_SEPARATOR)
+			description++;
+
+		value = strchr(entry, '=');
+		if(value == NULL)
+		{
+			fprintf(stderr, "ERROR: Invalid output format entry "
+						"\"%s\"!\r\n", entry);
+			return EXIT_FAILURE;
+		}
+		*value = '\0';
+		value++;
+
+		if(strcmp(entry, "bits") == 0)
+		{
+			if(strlen(value) != 2 || value[0] == value[1])
+			{
+				fprintf(stderr, "ERROR: Output format entry "
+					"\"bits\" needs two different "
+					"symbols!\r\n");
+				return EXIT_FAILURE;
+			}
+
+			format->symbol[0] = value[0];
+			format->symbol[1] = value[1];
+		}
+		else if(strcmp(entry, "separator") == 0)
+		{
+			if(findFormatText(separators, value, &text) !=
+								EXIT_SUCCESS)
+			{
+				fprintf(stderr, "ERROR: Unknown separator "
+						"\"%s\"!\r\n", value);
+				return EXIT_FAILURE;
+			}
+
+			strcpy(format->separator, text);
+			format->separatorLength = strlen(text);
+		}
+		else if(strcmp(entry, "terminator") == 0)
+		{
+			if(findFormatText(terminators, value, &text) !=
+								EXIT_SUCCESS)
+			{
+				fprintf(stderr, "ERROR: Unknown terminator "
+						"\"%s\"!\r\n", value);
+				return EXIT_FAILURE;
+			}
+
+			strcpy(format->terminator, text);
+			format->terminatorLength = strlen(text);
+		}
+		else if(strcmp(entry, "words") == 0)
+		{
+			wordsPerLine = strtol(value, &end, 10);
+			if((*value == '\0') || (*end != '\0') || 
+				(wordsPerLine < 1) || (wordsPerLine > INT_MAX))
+			{
+				fprintf(stderr, "ERROR: Output format entry "
+					"\"words\" needs a number greater "
+					"than 0!\r\n");
+				return EXIT_FAILURE;
+			}
+
+			format->wordsPerLine = (int) wordsPerLine;
+		}
+		else
+		{
+			fprintf(stderr, "ERROR: Unknown output format entry "
+						"\"%s\"!\r\n", entry);
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/* Check if two output formats render words the same way                      */
+/*----------------------------------------------------------------------------*/
+/* The number of words per line is not compared, it doesn't change the        */
+/* rendering of a single word.                                                */
+/* IN format1: First output format.                                           */
+/* IN format2: Second output format.                                          */
+/* RETURNS: true if the formats render words the same way, false otherwise.   */
+/*----------------------------------------------------------------------------*/
+int	outputFormatsAreEqual(outputFormat *format1, outputFormat *format2)
+{
+	return ((format1->type == format2->type) &&
+		(format1->symbol[0] == format2->symbol[0]) &&
+		(format1->symbol[1] == format2->symbol[1]) &&
+		(format1->separatorLength == format2->separatorLength) &&
+		(memcmp(format1->separator, format2->separator, 
+					format1->separatorLength) == 0) &&
+		(format1->terminatorLength == format2->terminatorLength) &&
+		(memcmp(format1->terminator, format2->terminator, 
+					format1->terminatorLength) == 0));
+}
@@ -0,0 +1,101 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _OUTPUT_FORMAT_H
+#define _OUTPUT_FORMAT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+
+/* output formats (BINARY_OUTPUT is false and ASCII_OUTPUT is true) */
+enum {BINARY_OUTPUT, ASCII_OUTPUT, PACKED_OUTPUT};
+
+/* maximum lengths of the separator and the line terminator */
+#define MAX_SEPARATOR_LENGTH	4
+#define MAX_TERMINATOR_LENGTH	4
+
+/* separator between the entries of a format description */
+#define FORMAT_ENTRY_SEPARATOR	','
+
+
+/* datatype describing the layout of the output files */
+typedef struct
+{
+	/* BINARY_OUTPUT, ASCII_OUTPUT or PACKED_OUTPUT */
+	int type;
+
+	/* symbols of 0 and 1 bits (not used for packed output) */
+	char symbol[2];
+
+	/* text following every bit */
+	char separator[MAX_SEPARATOR_LENGTH + 1];
+	int separatorLength;
+
+	/* text following every line */
+	char terminator[MAX_TERMINATOR_LENGTH + 1];
+	int terminatorLength;
+
+	/* number of words of the block in one line */
+	int wordsPerLine;
+}
+outputFormat;
+
+
+/* datatype for a named piece of text of a format description */
+typedef struct
+{
+	char *name;
+	char *text;
+}
+formatText;
+
+
+extern	void	initializeOutputFormat(outputFormat *, int);
+extern	int	findFormatText(formatText *, char *, char **);
+extern	int	parseOutputFormat(outputFormat *, char *);
+extern	int	outputFormatsAreEqual(outputFormat *, outputFormat *);
+
+#endif /* _OUTPUT_FORMAT_H */
@@ -0,0 +1,273 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "output-ring.h"
+
+
+#if(USING_IO_URING==1)
+/* Enter the ring                                                             */
+/*----------------------------------------------------------------------------*/
+/* IN ring: Output ring.                                                      */
+/* IN submitNum: Number of new submission queue entries.                      */
+/* IN waitNum: Number of completions to wait for.                             */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	enterOutputRing(outputRing *ring, unsigned submitNum, 
+							unsigned waitNum)
+{
+	long result;
+
+
+	do
+	{
+		result = syscall(__NR_io_uring_enter, ring->ring, submitNum, 
+			waitNum, (waitNum > 0) ? IORING_ENTER_GETEVENTS : 0, 
+								NULL, 0);
+	}
+	while(result < 0 && errno == EINTR);
+
+	return (result < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
+
+/* Set up a queue of asynchronous writes                                      */
+/*----------------------------------------------------------------------------*/
+/* The ring fails if io_uring isn't supported by the system or the kernel, the*/
+/* writes must be done with pwrite then.                                      */
+/* OUT ring: Output ring to be initialized.                                   */
+/* IN depth: Number of writes in flight at most.                              */
+/* RETURNS: EXIT_FAILURE if the ring could not be set up, EXIT_SUCCESS        */
+/*          otherwise.                                                        */
+/*----------------------------------------------------------------------------*/
+int	initializeOutputRing(outputRing *ring, unsigned depth)
+{
+#if(USING_IO_URING==1)
+	struct io_uring_params parameters;
+#endif
+
+
+	ring->ring = -1;
+	ring->pending = 0;
+	ring->submissionMap = MAP_FAILED;
+	ring->completionMap = MAP_FAILED;
+	ring->entries = MAP_FAILED;
+
+#if(USING_IO_URING==1)
+	memset(&parameters, 0, sizeof(parameters));
+	ring->ring = syscall(__NR_io_uring_setup, depth, &parameters);
+	if(ring->ring < 0)
+	{
+		ring->ring = -1;
+		return EXIT_FAILURE;
+	}
+
+	/* map the queues (separately, this works with every kernel) */
+	ring->submissionMapSize = parameters.sq_off.array + 
+				parameters.sq_entries * sizeof(unsigned);
+	ring->completionMapSize = parameters.cq_off.cqes + 
+		parameters.cq_entries * sizeof(struct io_uring_cqe);
+	ring->entriesSize = parameters.sq_entries * 
+					sizeof(struct io_uring_sqe);
+
+	ring->submissionMap = mmap(NULL, ring->submissionMapSize, 
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, 
+			ring->ring, IORING_OFF_SQ_RING);
+	ring->completionMap = mmap(NULL, ring->completionMapSize, 
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, 
+			ring->ring, IORING_OFF_CQ_RING);
+	ring->entries = mmap(NULL, ring->entriesSize, 
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, 
+			ring->ring, IORING_OFF_SQES);
+	if(ring->submissionMap == MAP_FAILED || 
+		ring->completionMap == MAP_FAILED || 
+		ring->entries == MAP_FAILED)
+	{
+		disposeOutputRing(ring);
+		return EXIT_FAILURE;
+	}
+
+	ring->submissionHead = (unsigned *) (ring->submissionMap + 
+						parameters.sq_off.head);
+	ring->submissionTail = (unsigned *) (ring->submissionMap + 
+						parameters.sq_off.tail);
+	ring->submissionMask = (unsigned *) (ring->submissionMap + 
+						parameters.sq_off.ring_mask);
+	ring->submissionArray = (unsigned *) (ring->submissionMap + 
+						parameters.sq_off.array);
+	ring->completionHead = (unsigned *) (ring->completionMap + 
+						parameters.cq_off.head);
+	ring->completionTail = (unsigned *) (ring->completionMap + 
+						parameters.cq_off.tail);
+	ring->completionMask = (unsigned *) (ring->completionMap + 
+						parameters.cq_off.ring_mask);
+	ring->completions = ring->completionMap + parameters.cq_off.cqes;
+
+	return EXIT_SUCCESS;
+#else
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Submit a write to the ring                                                 */
+/*----------------------------------------------------------------------------*/
+/* The data must not be changed until the write is completed.                 */
+/* INOUT ring: Output ring.                                                   */
+/* IN file: File to be written.                                               */
+/* IN data: Data to be written.                                               */
+/* IN length: Number of bytes to be written.                                  */
+/* IN offset: File position of the data.                                      */
+/* IN tag: Number identifying the write (see waitOutputRing).                 */
+/* RETURNS: EXIT_FAILURE if the write could not be submitted, EXIT_SUCCESS    */
+/*          otherwise.                                                        */
+/*----------------------------------------------------------------------------*/
+int	submitOutputRing(outputRing *ring, int file, char *data, size_t length,
+						off_t offset, int tag)
+{
+#if(USING_IO_URING==1)
+	unsigned tail;
+	unsigned index;
+	struct io_uring_sqe *entry;
+
+
+	if(ring->ring < 0)
+		return EXIT_FAILURE;
+
+	/* fill the next submission queue entry */
+	tail = *ring->submissionTail;
+	index = tail & *ring->submissionMask;
+	entry = (struct io_uring_sqe *) ring->entries + index;
+	memset(entry, 0, sizeof(*entry));
+	entry->opcode = IORING_OP_WRITE;
+	entry->fd = file;
+	entry->addr = (unsigned long) data;
+	entry->len = length;
+	entry->off = offset;
+	entry->user_data = tag;
+	ring->submissionArray[index] = index;
+
+	/* the kernel must see the entry before the new tail */
+	__atomic_store_n(ring->submissionTail, tail + 1, __ATOMIC_RELEASE);
+
+	/* the kernel takes entries only while the ring is entered, so an */
+	/* entry it didn't take can be taken back */
+	if((enterOutputRing(ring, 1, 0) != EXIT_SUCCESS) && 
+		(__atomic_load_n(ring->submissionHead, __ATOMIC_ACQUIRE) == 
+									tail))
+	{
+		__atomic_store_n(ring->submissionTail, tail, __ATOMIC_RELEASE);
+		return EXIT_FAILURE;
+	}
+
+	ring->pending++;
+	return EXIT_SUCCESS;
+#else
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Wait for the completion of a write                                         */
+/*----------------------------------------------------------------------------*/
+/* INOUT ring: Output ring with at least one pending write.                   */
+/* OUT tag: Tag of the completed write (see submitOutputRing).                */
+/* OUT result: Number of bytes written or a negative error number.            */
+/* RETURNS: EXIT_FAILURE if no write could be completed, EXIT_SUCCESS         */
+/*          otherwise.                                                        */
+/*----------------------------------------------------------------------------*/
+int	waitOutputRing(outputRing *ring, int *tag, long *result)
+{
+#if(USING_IO_URING==1)
+	unsigned head;
+	struct io_uring_cqe *completion;
+
+
+	if(ring->ring < 0 || ring->pending < 1)
+		return EXIT_FAILURE;
+
+	head = *ring->completionHead;
+	while(head == __atomic_load_n(ring->completionTail, __ATOMIC_ACQUIRE))
+	{
+		if(enterOutputRing(ring, 0, 1) != EXIT_SUCCESS)
+			return EXIT_FAILURE;
+	}
+
+	completion = (struct io_uring_cqe *) ring->completions + 
+					(head & *ring->completionMask);
+	*tag = completion->user_data;
+	*result = completion->res;
+
+	/* the entry can be reused by the kernel */
+	__atomic_store_n(ring->completionHead, head + 1, __ATOMIC_RELEASE);
+
+	ring->pending--;
+	return EXIT_SUCCESS;
+#else
+	return EXIT_FAILURE;
+#endif
+}
+
+
+/* Dispose a queue of asynchronous writes                                     */
+/*----------------------------------------------------------------------------*/
+/* All pending writes must be completed before (see waitOutputRing).          */
+/* INOUT ring: Output ring.                                                   */
+/*----------------------------------------------------------------------------*/
+void	disposeOutputRing(outputRing *ring)
+{
+	if(ring->entries != MAP_FAILED)
+		munmap(ring->entries, ring->entriesSize);
+	if(ring->completionMap != MAP_FAILED)
+		munmap(ring->completionMap, ring->completionMapSize);
+	if(ring->submissionMap != MAP_FAILED)
+		munmap(ring->submissionMap, ring->submissionMapSize);
+	if(ring->ring >= 0)
+		close(ring->ring);
+
+	ring->ring = -1;
+	ring->pending = 0;
+	ring->submissionMap = MAP_FAILED;
+	ring->completionMap = MAP_FAILED;
+	ring->entries = MAP_FAILED;
+}
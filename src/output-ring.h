@@ -0,0 +1,104 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef _OUTPUT_RING_H
+#define _OUTPUT_RING_H
+
+#include "device-description.h"
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+#if defined(HAVE_LINUX_IO_URING_H) && defined(HAVE_SYS_SYSCALL_H) && \
+						defined(HAVE_MMAP)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+/* the ring is set up with raw system calls (there is no library needed), */
+/* IORING_OP_WRITE came with the same header as IORING_FEAT_RW_CUR_POS */
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup) && \
+						defined(__NR_io_uring_enter)
+#define USING_IO_URING	1
+#else
+#define USING_IO_URING	0
+#endif
+
+
+/* datatype for a queue of asynchronous writes (io_uring) */
+typedef struct
+{
+	/* file descriptor of the ring (-1 if there is no ring) */
+	int ring;
+
+	/* number of writes submitted, but not completed yet */
+	unsigned pending;
+
+	/* mappings of the submission queue, completion queue and entries */
+	char *submissionMap;
+	size_t submissionMapSize;
+	char *completionMap;
+	size_t completionMapSize;
+	void *entries;
+	size_t entriesSize;
+
+	/* ring pointers inside the mappings */
+	unsigned *submissionHead;
+	unsigned *submissionTail;
+	unsigned *submissionMask;
+	unsigned *submissionArray;
+	unsigned *completionHead;
+	unsigned *completionTail;
+	unsigned *completionMask;
+	void *completions;
+}
+outputRing;
+
+
+extern	int	initializeOutputRing(outputRing *, unsigned);
+extern	int	submitOutputRing(outputRing *, int, char *, size_t, off_t,
+								int);
+extern	int	waitOutputRing(outputRing *, int *, long *);
+extern	void	disposeOutputRing(outputRing *);
+
+#endif /* _OUTPUT_RING_H */
@@ -65,7 +65,11 @@
 #include "parser.h"
 
 
-#define MAX_BIT_ARRAY_LENGTH	(3*MAX_BIT_ORDER_LENGTH)
+#define MAX_BIT_ARRAY_LENGTH	MAX_BIT_ORDER_LENGTH
+
+/* an address repeat exceeding this length sets the block size of devices */
+/* without one (the length of the bit array of former versions) */
+#define MAX_UNBLOCKED_REPEAT_LENGTH	(3*8*(int)sizeof(uint32_64_t))
 
 #define DATA_KEYWORD	(keyword == DATA || keyword == PROGRAM_DATA \
 						|| keyword == VERIFY_DATA)
@@ -88,8 +92,7 @@ static const char *keywordList[] =
 	"verifydata",
 	"verifyaddress",
 	"data",
-	"address",
-	""
+	"address"
 };
 
 typedef enum
@@ -110,6 +113,29 @@ typedef enum
 }
 keywords;
 
+/* perfect hash of the keywords (see findKeyword), unused entries are -1 */
+#define KEYWORD_HASH_SIZE	16
+
+static const signed char keywordHashTable[KEYWORD_HASH_SIZE] =
+{
+	-1,
+	DEVICE_NAME,
+	PROGRAM_DATA,
+	PROGRAM_ADDRESS,
+	START_ADDRESS,
+	-1,
+	ADDRESS_LENGTH,
+	VERIFY_DATA,
+	VERIFY_ADDRESS,
+	WORD_LENGTH,
+	MEMORY_SIZE,
+	-1,
+	ADDRESS_STEP,
+	ADDRESS,
+	BLOCK_SIZE,
+	DATA
+};
+
 /* keyword types */
 enum {STRING_KEYWORD, NUMBER_KEYWORD, BIT_ORDER_KEYWORD};
 
@@ -131,74 +157,161 @@ static const char keywordType[] =
 };
 
 
+/* state of the parser, every parser works on its own state so several */
+/* sources can be parsed at the same time */
+typedef struct
+{
+	scannerContext scanner;
+	bitArray bits;
+	deviceData *device;
+
+	/* stream the failures are reported to */
+	FILE *report;
+}
+parserContext;
+
 
 /* Nonterminal symbols */
-int	ProgrammingPattern(deviceData *);
-int	Assignment(deviceData *);
-int	String(deviceData *, int);
-int	Number(deviceData *, int);
-int	BitOrderDescription(deviceData *, int);
-int	BitSequence(deviceData *, int);
-int	SequenceLoop(deviceData *, int);
-int	SequencePart(deviceData *, int);
-int	Range(deviceData *, int);
-int	Literal(deviceData *, int);
-int	Group(deviceData *, int);
-
-
-/* Parse a device description source file into a device description object    */
-/* file.                                                                      */
+int	ProgrammingPattern(parserContext *);
+int	Assignment(parserContext *);
+int	String(parserContext *, int);
+int	Number(parserContext *, int);
+int	BitOrderDescription(parserContext *, int);
+int	BitSequence(parserContext *, int);
+int	SequenceLoop(parserContext *, int);
+int	SequencePart(parserContext *, int);
+int	Range(parserContext *, int);
+int	Literal(parserContext *, int);
+int	Group(parserContext *, int);
+
+
+/* Find a keyword                                                             */
+/*----------------------------------------------------------------------------*/
+/* The hash of the length, the first and the last character is unique for     */
+/* all keywords, so only one comparison is necessary.                         */
+/* IN ident: Identifier to be looked up.                                      */
+/* RETURNS: The keyword or -1 if the identifier is not a keyword.             */
 /*----------------------------------------------------------------------------*/
+static int	findKeyword(char *ident)
+{
+	size_t length;
+	int keyword;
+
+
+	length = strlen(ident);
+	if(length == 0)
+		return -1;
+
+	keyword = keywordHashTable[(length + (unsigned char)ident[0] +
+		7*(unsigned char)ident[length-1]) % KEYWORD_HASH_SIZE];
+
+	if((keyword < 0) || (strcmp(keywordList[keyword], ident) != 0))
+		return -1;
+
+	return keyword;
+}
+
+
+/* Parse the source of a device description                                   */
+/*----------------------------------------------------------------------------*/
+/* The scanner and the bit array of the parser are disposed afterwards.       */
+/* IN parser: State of the parser with an initialized scanner.                */
+/* OUT device: Device description parsed from the source.                     */
+/* IN report: Stream the failures are reported to.                            */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+static int	parseSource(parserContext *parser, deviceData *device,
+							FILE *report)
+{
+	int result;
+
+
+	parser->device = device;
+	parser->report = report;
+
+	/* parse the source into the deviceData structure */
+	result = ProgrammingPattern(parser);
+	disposeBitArray(&parser->bits);
+	disposeScanner(&parser->scanner);
+
+	return result;
+}
+
+
+/* Parse a device description source file into a device description           */
+/*----------------------------------------------------------------------------*/
+/* The device description is saved by the caller (see saveDeviceFile).        */
+/* The state of the parser is local, so several files can be parsed at the    */
+/* same time.                                                                 */
 /* IN inputFileName: File to be parsed.                                       */
-/* OUT outputFileName: File to be generated by the parser.                    */
+/* OUT device: Device description parsed from the file.                       */
+/* IN report: Stream the failures are reported to (e.g. stdout).              */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	compileSourceFile(char *inputFileName, char *outputFileName)
+int	parseSourceFile(char *inputFileName, deviceData *device, FILE *report)
 {
-	deviceData device;
+	parserContext parser;
 
 
 	/* initialize the device data structure */
-	initializeDeviceData(&device);
+	initializeDeviceData(device);
 
 	/* delegate the scanner to open the input file */
-	if(initializeScanner(inputFileName) != EXIT_SUCCESS)
+	if(initializeScanner(&parser.scanner, inputFileName) != EXIT_SUCCESS)
 		return EXIT_FAILURE;
 
-	/* parse the input file into the deviceData structure */
-	if(ProgrammingPattern(&device) != EXIT_SUCCESS)
-	{
-		disposeScanner();
-		return EXIT_FAILURE;
-	}
-	disposeScanner();
+	return parseSource(&parser, device, report);
+}
 
-	/* generate the device description file */
-	saveDeviceDescription(&device, outputFileName);
-		return EXIT_FAILURE;
 
-	return EXIT_SUCCESS;
+/* Parse a device description source in memory into a device description      */
+/*----------------------------------------------------------------------------*/
+/* IN source: Source to be parsed (doesn't need to be terminated).            */
+/* IN sourceSize: Length of the source in bytes.                              */
+/* OUT device: Device description parsed from the source.                     */
+/* IN report: Stream the failures are reported to (e.g. stdout).              */
+/* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
+/*----------------------------------------------------------------------------*/
+int	parseSourceBuffer(char *source, size_t sourceSize, deviceData *device,
+							FILE *report)
+{
+	parserContext parser;
+
+
+	/* initialize the device data structure */
+	initializeDeviceData(device);
+
+	/* the scanner reads the source directly */
+	initializeMemoryScanner(&parser.scanner, source, sourceSize);
+
+	return parseSource(&parser, device, report);
 }
 
 
 /* ProgrammingPattern = { Assignment } .                                      */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	ProgrammingPattern(deviceData *device)
+int	ProgrammingPattern(parserContext *parser)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+	deviceData *device = parser->device;
+
+
 	/* expecting any number of Assignment statements */
-	while(getCurrentSymbol() == IDENT_SYM)
+	while(getCurrentSymbol(scanner) == IDENT_SYM)
 	{
-		if(Assignment(device) != EXIT_SUCCESS) return EXIT_FAILURE;
+		if(Assignment(parser) != EXIT_SUCCESS) return EXIT_FAILURE;
 	}
 
 	/* check if there are any unexpected symbols at the end of the file */
-	if(getCurrentSymbol() != EOF_SYM)
+	if(getCurrentSymbol(scanner) != EOF_SYM)
 	{
-		fprintf(stdout, "FAILURE: Unexpected symbol at line %i column "
-			"%i.\r\n", getCurrentLine(), getCurrentColumn());
+		fprintf(report, "FAILURE: Unexpected symbol at line %i column "
+			"%i.\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
@@ -206,7 +319,7 @@ int	ProgrammingPattern(deviceData *device)
 	/* check if the device name was found */
 	if(strcmp(device->name, "") == 0)
 	{
-		fprintf(stdout, "FAILURE: The device name has not been set."
+		fprintf(report, "FAILURE: The device name has not been set."
 			"\r\n");
 		return EXIT_FAILURE;
 	}
@@ -214,7 +327,7 @@ int	ProgrammingPattern(deviceData *device)
 	/* memorySize must not be less than blockSize */
 	if(device->memorySize < device->blockSize)
 	{
-		fprintf(stdout, "FAILURE: The memory size must be greater or "
+		fprintf(report, "FAILURE: The memory size must be greater or "
 			"equal to the block size.\r\n         Memory size: \t"
 			"%lu\r\n         Block size: \t%lu\r\n", 
 			device->memorySize, device->blockSize);
@@ -224,39 +337,50 @@ int	ProgrammingPattern(deviceData *device)
 	/* memorySize must be greater than 0 */
 	if(device->memorySize < 1)
 	{
-		fprintf(stdout, "FAILURE: The memory size must be set to a "
+		fprintf(report, "FAILURE: The memory size must be set to a "
 			"value greater than 0.\r\n");
 		return EXIT_FAILURE;
 	}
 
+	/* memorySize must be a multiple of blockSize */
+	if((device->blockSize > 0) && 
+		(device->memorySize % device->blockSize != 0))
+	{
+		fprintf(report, "FAILURE: The memory size must be a multiple "
+			"of the block size.\r\n         Memory size: \t"
+			"%lu\r\n         Block size: \t%lu\r\n", 
+			device->memorySize, device->blockSize);
+		return EXIT_FAILURE;
+	}
+
 	/* program data word bit order must be set */
-	if(bitOrderIsEmpty(device->wordBitOrder[PROGRAM]) == true)
+	if(bitOrderIsEmpty(&device->wordBitOrder[PROGRAM]) == true)
 	{
-		fprintf(stdout, "FAILURE: The program data word bit order has "
+		fprintf(report, "FAILURE: The program data word bit order has "
 			"not been set.\r\n");
 		return EXIT_FAILURE;
 	}
 
 	/* verify data word bit order must be set */
-	if(bitOrderIsEmpty(device->wordBitOrder[VERIFY]) == true)
+	if(bitOrderIsEmpty(&device->wordBitOrder[VERIFY]) == true)
 	{
-		fprintf(stdout, "FAILURE: The verify data word bit order has "
+		fprintf(report, "FAILURE: The verify data word bit order has "
 			"not been set.\r\n");
 		return EXIT_FAILURE;
 	}
 
 	/* program address word bit order must be set */
-	if(bitOrderIsEmpty(device->wordAddressBitOrder[PROGRAM]) == true)
+	if(bitOrderIsEmpty(&device->wordAddressBitOrder[PROGRAM]) == true)
 	{
-		fprintf(stdout, "FAILURE: The program address word bit order "
+		fprintf(report, "FAILURE: The program address word bit order "
 			"has not been set.\r\n");
 		return EXIT_FAILURE;
 	}
 
 	/* verify address word bit order must be set */
-	if(bitOrderIsEmpty(device->wordAddressBitOrder[VERIFY]) == true)
+	if(bitOrderIsEmpty(&device->wordAddressBitOrder[VERIFY]) == true)
 	{
-		fprintf(stdout, "FAILURE: The verify address word bit order "
+		fprintf(report, "FAILURE: The verify address word bit order "
 			"has not been set.\r\n");
 		return EXIT_FAILURE;
 	}
@@ -267,40 +391,39 @@ int	ProgrammingPattern(deviceData *device)
 
 /* Assignment = ident '=' ( String | Number | BitOrderDescription ) .         */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	Assignment(deviceData *device)
+int	Assignment(parserContext *parser)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
 	int expectedSymbol;
 	int keyword;
 	char keywordString[MAX_IDENT_LENGTH];
 
 
 	/* expecting an ident */
-	if(getCurrentSymbol() != IDENT_SYM)
+	if(getCurrentSymbol(scanner) != IDENT_SYM)
 	{
-		fprintf(stdout, "FAILURE: Ident expected at line %i column %i."
-			"\r\n", getCurrentLine(), getCurrentColumn());
+		fprintf(report, "FAILURE: Ident expected at line %i column %i."
+			"\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 	/* copy the identifier to keyword */
-	strcpy(keywordString, getCurrentIdentName());
-
-	keyword = 0;
-	while((strcmp(keywordList[keyword], keywordString) != 0) && 
-					(strcmp(keywordList[keyword], "") != 0))
-		keyword++;
+	strcpy(keywordString, getCurrentIdentName(scanner));
 
 	/* check if the keyword is valid */
-	if(strcmp(keywordList[keyword], "") == 0)
+	keyword = findKeyword(keywordString);
+	if(keyword < 0)
 	{
-		fprintf(stdout, "FAILURE: Unknown keyword %s at line %i column "
-			"%i.\r\n", keywordString, getCurrentLine(),
-			getCurrentColumn());
+		fprintf(report, "FAILURE: Unknown keyword %s at line %i column "
+			"%i.\r\n", keywordString, getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	/* get expected following symbol */
 	switch(keywordType[keyword])
@@ -319,38 +442,40 @@ int	Assignment(deviceData *device)
 	}
 
 	/* expecting an equal symbol */
-	if(getCurrentSymbol() != EQUAL_SYM)
+	if(getCurrentSymbol(scanner) != EQUAL_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
-			"\r\n", terminalSymList[EQUAL_SYM], getCurrentLine(),
-			getCurrentColumn());
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
+			"\r\n", terminalSymList[EQUAL_SYM],
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 
-	switch(getCurrentSymbol())
+	switch(getCurrentSymbol(scanner))
 	{
 		case DOUBLE_QUOTE_SYM:
 		/* check keyword semantic */
 		if(expectedSymbol != DOUBLE_QUOTE_SYM)
 		{
 			if(expectedSymbol == HEX_NUMBER_SYM)
-				fprintf(stdout, "FAILURE: Number expected after"
+				fprintf(report, "FAILURE: Number expected after"
 					" \"%s\" keyword at line %i column %i."
 					"\r\n", keywordList[keyword], 
-					getCurrentLine(), getCurrentColumn());
+					getCurrentLine(scanner),
+					getCurrentColumn(scanner));
 			else
-				fprintf(stdout, "FAILURE: '%c' expected after "
+				fprintf(report, "FAILURE: '%c' expected after "
 					"\"%s\" keyword at line %i column %i."
-					"\r\n", terminalSymList[expectedSymbol], 
-					keywordList[keyword], getCurrentLine(), 
-					getCurrentColumn());
+					"\r\n", terminalSymList[expectedSymbol],
+					keywordList[keyword],
+					getCurrentLine(scanner),
+					getCurrentColumn(scanner));
 
 			return EXIT_FAILURE;
 		}
 
-		if(String(device, keyword) != EXIT_SUCCESS) return EXIT_FAILURE;
+		if(String(parser, keyword) != EXIT_SUCCESS) return EXIT_FAILURE;
 		break;
 
 
@@ -359,57 +484,60 @@ int	Assignment(deviceData *device)
 		/* check keyword semantic */
 		if(expectedSymbol != HEX_NUMBER_SYM)
 		{
-			fprintf(stdout, "FAILURE: '%c' expected after \"%s\" "
+			fprintf(report, "FAILURE: '%c' expected after \"%s\" "
 				"keyword at line %i column %i.\r\n", 
 				terminalSymList[expectedSymbol], 
-				keywordList[keyword], getCurrentLine(), 
-				getCurrentColumn());
+				keywordList[keyword], getCurrentLine(scanner), 
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
 
-		if(Number(device, keyword) != EXIT_SUCCESS) return EXIT_FAILURE;
+		if(Number(parser, keyword) != EXIT_SUCCESS) return EXIT_FAILURE;
 		break;
 
 
 		case NEWLINE_SYM:
 		/* new line after equal symbol is only allowed */
 		/* when a BitSequence is following */
-		scanNextSymbolSkipNewline();
+		scanNextSymbolSkipNewline(scanner);
 		case LEFT_CURLY_BRACKET_SYM:
 		/* check keyword semantic */
 		if(expectedSymbol != LEFT_CURLY_BRACKET_SYM)
 		{
 			if(expectedSymbol == HEX_NUMBER_SYM)
-				fprintf(stdout, "FAILURE: Number expected after"
+				fprintf(report, "FAILURE: Number expected after"
 					" \"%s\" keyword at line %i column %i."
 					"\r\n", keywordList[keyword], 
-					getCurrentLine(), getCurrentColumn());
+					getCurrentLine(scanner),
+					getCurrentColumn(scanner));
 			else
-				fprintf(stdout, "FAILURE: '%c' expected after "
+				fprintf(report, "FAILURE: '%c' expected after "
 					"\"%s\" keyword at line %i column %i."
-					"\r\n", terminalSymList[expectedSymbol], 
-					keywordList[keyword], getCurrentLine(), 
-					getCurrentColumn());
+					"\r\n", terminalSymList[expectedSymbol],
+					keywordList[keyword],
+					getCurrentLine(scanner),
+					getCurrentColumn(scanner));
 
 			return EXIT_FAILURE;
 		}
 
-		if(initializeBitArray(MAX_BIT_ARRAY_LENGTH) != EXIT_SUCCESS)
+		if(initializeBitArray(&parser->bits, MAX_BIT_ARRAY_LENGTH)
+							!= EXIT_SUCCESS)
 			return EXIT_FAILURE;
 
-		if(BitOrderDescription(device, keyword) != EXIT_SUCCESS) 
+		if(BitOrderDescription(parser, keyword) != EXIT_SUCCESS) 
 		{
-			disposeBitArray();
+			disposeBitArray(&parser->bits);
 			return EXIT_FAILURE;
 		}
-		disposeBitArray();
+		disposeBitArray(&parser->bits);
 		break;
 
 
 		default:
-		fprintf(stdout, "FAILURE: String, number or bit sequence "
+		fprintf(report, "FAILURE: String, number or bit sequence "
 			"expected at line %i column %i.\r\n", 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
@@ -419,27 +547,33 @@ int	Assignment(deviceData *device)
 
 /* String = '"' ident '"' .                                                   */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	String(deviceData *device, int keyword)
+int	String(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+	deviceData *device = parser->device;
+
+
 	/* expecting a double quote symbol */
-	if(getCurrentSymbol() != DOUBLE_QUOTE_SYM)
+	if(getCurrentSymbol(scanner) != DOUBLE_QUOTE_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[DOUBLE_QUOTE_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	/* expecting an ident */
-	if(getCurrentSymbol() != IDENT_SYM)
+	if(getCurrentSymbol(scanner) != IDENT_SYM)
 	{
-		fprintf(stdout, "FAILURE: Ident expected at line %i column %i."
-			"\r\n", getCurrentLine(), getCurrentColumn());
+		fprintf(report, "FAILURE: Ident expected at line %i column %i."
+			"\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
@@ -450,35 +584,36 @@ int	String(deviceData *device, int keyword)
 		if(strcmp(device->name, "") == 0)
 		{
 			/* copy the name of the device */
-			strcpy(device->name, getCurrentIdentName());
+			strcpy(device->name, getCurrentIdentName(scanner));
 		}
 		else
 		{
-			fprintf(stdout, "FAILURE: Device name has already been "
+			fprintf(report, "FAILURE: Device name has already been "
 				"set at line %i column %i.\r\n",
-				getCurrentLine(), getCurrentColumn());
+				getCurrentLine(scanner),
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
 		break;
 
 		default:
-		fprintf(stdout, "FAILURE: Tried to assign a string to %s at "
+		fprintf(report, "FAILURE: Tried to assign a string to %s at "
 			"line %i column %i.\r\n", keywordList[keyword], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	/* expecting a double quote symbol */
-	if(getCurrentSymbol() != DOUBLE_QUOTE_SYM)
+	if(getCurrentSymbol(scanner) != DOUBLE_QUOTE_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[DOUBLE_QUOTE_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbolSkipNewline();
+	scanNextSymbolSkipNewline(scanner);
 
 	return EXIT_SUCCESS;
 }
@@ -486,18 +621,24 @@ int	String(deviceData *device, int keyword)
 
 /* Number = hexnumber | decnumber .                                           */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	Number(deviceData *device, int keyword)
+int	Number(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+	deviceData *device = parser->device;
+
+
 	/* expecting a hexnumber or a decnumber symbol */
-	if((getCurrentSymbol() != DEC_NUMBER_SYM) && 
-					(getCurrentSymbol() != HEX_NUMBER_SYM))
+	if((getCurrentSymbol(scanner) != DEC_NUMBER_SYM) && 
+				(getCurrentSymbol(scanner) != HEX_NUMBER_SYM))
 	{
-		fprintf(stdout, "FAILURE: Number expected at line %i column %i."
-			"\r\n", getCurrentLine(), getCurrentColumn());
+		fprintf(report, "FAILURE: Number expected at line %i column %i."
+			"\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
@@ -507,13 +648,14 @@ int	Number(deviceData *device, int keyword)
 		case MEMORY_SIZE:
 		if(device->memorySize == 0)
 		{
-			device->memorySize = getCurrentNumberValue();
+			device->memorySize = getCurrentNumberValue(scanner);
 		}
 		else
 		{
-			fprintf(stdout, "FAILURE: Memory size has already been "
+			fprintf(report, "FAILURE: Memory size has already been "
 				"set at line %i column %i.\r\n",
-				getCurrentLine(), getCurrentColumn());
+				getCurrentLine(scanner),
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
 		break;
@@ -521,49 +663,51 @@ int	Number(deviceData *device, int keyword)
 		case BLOCK_SIZE:
 		if(device->blockSize == 0)
 		{
-			device->blockSize = getCurrentNumberValue();
+			device->blockSize = getCurrentNumberValue(scanner);
 		}
 		else
 		{
-			fprintf(stdout, "FAILURE: Block size has already been "
+			fprintf(report, "FAILURE: Block size has already been "
 				"set at line %i column %i.\r\n",
-				getCurrentLine(), getCurrentColumn());
+				getCurrentLine(scanner),
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
 		break;
 
 		case START_ADDRESS:
-		device->startAddress = getCurrentNumberValue();
+		device->startAddress = getCurrentNumberValue(scanner);
 		break;
 
 		case ADDRESS_STEP:
-		device->addressStepPerWord = getCurrentNumberValue();
+		device->addressStepPerWord = getCurrentNumberValue(scanner);
 		break;
 
 		case WORD_LENGTH:
 		/* check if word length is divisible by 8 */
-		if(getCurrentNumberValue() % 8)
+		if(getCurrentNumberValue(scanner) % 8)
 		{
-			fprintf(stdout, "FAILURE: Word length must be divisible"
+			fprintf(report, "FAILURE: Word length must be divisible"
 				" by 8 at line %i column %i.\r\n", 
-				getCurrentLine(), getCurrentColumn());
+				getCurrentLine(scanner),
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
-		device->wordLength = getCurrentNumberValue();
+		device->wordLength = getCurrentNumberValue(scanner);
 		break;
 
 		case ADDRESS_LENGTH:
-		device->addressLength = getCurrentNumberValue();
+		device->addressLength = getCurrentNumberValue(scanner);
 		break;
 
 		default:
-		fprintf(stdout, "FAILURE: Tried to assign a number to %s at "
+		fprintf(report, "FAILURE: Tried to assign a number to %s at "
 			"line %i column %i.\r\n", keywordList[keyword], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
-	scanNextSymbolSkipNewline();
+	scanNextSymbolSkipNewline(scanner);
 
 	return EXIT_SUCCESS;
 }
@@ -571,35 +715,37 @@ int	Number(deviceData *device, int keyword)
 
 /* BitOrderDescription = '{' BitSequence '}' .                                */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	BitOrderDescription(deviceData *device, int keyword)
+int	BitOrderDescription(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+	deviceData *device = parser->device;
 	int Line;
 	int Column;
-	int bitOrderLength;
-	int8_t *bitOrder;
+	bitOrderRuns *bitOrder;
 
 
 	/* expecting a left curly bracket symbol */
-	if(getCurrentSymbol() != LEFT_CURLY_BRACKET_SYM)
+	if(getCurrentSymbol(scanner) != LEFT_CURLY_BRACKET_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[LEFT_CURLY_BRACKET_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbolSkipNewline();
+	scanNextSymbolSkipNewline(scanner);
 
 	/* process the whole bit order description */
-	while((getCurrentSymbol() == DEC_NUMBER_SYM) || 
-		(getCurrentSymbol() == SINGLE_QUOTE_SYM) ||
-		(getCurrentSymbol() == LEFT_PARENTHESIS_SYM))
+	while((getCurrentSymbol(scanner) == DEC_NUMBER_SYM) || 
+		(getCurrentSymbol(scanner) == SINGLE_QUOTE_SYM) ||
+		(getCurrentSymbol(scanner) == LEFT_PARENTHESIS_SYM))
 	{
 		/* expecting a BitSequence statement */
-		if(BitSequence(device, keyword) != EXIT_SUCCESS)
+		if(BitSequence(parser, keyword) != EXIT_SUCCESS)
 			return EXIT_FAILURE;
 	}
 
@@ -608,95 +754,49 @@ int	BitOrderDescription(deviceData *device, int keyword)
 		device->blockSize = device->memorySize;
 
 	/* store the bit order in the right array */
-	bitOrder = getBitArray();
-	if(bitOrder == NULL)
-	{
-		fprintf(stderr, "ERROR: Invalid bit array.\r\n");
-		return EXIT_FAILURE;
-	}
-	bitOrderLength = bitArrayGetCurrentIndex();
+	bitOrder = getBitArray(&parser->bits);
 
 	/* set program data bit order */
 	if(keyword == PROGRAM_DATA || keyword == DATA)
-	{
-		if(bitOrderLength > MAX_BIT_ORDER_LENGTH)
-		{
-			fprintf(stderr, "ERROR: Length of program data bit "
-				"order exceeds the maximum number of %i.\r\n",
-				MAX_BIT_ORDER_LENGTH);
-			return EXIT_FAILURE;
-		}
-
-		memcpy(device->wordBitOrder[PROGRAM], bitOrder, bitOrderLength);
-	}
+		device->wordBitOrder[PROGRAM] = *bitOrder;
 
 	/* set verify data bit order */
 	if(keyword == VERIFY_DATA || keyword == DATA)
-	{
-		if(bitOrderLength > MAX_BIT_ORDER_LENGTH)
-		{
-			fprintf(stderr, "ERROR: Length of verify data bit "
-				"order exceeds the maximum number of %i.\r\n",
-				MAX_BIT_ORDER_LENGTH);
-			return EXIT_FAILURE;
-		}
-
-		memcpy(device->wordBitOrder[VERIFY], bitOrder, bitOrderLength);
-	}
+		device->wordBitOrder[VERIFY] = *bitOrder;
 
 	/* set program address bit order */
 	if(keyword == PROGRAM_ADDRESS || keyword == ADDRESS)
 	{
-		if(bitOrderLength > MAX_BIT_ORDER_LENGTH)
-		{
-			fprintf(stderr, "ERROR: Length of program address bit "
-				"order exceeds the maximum number of %i.\r\n",
-				MAX_BIT_ORDER_LENGTH);
-			return EXIT_FAILURE;
-		}
-
-		if(bitOrderIsEmpty(device->wordAddressBitOrder[PROGRAM])== true)
-			memcpy(device->wordAddressBitOrder[PROGRAM], bitOrder, 
-				bitOrderLength);
+		if(bitOrderIsEmpty(&device->wordAddressBitOrder[PROGRAM])==true)
+			device->wordAddressBitOrder[PROGRAM] = *bitOrder;
 		else
-			memcpy(device->postDataBlockAddrBitOrder[PROGRAM],
-				bitOrder, bitOrderLength);
+			device->postDataBlockAddrBitOrder[PROGRAM] = *bitOrder;
 	}
 
 	/* set verify address bit order */
 	if(keyword == VERIFY_ADDRESS || keyword == ADDRESS)
 	{
-		if(bitOrderLength > MAX_BIT_ORDER_LENGTH)
-		{
-			fprintf(stderr, "ERROR: Length of verify address bit "
-				"order exceeds the maximum number of %i.\r\n",
-				MAX_BIT_ORDER_LENGTH);
-			return EXIT_FAILURE;
-		}
-
-		if(bitOrderIsEmpty(device->wordAddressBitOrder[VERIFY]) == true)
-			memcpy(device->wordAddressBitOrder[VERIFY], bitOrder, 
-				bitOrderLength);
+		if(bitOrderIsEmpty(&device->wordAddressBitOrder[VERIFY]) ==true)
+			device->wordAddressBitOrder[VERIFY] = *bitOrder;
 		else
-			memcpy(device->postDataBlockAddrBitOrder[VERIFY],
-				bitOrder, bitOrderLength);
+			device->postDataBlockAddrBitOrder[VERIFY] = *bitOrder;
 	}
 
 	/* skip potential new lines */
-	Line = getCurrentLine();
-	Column = getCurrentColumn();
-	if(getCurrentSymbol() == NEWLINE_SYM)
-		scanNextSymbolSkipNewline();
+	Line = getCurrentLine(scanner);
+	Column = getCurrentColumn(scanner);
+	if(getCurrentSymbol(scanner) == NEWLINE_SYM)
+		scanNextSymbolSkipNewline(scanner);
 
 	/* expecting a right curly bracket symbol */
-	if(getCurrentSymbol() != RIGHT_CURLY_BRACKET_SYM)
+	if(getCurrentSymbol(scanner) != RIGHT_CURLY_BRACKET_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' or '%c' expected at line %i "
+		fprintf(report, "FAILURE: '%c' or '%c' expected at line %i "
 			"column %i.\r\n", terminalSymList[COMMA_SYM], 
 			terminalSymList[RIGHT_CURLY_BRACKET_SYM], Line, Column);
 		return EXIT_FAILURE;
 	}
-	scanNextSymbolSkipNewline();
+	scanNextSymbolSkipNewline(scanner);
 
 	return EXIT_SUCCESS;
 }
@@ -704,24 +804,27 @@ int	BitOrderDescription(deviceData *device, int keyword)
 
 /* BitSequence = SequenceLoop { ',' SequenceLoop } .                          */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	BitSequence(deviceData *device, int keyword)
+int	BitSequence(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+
+
 	/* expecting a SequenceLoop statement */
-	if(SequenceLoop(device, keyword) != EXIT_SUCCESS)
+	if(SequenceLoop(parser, keyword) != EXIT_SUCCESS)
 		return EXIT_FAILURE;
 
 	/* expecting any number of SequenceLoop statements */
-	while(getCurrentSymbol() == COMMA_SYM)
+	while(getCurrentSymbol(scanner) == COMMA_SYM)
 	{
 		/* a line break is allowed after a comma */
-		scanNextSymbolSkipNewline();
+		scanNextSymbolSkipNewline(scanner);
 
 		/* expecting a SequenceLoop statement */
-		if(SequenceLoop(device, keyword) != EXIT_SUCCESS)
+		if(SequenceLoop(parser, keyword) != EXIT_SUCCESS)
 			return EXIT_FAILURE;
 	}
 
@@ -731,51 +834,58 @@ int	BitSequence(deviceData *device, int keyword)
 
 /* SequenceLoop = SequencePart [ '*' decnumber ] .                            */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	SequenceLoop(deviceData *device, int keyword)
+int	SequenceLoop(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+	deviceData *device = parser->device;
 	int result;
 	int blockSizeFound;
 
 	int startIndex;
 	int endIndex;
+	int unblockedLength;
 	uint32_64_t repeatNum;
 
-	int8_t *bitOrder;
+	bitOrderRuns preBlockBitOrder;
+	bitOrderRuns wordBitOrder;
 
 
 	/* remember start index of the following bit sequence part */
-	startIndex = bitArrayGetCurrentIndex();
+	startIndex = bitArrayGetCurrentIndex(&parser->bits);
 
 	/* expecting a SequencePart statement */
-	if(SequencePart(device, keyword) != EXIT_SUCCESS)
+	if(SequencePart(parser, keyword) != EXIT_SUCCESS)
 		return EXIT_FAILURE;
 
 	/* optional repeat part */
-	if(getCurrentSymbol() == ASTERISK_SYM)
+	if(getCurrentSymbol(scanner) == ASTERISK_SYM)
 	{
-		scanNextSymbol();
+		scanNextSymbol(scanner);
 
 		/* expecting a decnumber symbol */
-		if(getCurrentSymbol() != DEC_NUMBER_SYM)
+		if(getCurrentSymbol(scanner) != DEC_NUMBER_SYM)
 		{
-			fprintf(stdout, "FAILURE: Number expected at line %i "
-				"column %i.\r\n", getCurrentLine(), 
-				getCurrentColumn());
+			fprintf(report, "FAILURE: Number expected at line %i "
+				"column %i.\r\n", getCurrentLine(scanner), 
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
-		repeatNum = getCurrentNumberValue()-1;
-		endIndex = bitArrayGetCurrentIndex()-1;
+		repeatNum = getCurrentNumberValue(scanner)-1;
+		endIndex = bitArrayGetCurrentIndex(&parser->bits)-1;
+		unblockedLength = MAX_UNBLOCKED_REPEAT_LENGTH - endIndex - 1;
 
 		/* check if the number is higher than 0 */
 		if(repeatNum < 1)
 		{
-			fprintf(stdout, "FAILURE: Number at line %i column %i "
-				"must be greater than 1.\r\n", getCurrentLine(),
-				getCurrentColumn());
+			fprintf(report, "FAILURE: Number at line %i column %i "
+				"must be greater than 1.\r\n",
+				getCurrentLine(scanner),
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
 
@@ -784,33 +894,35 @@ int	SequenceLoop(deviceData *device, int keyword)
 		/* the block size and the repeat number are equal */
 		/* -> the current repeat number means a repetition */
 		/*    over the whole block size */
+		/* if the block size has not been set, a repeat too long */
+		/* for a word sets it */
 		blockSizeFound = false;
 		if(repeatNum == device->blockSize && ADDRESS_KEYWORD)
 		{
 			blockSizeFound = true;
 		}
+		else if(device->blockSize == 0 && ADDRESS_KEYWORD &&
+			((unblockedLength < 0) || (repeatNum > (uint32_64_t) 
+				unblockedLength / (endIndex - startIndex + 1))))
+		{
+			device->blockSize = repeatNum;
+			blockSizeFound = true;
+		}
 		else
 		{
 			/* repeat the sequence */
-			result =bitArrayRepeat(startIndex, endIndex, repeatNum);
+			result = bitArrayRepeat(&parser->bits, startIndex,
+							endIndex, repeatNum);
 			if(result != EXIT_SUCCESS)
 			{
-				if(device->blockSize == 0 && ADDRESS_KEYWORD)
-				{
-					device->blockSize = repeatNum;
-					blockSizeFound = true;
-				}
-				else
-				{
-
-					fprintf(stdout, "FAILURE: Ambiguous "
-						"block size at line %i column "
-						"%i.\r\n         The length of"
-						"the bit array has been "
-						"exceeded.", getCurrentLine(),
-						getCurrentColumn());
-					return EXIT_FAILURE;
-				}
+				fprintf(report, "FAILURE: Ambiguous "
+					"block size at line %i column "
+					"%i.\r\n         The length of"
+					"the bit array has been "
+					"exceeded.",
+					getCurrentLine(scanner),
+					getCurrentColumn(scanner));
+				return EXIT_FAILURE;
 			}
 		}
 
@@ -818,45 +930,43 @@ int	SequenceLoop(deviceData *device, int keyword)
 		/* wordAddressBitOrderout of the bit array datastructure */
 		if(blockSizeFound == true)
 		{
-			bitOrder = getBitArray();
-
-			/* check the length of the bit orders */
-			if((endIndex-startIndex > MAX_BIT_ORDER_LENGTH) ||
-					(startIndex-1 > MAX_BIT_ORDER_LENGTH))
+			/* the repeated part is the word address */
+			if(bitArraySplit(&parser->bits, startIndex, 
+				&preBlockBitOrder, &wordBitOrder) != 
+								EXIT_SUCCESS)
 			{
-				fprintf(stdout, "FAILURE: Length of the bit "
+				fprintf(report, "FAILURE: Length of the bit "
 					"order has been exceeded at line %i "
-					"column %i.\r\n", getCurrentLine(),
-					getCurrentColumn());
+					"column %i.\r\n",
+					getCurrentLine(scanner),
+					getCurrentColumn(scanner));
 				return EXIT_FAILURE;
 			}
 
 			/* get program address bit orders */
 			if(keyword == ADDRESS || keyword == PROGRAM_ADDRESS)
 			{
-				memcpy(device->preDataBlockAddrBitOrder[PROGRAM]
-					, bitOrder, startIndex-1);
-				memcpy(device->wordAddressBitOrder[PROGRAM],
-					bitOrder+startIndex,
-					endIndex-startIndex);
+				device->preDataBlockAddrBitOrder[PROGRAM] =
+							preBlockBitOrder;
+				device->wordAddressBitOrder[PROGRAM] =
+							wordBitOrder;
 			}
 
 			/* get verify address bit orders */
 			if(keyword == ADDRESS || keyword == VERIFY_ADDRESS)
 			{
-				memcpy(device->preDataBlockAddrBitOrder[VERIFY]
-					, bitOrder, startIndex-1);
-				memcpy(device->wordAddressBitOrder[VERIFY],
-					bitOrder+startIndex,
-					endIndex-startIndex);
+				device->preDataBlockAddrBitOrder[VERIFY] =
+							preBlockBitOrder;
+				device->wordAddressBitOrder[VERIFY] =
+							wordBitOrder;
 			}
 
 			/* clear the bit array */
-			disposeBitArray();
-			initializeBitArray(MAX_BIT_ARRAY_LENGTH);
+			disposeBitArray(&parser->bits);
+			initializeBitArray(&parser->bits, MAX_BIT_ARRAY_LENGTH);
 		}
 
-		scanNextSymbol();
+		scanNextSymbol(scanner);
 	}
 	
 	return EXIT_SUCCESS;
@@ -865,37 +975,41 @@ int	SequenceLoop(deviceData *device, int keyword)
 
 /* SequencePart = Range | Literal | Group .                                   */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	SequencePart(deviceData *device, int keyword)
+int	SequencePart(parserContext *parser, int keyword)
 {
-	switch(getCurrentSymbol())
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+
+
+	switch(getCurrentSymbol(scanner))
 	{
 		case DEC_NUMBER_SYM:
 		/* expecting a Range statement */
-		if(Range(device, keyword) != EXIT_SUCCESS)
+		if(Range(parser, keyword) != EXIT_SUCCESS)
 			return EXIT_FAILURE;
 		break;
 
 		case SINGLE_QUOTE_SYM:
 		/* expecting a Literal statement */
-		if(Literal(device, keyword) != EXIT_SUCCESS)
+		if(Literal(parser, keyword) != EXIT_SUCCESS)
 			return EXIT_FAILURE;
 		break;
 
 		case LEFT_PARENTHESIS_SYM:
 		/* expecting a Group statement */
-		if(Group(device, keyword) != EXIT_SUCCESS)
+		if(Group(parser, keyword) != EXIT_SUCCESS)
 			return EXIT_FAILURE;
 		break;
 
 		default:
-		fprintf(stdout, "FAILURE: Number, '%c' or '%c' expected at line"
+		fprintf(report, "FAILURE: Number, '%c' or '%c' expected at line"
 			" %i column %i.\r\n", terminalSymList[SINGLE_QUOTE_SYM],
-			terminalSymList[LEFT_PARENTHESIS_SYM], getCurrentLine(),
-			getCurrentColumn());
+			terminalSymList[LEFT_PARENTHESIS_SYM],
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
@@ -905,12 +1019,15 @@ int	SequencePart(deviceData *device, int keyword)
 
 /* Range = decnumber  [ '-' decnumber ] .                                     */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	Range(deviceData *device, int keyword)
+int	Range(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+	deviceData *device = parser->device;
 	int8_t startRange;
 	int8_t endRange;
 	uint8_t wordLength;
@@ -923,63 +1040,65 @@ int	Range(deviceData *device, int keyword)
 		wordLength = device->addressLength;
 
 	/* expecting a decnumber symbol */
-	if(getCurrentSymbol() != DEC_NUMBER_SYM)
+	if(getCurrentSymbol(scanner) != DEC_NUMBER_SYM)
 	{
-		fprintf(stdout, "FAILURE: Number expected at line %i column %i."
-			"\r\n", getCurrentLine(), getCurrentColumn());
+		fprintf(report, "FAILURE: Number expected at line %i column %i."
+			"\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
 	/* check if the number is less than the word length */
-	if(getCurrentNumberValue() >= wordLength)
+	if(getCurrentNumberValue(scanner) >= wordLength)
 	{
-		fprintf(stdout, "FAILURE: Number at line %i column %i must be "
-			"less than %i.\r\n", getCurrentLine(),
-			getCurrentColumn(), wordLength);
+		fprintf(report, "FAILURE: Number at line %i column %i must be "
+			"less than %i.\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner), wordLength);
 		return EXIT_FAILURE;
 	}
 
 	/* set start and end of the range */
-	startRange = getCurrentNumberValue();
-	endRange = getCurrentNumberValue();
-	scanNextSymbol();
+	startRange = getCurrentNumberValue(scanner);
+	endRange = getCurrentNumberValue(scanner);
+	scanNextSymbol(scanner);
 
 
 	/* optional part  */
-	if(getCurrentSymbol() == HYPHEN_SYM)
+	if(getCurrentSymbol(scanner) == HYPHEN_SYM)
 	{
-		scanNextSymbol();
+		scanNextSymbol(scanner);
 
 		/* expecting a decnumber symbol */
-		if(getCurrentSymbol() != DEC_NUMBER_SYM)
+		if(getCurrentSymbol(scanner) != DEC_NUMBER_SYM)
 		{
-			fprintf(stdout, "FAILURE: Number expected at line %i "
-				"column %i.\r\n", getCurrentLine(),
-				getCurrentColumn());
+			fprintf(report, "FAILURE: Number expected at line %i "
+				"column %i.\r\n", getCurrentLine(scanner),
+				getCurrentColumn(scanner));
 			return EXIT_FAILURE;
 		}
 
 		/* set end of the range */
-		endRange = getCurrentNumberValue();
+		endRange = getCurrentNumberValue(scanner);
 
 		/* check if the number is less than the word length */
 		if(endRange >= wordLength)
 		{
-			fprintf(stdout, "FAILURE: Number at line %i column %i "
-				"must be less than %i.\r\n", getCurrentLine(),
-				getCurrentColumn(), wordLength);
+			fprintf(report, "FAILURE: Number at line %i column %i "
+				"must be less than %i.\r\n",
+				getCurrentLine(scanner),
+				getCurrentColumn(scanner), wordLength);
 			return EXIT_FAILURE;
 		}
 
-		scanNextSymbol();
+		scanNextSymbol(scanner);
 	}
 
 	/* add the range to the bit array */
-	if(bitArrayAdd(startRange, endRange) != EXIT_SUCCESS)
+	if(bitArrayAdd(&parser->bits, startRange, endRange) != EXIT_SUCCESS)
 	{
-		fprintf(stdout, "FAILURE: Length of the bit order has been "
-			"exceeded at line %i column %i.\r\n", getCurrentLine(),
-			getCurrentColumn());
+		fprintf(report, "FAILURE: Length of the bit order has been "
+			"exceeded at line %i column %i.\r\n",
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
@@ -989,65 +1108,68 @@ int	Range(deviceData *device, int keyword)
 
 /* Literal = ''' decnumber ''' .                                              */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	Literal(deviceData *device, int keyword)
+int	Literal(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
 	int result;
 
 
 	/* expecting a single quote symbol */
-	if(getCurrentSymbol() != SINGLE_QUOTE_SYM)
+	if(getCurrentSymbol(scanner) != SINGLE_QUOTE_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[SINGLE_QUOTE_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	/* expecting a decnumber symbol */
-	if(getCurrentSymbol() != DEC_NUMBER_SYM)
+	if(getCurrentSymbol(scanner) != DEC_NUMBER_SYM)
 	{
-		fprintf(stdout, "FAILURE: Number expected at line %i column %i."
-			"\r\n", getCurrentLine(), getCurrentColumn());
+		fprintf(report, "FAILURE: Number expected at line %i column %i."
+			"\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 
 	/* check if the number is either 0 or 1 */
-	if(getCurrentNumberValue() > 1)
+	if(getCurrentNumberValue(scanner) > 1)
 	{
-		fprintf(stdout, "FAILURE: Number at line %i column %i must be "
-			"either 0 or 1.\r\n", getCurrentLine(),
-			getCurrentColumn());
+		fprintf(report, "FAILURE: Number at line %i column %i must be "
+			"either 0 or 1.\r\n", getCurrentLine(scanner),
+			getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
 	/* add the literal to the bit array */
-	if(getCurrentNumberValue() == 0)
-		result = bitArrayAdd(LITERAL0_BIT, LITERAL0_BIT);
-	if(getCurrentNumberValue() == 1)
-		result = bitArrayAdd(LITERAL1_BIT, LITERAL1_BIT);
+	if(getCurrentNumberValue(scanner) == 0)
+		result = bitArrayAdd(&parser->bits, LITERAL0_BIT, LITERAL0_BIT);
+	if(getCurrentNumberValue(scanner) == 1)
+		result = bitArrayAdd(&parser->bits, LITERAL1_BIT, LITERAL1_BIT);
 
 	if(result != EXIT_SUCCESS)
 	{
-		fprintf(stdout, "FAILURE: Length of the bit order has been "
-			"exceeded at line %i column %i.\r\n", getCurrentLine(),
-			getCurrentColumn());
+		fprintf(report, "FAILURE: Length of the bit order has been "
+			"exceeded at line %i column %i.\r\n",
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	/* expecting a single quote symbol */
-	if(getCurrentSymbol() != SINGLE_QUOTE_SYM)
+	if(getCurrentSymbol(scanner) != SINGLE_QUOTE_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[SINGLE_QUOTE_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	return EXIT_SUCCESS;
 }
@@ -1055,35 +1177,39 @@ int	Literal(deviceData *device, int keyword)
 
 /* Group = '(' BitSequence ')' .                                              */
 /*----------------------------------------------------------------------------*/
-/* OUT device: Device structure for storing the parsed data.                  */
+/* IN parser: State of the parser, the parsed data is stored in its device.   */
 /* IN keyword: Current keyword.                                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	Group(deviceData *device, int keyword)
+int	Group(parserContext *parser, int keyword)
 {
+	scannerContext *scanner = &parser->scanner;
+	FILE *report = parser->report;
+
+
 	/* expecting a left parenthesis symbol */
-	if(getCurrentSymbol() != LEFT_PARENTHESIS_SYM)
+	if(getCurrentSymbol(scanner) != LEFT_PARENTHESIS_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[LEFT_PARENTHESIS_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	/* expecting a BitSequence statement */
-	if(BitSequence(device, keyword) != EXIT_SUCCESS)
+	if(BitSequence(parser, keyword) != EXIT_SUCCESS)
 		return EXIT_FAILURE;
 
 	/* expecting a right parenthesis symbol */
-	if(getCurrentSymbol() != RIGHT_PARENTHESIS_SYM)
+	if(getCurrentSymbol(scanner) != RIGHT_PARENTHESIS_SYM)
 	{
-		fprintf(stdout, "FAILURE: '%c' expected at line %i column %i."
+		fprintf(report, "FAILURE: '%c' expected at line %i column %i."
 			"\r\n", terminalSymList[RIGHT_PARENTHESIS_SYM], 
-			getCurrentLine(), getCurrentColumn());
+			getCurrentLine(scanner), getCurrentColumn(scanner));
 		return EXIT_FAILURE;
 	}
-	scanNextSymbol();
+	scanNextSymbol(scanner);
 
 	return EXIT_SUCCESS;
 }
@@ -48,7 +48,8 @@
 #include "device-description.h"
 
 
-extern	int	compileSourceFile(char *, char *);
+extern	int	parseSourceFile(char *, deviceData *, FILE *);
+extern	int	parseSourceBuffer(char *, size_t, deviceData *, FILE *);
 
 #endif /* _PARSER_H */
 
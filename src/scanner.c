@@ -57,309 +57,428 @@
 #define isblank(character)		(character == ' ' || character == '\t')
 
 
-/* global variables for saving information about the current state of the */
-/* scanner. */
-static char currentCharacter;
-static char previousCharacter;
-static int currentSymbol;
-
-static char commentBuffer[BUFSIZ];
-static char currentIdentName[MAX_IDENT_LENGTH];
-static uint32_64_t currentNumberValue;
-
-static int currentSymbolLine;
-static int currentSymbolColumn;
+/* Read a character from the source.                                          */
+/*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
+/* RETURNS: Next character of the source or EOF if the end has been reached.  */
+/*----------------------------------------------------------------------------*/
+static int	readCharacter(scannerContext *scanner)
+{
+	if(scanner->position >= scanner->sourceSize)
+		return EOF;
 
-static int currentLine;
-static int currentColumn;
-static FILE *file;
+	return (unsigned char)scanner->source[scanner->position++];
+}
 
 
 /* Get the next character.                                                    */
 /*----------------------------------------------------------------------------*/
-/* Read the next character from inputFile and store it in currentCharacter.   */
+/* Read the next character from the source and store it in currentCharacter.  */
+/* IN scanner: State of the scanner.                                          */
 /*----------------------------------------------------------------------------*/
-void	getNextCharacter()
+static void	getNextCharacter(scannerContext *scanner)
 {
 	do
 	{
 		/* read next character */
-		previousCharacter = currentCharacter;
-		currentCharacter = fgetc(file);
+		scanner->previousCharacter = scanner->currentCharacter;
+		scanner->currentCharacter = readCharacter(scanner);
 
 		/* skip second line break character if there is one */
-		if((previousCharacter == '\r') && (currentCharacter == '\n'))
+		if((scanner->previousCharacter == '\r') &&
+					(scanner->currentCharacter == '\n'))
 		{
-			currentCharacter = fgetc(file);
+			scanner->currentCharacter = readCharacter(scanner);
 		}
 
 		/* check if a new line was found */
-		if((previousCharacter == '\r') || (previousCharacter == '\n'))
+		if((scanner->previousCharacter == '\r') ||
+					(scanner->previousCharacter == '\n'))
 		{
-			currentLine++;
-			currentColumn = 0;
+			scanner->currentLine++;
+			scanner->currentColumn = 0;
 		}
-		currentColumn++;
+		scanner->currentColumn++;
 	}
-	while(isblank(currentCharacter));
+	while(isblank(scanner->currentCharacter));
 
-	/* read the rest of the line if a comment was found */
-	if(currentCharacter == '!')
+	/* skip the rest of the line if a comment was found */
+	if(scanner->currentCharacter == '!')
 	{
-		fgets(commentBuffer, BUFSIZ, file);
-		currentCharacter = '\n';
+		while(scanner->position < scanner->sourceSize)
+		{
+			if(scanner->source[scanner->position++] == '\n')
+				break;
+		}
+		scanner->currentCharacter = '\n';
 	}
 }
 
 
+/* Start scanning the source.                                                 */
+/*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner with the source already set.              */
+/*----------------------------------------------------------------------------*/
+static void	startScanner(scannerContext *scanner)
+{
+	/* initialize line and column number */
+	scanner->position = 0;
+	scanner->currentLine = 1;
+	scanner->currentColumn = 0;
+	scanner->currentCharacter = '\0';
+	scanner->previousCharacter = '\0';
+	getNextCharacter(scanner);
+	scanNextSymbol(scanner);
+}
+
+
 /* Initialize the scanner.                                                    */
 /*----------------------------------------------------------------------------*/
-/* This function must be called once before using the scanner.                */
+/* This function must be called once before using the scanner. The whole      */
+/* file is mapped into memory if possible, otherwise it is read.              */
+/* OUT scanner: State of the scanner.                                         */
 /* IN fileName: File to be read by the scanner.                               */
 /* RETURNS: EXIT_FAILURE if a failure occurred, EXIT_SUCCESS otherwise.       */
 /*----------------------------------------------------------------------------*/
-int	initializeScanner(char *fileName)
+int	initializeScanner(scannerContext *scanner, char *fileName)
 {
+	struct stat fileStatus;
+	ssize_t readBytes;
+	size_t offset;
+	int descriptor;
+
+
+	scanner->source = NULL;
+	scanner->sourceSize = 0;
+	scanner->mapped = false;
+	scanner->ownsSource = false;
+
 	/* open the input file */
-	file = fopen(fileName, "r");
-	if(file == NULL)
+	descriptor = open(fileName, O_RDONLY);
+	if((descriptor < 0) || (fstat(descriptor, &fileStatus) != 0))
 	{
-		fprintf(stderr, "ERROR: Could not open %s for reading!\r\n", 
+		if(descriptor >= 0)
+			close(descriptor);
+		fprintf(stderr, "ERROR: Could not open %s for reading!\r\n",
 			fileName);
 		return EXIT_FAILURE;
 	}
+	scanner->sourceSize = fileStatus.st_size;
 
-	/* initialize line and column number */
-	currentLine = 1;
-	currentColumn = 0;
-	currentCharacter = '\0';
-	getNextCharacter();
-	scanNextSymbol();
+#ifdef HAVE_MMAP
+	/* empty files can't be mapped, there is nothing to read anyway */
+	if(scanner->sourceSize > 0)
+	{
+		scanner->source = mmap(NULL, scanner->sourceSize, PROT_READ,
+						MAP_PRIVATE, descriptor, 0);
+		if(scanner->source == MAP_FAILED)
+			scanner->source = NULL;
+		else
+			scanner->mapped = true;
+	}
+#endif
+
+	/* read the whole file if it can't be mapped */
+	if((scanner->source == NULL) && (scanner->sourceSize > 0))
+	{
+		scanner->source = malloc(scanner->sourceSize);
+		if(scanner->source == NULL)
+		{
+			close(descriptor);
+			fprintf(stderr, "ERROR: Could not allocate enough "
+							"memory!\r\n");
+			return EXIT_FAILURE;
+		}
+
+		for(offset=0; offset < scanner->sourceSize; offset+=readBytes)
+		{
+			readBytes = pread(descriptor, scanner->source + offset,
+					scanner->sourceSize - offset, offset);
+			if(readBytes <= 0)
+			{
+				close(descriptor);
+				free(scanner->source);
+				scanner->source = NULL;
+				fprintf(stderr, "ERROR: Could not read from "
+					"file \"%s\"!\r\n", fileName);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	close(descriptor);
+	scanner->ownsSource = true;
+
+	startScanner(scanner);
 
 	return EXIT_SUCCESS;
 }
 
 
+/* Initialize the scanner for a source in memory.                             */
+/*----------------------------------------------------------------------------*/
+/* This function can be called instead of initializeScanner. The source is    */
+/* not copied and must not be changed or released before disposeScanner has   */
+/* been called.                                                               */
+/* OUT scanner: State of the scanner.                                         */
+/* IN source: Source to be read by the scanner.                               */
+/* IN sourceSize: Length of the source in bytes.                              */
+/*----------------------------------------------------------------------------*/
+void	initializeMemoryScanner(scannerContext *scanner, char *source,
+							size_t sourceSize)
+{
+	scanner->source = source;
+	scanner->sourceSize = sourceSize;
+	scanner->mapped = false;
+	scanner->ownsSource = false;
+
+	startScanner(scanner);
+}
+
+
 /* Dispose the scanner.                                                       */
 /*----------------------------------------------------------------------------*/
 /* This function must be called once if the scanner is no longer used.        */
+/* IN scanner: State of the scanner.                                          */
 /*----------------------------------------------------------------------------*/
-void	disposeScanner()
+void	disposeScanner(scannerContext *scanner)
 {
-	/* close the input file */
-	fclose(file);
+	/* release the content of the input file */
+	if((scanner->source != NULL) && (scanner->ownsSource == true))
+	{
+#ifdef HAVE_MMAP
+		if(scanner->mapped == true)
+			munmap(scanner->source, scanner->sourceSize);
+		else
+#endif
+			free(scanner->source);
+	}
+
+	scanner->source = NULL;
+	scanner->sourceSize = 0;
+	scanner->position = 0;
 }
 
 
 /* Scan and return the next symbol.                                           */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Symbol that has been scanned.                                     */
 /*----------------------------------------------------------------------------*/
-int	scanNextSymbol()
+int	scanNextSymbol(scannerContext *scanner)
 {
 	int i;
+	int digit;
 
 
 	/* remember current position */
-	currentSymbolLine = currentLine;
-	currentSymbolColumn = currentColumn;
+	scanner->currentSymbolLine = scanner->currentLine;
+	scanner->currentSymbolColumn = scanner->currentColumn;
 
 	/* check if the character is a newline symbol */
-	if((currentCharacter == '\r') || (currentCharacter == '\n'))
+	if((scanner->currentCharacter == '\r') ||
+					(scanner->currentCharacter == '\n'))
 	{
-		getNextCharacter();
-		currentSymbol = NEWLINE_SYM;
-		return currentSymbol;
+		getNextCharacter(scanner);
+		scanner->currentSymbol = NEWLINE_SYM;
+		return scanner->currentSymbol;
 	}
 
 	/* check if the end of file is reached */
-	if(currentCharacter == EOF)
+	if(scanner->currentCharacter == EOF)
 	{
-		currentSymbol = EOF_SYM;
-		return currentSymbol;
+		scanner->currentSymbol = EOF_SYM;
+		return scanner->currentSymbol;
 	}
 
 
 	/* check if the character is a terminal symbol */
-	currentSymbol=0;
-	while((terminalSymList[currentSymbol] != currentCharacter) && 
-				(terminalSymList[currentSymbol] != '\0'))
-		currentSymbol++;
+	scanner->currentSymbol=0;
+	while((terminalSymList[scanner->currentSymbol] !=
+					scanner->currentCharacter) &&
+			(terminalSymList[scanner->currentSymbol] != '\0'))
+		scanner->currentSymbol++;
 
 	/* return the terminal symbol if one was found */
-	if(terminalSymList[currentSymbol] != '\0')
+	if(terminalSymList[scanner->currentSymbol] != '\0')
 	{
-		getNextCharacter();
-		return currentSymbol;
+		getNextCharacter(scanner);
+		return scanner->currentSymbol;
 	}
 
 	/* check if the character is a hex or dec number */
-	if(isdigit(currentCharacter))
+	if(isdigit(scanner->currentCharacter))
 	{
-		currentNumberValue = 0;
+		scanner->currentNumberValue = 0;
 
 		/* if the first digit is a 0 it might be a hex number */
-		if(currentCharacter == '0')
+		if(scanner->currentCharacter == '0')
 		{
 			/* if the next character is a 'x', */
 			/* a hex number was found */
-			getNextCharacter();
-			if(tolower(currentCharacter) == 'x')
+			getNextCharacter(scanner);
+			if(tolower(scanner->currentCharacter) == 'x')
 			{
 				/* check if the 'x' is followed by a hex digit*/
 				/* and otherwise return an unknown symbol */
-				getNextCharacter();
-				if(!isxdigit(currentCharacter))
+				getNextCharacter(scanner);
+				if(!isxdigit(scanner->currentCharacter))
 				{
-					currentSymbol = UNKNOWN_SYM;
-					return currentSymbol;
+					scanner->currentSymbol = UNKNOWN_SYM;
+					return scanner->currentSymbol;
 				}
 
-				/* put together the hexadecimal number */ 
+				/* put together the hexadecimal number */
 				/* by using the horner scheme */
-				while(isxdigit(currentCharacter))
+				while(isxdigit(scanner->currentCharacter))
 				{
-					if(isdigit(currentCharacter))
+					digit = scanner->currentCharacter;
+					if(isdigit(digit))
 					{
-						/* add one of the digits 0-9 */
-						currentNumberValue *= 16;
-						currentNumberValue += 
-							currentCharacter-'0';
+						/* one of the digits 0-9 */
+						digit -= '0';
 					}
 					else
 					{
-						/* add one of the digits A-F */
-						currentNumberValue *= 16; 
-						currentNumberValue += 
-							currentCharacter-'A'+10;
+						/* one of the digits A-F */
+						digit -= 'A'-10;
 					}
-					getNextCharacter();
+					scanner->currentNumberValue *= 16;
+					scanner->currentNumberValue += digit;
+					getNextCharacter(scanner);
 				}
 
-				currentSymbol = HEX_NUMBER_SYM;
-				return currentSymbol;
+				scanner->currentSymbol = HEX_NUMBER_SYM;
+				return scanner->currentSymbol;
 			}
 		}
 
 		/* if no hex number was found and currentCharacter is a digit,*/
 		/* a decimal number was found */
-		if(isdigit(currentCharacter))
+		if(isdigit(scanner->currentCharacter))
 		{
 			/* put together the decimal number */
 			/* by using the horner scheme */
-			while(isdigit(currentCharacter))
+			while(isdigit(scanner->currentCharacter))
 			{
-				currentNumberValue *= 10;
-				currentNumberValue += currentCharacter-'0';
-				getNextCharacter();
+				scanner->currentNumberValue *= 10;
+				scanner->currentNumberValue +=
+						scanner->currentCharacter-'0';
+				getNextCharacter(scanner);
 			}
 		}
 
-		currentSymbol = DEC_NUMBER_SYM;
-		return currentSymbol;
+		scanner->currentSymbol = DEC_NUMBER_SYM;
+		return scanner->currentSymbol;
 	}
 
 	/* check if the character is part of an ident */
-	if(isalpha(currentCharacter))
+	if(isalpha(scanner->currentCharacter))
 	{
 		i=0;
 
-		currentIdentName[i] = tolower(currentCharacter);
-		getNextCharacter();
+		scanner->currentIdentName[i] =
+					tolower(scanner->currentCharacter);
+		getNextCharacter(scanner);
 		i++;
 
 		/* put together ident */
-		while((i < MAX_IDENT_LENGTH - 1) && (isalnum(currentCharacter)))
+		while((i < MAX_IDENT_LENGTH - 1) &&
+					(isalnum(scanner->currentCharacter)))
 		{
-			currentIdentName[i] = tolower(currentCharacter);
-			getNextCharacter();
+			scanner->currentIdentName[i] =
+					tolower(scanner->currentCharacter);
+			getNextCharacter(scanner);
 			i++;
 		}
-		currentIdentName[i] = '\0';
+		scanner->currentIdentName[i] = '\0';
 
 		/* return IDENT_SYM if the maximum length hasn't been exceeded*/
-		if(!isalnum(currentCharacter))
+		if(!isalnum(scanner->currentCharacter))
 		{
-			currentSymbol = IDENT_SYM;
-			return currentSymbol;
+			scanner->currentSymbol = IDENT_SYM;
+			return scanner->currentSymbol;
 		}
 	}
 
 	/* return UNKNOWN_SYM if an unexpected character or */
 	/* a too long ident was found */
-	getNextCharacter();
-	currentSymbol = UNKNOWN_SYM;
-	return currentSymbol;
+	getNextCharacter(scanner);
+	scanner->currentSymbol = UNKNOWN_SYM;
+	return scanner->currentSymbol;
 }
 
 
 /* Scan and return the next symbol and skip newline symbols.                  */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Symbol that has been scanned.                                     */
 /*----------------------------------------------------------------------------*/
-int	scanNextSymbolSkipNewline()
+int	scanNextSymbolSkipNewline(scannerContext *scanner)
 {
 	do
 	{
-		scanNextSymbol();
+		scanNextSymbol(scanner);
 	}
-	while(currentSymbol == NEWLINE_SYM);
+	while(scanner->currentSymbol == NEWLINE_SYM);
 
-	return currentSymbol;
+	return scanner->currentSymbol;
 }
 
 
 /* Get the current symbol.                                                    */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Current symbol.                                                   */
 /*----------------------------------------------------------------------------*/
-int	getCurrentSymbol()
+int	getCurrentSymbol(scannerContext *scanner)
 {
-	return currentSymbol;
+	return scanner->currentSymbol;
 }
 
 
 /* Get the name of the current ident.                                         */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Name of the current ident.                                        */
 /* If the current symbol is not an ident, the returned string is              */
 /* unpredictable.                                                             */
 /*----------------------------------------------------------------------------*/
-char *	getCurrentIdentName()
+char *	getCurrentIdentName(scannerContext *scanner)
 {
-	return currentIdentName;
+	return scanner->currentIdentName;
 }
 
 
 /* Get the value of the current number.                                       */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Value of the current number.                                      */
 /* If the current symbol is not a number, the returned value is               */
 /* unpredictable.                                                             */
 /*----------------------------------------------------------------------------*/
-uint32_64_t	getCurrentNumberValue()
+uint32_64_t	getCurrentNumberValue(scannerContext *scanner)
 {
-	return currentNumberValue;
+	return scanner->currentNumberValue;
 }
 
 
 /* Get the number of the current line.                                        */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Number of the current line.                                       */
 /*----------------------------------------------------------------------------*/
-int	getCurrentLine()
+int	getCurrentLine(scannerContext *scanner)
 {
-	return currentSymbolLine;
+	return scanner->currentSymbolLine;
 }
 
 
 /* Get the number of the current column.                                      */
 /*----------------------------------------------------------------------------*/
+/* IN scanner: State of the scanner.                                          */
 /* RETURNS: Number of the current column.                                     */
 /*----------------------------------------------------------------------------*/
-int	getCurrentColumn()
+int	getCurrentColumn(scannerContext *scanner)
 {
-	return currentSymbolColumn;
+	return scanner->currentSymbolColumn;
 }
-
-
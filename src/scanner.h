@@ -61,6 +61,10 @@
 
 
 #include "device-description.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 
 #define	MAX_IDENT_LENGTH	255
@@ -108,15 +112,43 @@ typedef enum
 symbol;
 
 
-extern	int	initializeScanner(char *);
-extern	void	disposeScanner(void);
-extern	int	scanNextSymbol(void);
-extern	int	scanNextSymbolSkipNewline(void);
-extern	int	getCurrentSymbol(void);
-extern	char *	getCurrentIdentName(void);
-extern	uint32_64_t	getCurrentNumberValue(void);
-extern	int	getCurrentLine(void);
-extern	int	getCurrentColumn(void);
+/* state of a scanner, every scanner works on its own state so several */
+/* sources can be scanned at the same time */
+typedef struct
+{
+	/* whole source (mapped, read or given by the caller) */
+	char *source;
+	size_t sourceSize;
+	size_t position;
+	int mapped;
+	int ownsSource;
+
+	int currentCharacter;
+	int previousCharacter;
+	int currentSymbol;
+
+	char currentIdentName[MAX_IDENT_LENGTH];
+	uint32_64_t currentNumberValue;
+
+	int currentSymbolLine;
+	int currentSymbolColumn;
+
+	int currentLine;
+	int currentColumn;
+}
+scannerContext;
+
+
+extern	int	initializeScanner(scannerContext *, char *);
+extern	void	initializeMemoryScanner(scannerContext *, char *, size_t);
+extern	void	disposeScanner(scannerContext *);
+extern	int	scanNextSymbol(scannerContext *);
+extern	int	scanNextSymbolSkipNewline(scannerContext *);
+extern	int	getCurrentSymbol(scannerContext *);
+extern	char *	getCurrentIdentName(scannerContext *);
+extern	uint32_64_t	getCurrentNumberValue(scannerContext *);
+extern	int	getCurrentLine(scannerContext *);
+extern	int	getCurrentColumn(scannerContext *);
 
 #endif /* _SCANNER_H */
 
@@ -0,0 +1,112 @@
+/*
+    01ASCII
+
+    Converter for hexadecimal or binary files into textfiles containing 
+    the data in form of ASCII 0s and 1s.
+
+    Authored By Patrick Hoislbauer  <patrick.hoislbauer@gmail.com>
+
+    Copyright (C) 2015 Patrick Hoislbauer
+
+    This file is part of 01ASCII.
+
+    01ASCII is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    01ASCII is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 01ASCII.  If not, see <http://www.gnu.org/licenses/>.
+
+    Diese Datei ist Teil von 01ASCII.
+
+    01ASCII ist Freie Software: Sie können es unter den Bedingungen
+    der GNU General Public License, wie von der Free Software Foundation,
+    Version 3 der Lizenz oder (nach Ihrer Wahl) jeder späteren
+    veröffentlichten Version, weiterverbreiten und/oder modifizieren.
+
+    01ASCII wird in der Hoffnung, dass es nützlich sein wird, aber
+    OHNE JEDE GEWÄHRLEISTUNG, bereitgestellt; sogar ohne die implizite
+    Gewährleistung der MARKTFÄHIGKEIT oder EIGNUNG FÜR EINEN BESTIMMTEN ZWECK.
+    Siehe die GNU General Public License für weitere Details.
+
+    Sie sollten eine Kopie der GNU General Public License zusammen mit diesem
+    Programm erhalten haben. Wenn nicht, siehe <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "used-blocks.h"
+
+
+/* Check if memory contains only 0xFF                                         */
+/*----------------------------------------------------------------------------*/
+/* The memory is tested in pieces of BLANK_TEST_WIDTH bytes, which are        */
+/* combined with a bitwise and of 64 bit words.                               */
+/* IN data: Memory to be checked.                                             */
+/* IN length: Number of bytes to check.                                       */
+/* RETURNS: true if all bytes are 0xFF, false otherwise.                      */
+/*----------------------------------------------------------------------------*/
+int	isBlankMemory(uint8_t *data, uint32_64_t length)
+{
+	int i;
+	uint64_t word;
+	uint64_t allBits;
+	uint32_64_t byte;
+
+
+	/* test wide pieces */
+	byte = 0;
+	while(length - byte >= BLANK_TEST_WIDTH)
+	{
+		allBits = ~UINT64_C(0);
+		for(i=0; i < BLANK_TEST_WIDTH; i += sizeof(word))
+		{
+			memcpy(&word, data + byte + i, sizeof(word));
+			allBits &= word;
+		}
+
+		if(allBits != ~UINT64_C(0))
+			return false;
+
+		byte += BLANK_TEST_WIDTH;
+	}
+
+	/* test the rest byte by byte */
+	for(; byte < length; byte++)
+	{
+		if(data[byte] != 0xFF)
+			return false;
+	}
+
+	return true;
+}
+
+
+/* Release the blank blocks of a range of a memory image                      */
+/*----------------------------------------------------------------------------*/
+/* Allocated blocks containing only 0xFF are released, so only the used       */
+/* blocks stay allocated. Blocks not allocated are not checked at all.        */
+/* INOUT image: Memory image whose blocks are checked.                        */
+/* IN firstBlock: First block to be checked.                                  */
+/* IN endBlock: Block after the last block to be checked.                     */
+/*----------------------------------------------------------------------------*/
+void	releaseBlankBlocks(memoryImage *image, uint32_64_t firstBlock,
+							uint32_64_t endBlock)
+{
+	uint32_64_t block;
+
+
+	for(block=firstBlock; block < endBlock; block++)
+	{
+		if((memoryBlockIsAllocated(image, block) == true) &&
+			(isBlankMemory(getMemoryBlock(image, block), 
+					image->blockSize) == true))
+			releaseMemoryBlock(image, block);
+	}
+}
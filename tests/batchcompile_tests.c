@@ -0,0 +1,219 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/batch-compile.h"
+
+
+// remove a directory of a test with all its files
+static void	removeTestDirectory(char *directoryName)
+{
+	DIR *directory;
+	struct dirent *entry;
+	char fileName[FILENAME_MAX];
+
+
+	directory = opendir(directoryName);
+	if(directory == NULL)
+		return;
+
+	while((entry = readdir(directory)) != NULL)
+	{
+		if((strcmp(entry->d_name, ".") == 0) ||
+					(strcmp(entry->d_name, "..") == 0))
+			continue;
+
+		snprintf(fileName, sizeof(fileName), "%s/%s", directoryName, entry->d_name);
+		remove(fileName);
+	}
+
+	closedir(directory);
+	rmdir(directoryName);
+}
+
+
+// create an empty directory for a test, left over files are removed
+static void	createTestDirectory(char *directoryName)
+{
+	removeTestDirectory(directoryName);
+	ck_assert_int_eq(mkdir(directoryName, 0755), 0);
+}
+
+
+// write a device description source
+static void	writeSource(char *fileName, char *name, int memorySize)
+{
+	FILE *file;
+
+
+	file = fopen(fileName, "w");
+	ck_assert_ptr_ne(file, NULL);
+	fprintf(file, "device name = \"%s\"\nmemory size = 0x%X\n", name,
+		memorySize);
+	fprintf(file, "block size = 0x100\nword length = 8\n");
+	fprintf(file, "address length = 16\ndata = { 0-7 }\n");
+	fprintf(file, "address = { 15-0 }\n");
+	fclose(file);
+}
+
+
+// compile all sources of a directory
+START_TEST(compileDirectoryTest)
+{
+	char **sourceNames;
+	int sourceNum;
+	compileStatistics statistics;
+	deviceData device;
+	deviceFile file;
+	outputFormat layout;
+
+
+	createTestDirectory("batchdir_sources");
+	createTestDirectory("batchdir_out");
+	writeSource("batchdir_sources/second.dev", "second", 0x2000);
+	writeSource("batchdir_sources/first.dev", "first", 0x1000);
+	writeSource("batchdir_sources/ignored.txt", "ignored", 0x1000);
+
+	// only the sources are collected, sorted by name
+	ck_assert_int_eq(collectDeviceSources("batchdir_sources", &sourceNames, &sourceNum), EXIT_SUCCESS);
+	ck_assert_int_eq(sourceNum, 2);
+	ck_assert_str_eq(sourceNames[0], "batchdir_sources/first.dev");
+	ck_assert_str_eq(sourceNames[1], "batchdir_sources/second.dev");
+
+	// compile both sources
+	ck_assert_int_eq(compileDeviceSources(sourceNames, sourceNum, "batchdir_out", 2, &statistics), EXIT_SUCCESS);
+	ck_assert_int_eq(statistics.compiledNum, 2);
+	ck_assert_int_eq(statistics.skippedNum, 0);
+	ck_assert_int_eq(statistics.failedNum, 0);
+
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	ck_assert_int_eq(loadDeviceFile(&device, &file, "batchdir_out/second", &layout), EXIT_SUCCESS);
+	ck_assert_str_eq(device.name, "second");
+	ck_assert_uint_eq(device.memorySize, 0x2000);
+	disposeDeviceFile(&file);
+
+	// nothing has changed
+	ck_assert_int_eq(compileDeviceSources(sourceNames, sourceNum, "batchdir_out", 2, &statistics), EXIT_SUCCESS);
+	ck_assert_int_eq(statistics.compiledNum, 0);
+	ck_assert_int_eq(statistics.skippedNum, 2);
+	ck_assert_int_eq(statistics.failedNum, 0);
+
+	// only the changed source is compiled again
+	writeSource("batchdir_sources/first.dev", "first", 0x4000);
+	ck_assert_int_eq(compileDeviceSources(sourceNames, sourceNum, "batchdir_out", 4, &statistics), EXIT_SUCCESS);
+	ck_assert_int_eq(statistics.compiledNum, 1);
+	ck_assert_int_eq(statistics.skippedNum, 1);
+	ck_assert_int_eq(statistics.failedNum, 0);
+
+	ck_assert_int_eq(loadDeviceFile(&device, &file, "batchdir_out/first", &layout), EXIT_SUCCESS);
+	ck_assert_uint_eq(device.memorySize, 0x4000);
+	disposeDeviceFile(&file);
+
+	disposeDeviceSources(sourceNames, sourceNum);
+	removeTestDirectory("batchdir_sources");
+	removeTestDirectory("batchdir_out");
+}
+END_TEST
+
+
+// compile the sources of a list file with a failing source
+START_TEST(compileListTest)
+{
+	FILE *list;
+	char **sourceNames;
+	int sourceNum;
+	compileStatistics statistics;
+
+
+	createTestDirectory("batchlist_sources");
+	createTestDirectory("batchlist_out");
+	writeSource("batchlist_sources/third.dev", "third", 0x1000);
+	list = fopen("batchlist_sources/invalid.dev", "w");
+	ck_assert_ptr_ne(list, NULL);
+	fprintf(list, "device name = \"invalid\"\nunknown = 1\n");
+	fclose(list);
+
+	// empty lines and comments are skipped
+	list = fopen("batchlist_sources/sources.list", "w");
+	ck_assert_ptr_ne(list, NULL);
+	fprintf(list, "! sources\r\nbatchlist_sources/third.dev\r\n\r\n");
+	fprintf(list, "batchlist_sources/invalid.dev  \r\nbatchlist_sources/missing.dev\r\n");
+	fclose(list);
+
+	ck_assert_int_eq(collectDeviceSources("batchlist_sources/sources.list", &sourceNames, &sourceNum), EXIT_SUCCESS);
+	ck_assert_int_eq(sourceNum, 3);
+	ck_assert_str_eq(sourceNames[0], "batchlist_sources/third.dev");
+	ck_assert_str_eq(sourceNames[1], "batchlist_sources/invalid.dev");
+	ck_assert_str_eq(sourceNames[2], "batchlist_sources/missing.dev");
+
+	// the valid source is compiled anyway
+	ck_assert_int_eq(compileDeviceSources(sourceNames, sourceNum, "batchlist_out", 3, &statistics), EXIT_FAILURE);
+	ck_assert_int_eq(statistics.compiledNum, 1);
+	ck_assert_int_eq(statistics.skippedNum, 0);
+	ck_assert_int_eq(statistics.failedNum, 2);
+	ck_assert_int_eq(access("batchlist_out/third", F_OK), 0);
+	ck_assert_int_ne(access("batchlist_out/invalid", F_OK), 0);
+
+	disposeDeviceSources(sourceNames, sourceNum);
+
+	// a missing list
+	ck_assert_int_eq(collectDeviceSources("batchlist_sources/missing.list", &sourceNames, &sourceNum), EXIT_FAILURE);
+
+	removeTestDirectory("batchlist_sources");
+	removeTestDirectory("batchlist_out");
+}
+END_TEST
+
+
+// sources which would be compiled into the same file
+START_TEST(compileDuplicateTest)
+{
+	char *sourceNames[2] = {"batchduplicate/first.dev", "batchduplicate/first.txt"};
+	compileStatistics statistics;
+
+
+	// nothing is read or written
+	ck_assert_int_eq(compileDeviceSources(sourceNames, 2, "batchduplicate_out", 2, &statistics), EXIT_FAILURE);
+	ck_assert_int_eq(statistics.compiledNum, 0);
+	ck_assert_int_ne(access("batchduplicate_out", F_OK), 0);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("BatchCompile");
+
+
+	// test cases for compiling many sources
+	testCase = tcase_create("compileSources");
+	tcase_add_test(testCase, compileDirectoryTest);
+	tcase_add_test(testCase, compileListTest);
+	tcase_add_test(testCase, compileDuplicateTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -8,7 +8,7 @@
 START_TEST(readBinFileTest)
 {
 	int i;
-	uint8_t data[10];
+	memoryImage image;
 	deviceData device;
 
 
@@ -18,22 +18,76 @@ START_TEST(readBinFileTest)
 	// set memory size
 	device.memorySize = 10;
 
+	// initialize the memory image
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+
 	// try to load files
-	ck_assert_int_eq(readBinFile("testfiles/nonexistentfile.bin", &device, data), EXIT_FAILURE);
-	ck_assert_int_eq(readBinFile("testfiles/empty.bin", &device, data), EXIT_FAILURE);
-	ck_assert_int_eq(readBinFile("testfiles/testfile.bin", &device, data), EXIT_SUCCESS);
+	ck_assert_int_eq(readBinFile("testfiles/nonexistentfile.bin", &device, &image), EXIT_FAILURE);
+	ck_assert_int_eq(readBinFile("testfiles/empty.bin", &device, &image), EXIT_FAILURE);
+	ck_assert_int_eq(readBinFile("testfiles/testfile.bin", &device, &image), EXIT_SUCCESS);
 
 	for(i=0; i<device.memorySize; i++)
 	{
 		if(i<5)
 		{
-			ck_assert_uint_eq(data[i], i+1);
+			ck_assert_uint_eq(readMemoryByte(&image, i), i+1);
 		}
 		else
 		{
-			ck_assert_uint_eq(data[i], 0xFF);
+			ck_assert_uint_eq(readMemoryByte(&image, i), 0xFF);
 		}
 	}
+
+	disposeMemoryImage(&image);
+
+	// only the used blocks are allocated while reading
+	device.blockSize = 2;
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readBinFile("testfiles/testfile.bin", &device, &image), EXIT_SUCCESS);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 2), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 3), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 4), false);
+	ck_assert_uint_eq(readMemoryByte(&image, 5), 0xFF);
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+// map a bin file into a memory image
+START_TEST(mapBinFileTest)
+{
+	memoryImage image;
+	deviceData device;
+
+
+	initializeDeviceData(&device);
+	device.memorySize = 10;
+	device.blockSize = 2;
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+
+	// only regular files containing data can be mapped
+	ck_assert_int_eq(mapBinFile("testfiles/nonexistentfile.bin", &device, &image), EXIT_FAILURE);
+	ck_assert_int_eq(mapBinFile("testfiles/empty.bin", &device, &image), EXIT_FAILURE);
+	ck_assert_int_eq(mapBinFile("testfiles/testfile.bin", &device, &image), EXIT_SUCCESS);
+
+	// whole blocks point into the mapping, the last one is a copy
+	ck_assert_int_eq(memoryBlockIsMapped(&image, 0), true);
+	ck_assert_int_eq(memoryBlockIsMapped(&image, 1), true);
+	ck_assert_int_eq(memoryBlockIsMapped(&image, 2), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 2), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 3), false);
+	ck_assert_uint_eq(readMemoryByte(&image, 4), 5);
+	ck_assert_uint_eq(readMemoryByte(&image, 5), 0xFF);
+
+	// mapped blocks are copied before they are written
+	ck_assert_int_eq(writeMemoryByte(&image, 1, 0x55), EXIT_SUCCESS);
+	ck_assert_int_eq(memoryBlockIsMapped(&image, 0), false);
+	ck_assert_uint_eq(readMemoryByte(&image, 0), 1);
+	ck_assert_uint_eq(readMemoryByte(&image, 1), 0x55);
+
+	disposeMemoryImage(&image);
 }
 END_TEST
 
@@ -52,6 +106,10 @@ Suite	*testSuite()
 	tcase_add_test(testCase, readBinFileTest);
 	suite_add_tcase(suite, testCase);
 
+	testCase = tcase_create("mapBinFile");
+	tcase_add_test(testCase, mapBinFileTest);
+	suite_add_tcase(suite, testCase);
+
 	return suite;
 }
 
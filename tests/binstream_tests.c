@@ -0,0 +1,155 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/bin-stream.h"
+#include "test-files.h"
+
+
+// test fillStreamRing function
+START_TEST(fillStreamRingTest)
+{
+	int file;
+	uint8_t ring[64];
+	uint32_64_t readBytes;
+
+
+	// testfile.bin is shorter than the ring
+	file = open("testfiles/testfile.bin", O_RDONLY);
+	ck_assert(file >= 0);
+	ck_assert_int_eq(fillStreamRing(file, ring, 4, &readBytes), EXIT_SUCCESS);
+	ck_assert_uint_eq(readBytes, 4);
+	ck_assert_int_eq(fillStreamRing(file, ring, sizeof(ring), &readBytes), EXIT_SUCCESS);
+	ck_assert(readBytes < sizeof(ring));
+
+	// nothing is read at the end of the file
+	ck_assert_int_eq(fillStreamRing(file, ring, sizeof(ring), &readBytes), EXIT_SUCCESS);
+	ck_assert_uint_eq(readBytes, 0);
+	close(file);
+
+	// reading fails for an invalid file
+	ck_assert_int_eq(fillStreamRing(-1, ring, sizeof(ring), &readBytes), EXIT_FAILURE);
+}
+END_TEST
+
+
+// test streamBinFile function
+START_TEST(streamBinFileTest)
+{
+	int i;
+	int format;
+	int allBlocks;
+	uint8_t data[200];
+	int8_t bitOrder[3][16];
+	FILE *file;
+	memoryImage image;
+	deviceData device;
+	outputOptions options;
+
+
+	// device with 16 blocks of 8 words and different bit orders
+	initializeDeviceData(&device);
+	device.memorySize = 256;
+	device.blockSize = 16;
+	device.wordLength = 16;
+	device.addressLength = 16;
+	device.startAddress = 0x100;
+
+	for(i=0; i < 16; i++)
+	{
+		bitOrder[0][i] = 15 - i;
+		bitOrder[1][i] = i;
+	}
+	encodeBitOrderRuns(&device.wordBitOrder[PROGRAM], bitOrder[0], 16);
+	encodeBitOrderRuns(&device.wordBitOrder[VERIFY], bitOrder[1], 16);
+
+	for(i=0; i < 8; i++)
+	{
+		bitOrder[0][i] = i;
+		bitOrder[1][i] = 15 - i;
+		bitOrder[2][i] = 8 + i;
+	}
+	encodeBitOrderRuns(&device.wordAddressBitOrder[PROGRAM], bitOrder[0], 8);
+	encodeBitOrderRuns(&device.wordAddressBitOrder[VERIFY], bitOrder[0], 8);
+	encodeBitOrderRuns(&device.preDataBlockAddrBitOrder[PROGRAM], bitOrder[1], 8);
+	encodeBitOrderRuns(&device.postDataBlockAddrBitOrder[VERIFY], bitOrder[2], 8);
+
+	// a file ending within block 12, blocks 0, 5, 6 and 12 are used
+	memset(data, 0xFF, sizeof(data));
+	data[3] = 0x12;
+	data[5*16] = 0x80;
+	data[6*16 + 15] = 0;
+	data[199] = 0x7F;
+	file = fopen("binstream_input", "wb");
+	ck_assert(file != NULL);
+	ck_assert_uint_eq(fwrite(data, 1, sizeof(data), file), sizeof(data));
+	fclose(file);
+
+	// the streamed output equals the output of the memory image
+	initializeOutputOptions(&options);
+	for(format=BINARY_OUTPUT; format <= PACKED_OUTPUT; format++)
+	{
+		for(allBlocks=false; allBlocks <= true; allBlocks++)
+		{
+			initializeOutputFormat(&options.format, format);
+			options.generateAllBlocks = allBlocks;
+
+			ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+			ck_assert_int_eq(readBinFile("binstream_input", &device, &image), EXIT_SUCCESS);
+			ck_assert_int_eq(generateOutputFiles("binstream_out1", &device, &image, &options), EXIT_SUCCESS);
+			disposeMemoryImage(&image);
+
+			ck_assert_int_eq(streamBinFile("binstream_input", "binstream_out3", &device, &options), EXIT_SUCCESS);
+
+			ck_assert(filesAreEqual("binstream_out1_program_data", "binstream_out3_program_data"));
+			ck_assert(filesAreEqual("binstream_out1_verify_data", "binstream_out3_verify_data"));
+			ck_assert(filesAreEqual("binstream_out1_program_address", "binstream_out3_program_address"));
+			ck_assert(filesAreEqual("binstream_out1_verify_address", "binstream_out3_verify_address"));
+		}
+	}
+
+	// files that can't be read
+	ck_assert_int_eq(streamBinFile("testfiles/nonexistentfile.bin", "binstream_out3", &device, &options), EXIT_FAILURE);
+	ck_assert_int_eq(streamBinFile("testfiles/empty.bin", "binstream_out3", &device, &options), EXIT_FAILURE);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("Bin Stream");
+
+
+	testCase = tcase_create("fillStreamRing");
+	tcase_add_test(testCase, fillStreamRingTest);
+	suite_add_tcase(suite, testCase);
+
+	testCase = tcase_create("streamBinFile");
+	tcase_add_test(testCase, streamBinFileTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2,6 +2,7 @@
 #include <check.h>
 
 #include "../src/bit-array.h"
+#include "../src/bit-runs.h"
 
 
 #define	ARRAY_SIZE	12
@@ -11,37 +12,51 @@
 START_TEST(bitArrayTest)
 {
 	int i;
-	int8_t *array;
+	int8_t array[ARRAY_SIZE];
+	bitOrderRuns *runs;
+	bitOrderRuns head;
+	bitOrderRuns tail;
+	bitArray bits;
 
 
 	// initialize the bit array with size ARRAY_SIZE
-	ck_assert_int_eq(initializeBitArray(ARRAY_SIZE), EXIT_SUCCESS);
+	ck_assert_int_eq(initializeBitArray(&bits, ARRAY_SIZE), EXIT_SUCCESS);
 
-	// check if a valid array will be returned
-	array = NULL;
-	array = getBitArray();
-	ck_assert_int_ne(array, NULL);
+	// check if valid runs will be returned
+	runs = NULL;
+	runs = getBitArray(&bits);
+	ck_assert_int_ne(runs, NULL);
 
 	// check the current index
-	ck_assert_int_eq(bitArrayGetCurrentIndex(), 0);
+	ck_assert_int_eq(bitArrayGetCurrentIndex(&bits), 0);
 
 	// check if the array has been initialized
+	ck_assert_int_eq(runs->length, 0);
+	ck_assert_int_eq(runs->runNum, 0);
+	ck_assert_int_eq(expandBitOrderRuns(runs, array, ARRAY_SIZE), EXIT_SUCCESS);
 	for(i=0; i<ARRAY_SIZE; i++)
 		ck_assert_int_eq(array[i], UNUSED_BIT);
 
 	// add values to the bit array
-	ck_assert_int_eq(bitArrayAdd(LITERAL1_BIT, LITERAL1_BIT), EXIT_SUCCESS);
-	ck_assert_int_eq(bitArrayAdd(5, 5), EXIT_SUCCESS);
-	ck_assert_int_eq(bitArrayAdd(LITERAL0_BIT, LITERAL0_BIT), EXIT_SUCCESS);
-	ck_assert_int_eq(bitArrayAdd(6, 3), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayAdd(&bits, LITERAL1_BIT, LITERAL1_BIT), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayAdd(&bits, 5, 5), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayAdd(&bits, LITERAL0_BIT, LITERAL0_BIT), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayAdd(&bits, 6, 3), EXIT_SUCCESS);
 
 	// try to add too much values to the array
-	ck_assert_int_eq(bitArrayAdd(1, 6), EXIT_FAILURE);
+	ck_assert_int_eq(bitArrayAdd(&bits, 1, 6), EXIT_FAILURE);
 
 	// check the current index
-	ck_assert_int_eq(bitArrayGetCurrentIndex(), 7);
+	ck_assert_int_eq(bitArrayGetCurrentIndex(&bits), 7);
+
+	// the range is kept as one run
+	ck_assert_int_eq(runs->runNum, 4);
+	ck_assert_int_eq(runs->run[3].type, DESCENDING_RUN);
+	ck_assert_int_eq(runs->run[3].first, 6);
+	ck_assert_int_eq(runs->run[3].length, 4);
 
 	// check the content of the array
+	ck_assert_int_eq(expandBitOrderRuns(runs, array, ARRAY_SIZE), EXIT_SUCCESS);
 	ck_assert_int_eq(array[0], LITERAL1_BIT);
 	ck_assert_int_eq(array[1], 5);
 	ck_assert_int_eq(array[2], LITERAL0_BIT);
@@ -56,43 +71,80 @@ START_TEST(bitArrayTest)
 	ck_assert_int_eq(array[11], UNUSED_BIT);
 
 
-	// try to repeat a part of the array
-	ck_assert_int_eq(bitArrayRepeat(3, 4, 3), EXIT_FAILURE);
+	// try to repeat a part which isn't the end of the array
+	ck_assert_int_eq(bitArrayRepeat(&bits, 3, 4, 2), EXIT_FAILURE);
+
+	// try to repeat a part of the array too often
+	ck_assert_int_eq(bitArrayRepeat(&bits, 5, 6, 3), EXIT_FAILURE);
 
 	// repeat a part of the array
-	ck_assert_int_eq(bitArrayRepeat(3, 4, 2), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayRepeat(&bits, 5, 6, 2), EXIT_SUCCESS);
 
 	// try an invalid repeat
-	ck_assert_int_eq(bitArrayRepeat(5, 3, 1), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayRepeat(&bits, 5, 3, 1), EXIT_SUCCESS);
 
 	// check the current index
-	ck_assert_int_eq(bitArrayGetCurrentIndex(), 11);
+	ck_assert_int_eq(bitArrayGetCurrentIndex(&bits), 11);
+
+	// the repeat is a single run following the repeated part
+	ck_assert_int_eq(runs->runNum, 6);
+	ck_assert_int_eq(runs->run[5].type, REPEAT_RUN);
+	ck_assert_int_eq(runs->run[5].length, 2);
+	ck_assert_int_eq(runs->run[5].count, 2);
 
 	// check the content of the array
+	ck_assert_int_eq(expandBitOrderRuns(runs, array, ARRAY_SIZE), EXIT_SUCCESS);
 	ck_assert_int_eq(array[0], LITERAL1_BIT);
 	ck_assert_int_eq(array[1], 5);
 	ck_assert_int_eq(array[2], LITERAL0_BIT);
 	ck_assert_int_eq(array[3], 6);
 	ck_assert_int_eq(array[4], 5);
-	ck_assert_int_eq(array[5], 6);
-	ck_assert_int_eq(array[6], 5);
-	ck_assert_int_eq(array[7], 6);
-	ck_assert_int_eq(array[8], 5);
+	ck_assert_int_eq(array[5], 4);
+	ck_assert_int_eq(array[6], 3);
+	ck_assert_int_eq(array[7], 4);
+	ck_assert_int_eq(array[8], 3);
 	ck_assert_int_eq(array[9], 4);
 	ck_assert_int_eq(array[10], 3);
 	ck_assert_int_eq(array[11], UNUSED_BIT);
 
 	// add one more value to the array
-	ck_assert_int_eq(bitArrayAdd(9, 9), EXIT_SUCCESS);
+	ck_assert_int_eq(bitArrayAdd(&bits, 9, 9), EXIT_SUCCESS);
 
 	// check the current index
-	ck_assert_int_eq(bitArrayGetCurrentIndex(), 12);
+	ck_assert_int_eq(bitArrayGetCurrentIndex(&bits), 12);
 
 	// try to add one more value to the array
-	ck_assert_int_eq(bitArrayAdd(8, 8), EXIT_FAILURE);
+	ck_assert_int_eq(bitArrayAdd(&bits, 8, 8), EXIT_FAILURE);
+
+	// try to split the array within the repeat
+	ck_assert_int_eq(bitArraySplit(&bits, 9, &head, &tail), EXIT_FAILURE);
+
+	// split the array within a range
+	ck_assert_int_eq(bitArraySplit(&bits, 4, &head, &tail), EXIT_SUCCESS);
+	ck_assert_int_eq(head.length, 4);
+	ck_assert_int_eq(tail.length, 8);
+
+	// check the content of the parts
+	ck_assert_int_eq(expandBitOrderRuns(&head, array, ARRAY_SIZE), EXIT_SUCCESS);
+	ck_assert_int_eq(array[0], LITERAL1_BIT);
+	ck_assert_int_eq(array[1], 5);
+	ck_assert_int_eq(array[2], LITERAL0_BIT);
+	ck_assert_int_eq(array[3], 6);
+	ck_assert_int_eq(array[4], UNUSED_BIT);
+
+	ck_assert_int_eq(expandBitOrderRuns(&tail, array, ARRAY_SIZE), EXIT_SUCCESS);
+	ck_assert_int_eq(array[0], 5);
+	ck_assert_int_eq(array[1], 4);
+	ck_assert_int_eq(array[2], 3);
+	ck_assert_int_eq(array[3], 4);
+	ck_assert_int_eq(array[4], 3);
+	ck_assert_int_eq(array[5], 4);
+	ck_assert_int_eq(array[6], 3);
+	ck_assert_int_eq(array[7], 9);
+	ck_assert_int_eq(array[8], UNUSED_BIT);
 
 	// dispose the array
-	disposeBitArray();
+	disposeBitArray(&bits);
 }
 END_TEST
 
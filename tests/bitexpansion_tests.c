@@ -0,0 +1,338 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/converter.h"
+#include "../src/bit-expansion.h"
+
+
+// encode a bit order array into runs
+static bitOrderRuns	*encode(bitOrderRuns *runs, int8_t *bitOrder)
+{
+	ck_assert_int_eq(encodeBitOrderRuns(runs, bitOrder, MAX_BIT_ORDER_LENGTH), EXIT_SUCCESS);
+
+	return runs;
+}
+
+
+// compare the output of a kernel with the output of formatWordToOutputString
+static void	compareFormatKernel(bitOrderRuns *bitOrder, outputFormat *format, int kernel)
+{
+	int i;
+	int length;
+	uint32_64_t word;
+	bitExpansion expansion;
+	char outputString[MAX_OUTPUT_STRING_LENGTH];
+	char expandedString[MAX_OUTPUT_STRING_LENGTH];
+
+
+	ck_assert_int_eq(initializeBitExpansion(&expansion, bitOrder, 8*sizeof(uint32_64_t), format, kernel), EXIT_SUCCESS);
+
+	for(i=0; i < 1000; i++)
+	{
+		word = (uint32_64_t) (i * UINT64_C(0x0123456789ABCDEF));
+
+		length = formatWordToOutputString(word, bitOrder, format, outputString);
+		ck_assert_int_eq(expandWordToOutputString(&expansion, word, expandedString), length);
+		ck_assert_int_eq(memcmp(outputString, expandedString, length), 0);
+	}
+}
+
+
+// compare the output of a kernel with the output of wordToOutputString
+static void	compareKernel(int8_t *bitOrder, int format, int kernel)
+{
+	bitOrderRuns runs;
+	outputFormat defaultFormat;
+
+
+	initializeOutputFormat(&defaultFormat, format);
+	compareFormatKernel(encode(&runs, bitOrder), &defaultFormat, kernel);
+}
+
+
+// test expandWordToOutputString function
+START_TEST(expandWordToOutputStringTest)
+{
+	int i;
+	int kernel;
+	int8_t ascending[MAX_BIT_ORDER_LENGTH];
+	int8_t descending[MAX_BIT_ORDER_LENGTH];
+	int8_t mixed[MAX_BIT_ORDER_LENGTH];
+	int8_t shortOrder[MAX_BIT_ORDER_LENGTH];
+#if(USING_64BIT == 1)
+	int8_t swapped[MAX_BIT_ORDER_LENGTH];
+#endif
+	bitOrderRuns runs;
+	outputFormat dense;
+	outputFormat paired;
+
+
+	memset(ascending, UNUSED_BIT, sizeof(ascending));
+	memset(descending, UNUSED_BIT, sizeof(descending));
+	memset(mixed, UNUSED_BIT, sizeof(mixed));
+	memset(shortOrder, UNUSED_BIT, sizeof(shortOrder));
+#if(USING_64BIT == 1)
+	memset(swapped, UNUSED_BIT, sizeof(swapped));
+
+	// 63-32, 0-31
+	for(i=0; i < 32; i++)
+	{
+		swapped[i] = 63 - i;
+		swapped[32 + i] = i;
+	}
+#endif
+
+	// 0-31, 31-0, bytes 2 (descending), 0 (ascending) and 3 (descending)
+	for(i=0; i < 32; i++)
+	{
+		ascending[i] = i;
+		descending[i] = 31 - i;
+	}
+
+	for(i=0; i < 8; i++)
+	{
+		mixed[i] = 23 - i;
+		mixed[8 + i] = i;
+		mixed[16 + i] = 31 - i;
+		shortOrder[i] = 7 - i;
+	}
+
+	for(kernel=SWAR_KERNEL; kernel < BEST_KERNEL; kernel++)
+	{
+		if(kernelIsSupported(kernel) != true)
+			continue;
+
+		compareKernel(ascending, true, kernel);
+		compareKernel(descending, true, kernel);
+		compareKernel(mixed, true, kernel);
+		compareKernel(shortOrder, true, kernel);
+#if(USING_64BIT == 1)
+		compareKernel(swapped, true, kernel);
+#endif
+	}
+
+	// binary and packed output is generated by the swar kernel
+	compareKernel(ascending, false, SWAR_KERNEL);
+	compareKernel(mixed, false, SWAR_KERNEL);
+	compareKernel(descending, false, BEST_KERNEL);
+	compareKernel(ascending, PACKED_OUTPUT, SWAR_KERNEL);
+	compareKernel(mixed, PACKED_OUTPUT, SWAR_KERNEL);
+	compareKernel(descending, PACKED_OUTPUT, SWAR_KERNEL);
+
+	// other symbols, separators and terminators
+	initializeOutputFormat(&dense, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&dense, "bits=.X,separator=none,terminator=lf"), EXIT_SUCCESS);
+	initializeOutputFormat(&paired, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&paired, "bits=ab,separator=tab,terminator=none"), EXIT_SUCCESS);
+
+	compareFormatKernel(encode(&runs, mixed), &dense, SWAR_KERNEL);
+	for(kernel=SWAR_KERNEL; kernel < BEST_KERNEL; kernel++)
+	{
+		if(kernelIsSupported(kernel) != true)
+			continue;
+
+		compareFormatKernel(encode(&runs, mixed), &paired, kernel);
+		compareFormatKernel(encode(&runs, descending), &paired, kernel);
+	}
+}
+END_TEST
+
+
+// test the run kernel with bit orders which are not byte aligned
+START_TEST(expandRunsTest)
+{
+	int i;
+	bitExpansion expansion;
+	int8_t literals[MAX_BIT_ORDER_LENGTH];
+	int8_t repeated[MAX_BIT_ORDER_LENGTH];
+	int8_t singleBits[MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns runs;
+	bitOrderRuns nested;
+	outputFormat dense;
+	outputFormat paired;
+
+
+	memset(literals, UNUSED_BIT, sizeof(literals));
+	memset(repeated, UNUSED_BIT, sizeof(repeated));
+	memset(singleBits, UNUSED_BIT, sizeof(singleBits));
+
+	// two literals followed by 29-0
+	literals[0] = LITERAL0_BIT;
+	literals[1] = LITERAL1_BIT;
+	for(i=0; i < 30; i++)
+		literals[2 + i] = 29 - i;
+
+	// { 11-0, '1 } * 2
+	for(i=0; i < 26; i++)
+		repeated[i] = (i % 13 == 12) ? LITERAL1_BIT : 11 - i % 13;
+
+	// single bits out of order
+	for(i=0; i < 16; i++)
+		singleBits[i] = (5*i) % 16;
+
+	compareKernel(literals, true, RUN_KERNEL);
+	compareKernel(literals, false, RUN_KERNEL);
+	compareKernel(repeated, true, RUN_KERNEL);
+	compareKernel(repeated, false, RUN_KERNEL);
+	compareKernel(singleBits, true, RUN_KERNEL);
+	compareKernel(singleBits, false, RUN_KERNEL);
+
+	// other symbols, separators and terminators
+	initializeOutputFormat(&dense, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&dense, "bits=.X,separator=none,terminator=lf"), EXIT_SUCCESS);
+	initializeOutputFormat(&paired, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&paired, "bits=ab,separator=tab,terminator=none"), EXIT_SUCCESS);
+
+	compareFormatKernel(encode(&runs, repeated), &dense, RUN_KERNEL);
+	compareFormatKernel(encode(&runs, repeated), &paired, RUN_KERNEL);
+	compareFormatKernel(encode(&runs, literals), &paired, RUN_KERNEL);
+
+	// repeats are expanded again
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, repeated), 32, &dense, RUN_KERNEL), EXIT_SUCCESS);
+	ck_assert_int_eq(expansion.runs.runNum, 3);
+	ck_assert_int_eq(expansion.sequenceNum, 4);
+	ck_assert_int_eq(expansion.length, 27);
+
+	// { (1-0, (2)*3)*2 } has a repeat within a repeat
+	memset(&nested, 0, sizeof(nested));
+	nested.run[0].type = DESCENDING_RUN;
+	nested.run[0].first = 1;
+	nested.run[0].length = 2;
+	nested.run[1].type = ASCENDING_RUN;
+	nested.run[1].first = 2;
+	nested.run[1].length = 1;
+	nested.run[2].type = REPEAT_RUN;
+	nested.run[2].first = 1;
+	nested.run[2].length = 1;
+	nested.run[2].count = 2;
+	nested.run[3].type = REPEAT_RUN;
+	nested.run[3].first = 3;
+	nested.run[3].length = 5;
+	nested.run[3].count = 1;
+	nested.runNum = 4;
+	nested.length = 10;
+	ck_assert_int_eq(bitOrderRunsAreValid(&nested), true);
+
+	ck_assert_int_eq(initializeBitExpansion(&expansion, &nested, 32, &dense, RUN_KERNEL), EXIT_SUCCESS);
+	ck_assert_int_eq(expansion.sequenceNum, 8);
+	compareFormatKernel(&nested, &dense, RUN_KERNEL);
+	compareFormatKernel(&nested, &paired, RUN_KERNEL);
+
+	// packed output is not expanded
+	initializeOutputFormat(&dense, PACKED_OUTPUT);
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, repeated), 32, &dense, RUN_KERNEL), EXIT_FAILURE);
+
+	// bits above the word length are not expanded
+	initializeOutputFormat(&dense, BINARY_OUTPUT);
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, repeated), 8, &dense, RUN_KERNEL), EXIT_FAILURE);
+
+	// runs of the whole word
+	for(i=0; i < 8*(int)sizeof(uint32_64_t); i++)
+		singleBits[i] = 8*sizeof(uint32_64_t) - 1 - i;
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, singleBits), 8*sizeof(uint32_64_t), &dense, RUN_KERNEL), EXIT_SUCCESS);
+	compareKernel(singleBits, true, RUN_KERNEL);
+	compareKernel(singleBits, false, RUN_KERNEL);
+}
+END_TEST
+
+
+// test initializeBitExpansion function
+START_TEST(initializeBitExpansionTest)
+{
+	int i;
+	bitExpansion expansion;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns runs;
+	outputFormat ascii;
+	outputFormat binary;
+
+
+	initializeOutputFormat(&ascii, ASCII_OUTPUT);
+	initializeOutputFormat(&binary, BINARY_OUTPUT);
+
+	// the swar kernel is always supported
+	ck_assert_int_eq(kernelIsSupported(SWAR_KERNEL), true);
+
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 16; i++)
+		bitOrder[i] = i;
+
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &ascii, BEST_KERNEL), EXIT_SUCCESS);
+	ck_assert_int_eq(expansion.groupNum, 2);
+	ck_assert_int_eq(expansion.length, 34);
+
+	// bytes above the word length are not expanded
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 8, &ascii, BEST_KERNEL), EXIT_FAILURE);
+	ck_assert_int_eq(expansion.kernel, NO_KERNEL);
+
+	// simd kernels don't generate binary output
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &binary, SSE2_KERNEL), EXIT_FAILURE);
+
+	// separators longer than one character can't be expanded
+	strcpy(ascii.separator, ", ");
+	ascii.separatorLength = 2;
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &ascii, SWAR_KERNEL), EXIT_FAILURE);
+	initializeOutputFormat(&ascii, ASCII_OUTPUT);
+
+	// bit orders with partial bytes can't be expanded
+	bitOrder[15] = UNUSED_BIT;
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &ascii, BEST_KERNEL), EXIT_FAILURE);
+
+	// bit orders with literals can't be expanded
+	bitOrder[15] = LITERAL1_BIT;
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &ascii, BEST_KERNEL), EXIT_FAILURE);
+
+	// bytes must be in ascending or descending order
+	bitOrder[14] = 15;
+	bitOrder[15] = 14;
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &ascii, BEST_KERNEL), EXIT_FAILURE);
+
+	// empty bit orders can't be expanded
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	ck_assert_int_eq(initializeBitExpansion(&expansion, encode(&runs, bitOrder), 16, &ascii, BEST_KERNEL), EXIT_FAILURE);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("BitExpansion");
+
+
+	// test cases for initializing a bit expansion
+	testCase = tcase_create("initializeBitExpansion");
+	tcase_add_test(testCase, initializeBitExpansionTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for expanding a word into an output string
+	testCase = tcase_create("expandWordToOutputString");
+	tcase_add_test(testCase, expandWordToOutputStringTest);
+	tcase_add_test(testCase, expandRunsTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
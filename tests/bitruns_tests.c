@@ -0,0 +1,336 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/bit-runs.h"
+
+
+// check a run
+static void	checkRun(bitRun *run, int type, int first, int length, int count)
+{
+	ck_assert_int_eq(run->type, type);
+	ck_assert_int_eq(run->first, first);
+	ck_assert_int_eq(run->length, length);
+	ck_assert_int_eq(run->count, count);
+}
+
+
+// test encodeBitOrderRuns function
+START_TEST(encodeBitOrderRunsTest)
+{
+	int i;
+	bitOrderRuns runs;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH + 1];
+
+
+	// ascending bits, two literals and descending bits
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 12; i++)
+		bitOrder[i] = i;
+	bitOrder[12] = LITERAL1_BIT;
+	bitOrder[13] = LITERAL1_BIT;
+	bitOrder[14] = 20;
+	bitOrder[15] = 19;
+	bitOrder[16] = 18;
+
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(runs.length, 17);
+	ck_assert_int_eq(runs.runNum, 3);
+	checkRun(&runs.run[0], ASCENDING_RUN, 0, 12, 0);
+	checkRun(&runs.run[1], LITERAL_RUN, 1, 2, 0);
+	checkRun(&runs.run[2], DESCENDING_RUN, 20, 3, 0);
+
+	// single bits out of order
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	bitOrder[0] = 5;
+	bitOrder[1] = 3;
+	bitOrder[2] = LITERAL0_BIT;
+
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(runs.length, 3);
+	ck_assert_int_eq(runs.runNum, 3);
+	checkRun(&runs.run[0], ASCENDING_RUN, 5, 1, 0);
+	checkRun(&runs.run[1], ASCENDING_RUN, 3, 1, 0);
+	checkRun(&runs.run[2], LITERAL_RUN, 0, 1, 0);
+
+	// { 7-0, '1 } * 3 is a byte, a literal and a repeat of both
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 27; i++)
+		bitOrder[i] = (i % 9 == 8) ? LITERAL1_BIT : 7 - i % 9;
+
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(runs.length, 27);
+	ck_assert_int_eq(runs.runNum, 3);
+	checkRun(&runs.run[0], DESCENDING_RUN, 7, 8, 0);
+	checkRun(&runs.run[1], LITERAL_RUN, 1, 1, 0);
+	checkRun(&runs.run[2], REPEAT_RUN, 2, 9, 2);
+
+	// runs of the whole word
+	for(i=0; i < 2*MAX_WORD_LENGTH64; i++)
+		bitOrder[i] = MAX_WORD_LENGTH64 - 1 - i % MAX_WORD_LENGTH64;
+
+	encodeBitOrderRuns(&runs, bitOrder, 2*MAX_WORD_LENGTH64);
+	ck_assert_int_eq(runs.length, 2*MAX_WORD_LENGTH64);
+	ck_assert_int_eq(runs.runNum, 2);
+	checkRun(&runs.run[0], DESCENDING_RUN, MAX_WORD_LENGTH64 - 1, MAX_WORD_LENGTH64, 0);
+	checkRun(&runs.run[1], DESCENDING_RUN, MAX_WORD_LENGTH64 - 1, MAX_WORD_LENGTH64, 0);
+
+	// literal runs are split after MAX_RUN_LENGTH bits
+	memset(bitOrder, LITERAL0_BIT, sizeof(bitOrder));
+	encodeBitOrderRuns(&runs, bitOrder, MAX_RUN_LENGTH + 3);
+	ck_assert_int_eq(runs.length, MAX_RUN_LENGTH + 3);
+	ck_assert_int_eq(runs.runNum, 2);
+	checkRun(&runs.run[0], LITERAL_RUN, 0, MAX_RUN_LENGTH, 0);
+	checkRun(&runs.run[1], LITERAL_RUN, 0, 3, 0);
+
+	// bit orders of the maximum length
+	ck_assert_int_eq(encodeBitOrderRuns(&runs, bitOrder, MAX_BIT_ORDER_LENGTH), EXIT_SUCCESS);
+	ck_assert_int_eq(runs.length, MAX_BIT_ORDER_LENGTH);
+
+	// longer bit orders are not encoded
+	bitOrder[MAX_BIT_ORDER_LENGTH] = LITERAL0_BIT;
+	ck_assert_int_eq(encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder)), EXIT_FAILURE);
+
+	// empty bit orders have no runs
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(runs.length, 0);
+	ck_assert_int_eq(runs.runNum, 0);
+}
+END_TEST
+
+
+// test expandBitOrderRuns function
+START_TEST(expandBitOrderRunsTest)
+{
+	int i;
+	bitOrderRuns runs;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	int8_t expanded[MAX_BIT_ORDER_LENGTH];
+
+
+	// { (7-0, '1')*2, 0-3 } is expanded into the encoded bit order
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 18; i++)
+		bitOrder[i] = (i % 9 == 8) ? LITERAL1_BIT : 7 - i % 9;
+	for(i=0; i < 4; i++)
+		bitOrder[18 + i] = i;
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+
+	ck_assert_int_eq(expandBitOrderRuns(&runs, expanded, sizeof(expanded)), EXIT_SUCCESS);
+	ck_assert_int_eq(memcmp(expanded, bitOrder, sizeof(bitOrder)), 0);
+
+	// the array has to hold the whole bit order
+	ck_assert_int_eq(expandBitOrderRuns(&runs, expanded, 21), EXIT_FAILURE);
+}
+END_TEST
+
+
+// test bitOrderRunsAreValid function
+START_TEST(bitOrderRunsAreValidTest)
+{
+	int i;
+	bitOrderRuns runs;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+
+
+	// encoded bit orders are valid
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 27; i++)
+		bitOrder[i] = (i % 9 == 8) ? LITERAL1_BIT : 7 - i % 9;
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), true);
+
+	// the length must match the runs
+	runs.length++;
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), false);
+	runs.length--;
+
+	// a repeat must repeat as many bits as its runs have
+	runs.run[2].length = 8;
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), false);
+	runs.run[2].length = 9;
+
+	// a repeat can't repeat runs before the first one
+	runs.run[2].first = 3;
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), false);
+	runs.run[2].first = 2;
+
+	// runs must be within the word
+	runs.run[0].first = MAX_WORD_LENGTH64;
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), false);
+	runs.run[0].first = 6;
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), false);
+	runs.run[0].first = 7;
+
+	// too many bits
+	runs.run[2].count = MAX_BIT_ORDER_LENGTH;
+	ck_assert_int_eq(bitOrderRunsAreValid(&runs), false);
+}
+END_TEST
+
+
+// test takeRunBits function
+START_TEST(takeRunBitsTest)
+{
+	bitRun run;
+
+
+	// ascending runs keep the order of the word
+	run.type = ASCENDING_RUN;
+	run.first = 4;
+	run.length = 8;
+	ck_assert_uint_eq(takeRunBits(&run, 0x1234), 0x23);
+
+	// descending runs are reversed
+	run.type = DESCENDING_RUN;
+	run.first = 11;
+	run.length = 8;
+	ck_assert_uint_eq(takeRunBits(&run, 0x1234), 0xC4);
+
+	// literals are constants
+	run.type = LITERAL_RUN;
+	run.first = 1;
+	run.length = 5;
+	ck_assert_uint_eq(takeRunBits(&run, 0), 0x1F);
+	run.first = 0;
+	ck_assert_uint_eq(takeRunBits(&run, 0xFFFFFFFF), 0);
+
+#if(USING_64BIT == 1)
+	// the bits above 31 are not folded into bit 31
+	run.type = ASCENDING_RUN;
+	run.first = 28;
+	run.length = 4;
+	ck_assert_uint_eq(takeRunBits(&run, UINT64_C(1) << 40), 0);
+	ck_assert_uint_eq(takeRunBits(&run, UINT64_C(1) << 31), 0x08);
+
+	// runs crossing bit 31
+	run.first = 30;
+	ck_assert_uint_eq(takeRunBits(&run, UINT64_C(0x280000000)), 0x0A);
+
+	// the bits 32 to 63 are not aliased to the bits 0 to 31
+	run.type = DESCENDING_RUN;
+	run.first = 35;
+	run.length = 4;
+	ck_assert_uint_eq(takeRunBits(&run, 0x3), 0);
+	ck_assert_uint_eq(takeRunBits(&run, UINT64_C(0x300000000)), 0x0C);
+
+	// runs of the whole word
+	run.first = 63;
+	run.length = 64;
+	ck_assert_uint_eq(takeRunBits(&run, UINT64_C(1) << 63), 1);
+#endif
+}
+END_TEST
+
+
+// test renderBitOrderRuns function
+START_TEST(renderBitOrderRunsTest)
+{
+	int i;
+	char outputString[64];
+	bitOrderRuns runs;
+	outputFormat format;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+
+
+	// { 3-0, '1 }
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 4; i++)
+		bitOrder[i] = 3 - i;
+	bitOrder[4] = LITERAL1_BIT;
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+
+	initializeOutputFormat(&format, ASCII_OUTPUT);
+	ck_assert_int_eq(renderBitOrderRuns(&runs, 0x5, &format, outputString), 12);
+	ck_assert_str_eq(outputString, "0 1 0 1 1 \r\n");
+
+	initializeOutputFormat(&format, BINARY_OUTPUT);
+	ck_assert_int_eq(renderBitOrderRuns(&runs, 0x5, &format, outputString), 5);
+	ck_assert_int_eq(memcmp(outputString, "\0\1\0\1\1", 5), 0);
+
+	initializeOutputFormat(&format, PACKED_OUTPUT);
+	ck_assert_int_eq(renderBitOrderRuns(&runs, 0x5, &format, outputString), 1);
+	ck_assert_uint_eq((uint8_t) outputString[0], 0x58);
+
+	// { 1-0 } * 5 copies the output of the first two bits
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 10; i++)
+		bitOrder[i] = 1 - i % 2;
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(runs.runNum, 2);
+
+	initializeOutputFormat(&format, ASCII_OUTPUT);
+	ck_assert_int_eq(renderBitOrderRuns(&runs, 0x2, &format, outputString), 22);
+	ck_assert_str_eq(outputString, "1 0 1 0 1 0 1 0 1 0 \r\n");
+
+	initializeOutputFormat(&format, PACKED_OUTPUT);
+	ck_assert_int_eq(renderBitOrderRuns(&runs, 0x2, &format, outputString), 2);
+	ck_assert_uint_eq((uint8_t) outputString[0], 0xAA);
+	ck_assert_uint_eq((uint8_t) outputString[1], 0x80);
+
+	// empty bit orders have no terminator
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+	initializeOutputFormat(&format, ASCII_OUTPUT);
+	ck_assert_int_eq(renderBitOrderRuns(&runs, 0x2, &format, outputString), 0);
+	ck_assert_str_eq(outputString, "");
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("BitRuns");
+
+
+	// test cases for encoding bit orders into runs
+	testCase = tcase_create("encodeBitOrderRuns");
+	tcase_add_test(testCase, encodeBitOrderRunsTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for expanding runs into a bit order array
+	testCase = tcase_create("expandBitOrderRuns");
+	tcase_add_test(testCase, expandBitOrderRunsTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for checking runs read from a file
+	testCase = tcase_create("bitOrderRunsAreValid");
+	tcase_add_test(testCase, bitOrderRunsAreValidTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for taking the bits of a run from a word
+	testCase = tcase_create("takeRunBits");
+	tcase_add_test(testCase, takeRunBitsTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for rendering runs into an output string
+	testCase = tcase_create("renderBitOrderRuns");
+	tcase_add_test(testCase, renderBitOrderRunsTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
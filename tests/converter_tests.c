@@ -1,42 +1,57 @@
 #include <config.h>
 #include <check.h>
+#include <stddef.h>
 
 #include "../src/converter.h"
+#include "../src/address-cache.h"
+#include "test-files.h"
+
+
+// encode a bit order array into runs
+static bitOrderRuns	*encode(bitOrderRuns *runs, int8_t *bitOrder)
+{
+	ck_assert_int_eq(encodeBitOrderRuns(runs, bitOrder, MAX_BIT_ORDER_LENGTH), EXIT_SUCCESS);
+
+	return runs;
+}
 
 
 // test findUsedBlocks function
 START_TEST(findUsedBlocksTest)
 {
 	int i;
-	uint8_t programData[10];
-	int usedBlocks[5];
+	memoryImage image;
 	deviceData device;
 
 
 	// initialize the device data structure
 	initializeDeviceData(&device);
 
-	// initialize the programData
-	memset(programData, 0xFF, 10);
-
 	// set memory and block size
 	device.memorySize = 10;
 	device.blockSize = 2;
 
-	// write some data
-	programData[3] = 0xFE;
-	programData[6] = 1;
-	programData[9] = 0;
+	// initialize the memory image
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+
+	// write some data (block 0 is written with 0xFF only)
+	writeMemoryByte(&image, 0, 0xFF);
+	writeMemoryByte(&image, 3, 0xFE);
+	writeMemoryByte(&image, 6, 1);
+	writeMemoryByte(&image, 9, 0);
 
 
 	// find used blocks
-	findUsedBlocks(&device, programData, usedBlocks);
+	findUsedBlocks(&image);
+
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 2), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 3), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 4), true);
+	ck_assert_uint_eq(readMemoryByte(&image, 3), 0xFE);
 
-	ck_assert_int_eq(usedBlocks[0], false);
-	ck_assert_int_eq(usedBlocks[1], true);
-	ck_assert_int_eq(usedBlocks[2], false);
-	ck_assert_int_eq(usedBlocks[3], true);
-	ck_assert_int_eq(usedBlocks[4], true);
+	disposeMemoryImage(&image);
 }
 END_TEST
 
@@ -46,9 +61,10 @@ START_TEST(wordToOutputStringTest)
 {
 	char outputString[MAX_BIT_ORDER_LENGTH*2 + 3];
 	uint32_64_t word;
+	bitOrderRuns runs;
 	int8_t bitOrder[] = {
 				0x0F, 0x0E, 0x0D, 0x0C, 0x08, 0x09, 0x0A, 0x0B, 
-				0x04, 0x05, 0x06, 0x07, 0x03, 0x02, 0x01, 0xA0, 
+				0x04, 0x05, 0x06, 0x07, 0x03, 0x02, 0x01, 0x00, 
 				0x1F, 0x1E, 0x1D, 0x1C, 0x18, 0x19, 0x1A, 0x1B, 
 				0x14, 0x15, 0x16, 0x17, 0x13, 0x12, 0x11,   -1,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
@@ -59,11 +75,11 @@ START_TEST(wordToOutputStringTest)
 	word = 0xFF55AA11;
 
 	// generate ascii string
-	ck_assert_int_eq(wordToOutputString(word, bitOrder, true, outputString), 64);
+	ck_assert_int_eq(wordToOutputString(word, encode(&runs, bitOrder), true, outputString), 64);
 	ck_assert_str_eq(outputString, "1 0 1 0 0 1 0 1 1 0 0 0 0 0 0 1 1 1 1 1 1 1 1 1 1 0 1 0 0 1 0 \r\n");
 
 	// generate binary string
-	ck_assert_int_eq(wordToOutputString(word, bitOrder, false, outputString), 31);
+	ck_assert_int_eq(wordToOutputString(word, encode(&runs, bitOrder), false, outputString), 31);
 	ck_assert_uint_eq(outputString[0], 1);
 	ck_assert_uint_eq(outputString[1], 0);
 	ck_assert_uint_eq(outputString[2], 1);
@@ -95,10 +111,674 @@ START_TEST(wordToOutputStringTest)
 	ck_assert_uint_eq(outputString[28], 0);
 	ck_assert_uint_eq(outputString[29], 1);
 	ck_assert_uint_eq(outputString[30], 0);
+
+	// generate packed string
+	ck_assert_int_eq(wordToOutputString(word, encode(&runs, bitOrder), PACKED_OUTPUT, outputString), 4);
+	ck_assert_uint_eq((uint8_t) outputString[0], 0xA5);
+	ck_assert_uint_eq((uint8_t) outputString[1], 0x81);
+	ck_assert_uint_eq((uint8_t) outputString[2], 0xFF);
+	ck_assert_uint_eq((uint8_t) outputString[3], 0xA4);
+}
+END_TEST
+
+
+// test compiled bit orders against wordToOutputString
+START_TEST(compiledWordToOutputStringTest)
+{
+	int i;
+	int format;
+	int length;
+	char outputString[MAX_OUTPUT_STRING_LENGTH];
+	char compiledString[MAX_OUTPUT_STRING_LENGTH];
+	uint32_64_t word;
+	compiledBitOrder compiled;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	int8_t literalBitOrder[MAX_BIT_ORDER_LENGTH];
+	int8_t emptyBitOrder[MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns runs;
+	outputFormat layout;
+
+
+	// bit order with literals and bits of all four bytes of the word
+	memset(bitOrder, UNUSED_BIT, MAX_BIT_ORDER_LENGTH);
+	for(i=0; i<16; i++)
+		bitOrder[i] = 31-2*i;
+	bitOrder[16] = LITERAL1_BIT;
+	bitOrder[17] = 0;
+	bitOrder[18] = LITERAL0_BIT;
+	bitOrder[19] = 8;
+
+	// bit order consisting of literals only
+	memset(literalBitOrder, UNUSED_BIT, MAX_BIT_ORDER_LENGTH);
+	literalBitOrder[0] = LITERAL1_BIT;
+	literalBitOrder[1] = LITERAL0_BIT;
+
+	memset(emptyBitOrder, UNUSED_BIT, MAX_BIT_ORDER_LENGTH);
+
+	for(format=BINARY_OUTPUT; format<=PACKED_OUTPUT; format++)
+	{
+		initializeOutputFormat(&layout, format);
+		ck_assert_int_eq(compileBitOrder(&compiled, encode(&runs, bitOrder), 32, &layout), EXIT_SUCCESS);
+		ck_assert_int_eq(compiled.byteNum, 4);
+
+		for(i=0; i<1000; i++)
+		{
+			word = (uint32_t) (i * 0x01234567UL);
+			length = wordToOutputString(word, encode(&runs, bitOrder), format, outputString);
+			ck_assert_int_eq(compiledWordToOutputString(&compiled, word, compiledString), length);
+			ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+		}
+		disposeCompiledBitOrder(&compiled);
+
+		// literals are rendered as constants
+		ck_assert_int_eq(compileBitOrder(&compiled, encode(&runs, literalBitOrder), 32, &layout), EXIT_SUCCESS);
+		length = wordToOutputString(0xFFFFFFFF, encode(&runs, literalBitOrder), format, outputString);
+		ck_assert_int_eq(compiledWordToOutputString(&compiled, 0x12345678, compiledString), length);
+		ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+		if(format == ASCII_OUTPUT)
+		{
+			ck_assert_int_eq(compiledString[0], '1');
+			ck_assert_int_eq(compiledString[2], '0');
+		}
+		else if(format == PACKED_OUTPUT)
+			ck_assert_uint_eq((uint8_t) compiledString[0], 0x80);
+		else
+		{
+			ck_assert_int_eq(compiledString[0], 1);
+			ck_assert_int_eq(compiledString[1], 0);
+		}
+		disposeCompiledBitOrder(&compiled);
+
+		// empty bit orders are rendered as empty strings
+		ck_assert_int_eq(compileBitOrder(&compiled, encode(&runs, emptyBitOrder), 32, &layout), EXIT_SUCCESS);
+		ck_assert_int_eq(compiledWordToOutputString(&compiled, 0x12345678, compiledString), 0);
+		disposeCompiledBitOrder(&compiled);
+	}
+
+	// symbols without common bits and a long separator
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	layout.symbol[0] = '.';
+	layout.symbol[1] = 'X';
+	strcpy(layout.separator, ", ");
+	layout.separatorLength = 2;
+	ck_assert_int_eq(compileBitOrder(&compiled, encode(&runs, bitOrder), 32, &layout), EXIT_SUCCESS);
+	for(i=0; i<1000; i++)
+	{
+		word = (uint32_t) (i * 0x01234567UL);
+		length = formatWordToOutputString(word, encode(&runs, bitOrder), &layout, outputString);
+		ck_assert_int_eq(compiledWordToOutputString(&compiled, word, compiledString), length);
+		ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+	}
+	disposeCompiledBitOrder(&compiled);
+}
+END_TEST
+
+
+#if(USING_64BIT == 1)
+// test the bits 32 to 63 of 64 bit words
+START_TEST(wideWordToOutputStringTest)
+{
+	int i;
+	int bit;
+	int format;
+	int length;
+	char outputString[MAX_OUTPUT_STRING_LENGTH];
+	char compiledString[MAX_OUTPUT_STRING_LENGTH];
+	uint32_64_t word;
+	compiledBitOrder compiled;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns runs;
+	outputFormat layout;
+
+
+	// bits 63 to 0
+	memset(bitOrder, UNUSED_BIT, MAX_BIT_ORDER_LENGTH);
+	for(i=0; i<64; i++)
+		bitOrder[i] = 63-i;
+	encode(&runs, bitOrder);
+
+	for(format=BINARY_OUTPUT; format<=ASCII_OUTPUT; format++)
+	{
+		initializeOutputFormat(&layout, format);
+		ck_assert_int_eq(compileBitOrder(&compiled, &runs, 64, &layout), EXIT_SUCCESS);
+
+		// set each of the upper bits separately
+		for(bit=32; bit<64; bit++)
+		{
+			word = UINT64_C(1) << bit;
+			length = wordToOutputString(word, &runs, format, outputString);
+			ck_assert_int_eq(length, (format == ASCII_OUTPUT) ? 130 : 64);
+
+			// only the output symbol of the bit is set
+			for(i=0; i<64; i++)
+			{
+				if(format == ASCII_OUTPUT)
+					ck_assert_int_eq(outputString[2*i], (63-i == bit) ? '1' : '0');
+				else
+					ck_assert_int_eq(outputString[i], (63-i == bit) ? 1 : 0);
+			}
+
+			ck_assert_int_eq(compiledWordToOutputString(&compiled, word, compiledString), length);
+			ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+		}
+		disposeCompiledBitOrder(&compiled);
+	}
+
+	// long separators are rendered with the tables
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	layout.symbol[0] = '.';
+	layout.symbol[1] = 'X';
+	strcpy(layout.separator, ", ");
+	layout.separatorLength = 2;
+	ck_assert_int_eq(compileBitOrder(&compiled, &runs, 64, &layout), EXIT_SUCCESS);
+	ck_assert_int_eq(compiled.byteNum, 8);
+	for(bit=32; bit<64; bit++)
+	{
+		word = UINT64_C(1) << bit;
+		length = formatWordToOutputString(word, &runs, &layout, outputString);
+		ck_assert_int_eq(outputString[3*(63-bit)], 'X');
+		ck_assert_int_eq(outputString[3*(63-(bit-32))], '.');
+
+		ck_assert_int_eq(compiledWordToOutputString(&compiled, word, compiledString), length);
+		ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+	}
+	disposeCompiledBitOrder(&compiled);
+}
+END_TEST
+#endif
+
+
+#if(USING_64BIT == 1)
+// test compiled bit orders of 64 bit words expanded from their runs
+START_TEST(compiledRunsTest)
+{
+	int i;
+	int format;
+	int length;
+	char outputString[MAX_OUTPUT_STRING_LENGTH];
+	char compiledString[MAX_OUTPUT_STRING_LENGTH];
+	uint32_64_t word;
+	compiledBitOrder compiled;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns runs;
+	outputFormat layout;
+
+
+	// the two halves of the word without bit 63
+	memset(bitOrder, UNUSED_BIT, MAX_BIT_ORDER_LENGTH);
+	for(i=0; i<31; i++)
+		bitOrder[i] = 62-i;
+	for(i=0; i<32; i++)
+		bitOrder[31+i] = i;
+
+	for(format=BINARY_OUTPUT; format<=PACKED_OUTPUT; format++)
+	{
+		initializeOutputFormat(&layout, format);
+		ck_assert_int_eq(compileBitOrder(&compiled, encode(&runs, bitOrder), 64, &layout), EXIT_SUCCESS);
+
+		// packed output is put together from the tables
+		if(format == PACKED_OUTPUT)
+			ck_assert_int_eq(compiled.expansion.kernel, NO_KERNEL);
+		else
+		{
+			ck_assert_int_eq(compiled.expansion.kernel, RUN_KERNEL);
+			ck_assert_ptr_eq(compiled.fragments, NULL);
+		}
+
+		for(i=0; i<1000; i++)
+		{
+			word = (uint64_t) i * UINT64_C(0x0123456789ABCDEF);
+			length = wordToOutputString(word, encode(&runs, bitOrder), format, outputString);
+			ck_assert_int_eq(compiledWordToOutputString(&compiled, word, compiledString), length);
+			ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+		}
+		disposeCompiledBitOrder(&compiled);
+	}
+
+	// bit orders of many runs keep their tables
+	memset(bitOrder, UNUSED_BIT, MAX_BIT_ORDER_LENGTH);
+	for(i=0; i<16; i++)
+		bitOrder[i] = (5*i) % 16;
+
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	ck_assert_int_eq(compileBitOrder(&compiled, encode(&runs, bitOrder), 64, &layout), EXIT_SUCCESS);
+	ck_assert_int_eq(compiled.expansion.kernel, NO_KERNEL);
+	ck_assert_ptr_ne(compiled.fragments, NULL);
+	disposeCompiledBitOrder(&compiled);
+}
+END_TEST
+#endif
+
+
+// test updateOutputString function
+START_TEST(updateOutputStringTest)
+{
+	int i;
+	int ascii;
+	int length;
+	uint32_64_t word;
+	uint32_64_t previousWord;
+	char outputString[MAX_OUTPUT_STRING_LENGTH];
+	char updatedString[MAX_OUTPUT_STRING_LENGTH];
+	incrementalBitOrder incremental;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+	int8_t wideBitOrder[MAX_BIT_ORDER_LENGTH];
+	bitOrderRuns runs;
+	outputFormat layout;
+
+
+	// bits 31 to 0, literals and bit 3 twice
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	memset(wideBitOrder, UNUSED_BIT, sizeof(wideBitOrder));
+	for(i=0; i < 28; i++)
+		bitOrder[i] = 31 - i;
+	bitOrder[28] = LITERAL1_BIT;
+	bitOrder[29] = 3;
+	bitOrder[30] = LITERAL0_BIT;
+	bitOrder[31] = 0;
+
+	for(ascii=false; ascii <= true; ascii++)
+	{
+		initializeOutputFormat(&layout, ascii);
+		ck_assert_int_eq(compileIncrementalBitOrder(&incremental, encode(&runs, bitOrder), &layout), EXIT_SUCCESS);
+
+		// count up with different steps and jumps
+		previousWord = 0x7FFFFFF0;
+		length = wordToOutputString(previousWord, encode(&runs, bitOrder), ascii, updatedString);
+		for(i=0; i < 1000; i++)
+		{
+			word = previousWord + (i % 7) + ((i % 100 == 0) ? 0x01234567 : 0);
+
+			wordToOutputString(word, encode(&runs, bitOrder), ascii, outputString);
+			updateOutputString(&incremental, previousWord, word, updatedString);
+			ck_assert_int_eq(memcmp(outputString, updatedString, length), 0);
+
+			previousWord = word;
+		}
+	}
+
+	// other symbols and separators
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	layout.symbol[0] = '-';
+	layout.symbol[1] = '+';
+	strcpy(layout.separator, "; ");
+	layout.separatorLength = 2;
+	ck_assert_int_eq(compileIncrementalBitOrder(&incremental, encode(&runs, bitOrder), &layout), EXIT_SUCCESS);
+	previousWord = 0;
+	length = formatWordToOutputString(previousWord, encode(&runs, bitOrder), &layout, updatedString);
+	for(word=1; word < 1000; word += 3)
+	{
+		formatWordToOutputString(word, encode(&runs, bitOrder), &layout, outputString);
+		updateOutputString(&incremental, previousWord, word, updatedString);
+		ck_assert_int_eq(memcmp(outputString, updatedString, length), 0);
+		previousWord = word;
+	}
+
+#if(USING_64BIT == 1)
+	// bits 63 to 0, counting across bit 31 and addresses above 2^32
+	for(i=0; i < 64; i++)
+		wideBitOrder[i] = 63 - i;
+
+	for(ascii=false; ascii <= true; ascii++)
+	{
+		initializeOutputFormat(&layout, ascii);
+		ck_assert_int_eq(compileIncrementalBitOrder(&incremental, encode(&runs, wideBitOrder), &layout), EXIT_SUCCESS);
+
+		previousWord = UINT64_C(0xFFFFFFF0);
+		length = wordToOutputString(previousWord, encode(&runs, wideBitOrder), ascii, updatedString);
+		for(i=0; i < 1000; i++)
+		{
+			word = previousWord + (i % 7) + ((i % 100 == 0) ? UINT64_C(0x1234567800000000) : 0);
+
+			wordToOutputString(word, encode(&runs, wideBitOrder), ascii, outputString);
+			updateOutputString(&incremental, previousWord, word, updatedString);
+			ck_assert_int_eq(memcmp(outputString, updatedString, length), 0);
+
+			previousWord = word;
+		}
+	}
+
+	// bit 40 isn't rendered like bit 8
+	wordToOutputString(UINT64_C(1) << 40, encode(&runs, wideBitOrder), true, outputString);
+	ck_assert_int_eq(outputString[2*(63 - 40)], '1');
+	ck_assert_int_eq(outputString[2*(63 - 8)], '0');
+#endif
+
+	// bits above 63 are not supported
+	memset(wideBitOrder, UNUSED_BIT, sizeof(wideBitOrder));
+	wideBitOrder[0] = 64;
+	ck_assert_int_eq(compileIncrementalBitOrder(&incremental, encode(&runs, wideBitOrder), &layout), EXIT_FAILURE);
 }
 END_TEST
 
 
+// test generateOutputFiles function with several threads
+START_TEST(generateOutputFilesTest)
+{
+	int i;
+	int format;
+	char line[50];
+	FILE *file;
+	memoryImage image;
+	deviceData device;
+	outputOptions options;
+	int8_t wordBitOrder[2][MAX_BIT_ORDER_LENGTH];
+	int8_t addressBitOrder[3][MAX_BIT_ORDER_LENGTH];
+
+
+	// device with 16 blocks of 8 words and different bit orders
+	initializeDeviceData(&device);
+	device.memorySize = 256;
+	device.blockSize = 16;
+	device.wordLength = 16;
+	device.addressLength = 16;
+	device.startAddress = 0x100;
+
+	memset(wordBitOrder, UNUSED_BIT, sizeof(wordBitOrder));
+	memset(addressBitOrder, UNUSED_BIT, sizeof(addressBitOrder));
+	for(i=0; i < 16; i++)
+	{
+		wordBitOrder[PROGRAM][i] = 15 - i;
+		wordBitOrder[VERIFY][i] = i;
+	}
+	wordBitOrder[VERIFY][16] = LITERAL1_BIT;
+
+	for(i=0; i < 8; i++)
+	{
+		addressBitOrder[0][i] = i;
+		addressBitOrder[1][i] = 15 - i;
+		addressBitOrder[2][i] = 8 + i;
+	}
+
+	encode(&device.wordBitOrder[PROGRAM], wordBitOrder[PROGRAM]);
+	encode(&device.wordBitOrder[VERIFY], wordBitOrder[VERIFY]);
+	encode(&device.wordAddressBitOrder[PROGRAM], addressBitOrder[0]);
+	encode(&device.wordAddressBitOrder[VERIFY], addressBitOrder[0]);
+	encode(&device.preDataBlockAddrBitOrder[PROGRAM], addressBitOrder[1]);
+	encode(&device.postDataBlockAddrBitOrder[VERIFY], addressBitOrder[2]);
+
+	// blocks 0, 5, 6 and 15 are used
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	writeMemoryByte(&image, 3, 0x12);
+	writeMemoryByte(&image, 5*16, 0x80);
+	writeMemoryByte(&image, 6*16 + 15, 0);
+	writeMemoryByte(&image, 255, 0x7F);
+
+	initializeOutputOptions(&options);
+	for(format=BINARY_OUTPUT; format <= PACKED_OUTPUT; format++)
+	{
+		initializeOutputFormat(&options.format, format);
+		options.generateAllBlocks = false;
+		options.threadNum = 1;
+		ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+		options.threadNum = 3;
+		ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+
+		ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+		ck_assert(filesAreEqual("converter_out1_verify_data", "converter_out3_verify_data"));
+		ck_assert(filesAreEqual("converter_out1_program_address", "converter_out3_program_address"));
+		ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+
+		// more threads than blocks
+		options.generateAllBlocks = true;
+		options.threadNum = 100;
+		ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+		options.threadNum = 1;
+		ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+
+		ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+		ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+	}
+
+	// three words per line, the last line of a block is shorter
+	initializeOutputFormat(&options.format, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&options.format, "separator=none,terminator=lf,words=3"), EXIT_SUCCESS);
+	ck_assert_int_eq(calculateBlockLength(&device, DATA_STREAM, PROGRAM, &options.format), 8*16 + 3);
+	options.generateAllBlocks = false;
+	options.threadNum = 1;
+	ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+	options.threadNum = 3;
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+
+	ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+	ck_assert(filesAreEqual("converter_out1_verify_data", "converter_out3_verify_data"));
+	ck_assert(filesAreEqual("converter_out1_program_address", "converter_out3_program_address"));
+	ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+
+	file = fopen("converter_out1_program_data", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	ck_assert_int_eq(fread(line, 1, 49, file), 49);
+	line[49] = '\0';
+	ck_assert_str_eq(line, "111111111111111100010010111111111111111111111111\n");
+	fseek(file, 0, SEEK_END);
+	ck_assert_int_eq(ftell(file), 4 * (8*16 + 3));
+	fclose(file);
+
+	// the threads render into disjoint parts of the mapped files
+	ck_assert_int_eq(countOutputBlocks(&device, &image, false), 4);
+	ck_assert_int_eq(countOutputBlocks(&device, &image, true), 16);
+	options.mapOutput = true;
+	options.threadNum = 3;
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+
+	ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+	ck_assert(filesAreEqual("converter_out1_verify_data", "converter_out3_verify_data"));
+	ck_assert(filesAreEqual("converter_out1_program_address", "converter_out3_program_address"));
+	ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+
+	options.mapOutput = false;
+	options.generateAllBlocks = true;
+	ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+	options.mapOutput = true;
+	options.threadNum = 1;
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+
+	ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+	ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+
+	// queued writes (or pwrite if io_uring isn't supported)
+	options.mapOutput = false;
+	options.queueOutput = true;
+	options.threadNum = 3;
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+
+	ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+	ck_assert(filesAreEqual("converter_out1_verify_data", "converter_out3_verify_data"));
+	ck_assert(filesAreEqual("converter_out1_program_address", "converter_out3_program_address"));
+	ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+
+	// output kept out of the page cache, with and without threads
+	options.uncacheOutput = true;
+	for(i=1; i <= 3; i += 2)
+	{
+		options.threadNum = i;
+		ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+
+		ck_assert(filesAreEqual("converter_out1_program_data", "converter_out3_program_data"));
+		ck_assert(filesAreEqual("converter_out1_verify_data", "converter_out3_verify_data"));
+		ck_assert(filesAreEqual("converter_out1_program_address", "converter_out3_program_address"));
+		ck_assert(filesAreEqual("converter_out1_verify_address", "converter_out3_verify_address"));
+	}
+
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+// test generateOutputFiles function with an address cache
+START_TEST(addressCacheTest)
+{
+	int i;
+	int run;
+	char cacheFileName[FILENAME_MAX];
+	FILE *file;
+	struct stat cacheStatus;
+	addressCacheHeader header;
+	addressCacheHeader fileHeader;
+	memoryImage image;
+	deviceData device;
+	outputOptions options;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+
+
+	// device with 8 blocks of 4 words
+	initializeDeviceData(&device);
+	device.memorySize = 64;
+	device.blockSize = 8;
+	device.wordLength = 16;
+	device.addressLength = 16;
+	device.startAddress = 0x40;
+
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 16; i++)
+		bitOrder[i] = i;
+	encode(&device.wordBitOrder[PROGRAM], bitOrder);
+
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 12; i++)
+		bitOrder[i] = 11 - i;
+	encode(&device.wordAddressBitOrder[PROGRAM], bitOrder);
+
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 4; i++)
+		bitOrder[i] = i;
+	encode(&device.postDataBlockAddrBitOrder[PROGRAM], bitOrder);
+
+	device.wordBitOrder[VERIFY] = device.wordBitOrder[PROGRAM];
+	device.wordAddressBitOrder[VERIFY] = device.wordAddressBitOrder[PROGRAM];
+	device.postDataBlockAddrBitOrder[VERIFY] = device.postDataBlockAddrBitOrder[PROGRAM];
+
+	// blocks 1, 2 and 7 are used
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	writeMemoryByte(&image, 8, 0);
+	writeMemoryByte(&image, 23, 0);
+	writeMemoryByte(&image, 63, 0);
+
+	initializeOutputOptions(&options);
+	ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+
+	// the first run builds the cache, the second one uses it
+	strcpy(options.cacheDirectory, ".");
+	for(run=0; run < 2; run++)
+	{
+		ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+		ck_assert(filesAreEqual("converter_out1_address", "converter_out3_address"));
+		ck_assert(filesAreEqual("converter_out1_data", "converter_out3_data"));
+	}
+
+	// cache files of another device with the same size are rebuilt
+	setAddressCacheFileName(cacheFileName, ".", &device, PROGRAM, &options.format);
+	file = fopen(cacheFileName, "r+b");
+	ck_assert_ptr_ne(file, NULL);
+	fseek(file, offsetof(addressCacheHeader, startAddress), SEEK_SET);
+	fputc(0x80, file);
+	fseek(file, sizeof(addressCacheHeader), SEEK_SET);
+	fputc('x', file);
+	fclose(file);
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+	ck_assert(filesAreEqual("converter_out1_address", "converter_out3_address"));
+
+	initializeAddressCacheHeader(&header, &device, PROGRAM, &options.format);
+	file = fopen(cacheFileName, "rb");
+	ck_assert_ptr_ne(file, NULL);
+	ck_assert_int_eq(fread(&fileHeader, sizeof(fileHeader), 1, file), 1);
+	fclose(file);
+	ck_assert_int_eq(memcmp(&fileHeader, &header, sizeof(header)), 0);
+
+	// mapped, queued and uncached address files from the cache
+	for(run=0; run < 3; run++)
+	{
+		options.mapOutput = (run == 0);
+		options.queueOutput = (run == 1);
+		options.uncacheOutput = (run == 2);
+		ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+		ck_assert(filesAreEqual("converter_out1_address", "converter_out3_address"));
+	}
+	options.mapOutput = false;
+	options.queueOutput = false;
+	options.uncacheOutput = false;
+
+	// all blocks from the same cache
+	options.generateAllBlocks = true;
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+	strcpy(options.cacheDirectory, "");
+	ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+	ck_assert(filesAreEqual("converter_out1_address", "converter_out3_address"));
+
+	// generation without cache if the cache directory is missing
+	strcpy(options.cacheDirectory, "missing");
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+	ck_assert(filesAreEqual("converter_out1_address", "converter_out3_address"));
+
+	// the cache depends on the output format
+	ck_assert_int_eq(parseOutputFormat(&options.format, "bits=ab,words=3"), EXIT_SUCCESS);
+	options.generateAllBlocks = false;
+	ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+	strcpy(options.cacheDirectory, ".");
+	ck_assert_int_eq(generateOutputFiles("converter_out3", &device, &image, &options), EXIT_SUCCESS);
+	ck_assert(filesAreEqual("converter_out1_address", "converter_out3_address"));
+
+	// large devices are not cached
+	device.memorySize = UINT32_C(0x40000000);
+	device.blockSize = UINT32_C(0x100000);
+	setAddressCacheFileName(cacheFileName, ".", &device, PROGRAM, &options.format);
+	ck_assert_int_eq(writeCachedAddressFile(".", "converter_out3_address", &device, &image, PROGRAM, &options), EXIT_FAILURE);
+	ck_assert_int_ne(stat(cacheFileName, &cacheStatus), 0);
+
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+#if(USING_64BIT == 1)
+// test generateOutputFiles function with 64 bit words
+START_TEST(generateLongWordsTest)
+{
+	int i;
+	char line[40];
+	FILE *file;
+	memoryImage image;
+	deviceData device;
+	outputOptions options;
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+
+
+	// device with one block of two 64 bit words
+	initializeDeviceData(&device);
+	device.memorySize = 16;
+	device.blockSize = 16;
+	device.wordLength = 64;
+	device.addressLength = 16;
+
+	memset(bitOrder, UNUSED_BIT, sizeof(bitOrder));
+	for(i=0; i < 32; i++)
+		bitOrder[i] = 31 - i;
+	encode(&device.wordBitOrder[PROGRAM], bitOrder);
+	encode(&device.wordBitOrder[VERIFY], bitOrder);
+
+	// the bytes of a word are stored little endian
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	for(i=0; i < 8; i++)
+		writeMemoryByte(&image, i, (UINT64_C(0x0123456789ABCDEF) >> 8*i) & 0xFF);
+
+	initializeOutputOptions(&options);
+	ck_assert_int_eq(parseOutputFormat(&options.format, "separator=none,terminator=lf"), EXIT_SUCCESS);
+	ck_assert_int_eq(generateOutputFiles("converter_out1", &device, &image, &options), EXIT_SUCCESS);
+
+	// the upper bytes don't change the lower half of the word
+	file = fopen("converter_out1_data", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	ck_assert_int_eq(fread(line, 1, 33, file), 33);
+	line[33] = '\0';
+	ck_assert_str_eq(line, "10001001101010111100110111101111\n");
+	fclose(file);
+
+	disposeMemoryImage(&image);
+}
+END_TEST
+#endif
+
+
 Suite	*testSuite()
 {
 	Suite *suite;
@@ -118,6 +798,31 @@ Suite	*testSuite()
 	tcase_add_test(testCase, wordToOutputStringTest);
 	suite_add_tcase(suite, testCase);
 
+	// test cases for converting a word with a compiled bit order
+	testCase = tcase_create("compiledWordToOutputString");
+	tcase_add_test(testCase, compiledWordToOutputStringTest);
+#if(USING_64BIT == 1)
+	tcase_add_test(testCase, wideWordToOutputStringTest);
+#endif
+#if(USING_64BIT == 1)
+	tcase_add_test(testCase, compiledRunsTest);
+#endif
+	suite_add_tcase(suite, testCase);
+
+	// test cases for rendering words incrementally
+	testCase = tcase_create("updateOutputString");
+	tcase_add_test(testCase, updateOutputStringTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for generating the output files with several threads
+	testCase = tcase_create("generateOutputFiles");
+	tcase_add_test(testCase, generateOutputFilesTest);
+	tcase_add_test(testCase, addressCacheTest);
+#if(USING_64BIT == 1)
+	tcase_add_test(testCase, generateLongWordsTest);
+#endif
+	suite_add_tcase(suite, testCase);
+
 	return suite;
 }
 
@@ -3,6 +3,7 @@
 
 #include <string.h>
 #include "../src/device-description.h"
+#include "../src/bit-runs.h"
 
 
 // check if the support of 32 and 64 bit is set correctly
@@ -44,9 +45,16 @@ START_TEST(bitOrderLengthTest)
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1 };
 
 
+	bitOrderRuns runs1;
+	bitOrderRuns runs2;
+
+
+	encodeBitOrderRuns(&runs1, bitOrder1, sizeof(bitOrder1));
+	encodeBitOrderRuns(&runs2, bitOrder2, sizeof(bitOrder2));
+
 	// check lengths
-	ck_assert_uint_eq(bitOrderLength(bitOrder1), 11);
-	ck_assert_uint_eq(bitOrderLength(bitOrder2), 16);
+	ck_assert_uint_eq(bitOrderLength(&runs1), 11);
+	ck_assert_uint_eq(bitOrderLength(&runs2), 16);
 
 }
 END_TEST
@@ -76,9 +84,16 @@ START_TEST(bitOrderEmptyTest)
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1 };
 
 
+	bitOrderRuns runs1;
+	bitOrderRuns runs2;
+
+
+	encodeBitOrderRuns(&runs1, bitOrder1, sizeof(bitOrder1));
+	encodeBitOrderRuns(&runs2, bitOrder2, sizeof(bitOrder2));
+
 	// check whether the bit orders are empty or not
-	ck_assert_int_eq(bitOrderIsEmpty(bitOrder1), false);
-	ck_assert_int_eq(bitOrderIsEmpty(bitOrder2), true);
+	ck_assert_int_eq(bitOrderIsEmpty(&runs1), false);
+	ck_assert_int_eq(bitOrderIsEmpty(&runs2), true);
 }
 END_TEST
 
@@ -116,10 +131,19 @@ START_TEST(bitOrderComparisonTest)
 				0x03, 0x13, 0x23, 0x33, 0x43, 0x53, 0x63, 0x73 };
 
 
-	// compare bit order arrays
-	ck_assert_int_eq(bitOrdersAreEqual(bitOrder1, bitOrder1), true);
-	ck_assert_int_eq(bitOrdersAreEqual(bitOrder1, bitOrder2), true);
-	ck_assert_int_eq(bitOrdersAreEqual(bitOrder1, bitOrder3), false);
+	bitOrderRuns runs1;
+	bitOrderRuns runs2;
+	bitOrderRuns runs3;
+
+
+	encodeBitOrderRuns(&runs1, bitOrder1, sizeof(bitOrder1));
+	encodeBitOrderRuns(&runs2, bitOrder2, sizeof(bitOrder2));
+	encodeBitOrderRuns(&runs3, bitOrder3, sizeof(bitOrder3));
+
+	// compare bit orders
+	ck_assert_int_eq(bitOrdersAreEqual(&runs1, &runs1), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&runs1, &runs2), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&runs1, &runs3), false);
 }
 END_TEST
 
@@ -148,17 +172,17 @@ START_TEST(deviceDataInitializationTest)
 	ck_assert_uint_eq(device.wordLength, DEFAULT_WORD_LENGTH);
 	ck_assert_uint_eq(device.addressLength, DEFAULT_ADDRESS_LENGTH);
 
-	// check initialization of the bit order arrays
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
+	// check initialization of the bit orders
+	for(i=PROGRAM; i<=VERIFY; i++)
 	{
-		ck_assert_int_eq(device.wordBitOrder[PROGRAM][i], -1);
-		ck_assert_int_eq(device.wordBitOrder[VERIFY][i], -1);
-		ck_assert_int_eq(device.wordAddressBitOrder[PROGRAM][i], -1);
-		ck_assert_int_eq(device.wordAddressBitOrder[VERIFY][i], -1);
-		ck_assert_int_eq(device.preDataBlockAddrBitOrder[PROGRAM][i], -1);
-		ck_assert_int_eq(device.preDataBlockAddrBitOrder[VERIFY][i], -1);
-		ck_assert_int_eq(device.postDataBlockAddrBitOrder[PROGRAM][i], -1);
-		ck_assert_int_eq(device.postDataBlockAddrBitOrder[VERIFY][i], -1);
+		ck_assert_int_eq(device.wordBitOrder[i].length, 0);
+		ck_assert_int_eq(device.wordBitOrder[i].runNum, 0);
+		ck_assert_int_eq(device.wordAddressBitOrder[i].length, 0);
+		ck_assert_int_eq(device.wordAddressBitOrder[i].runNum, 0);
+		ck_assert_int_eq(device.preDataBlockAddrBitOrder[i].length, 0);
+		ck_assert_int_eq(device.preDataBlockAddrBitOrder[i].runNum, 0);
+		ck_assert_int_eq(device.postDataBlockAddrBitOrder[i].length, 0);
+		ck_assert_int_eq(device.postDataBlockAddrBitOrder[i].runNum, 0);
 	}
 }
 END_TEST
@@ -197,8 +221,11 @@ START_TEST(load32BitFileTest)
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1 };
+	bitOrderRuns runs;
 
 
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+
 	// load file
 	ck_assert_int_eq(loadDeviceDescription(&device, "testfiles/testdevice32"), EXIT_SUCCESS);
 
@@ -224,20 +251,20 @@ START_TEST(load32BitFileTest)
 	ck_assert_uint_eq(device.addressLength, 11);
 
 	// wordBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[VERIFY], &runs), true);
 
 	// wordAddressBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordAddressBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordAddressBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[VERIFY], &runs), true);
 
 	// blockAddressBeforeDataBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.preDataBlockAddrBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.preDataBlockAddrBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[VERIFY], &runs), true);
 
 	// blockAddressAfterDataBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.postDataBlockAddrBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.postDataBlockAddrBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[VERIFY], &runs), true);
 
 	// check if program and verify bit orders are equal
 	ck_assert_int_eq(programAndVerfiyBitOrdersAreEqual(&device), true);
@@ -258,7 +285,10 @@ START_TEST(load32BitCompatible64BitFileTest)
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1 };
+	bitOrderRuns runs;
+
 
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
 
 	// try to load file with too long bit orders
 	ck_assert_int_eq(loadDeviceDescription(&device, "testfiles/testdevice64notcomp32"), EXIT_FAILURE);
@@ -288,20 +318,20 @@ START_TEST(load32BitCompatible64BitFileTest)
 	ck_assert_uint_eq(device.addressLength, 11);
 
 	// wordBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[VERIFY], &runs), true);
 
 	// wordAddressBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordAddressBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordAddressBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[VERIFY], &runs), true);
 
 	// blockAddressBeforeDataBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.preDataBlockAddrBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.preDataBlockAddrBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[VERIFY], &runs), true);
 
 	// blockAddressAfterDataBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.postDataBlockAddrBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.postDataBlockAddrBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[VERIFY], &runs), true);
 }
 END_TEST
 
@@ -319,8 +349,11 @@ START_TEST(load64BitFileTest)
 				0x05, 0x15, 0x25, 0x35, 0x45, 0x55, 0x65, 0x75,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1,
 				  -1,   -1,   -1,   -1,   -1,   -1,   -1,   -1 };
+	bitOrderRuns runs;
 
 
+	encodeBitOrderRuns(&runs, bitOrder, sizeof(bitOrder));
+
 	#if(USING_64BIT == 0)
 	ck_assert_int_eq(loadDeviceDescription(&device, "testfiles/testdevice64"), EXIT_FAILURE);
 	#else
@@ -349,21 +382,21 @@ START_TEST(load64BitFileTest)
 	ck_assert_uint_eq(device.addressLength, 48);
 
 	// wordBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordBitOrder[PROGRAM], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[PROGRAM], &runs), true);
 
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[VERIFY], &runs), true);
 
 	// wordAddressBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordAddressBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.wordAddressBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[VERIFY], &runs), true);
 
 	// blockAddressBeforeDataBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.preDataBlockAddrBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.preDataBlockAddrBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[VERIFY], &runs), true);
 
 	// blockAddressAfterDataBitOrder
-	ck_assert_int_eq(bitOrdersAreEqual(device.postDataBlockAddrBitOrder[PROGRAM], bitOrder), true);
-	ck_assert_int_eq(bitOrdersAreEqual(device.postDataBlockAddrBitOrder[VERIFY], bitOrder), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[PROGRAM], &runs), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[VERIFY], &runs), true);
 	#endif
 }
 END_TEST
@@ -372,7 +405,10 @@ END_TEST
 START_TEST(save32BitFileTest)
 {
 	int i;
+	int j;
 	deviceData device;
+	int8_t bitOrder[MAX_FILE_BIT_ORDER_LENGTH];
+	bitOrderRuns runs[8];
 
 
 	// fill datastructure with data
@@ -386,17 +422,20 @@ START_TEST(save32BitFileTest)
 	device.addressLength = 11;
 
 	// set bit orders to defined values
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
+	for(i=0; i<8; i++)
 	{
-		device.wordBitOrder[0][i] = 0x51;
-		device.wordBitOrder[1][i] = 0x52;
-		device.wordAddressBitOrder[0][i] = 0x53;
-		device.wordAddressBitOrder[1][i] = 0x54;
-		device.preDataBlockAddrBitOrder[0][i] = 0x55;
-		device.preDataBlockAddrBitOrder[1][i] = 0x56;
-		device.postDataBlockAddrBitOrder[0][i] = 0x57;
-		device.postDataBlockAddrBitOrder[1][i] = 0x58;
+		for(j=0; j<MAX_FILE_BIT_ORDER_LENGTH; j++)
+			bitOrder[j] = 0x51 + i;
+		encodeBitOrderRuns(&runs[i], bitOrder, MAX_FILE_BIT_ORDER_LENGTH);
 	}
+	device.wordBitOrder[PROGRAM] = runs[0];
+	device.wordBitOrder[VERIFY] = runs[1];
+	device.wordAddressBitOrder[PROGRAM] = runs[2];
+	device.wordAddressBitOrder[VERIFY] = runs[3];
+	device.preDataBlockAddrBitOrder[PROGRAM] = runs[4];
+	device.preDataBlockAddrBitOrder[VERIFY] = runs[5];
+	device.postDataBlockAddrBitOrder[PROGRAM] = runs[6];
+	device.postDataBlockAddrBitOrder[VERIFY] = runs[7];
 
 	// save the device data structure
 	ck_assert_int_eq(saveDeviceDescription(&device, "testdevice"), EXIT_SUCCESS);
@@ -426,18 +465,15 @@ START_TEST(save32BitFileTest)
 	// addressLength
 	ck_assert_uint_eq(device.addressLength, 11);
 
-	// check the bit order arrays
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
-	{
-		ck_assert_int_eq(device.wordBitOrder[PROGRAM][i], 0x51);
-		ck_assert_int_eq(device.wordBitOrder[VERIFY][i], 0x52);
-		ck_assert_int_eq(device.wordAddressBitOrder[PROGRAM][i], 0x53);
-		ck_assert_int_eq(device.wordAddressBitOrder[VERIFY][i], 0x54);
-		ck_assert_int_eq(device.preDataBlockAddrBitOrder[PROGRAM][i], 0x55);
-		ck_assert_int_eq(device.preDataBlockAddrBitOrder[VERIFY][i], 0x56);
-		ck_assert_int_eq(device.postDataBlockAddrBitOrder[PROGRAM][i], 0x57);
-		ck_assert_int_eq(device.postDataBlockAddrBitOrder[VERIFY][i], 0x58);
-	}
+	// check the bit orders
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[PROGRAM], &runs[0]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[VERIFY], &runs[1]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[PROGRAM], &runs[2]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[VERIFY], &runs[3]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[PROGRAM], &runs[4]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[VERIFY], &runs[5]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[PROGRAM], &runs[6]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[VERIFY], &runs[7]), true);
 }
 END_TEST
 
@@ -445,7 +481,10 @@ END_TEST
 START_TEST(save64BitFileTest)
 {
 	int i;
+	int j;
 	deviceData device;
+	int8_t bitOrder[MAX_FILE_BIT_ORDER_LENGTH];
+	bitOrderRuns runs[8];
 
 
 	// fill datastructure with data
@@ -459,17 +498,20 @@ START_TEST(save64BitFileTest)
 	device.addressLength = 48;
 
 	// set bit orders to defined values
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
+	for(i=0; i<8; i++)
 	{
-		device.wordBitOrder[0][i] = 0x51;
-		device.wordBitOrder[1][i] = 0x52;
-		device.wordAddressBitOrder[0][i] = 0x53;
-		device.wordAddressBitOrder[1][i] = 0x54;
-		device.preDataBlockAddrBitOrder[0][i] = 0x55;
-		device.preDataBlockAddrBitOrder[1][i] = 0x56;
-		device.postDataBlockAddrBitOrder[0][i] = 0x57;
-		device.postDataBlockAddrBitOrder[1][i] = 0x58;
+		for(j=0; j<MAX_FILE_BIT_ORDER_LENGTH; j++)
+			bitOrder[j] = 0x51 + i;
+		encodeBitOrderRuns(&runs[i], bitOrder, MAX_FILE_BIT_ORDER_LENGTH);
 	}
+	device.wordBitOrder[PROGRAM] = runs[0];
+	device.wordBitOrder[VERIFY] = runs[1];
+	device.wordAddressBitOrder[PROGRAM] = runs[2];
+	device.wordAddressBitOrder[VERIFY] = runs[3];
+	device.preDataBlockAddrBitOrder[PROGRAM] = runs[4];
+	device.preDataBlockAddrBitOrder[VERIFY] = runs[5];
+	device.postDataBlockAddrBitOrder[PROGRAM] = runs[6];
+	device.postDataBlockAddrBitOrder[VERIFY] = runs[7];
 
 	// save the device data structure
 	ck_assert_int_eq(saveDeviceDescription(&device, "testdevice"), EXIT_SUCCESS);
@@ -499,18 +541,42 @@ START_TEST(save64BitFileTest)
 	// addressLength
 	ck_assert_uint_eq(device.addressLength, 48);
 
-	// check the bit order arrays
-	for(i=0; i<MAX_BIT_ORDER_LENGTH; i++)
-	{
-		ck_assert_int_eq(device.wordBitOrder[PROGRAM][i], 0x51);
-		ck_assert_int_eq(device.wordBitOrder[VERIFY][i], 0x52);
-		ck_assert_int_eq(device.wordAddressBitOrder[PROGRAM][i], 0x53);
-		ck_assert_int_eq(device.wordAddressBitOrder[VERIFY][i], 0x54);
-		ck_assert_int_eq(device.preDataBlockAddrBitOrder[PROGRAM][i], 0x55);
-		ck_assert_int_eq(device.preDataBlockAddrBitOrder[VERIFY][i], 0x56);
-		ck_assert_int_eq(device.postDataBlockAddrBitOrder[PROGRAM][i], 0x57);
-		ck_assert_int_eq(device.postDataBlockAddrBitOrder[VERIFY][i], 0x58);
-	}
+	// check the bit orders
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[PROGRAM], &runs[0]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordBitOrder[VERIFY], &runs[1]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[PROGRAM], &runs[2]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.wordAddressBitOrder[VERIFY], &runs[3]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[PROGRAM], &runs[4]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.preDataBlockAddrBitOrder[VERIFY], &runs[5]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[PROGRAM], &runs[6]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&device.postDataBlockAddrBitOrder[VERIFY], &runs[7]), true);
+}
+END_TEST
+
+
+// check that bit orders too long for the file format are not saved
+START_TEST(saveTooLongBitOrderTest)
+{
+	int i;
+	deviceData device;
+	int8_t bitOrder[MAX_FILE_BIT_ORDER_LENGTH + 1];
+
+
+	// fill datastructure with data
+	initializeDeviceData(&device);
+	strcpy(device.name, "testdevice");
+	device.memorySize = 0x100;
+	device.blockSize = 16;
+
+	// a word bit order one bit longer than a file bit order array
+	for(i=0; i<MAX_FILE_BIT_ORDER_LENGTH + 1; i++)
+		bitOrder[i] = i % MAX_FILE_BIT_ORDER_LENGTH;
+	encodeBitOrderRuns(&device.wordBitOrder[PROGRAM], bitOrder, sizeof(bitOrder));
+	ck_assert_int_eq(saveDeviceDescription(&device, "testdevice"), EXIT_FAILURE);
+
+	// the same bit order without the last bit can be saved
+	encodeBitOrderRuns(&device.wordBitOrder[PROGRAM], bitOrder, sizeof(bitOrder) - 1);
+	ck_assert_int_eq(saveDeviceDescription(&device, "testdevice"), EXIT_SUCCESS);
 }
 END_TEST
 
@@ -582,6 +648,8 @@ Suite	*testSuite()
 	tcase_add_test(testCase, save64BitFileTest);
 	suite_add_tcase(suite, testCase);
 	#endif
+	tcase_add_test(testCase, saveTooLongBitOrderTest);
+	suite_add_tcase(suite, testCase);
 
 	return suite;
 }
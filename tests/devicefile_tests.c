@@ -0,0 +1,286 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/device-file.h"
+#include "test-files.h"
+
+
+// fill a device whose bit orders need lookup tables
+static void	initializeTestDevice(deviceData *device)
+{
+	int i;
+	int8_t bitOrder[4][17];
+
+
+	initializeDeviceData(device);
+	strcpy(device->name, "testdevicefile");
+	device->memorySize = 256;
+	device->blockSize = 16;
+	device->wordLength = 16;
+	device->addressLength = 16;
+	device->startAddress = 0x100;
+
+	for(i=0; i < 16; i++)
+	{
+		bitOrder[0][i] = (5*i) % 16;
+		bitOrder[1][i] = (3*i) % 16;
+	}
+	bitOrder[0][16] = LITERAL1_BIT;
+	encodeBitOrderRuns(&device->wordBitOrder[PROGRAM], bitOrder[0], 16);
+	encodeBitOrderRuns(&device->wordBitOrder[VERIFY], bitOrder[0], 17);
+	encodeBitOrderRuns(&device->wordAddressBitOrder[PROGRAM], bitOrder[1], 16);
+
+	for(i=0; i < 8; i++)
+	{
+		bitOrder[1][i] = i;
+		bitOrder[2][i] = 15 - 2*i;
+		bitOrder[3][i] = 8 + i;
+	}
+	encodeBitOrderRuns(&device->wordAddressBitOrder[VERIFY], bitOrder[1], 8);
+	encodeBitOrderRuns(&device->preDataBlockAddrBitOrder[PROGRAM], bitOrder[2], 8);
+	encodeBitOrderRuns(&device->postDataBlockAddrBitOrder[VERIFY], bitOrder[3], 8);
+}
+
+
+// save a device file and load it again
+START_TEST(saveLoadTest)
+{
+	int i;
+	int format;
+	int length;
+	char outputString[MAX_OUTPUT_STRING_LENGTH];
+	char compiledString[MAX_OUTPUT_STRING_LENGTH];
+	deviceData device;
+	deviceData loadedDevice;
+	deviceFile file;
+	compiledBitOrder compiled;
+	outputFormat layout;
+
+
+	initializeTestDevice(&device);
+	ck_assert_int_eq(saveDeviceFile(&device, 0, "testdevicefile"), EXIT_SUCCESS);
+
+	for(format=BINARY_OUTPUT; format <= ASCII_OUTPUT; format++)
+	{
+		initializeOutputFormat(&layout, format);
+		ck_assert_int_eq(loadDeviceFile(&loadedDevice, &file, "testdevicefile", &layout), EXIT_SUCCESS);
+
+		// the description is restored
+		ck_assert_str_eq(loadedDevice.name, "testdevicefile");
+		ck_assert_uint_eq(loadedDevice.memorySize, 256);
+		ck_assert_uint_eq(loadedDevice.blockSize, 16);
+		ck_assert_uint_eq(loadedDevice.startAddress, 0x100);
+		ck_assert_uint_eq(loadedDevice.addressStepPerWord, 1);
+		ck_assert_uint_eq(loadedDevice.wordLength, 16);
+		ck_assert_uint_eq(loadedDevice.addressLength, 16);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.wordBitOrder[PROGRAM], &device.wordBitOrder[PROGRAM]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.wordBitOrder[VERIFY], &device.wordBitOrder[VERIFY]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.wordAddressBitOrder[PROGRAM], &device.wordAddressBitOrder[PROGRAM]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.wordAddressBitOrder[VERIFY], &device.wordAddressBitOrder[VERIFY]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.preDataBlockAddrBitOrder[PROGRAM], &device.preDataBlockAddrBitOrder[PROGRAM]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.preDataBlockAddrBitOrder[VERIFY], &device.preDataBlockAddrBitOrder[VERIFY]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.postDataBlockAddrBitOrder[PROGRAM], &device.postDataBlockAddrBitOrder[PROGRAM]), true);
+		ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.postDataBlockAddrBitOrder[VERIFY], &device.postDataBlockAddrBitOrder[VERIFY]), true);
+
+		// the stored tables render the same output as compiled tables
+		ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][PROGRAM], true);
+		ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][VERIFY], true);
+		ck_assert_int_eq(file.bitOrders.available[WORD_ADDRESS_BIT_ORDER][PROGRAM], true);
+		ck_assert_int_eq(file.bitOrders.bitOrder[WORD_BIT_ORDER][PROGRAM].ownsFragments, false);
+
+		ck_assert_int_eq(compileBitOrder(&compiled, &device.wordBitOrder[VERIFY], 16, &layout), EXIT_SUCCESS);
+		for(i=0; i < 0x10000; i += 7)
+		{
+			length = compiledWordToOutputString(&compiled, i, outputString);
+			ck_assert_int_eq(compiledWordToOutputString(&file.bitOrders.bitOrder[WORD_BIT_ORDER][VERIFY], i, compiledString), length);
+			ck_assert_int_eq(memcmp(outputString, compiledString, length), 0);
+		}
+		disposeCompiledBitOrder(&compiled);
+
+		// the tables can't be freed by the users
+		compiled = file.bitOrders.bitOrder[WORD_BIT_ORDER][PROGRAM];
+		disposeCompiledBitOrder(&compiled);
+
+		disposeDeviceFile(&file);
+		ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][PROGRAM], false);
+	}
+
+	// there are no tables for other formats
+	initializeOutputFormat(&layout, PACKED_OUTPUT);
+	ck_assert_int_eq(loadDeviceFile(&loadedDevice, &file, "testdevicefile", &layout), EXIT_SUCCESS);
+	ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][PROGRAM], false);
+	disposeDeviceFile(&file);
+
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&layout, "separator=tab"), EXIT_SUCCESS);
+	ck_assert_int_eq(loadDeviceFile(&loadedDevice, &file, "testdevicefile", &layout), EXIT_SUCCESS);
+	ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][PROGRAM], false);
+	disposeDeviceFile(&file);
+}
+END_TEST
+
+
+// try to load damaged files
+START_TEST(loadInvalidFileTest)
+{
+	char data[8192];
+	size_t size;
+	deviceData device;
+	deviceFile file;
+	outputFormat layout;
+	FILE *stream;
+
+
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	ck_assert_int_eq(loadDeviceFile(&device, &file, "testfiles/nonexistentfile", &layout), EXIT_FAILURE);
+
+	initializeTestDevice(&device);
+	ck_assert_int_eq(saveDeviceFile(&device, 0, "testdevicefile"), EXIT_SUCCESS);
+	stream = fopen("testdevicefile", "rb");
+	ck_assert_ptr_ne(stream, NULL);
+	size = fread(data, 1, sizeof(data), stream);
+	fclose(stream);
+	ck_assert(size > DEVICE_FILE_HEADER_SIZE + DEVICE_FILE_DESCRIPTION_SIZE);
+
+	// a changed byte of the description is detected by the checksum
+	data[DEVICE_FILE_HEADER_SIZE + 100] ^= 1;
+	stream = fopen("testdevicefile_corrupt", "wb");
+	fwrite(data, 1, size, stream);
+	fclose(stream);
+	ck_assert_int_eq(loadDeviceFile(&device, &file, "testdevicefile_corrupt", &layout), EXIT_FAILURE);
+	ck_assert_ptr_eq(file.data, NULL);
+
+	// truncated file
+	data[DEVICE_FILE_HEADER_SIZE + 100] ^= 1;
+	stream = fopen("testdevicefile_corrupt", "wb");
+	fwrite(data, 1, size / 2, stream);
+	fclose(stream);
+	ck_assert_int_eq(loadDeviceFile(&device, &file, "testdevicefile_corrupt", &layout), EXIT_FAILURE);
+
+	// unknown version
+	data[8] = DEVICE_FILE_VERSION + 1;
+	stream = fopen("testdevicefile_corrupt", "wb");
+	fwrite(data, 1, size, stream);
+	fclose(stream);
+	ck_assert_int_eq(loadDeviceFile(&device, &file, "testdevicefile_corrupt", &layout), EXIT_FAILURE);
+}
+END_TEST
+
+
+// version 1 files are still loaded
+START_TEST(loadVersion1FileTest)
+{
+	deviceData device;
+	deviceData loadedDevice;
+	deviceFile file;
+	outputFormat layout;
+
+
+	initializeTestDevice(&device);
+	ck_assert_int_eq(saveDeviceDescription(&device, "testdevicefile"), EXIT_SUCCESS);
+
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	ck_assert_int_eq(loadDeviceFile(&loadedDevice, &file, "testdevicefile", &layout), EXIT_SUCCESS);
+	ck_assert_str_eq(loadedDevice.name, "testdevicefile");
+	ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.wordBitOrder[PROGRAM], &device.wordBitOrder[PROGRAM]), true);
+	ck_assert_int_eq(bitOrdersAreEqual(&loadedDevice.wordBitOrder[VERIFY], &device.wordBitOrder[VERIFY]), true);
+	ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][PROGRAM], false);
+	disposeDeviceFile(&file);
+
+	// 64 bit version 1 files are loaded as before
+	ck_assert_int_eq(loadDeviceFile(&loadedDevice, &file, "testfiles/testdevice64comp32", &layout), EXIT_SUCCESS);
+	ck_assert_str_eq(loadedDevice.name, "testdevice64comp32");
+	disposeDeviceFile(&file);
+}
+END_TEST
+
+
+// output files generated with the stored tables are the same
+START_TEST(generateOutputFilesTest)
+{
+	int format;
+	int threadNum;
+	deviceData device;
+	deviceFile file;
+	memoryImage image;
+	outputOptions options;
+
+
+	initializeTestDevice(&device);
+	ck_assert_int_eq(saveDeviceFile(&device, 0, "testdevicefile"), EXIT_SUCCESS);
+
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	writeMemoryByte(&image, 3, 0x12);
+	writeMemoryByte(&image, 5*16, 0x80);
+	writeMemoryByte(&image, 255, 0x7F);
+
+	initializeOutputOptions(&options);
+	for(format=BINARY_OUTPUT; format <= ASCII_OUTPUT; format++)
+	{
+		for(threadNum=1; threadNum <= 3; threadNum += 2)
+		{
+			initializeOutputFormat(&options.format, format);
+			options.threadNum = threadNum;
+			options.precompiled = NULL;
+			ck_assert_int_eq(generateOutputFiles("devicefile_out1", &device, &image, &options), EXIT_SUCCESS);
+
+			ck_assert_int_eq(loadDeviceFile(&device, &file, "testdevicefile", &options.format), EXIT_SUCCESS);
+			options.precompiled = &file.bitOrders;
+			ck_assert_int_eq(generateOutputFiles("devicefile_out3", &device, &image, &options), EXIT_SUCCESS);
+			disposeDeviceFile(&file);
+
+			ck_assert(filesAreEqual("devicefile_out1_program_data", "devicefile_out3_program_data"));
+			ck_assert(filesAreEqual("devicefile_out1_verify_data", "devicefile_out3_verify_data"));
+			ck_assert(filesAreEqual("devicefile_out1_program_address", "devicefile_out3_program_address"));
+			ck_assert(filesAreEqual("devicefile_out1_verify_address", "devicefile_out3_verify_address"));
+		}
+	}
+
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("DeviceFile");
+
+
+	// test cases for saving and loading compiled device files
+	testCase = tcase_create("saveLoad");
+	tcase_add_test(testCase, saveLoadTest);
+	tcase_add_test(testCase, loadInvalidFileTest);
+	tcase_add_test(testCase, loadVersion1FileTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for generating output with the stored tables
+	testCase = tcase_create("generateOutputFiles");
+	tcase_add_test(testCase, generateOutputFilesTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/device-library.h"
+
+
+// fill a device with a name and bit orders depending on a number
+static void	initializeTestDevice(deviceData *device, int number)
+{
+	int i;
+	int8_t bitOrder[3][16];
+
+
+	initializeDeviceData(device);
+	sprintf(device->name, "device%i", number);
+	device->memorySize = 256 * (number + 1);
+	device->blockSize = 16;
+	device->wordLength = 16;
+	device->addressLength = 16;
+
+	for(i=0; i < 16; i++)
+	{
+		bitOrder[0][i] = ((number + 3)*i) % 16;
+		bitOrder[1][i] = i;
+		bitOrder[2][i] = 15 - i;
+	}
+	encodeBitOrderRuns(&device->wordBitOrder[PROGRAM], bitOrder[0], 16);
+	encodeBitOrderRuns(&device->wordBitOrder[VERIFY], bitOrder[0], 16);
+	encodeBitOrderRuns(&device->wordAddressBitOrder[PROGRAM], bitOrder[1], 16);
+	encodeBitOrderRuns(&device->wordAddressBitOrder[VERIFY], bitOrder[2], 16);
+}
+
+
+// save a library and load its devices
+START_TEST(saveLoadTest)
+{
+	int number;
+	char name[MAX_DEVICE_NAME_LENGTH];
+	deviceData devices[100];
+	deviceData device;
+	deviceFile file;
+	deviceLibrary library;
+	outputFormat layout;
+
+
+	for(number=0; number < 100; number++)
+		initializeTestDevice(&devices[number], number);
+	ck_assert_int_eq(saveDeviceLibrary(devices, 100, "testlibrary"), EXIT_SUCCESS);
+
+	ck_assert_int_eq(openDeviceLibrary(&library, "testlibrary"), EXIT_SUCCESS);
+	ck_assert_uint_eq(library.deviceNum, 100);
+	ck_assert(library.bucketNum >= 200);
+
+	initializeOutputFormat(&layout, ASCII_OUTPUT);
+	for(number=99; number >= 0; number--)
+	{
+		sprintf(name, "device%i", number);
+		ck_assert_int_eq(loadLibraryDevice(&device, &file, &library, name, &layout), EXIT_SUCCESS);
+		ck_assert_str_eq(device.name, name);
+		ck_assert_uint_eq(device.memorySize, 256 * (number + 1));
+		ck_assert_int_eq(memcmp(device.wordBitOrder, devices[number].wordBitOrder, sizeof(device.wordBitOrder)), 0);
+		ck_assert_int_eq(memcmp(device.wordAddressBitOrder, devices[number].wordAddressBitOrder, sizeof(device.wordAddressBitOrder)), 0);
+
+		// the device file is part of the library
+		ck_assert(file.data > library.data);
+		ck_assert(file.data < library.data + library.size);
+		ck_assert_int_eq(file.ownsData, false);
+		if(number == 0)
+			ck_assert_int_eq(file.bitOrders.available[WORD_BIT_ORDER][PROGRAM], true);
+		disposeDeviceFile(&file);
+	}
+
+	// unknown devices
+	ck_assert_int_eq(loadLibraryDevice(&device, &file, &library, "device100", &layout), EXIT_FAILURE);
+	ck_assert_int_eq(loadLibraryDevice(&device, &file, &library, "", &layout), EXIT_FAILURE);
+
+	closeDeviceLibrary(&library);
+	ck_assert_ptr_eq(library.data, NULL);
+}
+END_TEST
+
+
+// devices need unique names
+START_TEST(saveInvalidLibraryTest)
+{
+	deviceData devices[3];
+
+
+	initializeTestDevice(&devices[0], 0);
+	initializeTestDevice(&devices[1], 1);
+	initializeTestDevice(&devices[2], 0);
+	ck_assert_int_eq(saveDeviceLibrary(devices, 3, "testlibrary"), EXIT_FAILURE);
+
+	strcpy(devices[2].name, "");
+	ck_assert_int_eq(saveDeviceLibrary(devices, 3, "testlibrary"), EXIT_FAILURE);
+}
+END_TEST
+
+
+// try to open damaged libraries
+START_TEST(openInvalidLibraryTest)
+{
+	char data[16384];
+	size_t size;
+	deviceData devices[2];
+	deviceLibrary library;
+	FILE *stream;
+
+
+	ck_assert_int_eq(openDeviceLibrary(&library, "testfiles/nonexistentfile"), EXIT_FAILURE);
+
+	// a device file is not a library
+	initializeTestDevice(&devices[0], 0);
+	ck_assert_int_eq(saveDeviceFile(&devices[0], 0, "testlibrary"), EXIT_SUCCESS);
+	ck_assert_int_eq(openDeviceLibrary(&library, "testlibrary"), EXIT_FAILURE);
+
+	initializeTestDevice(&devices[1], 1);
+	ck_assert_int_eq(saveDeviceLibrary(devices, 2, "testlibrary"), EXIT_SUCCESS);
+	stream = fopen("testlibrary", "rb");
+	ck_assert_ptr_ne(stream, NULL);
+	size = fread(data, 1, sizeof(data), stream);
+	fclose(stream);
+	ck_assert(size > DEVICE_LIBRARY_HEADER_SIZE + 4 * DEVICE_LIBRARY_BUCKET_SIZE);
+
+	// a changed bucket is detected by the checksum
+	data[DEVICE_LIBRARY_HEADER_SIZE + 1] ^= 1;
+	data[DEVICE_LIBRARY_HEADER_SIZE + DEVICE_LIBRARY_BUCKET_SIZE + 1] ^= 1;
+	data[DEVICE_LIBRARY_HEADER_SIZE + 2 * DEVICE_LIBRARY_BUCKET_SIZE + 1] ^= 1;
+	data[DEVICE_LIBRARY_HEADER_SIZE + 3 * DEVICE_LIBRARY_BUCKET_SIZE + 1] ^= 1;
+	stream = fopen("testlibrary", "wb");
+	fwrite(data, 1, size, stream);
+	fclose(stream);
+	ck_assert_int_eq(openDeviceLibrary(&library, "testlibrary"), EXIT_FAILURE);
+
+	// truncated library
+	stream = fopen("testlibrary", "wb");
+	fwrite(data, 1, size - 1, stream);
+	fclose(stream);
+	ck_assert_int_eq(openDeviceLibrary(&library, "testlibrary"), EXIT_FAILURE);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("DeviceLibrary");
+
+
+	// test cases for saving and loading device libraries
+	testCase = tcase_create("saveLoad");
+	tcase_add_test(testCase, saveLoadTest);
+	tcase_add_test(testCase, saveInvalidLibraryTest);
+	tcase_add_test(testCase, openInvalidLibraryTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
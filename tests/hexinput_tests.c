@@ -93,19 +93,19 @@ END_TEST
 // test calculateChecksum function
 START_TEST(saveHexLineToProgramDataTest)
 {
-	uint8_t programData[1024];
+	memoryImage image;
 	deviceData device;
 	hexFileLine line;
 
 
-	// initialize the programData
-	memset(programData, 0xFF, 1024);
-
 	// initialize a device
 	initializeDeviceData(&device);
 	device.memorySize = 1024;
 	device.startAddress = 0x08000000;
 
+	// initialize the memory image
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+
 
 	// setup a line to save
 	line.address = 0x03E0;
@@ -119,29 +119,31 @@ START_TEST(saveHexLineToProgramDataTest)
 	// try to save some lines that are invalid for the given device
 	line.byteCount = 0x05;
 	line.extendedAddress = 0x00000000;
-	ck_assert_int_eq(saveHexLineToProgramData(line, &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(saveHexLineToProgramData(&line, &device, &image), EXIT_FAILURE);
 
 	line.byteCount = 32;
 	line.extendedAddress = 0x08000000;
-	ck_assert_int_eq(saveHexLineToProgramData(line, &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(saveHexLineToProgramData(&line, &device, &image), EXIT_FAILURE);
 
-	// write 0 bytes to programData
+	// write 0 bytes to the memory image
 	line.byteCount = 0;
 	line.extendedAddress = 0x08000000;
-	ck_assert_int_eq(saveHexLineToProgramData(line, &device, programData), EXIT_SUCCESS);
-	ck_assert_uint_eq(programData[line.address], 0xFF);
+	ck_assert_int_eq(saveHexLineToProgramData(&line, &device, &image), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address), 0xFF);
 
-	// write 5 bytes to programData
+	// write 5 bytes to the memory image
 	line.byteCount = 5;
 	line.extendedAddress = 0x08000000;
-	ck_assert_int_eq(saveHexLineToProgramData(line, &device, programData), EXIT_SUCCESS);
-	ck_assert_uint_eq(programData[line.address-1], 0xFF);
-	ck_assert_uint_eq(programData[line.address+0], 0xFB);
-	ck_assert_uint_eq(programData[line.address+1], 0xCF);
-	ck_assert_uint_eq(programData[line.address+2], 0x05);
-	ck_assert_uint_eq(programData[line.address+3], 0xF0);
-	ck_assert_uint_eq(programData[line.address+4], 0xE9);
-	ck_assert_uint_eq(programData[line.address+5], 0xFF);
+	ck_assert_int_eq(saveHexLineToProgramData(&line, &device, &image), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address-1), 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address+0), 0xFB);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address+1), 0xCF);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address+2), 0x05);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address+3), 0xF0);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address+4), 0xE9);
+	ck_assert_uint_eq(readMemoryByte(&image, line.address+5), 0xFF);
+
+	disposeMemoryImage(&image);
 }
 END_TEST
 
@@ -193,76 +195,248 @@ END_TEST
 // test readHexFileTest function
 START_TEST(readHexFileTest)
 {
-	uint8_t programData[1024];
+	memoryImage image;
 	deviceData device;
 
 
-	// initialize the programData
-	memset(programData, 0xFF, 1024);
-
 	// initialize the device
 	initializeDeviceData(&device);
 	device.memorySize = 1024;
 	device.startAddress = 40;
 
+	// initialize the memory image
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+
 	// try to read a file that does not exist
-	ck_assert_int_eq(readHexFile("testfiles/nonexistentfile.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/nonexistentfile.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file with a missing start code
-	ck_assert_int_eq(readHexFile("testfiles/missingstartcode.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/missingstartcode.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid character
-	ck_assert_int_eq(readHexFile("testfiles/invalidchar.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidchar.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid checksum
-	ck_assert_int_eq(readHexFile("testfiles/invalidchecksum.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidchecksum.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid record type
-	ck_assert_int_eq(readHexFile("testfiles/invalidrecord.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidrecord.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing data not within the address boundaries of the device
-	ck_assert_int_eq(readHexFile("testfiles/wrongaddress.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/wrongaddress.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file with a missing end of file record
-	ck_assert_int_eq(readHexFile("testfiles/missingendoffile.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/missingendoffile.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid end of file record
-	ck_assert_int_eq(readHexFile("testfiles/invalidendoffile.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidendoffile.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid start segment address record
-	ck_assert_int_eq(readHexFile("testfiles/invalidstartsegmentaddress.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidstartsegmentaddress.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid extended segment address record
-	ck_assert_int_eq(readHexFile("testfiles/invalidextendedsegmentaddress.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidextendedsegmentaddress.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid start linear address record
-	ck_assert_int_eq(readHexFile("testfiles/invalidstartlinearaddress.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidstartlinearaddress.hex", &device, &image), EXIT_FAILURE);
 
 	// try to open a file containing an invalid extended linear address record
-	ck_assert_int_eq(readHexFile("testfiles/invalidextendedlinearaddress.hex", &device, programData), EXIT_FAILURE);
+	ck_assert_int_eq(readHexFile("testfiles/invalidextendedlinearaddress.hex", &device, &image), EXIT_FAILURE);
 
 	// read two files containing all record types
 	device.startAddress = 0x00080000;
-	memset(programData, 0xFF, 1024);
-	ck_assert_int_eq(readHexFile("testfiles/testfilelinearaddress.hex", &device, programData), EXIT_SUCCESS);
-	ck_assert_uint_eq(programData[0x27], 0xFF);
-	ck_assert_uint_eq(programData[0x28], 0xFB);
-	ck_assert_uint_eq(programData[0x29], 0xCF);
-	ck_assert_uint_eq(programData[0x2A], 0x05);
-	ck_assert_uint_eq(programData[0x36], 0x08);
-	ck_assert_uint_eq(programData[0x37], 0xF0);
-	ck_assert_uint_eq(programData[0x38], 0xFF);
+	disposeMemoryImage(&image);
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFile("testfiles/testfilelinearaddress.hex", &device, &image), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x27), 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x28), 0xFB);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x29), 0xCF);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x2A), 0x05);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x36), 0x08);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x37), 0xF0);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x38), 0xFF);
 
 	device.startAddress = 0x00080000;
-	memset(programData, 0xFF, 1024);
-	ck_assert_int_eq(readHexFile("testfiles/testfilesegmentaddress.hex", &device, programData), EXIT_SUCCESS);
-	ck_assert_uint_eq(programData[0x27], 0xFF);
-	ck_assert_uint_eq(programData[0x28], 0xFB);
-	ck_assert_uint_eq(programData[0x29], 0xCF);
-	ck_assert_uint_eq(programData[0x2A], 0x05);
-	ck_assert_uint_eq(programData[0x36], 0x08);
-	ck_assert_uint_eq(programData[0x37], 0xF0);
-	ck_assert_uint_eq(programData[0x38], 0xFF);
+	disposeMemoryImage(&image);
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFile("testfiles/testfilesegmentaddress.hex", &device, &image), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x27), 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x28), 0xFB);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x29), 0xCF);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x2A), 0x05);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x36), 0x08);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x37), 0xF0);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x38), 0xFF);
+
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+// write a hex file with 16 data bytes per line for almost 128KB starting at 0x00080000
+// (the last line is left out, because a line must not end at the end of the memory)
+static void	writeParallelTestFile(char *fileName, int corruptLine, int endOfFileLine)
+{
+	int line;
+	int byte;
+	int record;
+	uint8_t sum;
+	uint32_t address;
+	FILE *file;
+
+
+	file = fopen(fileName, "wb");
+	ck_assert(file != NULL);
+
+	line = 0;
+	for(record=0; record < 8191; record++)
+	{
+		address = record*16;
+
+		// extended linear address record every 64KB
+		if(address % 0x10000 == 0)
+		{
+			sum = 0x02 + 0x04 + 0x00 + 0x08 + (address >> 16);
+			fprintf(file, ":020000040%03X%02X\r\n", 0x008 + 
+				(address >> 16), (uint8_t) -sum);
+			line++;
+		}
+
+		sum = 0x10 + ((address >> 8) & 0xFF) + (address & 0xFF);
+		fprintf(file, ":10%04X00", address & 0xFFFF);
+		for(byte=0; byte < 16; byte++)
+		{
+			fprintf(file, "%02X", (address + byte) * 7 & 0xFF);
+			sum += (address + byte) * 7;
+		}
+		fprintf(file, "%02X\r\n", (uint8_t) (-sum + 
+						(++line == corruptLine)));
+
+		if(line == endOfFileLine)
+			fprintf(file, ":00000001FF\r\n");
+	}
+
+	fprintf(file, ":00000001FF\r\n");
+	fclose(file);
+}
+
+
+// test readHexFileParallel function
+START_TEST(readHexFileParallelTest)
+{
+	uint32_64_t byte;
+	memoryImage image;
+	memoryImage parallelImage;
+	deviceData device;
+
+
+	// initialize the device
+	initializeDeviceData(&device);
+	device.memorySize = 0x20000;
+	device.startAddress = 0x00080000;
+	device.blockSize = 4096;
+
+	// read a file with one and with four threads
+	writeParallelTestFile("testfiles/parallel.hex", 0, 0);
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(initializeMemoryImage(&parallelImage, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFileParallel("testfiles/parallel.hex", &device, &image, 1, false), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFileParallel("testfiles/parallel.hex", &device, &parallelImage, 4, false), EXIT_SUCCESS);
+	for(byte=0; byte < device.memorySize - 16; byte++)
+	{
+		ck_assert_uint_eq(readMemoryByte(&image, byte), (byte * 7) & 0xFF);
+		ck_assert_uint_eq(readMemoryByte(&parallelImage, byte), (byte * 7) & 0xFF);
+	}
+	disposeMemoryImage(&image);
+	disposeMemoryImage(&parallelImage);
+
+	// end of file record before the last part (the rest is ignored)
+	writeParallelTestFile("testfiles/parallel.hex", 0, 1000);
+	ck_assert_int_eq(initializeMemoryImage(&parallelImage, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFileParallel("testfiles/parallel.hex", &device, &parallelImage, 4, false), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&parallelImage, 998*16), (998*16*7) & 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&parallelImage, 999*16), 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&parallelImage, 0x10000), 0xFF);
+	disposeMemoryImage(&parallelImage);
+
+	// failure in the last part
+	writeParallelTestFile("testfiles/parallel.hex", 8000, 0);
+	ck_assert_int_eq(initializeMemoryImage(&parallelImage, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFileParallel("testfiles/parallel.hex", &device, &parallelImage, 4, false), EXIT_FAILURE);
+	disposeMemoryImage(&parallelImage);
+
+	remove("testfiles/parallel.hex");
+}
+END_TEST
+
+
+// test readHexFileParallel function with the record coverage
+START_TEST(readHexFileRecordCoverageTest)
+{
+	memoryImage image;
+	deviceData device;
+
+
+	// initialize the device
+	initializeDeviceData(&device);
+	device.memorySize = 1024;
+	device.startAddress = 0;
+	device.blockSize = 256;
+
+	// a block written with 0xFF is released without the record coverage
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFileParallel("testfiles/blankrecord.hex", &device, &image, 1, false), EXIT_SUCCESS);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 2), false);
+	disposeMemoryImage(&image);
+
+	// all blocks written by records are used with the record coverage
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(readHexFileParallel("testfiles/blankrecord.hex", &device, &image, 1, true), EXIT_SUCCESS);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 2), false);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x00), 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&image, 0x101), 0x01);
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+// test indexHexFile function
+START_TEST(indexHexFileTest)
+{
+	int mapped;
+	uint8_t *text;
+	size_t textLength;
+	size_t recordNum;
+	hexRecord *records;
+	deviceData device;
+
+
+	// initialize the device
+	initializeDeviceData(&device);
+	device.memorySize = 256;
+	device.startAddress = 0;
+
+	// the data records are indexed in file order
+	ck_assert_int_eq(mapInputFile("testfiles/unordered.hex", &text, &textLength, &mapped), EXIT_SUCCESS);
+	ck_assert_int_eq(indexHexFile("testfiles/unordered.hex", text, textLength, &device, &records, &recordNum), EXIT_SUCCESS);
+	ck_assert_uint_eq(recordNum, 6);
+	ck_assert_uint_eq(records[0].offset, 0x40);
+	ck_assert_uint_eq(records[0].length, 16);
+	ck_assert_uint_eq(records[0].position, LINE_HEADER_LENGTH);
+	ck_assert_uint_eq(records[5].offset, 0x42);
+	ck_assert_uint_eq(records[5].length, 2);
+	ck_assert_uint_eq(text[records[5].position], '5');
+	free(records);
+
+	// records outside of the device are not indexed
+	device.memorySize = 0x40;
+	ck_assert_int_eq(indexHexFile("testfiles/unordered.hex", text, textLength, &device, &records, &recordNum), EXIT_FAILURE);
+	ck_assert(records == NULL);
+	unmapInputFile(text, textLength, mapped);
 }
 END_TEST
 
@@ -296,6 +470,21 @@ Suite	*testSuite()
 	tcase_add_test(testCase, readHexFileTest);
 	suite_add_tcase(suite, testCase);
 
+	// test cases for reading hex files with several threads
+	testCase = tcase_create("readHexFileParallel");
+	tcase_add_test(testCase, readHexFileParallelTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for using the blocks written by hex records
+	testCase = tcase_create("readHexFileRecordCoverage");
+	tcase_add_test(testCase, readHexFileRecordCoverageTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for indexing the data records of hex files
+	testCase = tcase_create("indexHexFile");
+	tcase_add_test(testCase, indexHexFileTest);
+	suite_add_tcase(suite, testCase);
+
 	return suite;
 }
 
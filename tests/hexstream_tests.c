@@ -0,0 +1,168 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/hex-stream.h"
+#include "test-files.h"
+
+
+// test compareHexRecords function
+START_TEST(compareHexRecordsTest)
+{
+	hexRecord first;
+	hexRecord second;
+
+
+	// records are sorted by offset
+	first.offset = 0x10;
+	first.position = 100;
+	second.offset = 0x20;
+	second.position = 10;
+	ck_assert(compareHexRecords(&first, &second) < 0);
+	ck_assert(compareHexRecords(&second, &first) > 0);
+
+	// then by position
+	second.offset = 0x10;
+	ck_assert(compareHexRecords(&first, &second) > 0);
+	ck_assert(compareHexRecords(&second, &first) < 0);
+	ck_assert(compareHexRecords(&first, &first) == 0);
+}
+END_TEST
+
+
+// test compareHexRecordPositions function
+START_TEST(compareHexRecordPositionsTest)
+{
+	hexRecord first;
+	hexRecord second;
+
+
+	first.offset = 0x10;
+	first.position = 10;
+	second.offset = 0x00;
+	second.position = 20;
+	ck_assert(compareHexRecordPositions(&first, &second) < 0);
+	ck_assert(compareHexRecordPositions(&second, &first) > 0);
+	ck_assert(compareHexRecordPositions(&first, &first) == 0);
+}
+END_TEST
+
+
+// test streamHexFile function
+START_TEST(streamHexFileTest)
+{
+	int i;
+	int format;
+	int allBlocks;
+	int coverage;
+	int8_t bitOrder[3][16];
+	memoryImage image;
+	deviceData device;
+	outputOptions options;
+
+
+	// device with 16 blocks of 8 words and different bit orders
+	initializeDeviceData(&device);
+	device.memorySize = 256;
+	device.blockSize = 16;
+	device.wordLength = 16;
+	device.addressLength = 16;
+	device.startAddress = 0;
+
+	for(i=0; i < 16; i++)
+	{
+		bitOrder[0][i] = 15 - i;
+		bitOrder[1][i] = i;
+	}
+	encodeBitOrderRuns(&device.wordBitOrder[PROGRAM], bitOrder[0], 16);
+	encodeBitOrderRuns(&device.wordBitOrder[VERIFY], bitOrder[1], 16);
+
+	for(i=0; i < 8; i++)
+	{
+		bitOrder[0][i] = i;
+		bitOrder[1][i] = 15 - i;
+		bitOrder[2][i] = 8 + i;
+	}
+	encodeBitOrderRuns(&device.wordAddressBitOrder[PROGRAM], bitOrder[0], 8);
+	encodeBitOrderRuns(&device.wordAddressBitOrder[VERIFY], bitOrder[0], 8);
+	encodeBitOrderRuns(&device.preDataBlockAddrBitOrder[PROGRAM], bitOrder[1], 8);
+	encodeBitOrderRuns(&device.postDataBlockAddrBitOrder[VERIFY], bitOrder[2], 8);
+
+	// unordered and overlapping records, records crossing blocks and a
+	// block written with 0xFF
+	initializeOutputOptions(&options);
+	for(format=BINARY_OUTPUT; format <= PACKED_OUTPUT; format++)
+	{
+		for(allBlocks=false; allBlocks <= true; allBlocks++)
+		{
+			for(coverage=false; coverage <= true; coverage++)
+			{
+				initializeOutputFormat(&options.format, format);
+				options.generateAllBlocks = allBlocks;
+				options.recordCoverage = coverage;
+
+				ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+				ck_assert_int_eq(readHexFileParallel("testfiles/unordered.hex", &device, &image, 1, coverage), EXIT_SUCCESS);
+				ck_assert_int_eq(generateOutputFiles("hexstream_out1", &device, &image, &options), EXIT_SUCCESS);
+				disposeMemoryImage(&image);
+
+				ck_assert_int_eq(streamHexFile("testfiles/unordered.hex", "hexstream_out3", &device, &options), EXIT_SUCCESS);
+
+				ck_assert(filesAreEqual("hexstream_out1_program_data", "hexstream_out3_program_data"));
+				ck_assert(filesAreEqual("hexstream_out1_verify_data", "hexstream_out3_verify_data"));
+				ck_assert(filesAreEqual("hexstream_out1_program_address", "hexstream_out3_program_address"));
+				ck_assert(filesAreEqual("hexstream_out1_verify_address", "hexstream_out3_verify_address"));
+			}
+		}
+	}
+
+	// files that can't be converted
+	ck_assert_int_eq(streamHexFile("testfiles/nonexistentfile.hex", "hexstream_out3", &device, &options), EXIT_FAILURE);
+	ck_assert_int_eq(streamHexFile("testfiles/invalidchecksum.hex", "hexstream_out3", &device, &options), EXIT_FAILURE);
+	ck_assert_int_eq(streamHexFile("testfiles/missingendoffile.hex", "hexstream_out3", &device, &options), EXIT_FAILURE);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("Hex Stream");
+
+
+	testCase = tcase_create("compareHexRecords");
+	tcase_add_test(testCase, compareHexRecordsTest);
+	suite_add_tcase(suite, testCase);
+
+	testCase = tcase_create("compareHexRecordPositions");
+	tcase_add_test(testCase, compareHexRecordPositionsTest);
+	suite_add_tcase(suite, testCase);
+
+	testCase = tcase_create("streamHexFile");
+	tcase_add_test(testCase, streamHexFileTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/memory-image.h"
+
+
+// test reading and writing a memory image
+START_TEST(memoryImageTest)
+{
+	uint8_t data[16];
+	memoryImage image;
+	deviceData device;
+
+
+	initializeDeviceData(&device);
+	device.memorySize = 64;
+	device.blockSize = 16;
+
+	// no block is allocated at the beginning
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(image.blockSize, 16);
+	ck_assert_int_eq(image.blockNum, 4);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), false);
+	ck_assert_uint_eq(readMemoryByte(&image, 63), 0xFF);
+
+	// a written byte allocates its block only
+	ck_assert_int_eq(writeMemoryByte(&image, 17, 0x12), EXIT_SUCCESS);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), true);
+	ck_assert_uint_eq(readMemoryByte(&image, 16), 0xFF);
+	ck_assert_uint_eq(readMemoryByte(&image, 17), 0x12);
+
+	// complete blocks
+	memset(data, 0x34, sizeof(data));
+	ck_assert_int_eq(storeMemoryBlock(&image, 3, data), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&image, 48), 0x34);
+	ck_assert_uint_eq(getMemoryBlock(&image, 3)[15], 0x34);
+	ck_assert_uint_eq(getMemoryBlock(&image, 2)[15], 0xFF);
+
+	// released blocks read as 0xFF again
+	releaseMemoryBlock(&image, 1);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), false);
+	ck_assert_uint_eq(readMemoryByte(&image, 17), 0xFF);
+
+	disposeMemoryImage(&image);
+
+	// the whole memory is one block without a valid block size
+	device.blockSize = 0;
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+	ck_assert_int_eq(image.blockSize, 64);
+	ck_assert_int_eq(image.blockNum, 1);
+	ck_assert_int_eq(writeMemoryByte(&image, 63, 0), EXIT_SUCCESS);
+	ck_assert_uint_eq(readMemoryByte(&image, 63), 0);
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("Memory Image");
+
+
+	testCase = tcase_create("memoryImage");
+	tcase_add_test(testCase, memoryImageTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
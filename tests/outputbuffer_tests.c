@@ -0,0 +1,393 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/output-buffer.h"
+
+
+// test writing a file through an output buffer
+START_TEST(outputBufferTest)
+{
+	int i;
+	char *string;
+	char readData[1000];
+	FILE *file;
+	outputBuffer buffer;
+
+
+	// the buffer holds whole chunks
+	ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", 300), EXIT_SUCCESS);
+	ck_assert_int_eq(buffer.size % 300, 0);
+	ck_assert_int_eq(buffer.length, 0);
+
+	// write 10 chunks of 100 bytes
+	for(i=0; i < 10; i++)
+	{
+		string = reserveOutputBuffer(&buffer, 100);
+		ck_assert_ptr_ne(string, NULL);
+		memset(string, '0' + i, 100);
+		buffer.length += 100;
+	}
+
+	// flush part of the data before closing the file
+	ck_assert_int_eq(flushOutputBuffer(&buffer), EXIT_SUCCESS);
+	ck_assert_int_eq(buffer.length, 0);
+
+	string = reserveOutputBuffer(&buffer, 1);
+	*string = 'X';
+	buffer.length++;
+
+	ck_assert_int_eq(closeOutputBuffer(&buffer), EXIT_SUCCESS);
+	ck_assert_ptr_eq(buffer.data, NULL);
+
+	// check the content of the file
+	file = fopen("testoutput", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	ck_assert_int_eq(fread(readData, 1, sizeof(readData), file), 1000);
+	ck_assert_int_eq(fread(readData, 1, sizeof(readData), file), 1);
+	fclose(file);
+
+	ck_assert_int_eq(readData[0], 'X');
+}
+END_TEST
+
+
+// test large chunks
+START_TEST(largeChunkTest)
+{
+	char *string;
+	outputBuffer buffer;
+
+
+	// a buffer holds at least one chunk
+	ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", OUTPUT_BUFFER_SIZE + 1), EXIT_SUCCESS);
+	ck_assert_int_eq(buffer.size, OUTPUT_BUFFER_SIZE + 1);
+
+	string = reserveOutputBuffer(&buffer, OUTPUT_BUFFER_SIZE + 1);
+	ck_assert_ptr_ne(string, NULL);
+	disposeOutputBuffer(&buffer);
+
+	// files in missing directories can't be created
+	ck_assert_int_eq(openOutputBuffer(&buffer, "missing/testoutput", 10), EXIT_FAILURE);
+}
+END_TEST
+
+
+// test buffers writing to a mapped file
+START_TEST(mappedBufferTest)
+{
+	int i;
+	char *string;
+	char readData[1000];
+	FILE *file;
+	outputBuffer buffer;
+	outputBuffer sharedBuffer;
+
+
+	ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", 100), EXIT_SUCCESS);
+
+	// empty files are not mapped
+	ck_assert_int_eq(mapOutputBuffer(&buffer, 0), EXIT_FAILURE);
+	ck_assert_ptr_eq(buffer.map, NULL);
+	ck_assert_ptr_ne(buffer.data, NULL);
+
+	ck_assert_int_eq(mapOutputBuffer(&buffer, 1000), EXIT_SUCCESS);
+	ck_assert_ptr_ne(buffer.map, NULL);
+	ck_assert_ptr_eq(buffer.data, NULL);
+
+	// the second half is written by a shared buffer with its own window
+	ck_assert_int_eq(shareOutputBuffer(&sharedBuffer, &buffer, 100, 500), EXIT_SUCCESS);
+	ck_assert_ptr_ne(sharedBuffer.map, NULL);
+	ck_assert_ptr_ne(sharedBuffer.map, buffer.map);
+	for(i=0; i < 5; i++)
+	{
+		string = reserveOutputBuffer(&sharedBuffer, 100);
+		ck_assert_ptr_eq(string, sharedBuffer.map + 500 + i*100);
+		memset(string, 'B', 100);
+		sharedBuffer.length += 100;
+		if(i == 2)
+			ck_assert_int_eq(flushOutputBuffer(&sharedBuffer), EXIT_SUCCESS);
+	}
+
+	// writing beyond the end of the file fails
+	ck_assert_ptr_eq(reserveOutputBuffer(&sharedBuffer, 1), NULL);
+	ck_assert_int_eq(closeOutputBuffer(&sharedBuffer), EXIT_SUCCESS);
+	ck_assert_ptr_ne(buffer.map, NULL);
+
+	for(i=0; i < 5; i++)
+	{
+		string = reserveOutputBuffer(&buffer, 100);
+		ck_assert_ptr_ne(string, NULL);
+		memset(string, 'A', 100);
+		buffer.length += 100;
+	}
+	ck_assert_int_eq(closeOutputBuffer(&buffer), EXIT_SUCCESS);
+	ck_assert_ptr_eq(buffer.map, NULL);
+
+	// check the content of the file
+	file = fopen("testoutput", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	ck_assert_int_eq(fread(readData, 1, sizeof(readData), file), 1000);
+	ck_assert_int_eq(fread(readData, 1, sizeof(readData), file), 0);
+	fclose(file);
+
+	for(i=0; i < 1000; i++)
+		ck_assert_int_eq(readData[i], (i < 500) ? 'A' : 'B');
+}
+END_TEST
+
+
+// test mapped files larger than a window
+START_TEST(mappedWindowTest)
+{
+	int i;
+	int c;
+	off_t mapOffset;
+	char *string;
+	FILE *file;
+	outputBuffer buffer;
+	outputBuffer sharedBuffer;
+
+
+	// 7 MB in chunks of 1000 bytes, windows of about 1 MB
+	ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", 1000), EXIT_SUCCESS);
+	ck_assert_int_eq(mapOutputBuffer(&buffer, 7000000), EXIT_SUCCESS);
+	ck_assert_int_eq(buffer.mapOffset, 0);
+	ck_assert(buffer.mapLength < 7000000);
+
+	// the last part of the file is written by a shared buffer
+	ck_assert_int_eq(shareOutputBuffer(&sharedBuffer, &buffer, 1000, 6000000), EXIT_SUCCESS);
+	ck_assert(sharedBuffer.mapOffset <= 6000000);
+	for(i=0; i < 1000; i++)
+	{
+		string = reserveOutputBuffer(&sharedBuffer, 1000);
+		ck_assert_ptr_ne(string, NULL);
+		memset(string, 'S', 1000);
+		sharedBuffer.length += 1000;
+	}
+	ck_assert_ptr_eq(reserveOutputBuffer(&sharedBuffer, 1), NULL);
+	ck_assert_int_eq(closeOutputBuffer(&sharedBuffer), EXIT_SUCCESS);
+
+	// only a bounded window is mapped while the window moves on
+	mapOffset = buffer.mapOffset;
+	for(i=0; i < 6000; i++)
+	{
+		string = reserveOutputBuffer(&buffer, 1000);
+		ck_assert_ptr_ne(string, NULL);
+		ck_assert(string >= buffer.map);
+		ck_assert(string + 1000 <= buffer.map + buffer.mapLength);
+		ck_assert(buffer.mapLength <= buffer.size + 65536);
+		ck_assert(buffer.mapOffset >= mapOffset);
+		mapOffset = buffer.mapOffset;
+		memset(string, 'A' + i % 26, 1000);
+		buffer.length += 1000;
+	}
+	ck_assert(buffer.mapOffset > 4000000);
+	ck_assert_int_eq(closeOutputBuffer(&buffer), EXIT_SUCCESS);
+	ck_assert_ptr_eq(buffer.map, NULL);
+
+	// check the content of the file
+	file = fopen("testoutput", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	for(i=0; i < 7000000; i++)
+	{
+		c = fgetc(file);
+		ck_assert_int_eq(c, (i < 6000000) ? 'A' + (i / 1000) % 26 : 'S');
+	}
+	ck_assert_int_eq(fgetc(file), EOF);
+	fclose(file);
+}
+END_TEST
+
+
+// test buffers with queued writes
+START_TEST(queuedBufferTest)
+{
+	int i;
+	int c;
+	char *string;
+	FILE *file;
+	outputBuffer buffer;
+	outputBuffer sharedBuffer;
+
+
+	// more data than fits into all buffers of the queue
+	ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", 1000), EXIT_SUCCESS);
+	if(queueOutputBuffer(&buffer) == EXIT_SUCCESS)
+	{
+		ck_assert_int_eq(buffer.backend, RING_BACKEND);
+		ck_assert_int_eq(buffer.bufferNum, OUTPUT_QUEUE_DEPTH);
+
+		// the writes are queued only once
+		ck_assert_int_eq(queueOutputBuffer(&buffer), EXIT_FAILURE);
+	}
+	else
+		ck_assert_int_eq(buffer.backend, WRITE_BACKEND);
+
+	// the last part of the file is written by a shared buffer
+	ck_assert_int_eq(shareOutputBuffer(&sharedBuffer, &buffer, 1000, 6000000), EXIT_SUCCESS);
+	ck_assert_int_eq(sharedBuffer.backend, buffer.backend);
+	for(i=0; i < 1000; i++)
+	{
+		string = reserveOutputBuffer(&sharedBuffer, 1000);
+		ck_assert_ptr_ne(string, NULL);
+		memset(string, 'S', 1000);
+		sharedBuffer.length += 1000;
+	}
+	ck_assert_int_eq(closeOutputBuffer(&sharedBuffer), EXIT_SUCCESS);
+
+	for(i=0; i < 6000; i++)
+	{
+		string = reserveOutputBuffer(&buffer, 1000);
+		ck_assert_ptr_ne(string, NULL);
+		memset(string, 'A' + i % 26, 1000);
+		buffer.length += 1000;
+	}
+	ck_assert_int_eq(closeOutputBuffer(&buffer), EXIT_SUCCESS);
+	ck_assert_ptr_eq(buffer.data, NULL);
+
+	// 5 full buffers and the rest
+	ck_assert_int_eq(buffer.writeNum, 6);
+	if(buffer.backend == RING_BACKEND)
+	{
+		ck_assert(buffer.maxQueueDepth >= 1);
+		ck_assert(buffer.maxQueueDepth <= OUTPUT_QUEUE_DEPTH);
+	}
+
+	addOutputStatistics(&buffer, &sharedBuffer);
+	ck_assert_int_eq(buffer.writeNum, 7);
+
+	// check the content of the file
+	file = fopen("testoutput", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	for(i=0; i < 7000000; i++)
+	{
+		c = fgetc(file);
+		ck_assert_int_eq(c, (i < 6000000) ? 'A' + (i / 1000) % 26 : 'S');
+	}
+	ck_assert_int_eq(fgetc(file), EOF);
+	fclose(file);
+}
+END_TEST
+
+
+// test buffers keeping the data out of the page cache
+START_TEST(uncachedBufferTest)
+{
+	int i;
+	int c;
+	int queued;
+	char *string;
+	FILE *file;
+	outputBuffer buffer;
+	outputBuffer sharedBuffer;
+
+
+	for(queued=false; queued <= true; queued++)
+	{
+		// the end of the file is not aligned
+		ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", 1000), EXIT_SUCCESS);
+		ck_assert_int_eq(uncacheOutputBuffer(&buffer), EXIT_SUCCESS);
+		ck_assert(buffer.caching == DIRECT_IO || buffer.caching == DROP_CACHE);
+		ck_assert_int_eq(uncacheOutputBuffer(&buffer), EXIT_FAILURE);
+		if(queued == true)
+			queueOutputBuffer(&buffer);
+
+		for(i=0; i < 2500; i++)
+		{
+			string = reserveOutputBuffer(&buffer, 1000);
+			ck_assert_ptr_ne(string, NULL);
+			memset(string, 'A' + i % 26, 1000);
+			buffer.length += 1000;
+
+			// flushed data is written in aligned parts only
+			if(i == 10)
+			{
+				ck_assert_int_eq(flushOutputBuffer(&buffer), EXIT_SUCCESS);
+				if(buffer.caching == DIRECT_IO)
+				{
+					ck_assert_int_eq(buffer.offset, 8192);
+					ck_assert_int_eq(buffer.length, 11000 - 8192);
+				}
+			}
+		}
+		ck_assert_int_eq(closeOutputBuffer(&buffer), EXIT_SUCCESS);
+
+		file = fopen("testoutput", "rb");
+		ck_assert_ptr_ne(file, NULL);
+		for(i=0; i < 2500000; i++)
+		{
+			c = fgetc(file);
+			ck_assert_int_eq(c, 'A' + (i / 1000) % 26);
+		}
+		ck_assert_int_eq(fgetc(file), EOF);
+		fclose(file);
+	}
+
+	// buffers sharing the file start at unaligned positions
+	ck_assert_int_eq(openOutputBuffer(&buffer, "testoutput", 1000), EXIT_SUCCESS);
+	ck_assert_int_eq(uncacheOutputBuffer(&buffer), EXIT_SUCCESS);
+	ck_assert_int_eq(shareOutputBuffer(&sharedBuffer, &buffer, 1000, 1000), EXIT_SUCCESS);
+	ck_assert_int_ne(buffer.caching, DIRECT_IO);
+	ck_assert_int_eq(sharedBuffer.caching, buffer.caching);
+
+	string = reserveOutputBuffer(&sharedBuffer, 1000);
+	memset(string, 'S', 1000);
+	sharedBuffer.length += 1000;
+	ck_assert_int_eq(closeOutputBuffer(&sharedBuffer), EXIT_SUCCESS);
+
+	string = reserveOutputBuffer(&buffer, 1000);
+	memset(string, 'B', 1000);
+	buffer.length += 1000;
+	ck_assert_int_eq(closeOutputBuffer(&buffer), EXIT_SUCCESS);
+
+	file = fopen("testoutput", "rb");
+	ck_assert_ptr_ne(file, NULL);
+	for(i=0; i < 2000; i++)
+		ck_assert_int_eq(fgetc(file), (i < 1000) ? 'B' : 'S');
+	ck_assert_int_eq(fgetc(file), EOF);
+	fclose(file);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("OutputBuffer");
+
+
+	// test cases for writing files through output buffers
+	testCase = tcase_create("outputBuffer");
+	tcase_add_test(testCase, outputBufferTest);
+	tcase_add_test(testCase, largeChunkTest);
+	tcase_add_test(testCase, mappedBufferTest);
+	tcase_add_test(testCase, mappedWindowTest);
+	tcase_add_test(testCase, queuedBufferTest);
+	tcase_add_test(testCase, uncachedBufferTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
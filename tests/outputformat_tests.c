@@ -0,0 +1,112 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/output-format.h"
+
+
+// test initializeOutputFormat function
+START_TEST(initializeOutputFormatTest)
+{
+	outputFormat format;
+
+
+	// space separated ascii output with a line break after every word
+	initializeOutputFormat(&format, ASCII_OUTPUT);
+	ck_assert_int_eq(format.type, ASCII_OUTPUT);
+	ck_assert_int_eq(format.symbol[0], '0');
+	ck_assert_int_eq(format.symbol[1], '1');
+	ck_assert_str_eq(format.separator, " ");
+	ck_assert_int_eq(format.separatorLength, 1);
+	ck_assert_str_eq(format.terminator, "\r\n");
+	ck_assert_int_eq(format.terminatorLength, 2);
+	ck_assert_int_eq(format.wordsPerLine, 1);
+
+	// binary output has no separators
+	initializeOutputFormat(&format, BINARY_OUTPUT);
+	ck_assert_int_eq(format.type, BINARY_OUTPUT);
+	ck_assert_int_eq(format.symbol[0], 0);
+	ck_assert_int_eq(format.symbol[1], 1);
+	ck_assert_int_eq(format.separatorLength, 0);
+	ck_assert_int_eq(format.terminatorLength, 0);
+	ck_assert_int_eq(format.wordsPerLine, 1);
+}
+END_TEST
+
+
+// test parseOutputFormat function
+START_TEST(parseOutputFormatTest)
+{
+	outputFormat format;
+
+
+	// all entries
+	initializeOutputFormat(&format, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&format, "bits=.X,separator=none,terminator=lf,words=4"), EXIT_SUCCESS);
+	ck_assert_int_eq(format.symbol[0], '.');
+	ck_assert_int_eq(format.symbol[1], 'X');
+	ck_assert_int_eq(format.separatorLength, 0);
+	ck_assert_str_eq(format.terminator, "\n");
+	ck_assert_int_eq(format.terminatorLength, 1);
+	ck_assert_int_eq(format.wordsPerLine, 4);
+
+	// entries which are not given keep their value
+	initializeOutputFormat(&format, ASCII_OUTPUT);
+	ck_assert_int_eq(parseOutputFormat(&format, "separator=tab"), EXIT_SUCCESS);
+	ck_assert_str_eq(format.separator, "\t");
+	ck_assert_str_eq(format.terminator, "\r\n");
+	ck_assert_int_eq(format.symbol[1], '1');
+
+	// invalid descriptions
+	ck_assert_int_eq(parseOutputFormat(&format, "bits"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "bits=0"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "bits=00"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "separator=dash"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "terminator=crcr"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "words=0"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "words=2x"), EXIT_FAILURE);
+	ck_assert_int_eq(parseOutputFormat(&format, "lines=2"), EXIT_FAILURE);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("OutputFormat");
+
+
+	// test cases for initializeOutputFormat function
+	testCase = tcase_create("initializeOutputFormat");
+	tcase_add_test(testCase, initializeOutputFormatTest);
+	suite_add_tcase(suite, testCase);
+
+	// test cases for parseOutputFormat function
+	testCase = tcase_create("parseOutputFormat");
+	tcase_add_test(testCase, parseOutputFormatTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
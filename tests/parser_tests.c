@@ -0,0 +1,126 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/parser.h"
+#include "../src/bit-runs.h"
+
+
+// parse a device description from a string
+static int	parseString(char *source, deviceData *device)
+{
+	initializeDeviceData(device);
+
+	return parseSourceBuffer(source, strlen(source), device, stdout);
+}
+
+
+// check the bits of a bit order
+static void	checkBitOrder(bitOrderRuns *runs, int8_t *expected, int length)
+{
+	int8_t bitOrder[MAX_BIT_ORDER_LENGTH];
+
+
+	ck_assert_int_eq(runs->length, length);
+	ck_assert_int_eq(expandBitOrderRuns(runs, bitOrder, MAX_BIT_ORDER_LENGTH), EXIT_SUCCESS);
+	ck_assert_int_eq(memcmp(bitOrder, expected, length), 0);
+}
+
+
+// test parsing of the bit orders
+START_TEST(parseBitOrdersTest)
+{
+	deviceData device;
+	int8_t wordBitOrder[] = {31, 30, 29, 28, 3, 2, 1, 0};
+	int8_t addressBitOrder[] = {LITERAL0_BIT, 0, 1, 2, 3, 4, 5, 6, 7, 
+		LITERAL1_BIT};
+
+
+	ck_assert_int_eq(parseString(
+		"device name = \"parsertest\"\r\n"
+		"memory size = 0x100\r\n"
+		"block size = 0x10\r\n"
+		"word length = 32\r\n"
+		"address length = 8\r\n"
+		"program data = { 31-28, 3-0 }\r\n"
+		"verify data = { 31-28, 3-0 }\r\n"
+		"address = { '0', 0-7, '1' }\r\n", &device), EXIT_SUCCESS);
+
+	ck_assert_str_eq(device.name, "parsertest");
+	checkBitOrder(&device.wordBitOrder[PROGRAM], wordBitOrder, sizeof(wordBitOrder));
+	checkBitOrder(&device.wordBitOrder[VERIFY], wordBitOrder, sizeof(wordBitOrder));
+	checkBitOrder(&device.wordAddressBitOrder[PROGRAM], addressBitOrder, sizeof(addressBitOrder));
+	checkBitOrder(&device.wordAddressBitOrder[VERIFY], addressBitOrder, sizeof(addressBitOrder));
+	ck_assert_int_eq(bitOrderIsEmpty(&device.preDataBlockAddrBitOrder[PROGRAM]), true);
+}
+END_TEST
+
+
+// test splitting a block address at the repeat of the word address
+START_TEST(parseBlockAddressTest)
+{
+	deviceData device;
+	int8_t preBlockBitOrder[] = {15, 14, 13, 12, 11, 10, 9, 8, LITERAL1_BIT};
+	int8_t wordBitOrder[] = {7, 6, 5, 4, 3, 2, 1, 0, LITERAL0_BIT};
+	int8_t postBlockBitOrder[] = {LITERAL0_BIT, 0, 1, 2, 3, 4, 5, 6, 7, 
+		8, 9, 10, 11, 12, 13, 14, 15, LITERAL1_BIT};
+
+
+	ck_assert_int_eq(parseString(
+		"device name = \"parsertest\"\r\n"
+		"memory size = 0x8000\r\n"
+		"block size = 0x100\r\n"
+		"word length = 32\r\n"
+		"address length = 16\r\n"
+		"program data = { 0-31 }\r\n"
+		"verify data = { 31-0 }\r\n"
+		"address = { 15-8, '1', (7-0, '0')*257 }\r\n"
+		"address = { '0', 0-15, '1' }\r\n", &device), EXIT_SUCCESS);
+
+	// all bits before the repeat are the block address, all repeated bits
+	// are the word address
+	checkBitOrder(&device.preDataBlockAddrBitOrder[PROGRAM], preBlockBitOrder, sizeof(preBlockBitOrder));
+	checkBitOrder(&device.preDataBlockAddrBitOrder[VERIFY], preBlockBitOrder, sizeof(preBlockBitOrder));
+	checkBitOrder(&device.wordAddressBitOrder[PROGRAM], wordBitOrder, sizeof(wordBitOrder));
+	checkBitOrder(&device.wordAddressBitOrder[VERIFY], wordBitOrder, sizeof(wordBitOrder));
+	checkBitOrder(&device.postDataBlockAddrBitOrder[PROGRAM], postBlockBitOrder, sizeof(postBlockBitOrder));
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("Parser");
+
+
+	// test cases for parsing bit orders
+	testCase = tcase_create("parseBitOrders");
+	tcase_add_test(testCase, parseBitOrdersTest);
+	tcase_add_test(testCase, parseBlockAddressTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -7,154 +7,261 @@
 // scan an input file
 START_TEST(scanFileTest)
 {
+	scannerContext scanner;
+
+
 	// initialize the scanner
-	ck_assert_int_eq(initializeScanner("testfiles/scanner.dev"), EXIT_SUCCESS);
+	ck_assert_int_eq(initializeScanner(&scanner, "testfiles/scanner.dev"),
+		EXIT_SUCCESS);
 
 	// expect '='
-	ck_assert_int_eq(getCurrentSymbol(), EQUAL_SYM);
-	ck_assert_int_eq(getCurrentLine(), 1);
-	ck_assert_int_eq(getCurrentColumn(), 2);
+	ck_assert_int_eq(getCurrentSymbol(&scanner), EQUAL_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 1);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 2);
 
 	// expect new line
-	ck_assert_int_eq(scanNextSymbol(), NEWLINE_SYM);
-	ck_assert_int_eq(getCurrentLine(), 1);
-	ck_assert_int_eq(getCurrentColumn(), 4);
+	ck_assert_int_eq(scanNextSymbol(&scanner), NEWLINE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 1);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 4);
 
 	// expect ident
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), IDENT_SYM);
-	ck_assert_str_eq(getCurrentIdentName(), "wident");
-	ck_assert_int_eq(getCurrentLine(), 2);
-	ck_assert_int_eq(getCurrentColumn(), 3);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "wident");
+	ck_assert_int_eq(getCurrentLine(&scanner), 2);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 3);
 
 	// expect '='
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), EQUAL_SYM);
-	ck_assert_int_eq(getCurrentLine(), 2);
-	ck_assert_int_eq(getCurrentColumn(), 11);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), EQUAL_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 2);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 11);
 
 	// expect decimal number
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), DEC_NUMBER_SYM);
-	ck_assert_int_eq(getCurrentNumberValue(), 0);
-	ck_assert_int_eq(getCurrentLine(), 2);
-	ck_assert_int_eq(getCurrentColumn(), 13);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), DEC_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 0);
+	ck_assert_int_eq(getCurrentLine(&scanner), 2);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 13);
 
 	// expect ident
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), IDENT_SYM);
-	ck_assert_str_eq(getCurrentIdentName(), "xident");
-	ck_assert_int_eq(getCurrentLine(), 4);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "xident");
+	ck_assert_int_eq(getCurrentLine(&scanner), 4);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// expect '='
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), EQUAL_SYM);
-	ck_assert_int_eq(getCurrentLine(), 4);
-	ck_assert_int_eq(getCurrentColumn(), 8);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), EQUAL_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 4);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 8);
 
 	// expect hexadecimal number
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), HEX_NUMBER_SYM);
-	ck_assert_int_eq(getCurrentNumberValue(), 0x400);
-	ck_assert_int_eq(getCurrentLine(), 4);
-	ck_assert_int_eq(getCurrentColumn(), 10);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), HEX_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 0x400);
+	ck_assert_int_eq(getCurrentLine(&scanner), 4);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 10);
 
 	// expect ident
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), IDENT_SYM);
-	ck_assert_str_eq(getCurrentIdentName(), "yident");
-	ck_assert_int_eq(getCurrentLine(), 6);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "yident");
+	ck_assert_int_eq(getCurrentLine(&scanner), 6);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// expect new line
-	ck_assert_int_eq(scanNextSymbol(), NEWLINE_SYM);
-	ck_assert_int_eq(getCurrentLine(), 6);
-	ck_assert_int_eq(getCurrentColumn(), 8);
+	ck_assert_int_eq(scanNextSymbol(&scanner), NEWLINE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 6);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 8);
 
 	// expect new line
-	ck_assert_int_eq(scanNextSymbol(), NEWLINE_SYM);
-	ck_assert_int_eq(getCurrentLine(), 7);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbol(&scanner), NEWLINE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 7);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// expect new line
-	ck_assert_int_eq(scanNextSymbol(), NEWLINE_SYM);
-	ck_assert_int_eq(getCurrentLine(), 8);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbol(&scanner), NEWLINE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 8);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// expect ident
-	ck_assert_int_eq(scanNextSymbol(), IDENT_SYM);
-	ck_assert_str_eq(getCurrentIdentName(), "zident");
-	ck_assert_int_eq(getCurrentLine(), 9);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbol(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "zident");
+	ck_assert_int_eq(getCurrentLine(&scanner), 9);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// expect '='
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), EQUAL_SYM);
-	ck_assert_int_eq(getCurrentLine(), 9);
-	ck_assert_int_eq(getCurrentColumn(), 8);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), EQUAL_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 9);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 8);
 
 	// expect decimal number
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), DEC_NUMBER_SYM);
-	ck_assert_int_eq(getCurrentNumberValue(), 8192);
-	ck_assert_int_eq(getCurrentLine(), 9);
-	ck_assert_int_eq(getCurrentColumn(), 10);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), DEC_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 8192);
+	ck_assert_int_eq(getCurrentLine(&scanner), 9);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 10);
 
 	// expect '"'
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), DOUBLE_QUOTE_SYM);
-	ck_assert_int_eq(getCurrentLine(), 11);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), DOUBLE_QUOTE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 11);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// expect ident
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), IDENT_SYM);
-	ck_assert_str_eq(getCurrentIdentName(), "stringstring");
-	ck_assert_int_eq(getCurrentLine(), 11);
-	ck_assert_int_eq(getCurrentColumn(), 2);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "stringstring");
+	ck_assert_int_eq(getCurrentLine(&scanner), 11);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 2);
 
 	// expect '''
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), SINGLE_QUOTE_SYM);
-	ck_assert_int_eq(getCurrentLine(), 11);
-	ck_assert_int_eq(getCurrentColumn(), 14);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), SINGLE_QUOTE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 11);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 14);
 
 	// expect '{'
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), LEFT_CURLY_BRACKET_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 3);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), LEFT_CURLY_BRACKET_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 3);
 
 	// expect ')'
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), RIGHT_PARENTHESIS_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 4);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), RIGHT_PARENTHESIS_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 4);
 
 	// expect ','
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), COMMA_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 5);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), COMMA_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 5);
 
 	// expect '*'
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), ASTERISK_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 6);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), ASTERISK_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 6);
 
 	// expect '-'
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), HYPHEN_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 7);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), HYPHEN_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 7);
 
 	// expect '('
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), LEFT_PARENTHESIS_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 8);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), LEFT_PARENTHESIS_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 8);
 
 	// expect '}'
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), RIGHT_CURLY_BRACKET_SYM);
-	ck_assert_int_eq(getCurrentLine(), 12);
-	ck_assert_int_eq(getCurrentColumn(), 9);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), RIGHT_CURLY_BRACKET_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 12);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 9);
 
 	// expect unknown symbol
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), UNKNOWN_SYM);
-	ck_assert_int_eq(getCurrentLine(), 13);
-	ck_assert_int_eq(getCurrentColumn(), 5);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), UNKNOWN_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 13);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 5);
 
 	// expect end of file
-	ck_assert_int_eq(scanNextSymbolSkipNewline(), EOF_SYM);
-	ck_assert_int_eq(getCurrentLine(), 14);
-	ck_assert_int_eq(getCurrentColumn(), 1);
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), EOF_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 14);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
 
 	// dispose the scanner
-	disposeScanner();
+	disposeScanner(&scanner);
+}
+END_TEST
+
+
+// scan a source in memory
+START_TEST(scanMemoryTest)
+{
+	scannerContext scanner;
+	char source[] = "data = 0x1F ! comment\r\n{3-0}*2\n 'X";
+
+
+	// initialize the scanner without the terminating zero
+	initializeMemoryScanner(&scanner, source, strlen(source));
+
+	// expect ident
+	ck_assert_int_eq(getCurrentSymbol(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "data");
+	ck_assert_int_eq(getCurrentLine(&scanner), 1);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
+
+	// expect '='
+	ck_assert_int_eq(scanNextSymbol(&scanner), EQUAL_SYM);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 6);
+
+	// expect hexadecimal number
+	ck_assert_int_eq(scanNextSymbol(&scanner), HEX_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 0x1F);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 8);
+
+	// expect the comment to be a new line
+	ck_assert_int_eq(scanNextSymbol(&scanner), NEWLINE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 1);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 13);
+
+	// expect '{'
+	ck_assert_int_eq(scanNextSymbol(&scanner), LEFT_CURLY_BRACKET_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 2);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 1);
+
+	// expect a range and a repeat
+	ck_assert_int_eq(scanNextSymbol(&scanner), DEC_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 3);
+	ck_assert_int_eq(scanNextSymbol(&scanner), HYPHEN_SYM);
+	ck_assert_int_eq(scanNextSymbol(&scanner), DEC_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 0);
+	ck_assert_int_eq(scanNextSymbol(&scanner), RIGHT_CURLY_BRACKET_SYM);
+	ck_assert_int_eq(scanNextSymbol(&scanner), ASTERISK_SYM);
+	ck_assert_int_eq(scanNextSymbol(&scanner), DEC_NUMBER_SYM);
+	ck_assert_int_eq(getCurrentNumberValue(&scanner), 2);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 7);
+
+	// expect '''
+	ck_assert_int_eq(scanNextSymbolSkipNewline(&scanner), SINGLE_QUOTE_SYM);
+	ck_assert_int_eq(getCurrentLine(&scanner), 3);
+	ck_assert_int_eq(getCurrentColumn(&scanner), 2);
+
+	// expect ident and the end of the source
+	ck_assert_int_eq(scanNextSymbol(&scanner), IDENT_SYM);
+	ck_assert_str_eq(getCurrentIdentName(&scanner), "x");
+	ck_assert_int_eq(scanNextSymbol(&scanner), EOF_SYM);
+	ck_assert_int_eq(scanNextSymbol(&scanner), EOF_SYM);
+
+	// the source is not changed by the scanner
+	disposeScanner(&scanner);
+	ck_assert_str_eq(source, "data = 0x1F ! comment\r\n{3-0}*2\n 'X");
+}
+END_TEST
+
+
+// scan a file twice at the same time
+START_TEST(scanInterleavedTest)
+{
+	scannerContext first;
+	scannerContext second;
+	int symbol;
+
+
+	// initialize both scanners
+	ck_assert_int_eq(initializeScanner(&first, "testfiles/scanner.dev"),
+		EXIT_SUCCESS);
+	ck_assert_int_eq(initializeScanner(&second, "testfiles/scanner.dev"),
+		EXIT_SUCCESS);
+
+	// both scanners have to return the same symbols
+	do
+	{
+		symbol = scanNextSymbol(&first);
+		ck_assert_int_eq(scanNextSymbol(&second), symbol);
+		ck_assert_int_eq(getCurrentLine(&first), getCurrentLine(&second));
+		ck_assert_int_eq(getCurrentColumn(&first),
+			getCurrentColumn(&second));
+		if(symbol == IDENT_SYM)
+			ck_assert_str_eq(getCurrentIdentName(&first),
+				getCurrentIdentName(&second));
+		if((symbol == DEC_NUMBER_SYM) || (symbol == HEX_NUMBER_SYM))
+			ck_assert_int_eq(getCurrentNumberValue(&first),
+				getCurrentNumberValue(&second));
+	}
+	while(symbol != EOF_SYM);
+
+	// dispose the scanners
+	disposeScanner(&first);
+	disposeScanner(&second);
 }
 END_TEST
 
@@ -173,6 +280,11 @@ Suite	*testSuite()
 	tcase_add_test(testCase, scanFileTest);
 	suite_add_tcase(suite, testCase);
 
+	testCase = tcase_create("scanMemory");
+	tcase_add_test(testCase, scanMemoryTest);
+	tcase_add_test(testCase, scanInterleavedTest);
+	suite_add_tcase(suite, testCase);
+
 	return suite;
 }
 
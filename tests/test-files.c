@@ -0,0 +1,32 @@
+#include <config.h>
+#include <check.h>
+
+#include "test-files.h"
+
+
+// compare two files
+int	filesAreEqual(char *fileName1, char *fileName2)
+{
+	int c1;
+	int c2;
+	FILE *file1;
+	FILE *file2;
+
+
+	file1 = fopen(fileName1, "rb");
+	file2 = fopen(fileName2, "rb");
+	ck_assert_ptr_ne(file1, NULL);
+	ck_assert_ptr_ne(file2, NULL);
+
+	do
+	{
+		c1 = fgetc(file1);
+		c2 = fgetc(file2);
+	}
+	while((c1 == c2) && (c1 != EOF));
+
+	fclose(file1);
+	fclose(file2);
+
+	return (c1 == c2);
+}
@@ -0,0 +1,10 @@
+#ifndef _TEST_FILES_H
+#define _TEST_FILES_H
+
+#include <stdio.h>
+
+
+// compare two files, true if they have the same contents
+extern	int	filesAreEqual(char *, char *);
+
+#endif /* _TEST_FILES_H */
@@ -0,0 +1,106 @@
+#include <config.h>
+#include <check.h>
+
+#include "../src/used-blocks.h"
+
+
+// test the detection of blank memory
+START_TEST(isBlankMemoryTest)
+{
+	int i;
+	uint8_t data[200];
+
+
+	memset(data, 0xFF, sizeof(data));
+
+	// empty and blank memory
+	ck_assert_int_eq(isBlankMemory(data, 0), true);
+	ck_assert_int_eq(isBlankMemory(data, sizeof(data)), true);
+
+	// a single cleared bit has to be found in the wide pieces and in the rest
+	for(i=0; i < sizeof(data); i++)
+	{
+		data[i] = 0x7F;
+		ck_assert_int_eq(isBlankMemory(data, sizeof(data)), false);
+		ck_assert_int_eq(isBlankMemory(data, i), true);
+		ck_assert_int_eq(isBlankMemory(data + i + 1, sizeof(data) - i - 1), true);
+		data[i] = 0xFF;
+	}
+}
+END_TEST
+
+
+// test releasing the blank blocks of a memory image
+START_TEST(releaseBlankBlocksTest)
+{
+	memoryImage image;
+	deviceData device;
+
+
+	initializeDeviceData(&device);
+	device.memorySize = 1000;
+	device.blockSize = 100;
+	ck_assert_int_eq(initializeMemoryImage(&image, &device), EXIT_SUCCESS);
+
+	writeMemoryByte(&image, 50, 0xFF);
+	writeMemoryByte(&image, 150, 0x00);
+	writeMemoryByte(&image, 250, 0xFF);
+	writeMemoryByte(&image, 999, 0xFE);
+
+	// only the given range is checked
+	releaseBlankBlocks(&image, 1, 9);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 1), true);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 2), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 8), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 9), true);
+
+	releaseBlankBlocks(&image, 0, 10);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 0), false);
+	ck_assert_int_eq(memoryBlockIsAllocated(&image, 9), true);
+	ck_assert_uint_eq(readMemoryByte(&image, 999), 0xFE);
+
+	disposeMemoryImage(&image);
+}
+END_TEST
+
+
+Suite	*testSuite()
+{
+	Suite *suite;
+	TCase *testCase;
+
+
+	suite = suite_create("Used Blocks");
+
+
+	testCase = tcase_create("isBlankMemory");
+	tcase_add_test(testCase, isBlankMemoryTest);
+	suite_add_tcase(suite, testCase);
+
+	testCase = tcase_create("releaseBlankBlocks");
+	tcase_add_test(testCase, releaseBlankBlocksTest);
+	suite_add_tcase(suite, testCase);
+
+	return suite;
+}
+
+
+int main(void)
+{
+	int testResult;
+	Suite *suite;
+	SRunner *suiteRunner;
+
+
+	// create the test suite and the runner
+	suite = testSuite();
+	suiteRunner = srunner_create(suite);
+
+	// execute the tests
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	testResult = srunner_ntests_failed(suiteRunner);
+	srunner_free(suiteRunner);
+
+	return (testResult == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}